@@ -8,9 +8,11 @@
 #include <absl/strings/str_format.h>
 #include <absl/time/time.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <map>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -30,6 +32,7 @@
 #include "OrbitBase/Future.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Result.h"
+#include "OrbitBase/Zlib.h"
 
 namespace orbit_capture_client {
 
@@ -179,9 +182,50 @@ std::vector<ApiFunction> FindApiFunctions(const orbit_client_data::ModuleManager
   capture_options.set_thread_state_change_callstack_collection(
       options.thread_state_change_callstack_collection);
 
+  capture_options.set_ring_buffer_wakeup_method(options.ring_buffer_wakeup_method);
+  capture_options.set_ring_buffer_reader_thread_count(options.ring_buffer_reader_thread_count);
+  capture_options.set_event_processing_delay_mode(options.event_processing_delay_mode);
+  capture_options.set_unwinding_thread_count(options.unwinding_thread_count);
+  capture_options.set_capture_stream_compression(options.capture_stream_compression);
+
   return capture_options;
 }
 
+// The maximum size of a message received on the channels of the client, which use gRPC's default.
+constexpr uint64_t kMaxUncompressedCaptureResponseSize = 4 * 1024 * 1024;
+
+// If the service sent the capture events of `response` compressed, replaces them with the
+// decompressed ones.
+ErrorMessageOr<void> DecompressCaptureEvents(CaptureResponse* response) {
+  switch (response->compression()) {
+    case CaptureOptions::kCaptureStreamCompressionUnspecified:
+    case CaptureOptions::kCaptureStreamNoCompression:
+      return outcome::success();
+    case CaptureOptions::kCaptureStreamZlib:
+      break;
+    default:
+      return ErrorMessage{
+          absl::StrFormat("Unknown capture stream compression %d", response->compression())};
+  }
+
+  // The same events sent uncompressed would have to fit into a single message, so there is no
+  // reason to allocate more than that for them.
+  if (response->uncompressed_size() > kMaxUncompressedCaptureResponseSize) {
+    return ErrorMessage{
+        absl::StrFormat("Compressed capture events of %u bytes exceed the limit of %u bytes",
+                        response->uncompressed_size(), kMaxUncompressedCaptureResponseSize)};
+  }
+  OUTCOME_TRY(std::string serialized_response,
+              orbit_base::ZlibDecompress(response->compressed_capture_events(),
+                                         response->uncompressed_size()));
+  CaptureResponse decompressed_response;
+  if (!decompressed_response.ParseFromString(serialized_response)) {
+    return ErrorMessage{"Unable to parse the decompressed capture events"};
+  }
+  *response = std::move(decompressed_response);
+  return outcome::success();
+}
+
 }  // namespace
 
 orbit_base::Future<ErrorMessageOr<CaptureListener::CaptureOutcome>> CaptureClient::Capture(
@@ -242,6 +286,7 @@ ErrorMessageOr<CaptureListener::CaptureOutcome> CaptureClient::CaptureSync(
   }
   ORBIT_LOG("Sent CaptureRequest on Capture's gRPC stream: asking to start capturing");
 
+  std::optional<ErrorMessage> decompress_error;
   while (!writes_done_failed_ && !try_abort_) {
     CaptureResponse response;
     bool read_succeeded{};
@@ -249,11 +294,19 @@ ErrorMessageOr<CaptureListener::CaptureOutcome> CaptureClient::CaptureSync(
       absl::ReaderMutexLock lock{&context_and_stream_mutex_};
       read_succeeded = reader_writer_->Read(&response);
     }
-    if (read_succeeded) {
-      ProcessEvents(capture_event_processor, response.capture_events());
-    } else {
+    if (!read_succeeded) break;
+
+    ErrorMessageOr<void> decompress_result = DecompressCaptureEvents(&response);
+    if (decompress_result.has_error()) {
+      // Later events can refer to interned strings and callstacks sent with the lost ones, so the
+      // capture can't continue.
+      ORBIT_ERROR("Decompressing CaptureResponse: %s", decompress_result.error().message());
+      decompress_error = decompress_result.error();
+      absl::ReaderMutexLock lock{&context_and_stream_mutex_};
+      client_context_->TryCancel();
       break;
     }
+    ProcessEvents(capture_event_processor, response.capture_events());
   }
 
   ErrorMessageOr<void> finish_result = FinishCapture();
@@ -263,6 +316,13 @@ ErrorMessageOr<CaptureListener::CaptureOutcome> CaptureClient::CaptureSync(
     return CaptureListener::CaptureOutcome::kCancelled;
   }
 
+  if (decompress_error.has_value()) {
+    return ErrorMessage{absl::StrFormat(
+        "The capture was stopped, as capture data received from the service could not be "
+        "decompressed: %s",
+        decompress_error->message())};
+  }
+
   if (writes_done_failed_) {
     ORBIT_LOG(
         "WritesDone on Capture's gRPC stream failed: stop reading and try to finish the gRPC call");
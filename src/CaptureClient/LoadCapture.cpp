@@ -6,6 +6,9 @@
 
 #include <absl/container/flat_hash_set.h>
 #include <absl/hash/hash.h>
+#include <absl/time/clock.h>
+#include <absl/time/time.h>
+#include <absl/types/span.h>
 #include <google/protobuf/stubs/port.h>
 
 #include <cstdint>
@@ -22,6 +25,39 @@
 
 namespace orbit_capture_client {
 
+using orbit_grpc_protos::ClientCaptureEvent;
+
+namespace {
+
+struct LoadStatistics {
+  uint64_t event_count = 0;
+  uint64_t event_bytes = 0;
+};
+
+[[nodiscard]] ErrorMessageOr<CaptureListener::CaptureOutcome> ProcessCaptureSection(
+    orbit_capture_file::ProtoSectionInputStream* capture_section_input_stream,
+    CaptureEventProcessor* capture_event_processor,
+    std::atomic<bool>* capture_loading_cancellation_requested, LoadStatistics* statistics) {
+  while (true) {
+    if (*capture_loading_cancellation_requested) {
+      return CaptureListener::CaptureOutcome::kCancelled;
+    }
+    ClientCaptureEvent event;
+    // Not copied when the capture section is mapped into memory.
+    OUTCOME_TRY(absl::Span<const uint8_t> event_bytes,
+                capture_section_input_stream->ReadMessageSpan());
+    OUTCOME_TRY(orbit_capture_file::ParseMessage(event_bytes.data(), event_bytes.size(), &event));
+    ++statistics->event_count;
+    statistics->event_bytes += event_bytes.size();
+    capture_event_processor->ProcessEvent(event);
+    if (event.event_case() == ClientCaptureEvent::kCaptureFinished) {
+      return CaptureListener::CaptureOutcome::kComplete;
+    }
+  }
+}
+
+}  // namespace
+
 [[nodiscard]] ErrorMessageOr<CaptureListener::CaptureOutcome> LoadCapture(
     CaptureListener* listener, orbit_capture_file::CaptureFile* capture_file,
     std::atomic<bool>* capture_loading_cancellation_requested) {
@@ -46,18 +82,19 @@ namespace orbit_capture_client {
                                                         frame_track_function_ids);
 
     auto capture_section_input_stream = capture_file->CreateCaptureSectionInputStream();
-    while (true) {
-      if (*capture_loading_cancellation_requested) {
-        return CaptureListener::CaptureOutcome::kCancelled;
-      }
-      orbit_grpc_protos::ClientCaptureEvent event;
-      OUTCOME_TRY(capture_section_input_stream->ReadMessage(&event));
-      capture_event_processor->ProcessEvent(event);
-      if (event.event_case() == orbit_grpc_protos::ClientCaptureEvent::kCaptureFinished) {
-        return CaptureListener::CaptureOutcome::kComplete;
-      }
-    }
+    LoadStatistics statistics;
+    const absl::Time start_time = absl::Now();
+    ErrorMessageOr<CaptureListener::CaptureOutcome> outcome =
+        ProcessCaptureSection(capture_section_input_stream.get(), capture_event_processor.get(),
+                              capture_loading_cancellation_requested, &statistics);
+
+    const double seconds = absl::ToDoubleSeconds(absl::Now() - start_time);
+    ORBIT_LOG("Processed %u events (%.1f MB): %.1f MB/s, %.0f events/s", statistics.event_count,
+              statistics.event_bytes / 1e6,
+              seconds > 0 ? statistics.event_bytes / 1e6 / seconds : 0,
+              seconds > 0 ? statistics.event_count / seconds : 0);
+    return outcome;
   }
 }
 
-}  // namespace orbit_capture_client
\ No newline at end of file
+}  // namespace orbit_capture_client
@@ -0,0 +1,130 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CaptureClient/CaptureListener.h"
+#include "CaptureClient/LoadCapture.h"
+#include "CaptureFile/CaptureFile.h"
+#include "CaptureFile/CaptureFileOutputStream.h"
+#include "GrpcProtos/capture.pb.h"
+#include "MockCaptureListener.h"
+#include "OrbitBase/Result.h"
+#include "TestUtils/TemporaryDirectory.h"
+#include "TestUtils/TestUtils.h"
+
+namespace orbit_capture_client {
+
+using orbit_capture_file::CaptureFile;
+using orbit_capture_file::CaptureFileOutputStream;
+using orbit_grpc_protos::CaptureFinished;
+using orbit_grpc_protos::ClientCaptureEvent;
+using orbit_test_utils::HasErrorWithMessage;
+using orbit_test_utils::HasNoError;
+using orbit_test_utils::HasValue;
+using orbit_test_utils::TemporaryDirectory;
+using ::testing::_;
+
+namespace {
+
+// Enough events for the capture section to span several buffers of the input stream.
+constexpr uint64_t kInternedStringCount = 20'000;
+constexpr size_t kInternedStringSize = 500;
+
+class LoadCaptureTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto temporary_dir_or_error = TemporaryDirectory::Create();
+    ASSERT_THAT(temporary_dir_or_error, HasNoError());
+    temporary_dir_ =
+        std::make_unique<TemporaryDirectory>(std::move(temporary_dir_or_error.value()));
+  }
+
+  [[nodiscard]] std::unique_ptr<CaptureFile> WriteCaptureFile(bool with_capture_finished) {
+    const std::filesystem::path file_path =
+        temporary_dir_->GetDirectoryPath() / (std::to_string(capture_file_count_++) + ".orbit");
+    {
+      auto output_stream_or_error = CaptureFileOutputStream::Create(file_path);
+      EXPECT_THAT(output_stream_or_error, HasNoError());
+      std::unique_ptr<CaptureFileOutputStream> output_stream =
+          std::move(output_stream_or_error.value());
+      for (uint64_t key = 0; key < kInternedStringCount; ++key) {
+        ClientCaptureEvent event;
+        event.mutable_interned_string()->set_key(key);
+        event.mutable_interned_string()->set_intern(std::string(kInternedStringSize, 'a'));
+        EXPECT_THAT(output_stream->WriteCaptureEvent(event), HasNoError());
+      }
+      if (with_capture_finished) {
+        ClientCaptureEvent event;
+        event.mutable_capture_finished()->set_status(CaptureFinished::kSuccessful);
+        EXPECT_THAT(output_stream->WriteCaptureEvent(event), HasNoError());
+      }
+      EXPECT_THAT(output_stream->Close(), HasNoError());
+    }
+
+    auto capture_file_or_error = CaptureFile::OpenForReadWrite(file_path);
+    EXPECT_THAT(capture_file_or_error, HasNoError());
+    return std::move(capture_file_or_error.value());
+  }
+
+  void ExpectAllInternedStringsInOrder(MockCaptureListener* listener) {
+    next_expected_key_ = 0;
+    EXPECT_CALL(*listener, OnKeyAndString)
+        .Times(kInternedStringCount)
+        .WillRepeatedly([this](uint64_t key, const std::string& /*str*/) {
+          EXPECT_EQ(key, next_expected_key_);
+          ++next_expected_key_;
+        });
+  }
+
+ private:
+  std::unique_ptr<TemporaryDirectory> temporary_dir_;
+  int capture_file_count_ = 0;
+  uint64_t next_expected_key_ = 0;
+};
+
+}  // namespace
+
+TEST_F(LoadCaptureTest, LoadsAllEventsInOrder) {
+  std::unique_ptr<CaptureFile> capture_file = WriteCaptureFile(/*with_capture_finished=*/true);
+  MockCaptureListener listener;
+  ExpectAllInternedStringsInOrder(&listener);
+  EXPECT_CALL(listener, OnCaptureFinished).Times(1);
+
+  std::atomic<bool> cancellation_requested = false;
+  EXPECT_THAT(LoadCapture(&listener, capture_file.get(), &cancellation_requested),
+              HasValue(CaptureListener::CaptureOutcome::kComplete));
+}
+
+TEST_F(LoadCaptureTest, ReportsErrorWithoutCaptureFinished) {
+  std::unique_ptr<CaptureFile> capture_file = WriteCaptureFile(/*with_capture_finished=*/false);
+  MockCaptureListener listener;
+  ExpectAllInternedStringsInOrder(&listener);
+  EXPECT_CALL(listener, OnCaptureFinished).Times(0);
+
+  std::atomic<bool> cancellation_requested = false;
+  EXPECT_THAT(LoadCapture(&listener, capture_file.get(), &cancellation_requested),
+              HasErrorWithMessage("end of section"));
+}
+
+TEST_F(LoadCaptureTest, StopsWhenCancelled) {
+  std::unique_ptr<CaptureFile> capture_file = WriteCaptureFile(/*with_capture_finished=*/true);
+  MockCaptureListener listener;
+  EXPECT_CALL(listener, OnKeyAndString(_, _)).Times(0);
+
+  std::atomic<bool> cancellation_requested = true;
+  EXPECT_THAT(LoadCapture(&listener, capture_file.get(), &cancellation_requested),
+              HasValue(CaptureListener::CaptureOutcome::kCancelled));
+}
+
+}  // namespace orbit_capture_client
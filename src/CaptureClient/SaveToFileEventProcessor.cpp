@@ -52,7 +52,8 @@ class SaveToFileEventProcessor : public CaptureEventProcessor {
 };
 
 ErrorMessageOr<void> SaveToFileEventProcessor::Initialize() {
-  auto stream_or_error = CaptureFileOutputStream::Create(file_path_);
+  auto stream_or_error = CaptureFileOutputStream::Create(
+      file_path_, CaptureFileOutputStream::kDefaultCaptureIndexCheckpointSize);
   if (stream_or_error.has_error()) {
     return ErrorMessage{absl::StrFormat("Failed to initialize CaptureSaveToFileProcessor: %s",
                                         stream_or_error.error().message())};
@@ -108,7 +108,8 @@ TEST(SaveToFileEventProcessor, SaveAndLoadSimpleCapture) {
   }
 
   const auto& sections = capture_file->GetSectionList();
-  EXPECT_EQ(sections.size(), 0);
+  ASSERT_EQ(sections.size(), 1);
+  EXPECT_EQ(sections[0].type, orbit_capture_file::kSectionTypeCaptureIndex);
 
   std::optional<size_t> user_data_section =
       capture_file->FindSectionByType(orbit_capture_file::kSectionTypeUserData);
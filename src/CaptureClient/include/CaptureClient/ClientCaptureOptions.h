@@ -33,6 +33,19 @@ struct ClientCaptureOptions {
       thread_state_change_callstack_collection =
           orbit_grpc_protos::CaptureOptions::kThreadStateChangeCallStackCollectionUnspecified;
 
+  orbit_grpc_protos::CaptureOptions::RingBufferWakeupMethod ring_buffer_wakeup_method =
+      orbit_grpc_protos::CaptureOptions::kRingBufferWakeupMethodUnspecified;
+
+  uint32_t ring_buffer_reader_thread_count = 0;
+
+  orbit_grpc_protos::CaptureOptions::EventProcessingDelayMode event_processing_delay_mode =
+      orbit_grpc_protos::CaptureOptions::kEventProcessingDelayModeUnspecified;
+
+  uint32_t unwinding_thread_count = 0;
+
+  orbit_grpc_protos::CaptureOptions::CaptureStreamCompression capture_stream_compression =
+      orbit_grpc_protos::CaptureOptions::kCaptureStreamCompressionUnspecified;
+
   uint16_t stack_dump_size = 0;
   uint16_t thread_state_change_callstack_stack_dump_size = 0;
   uint64_t max_local_marker_depth_per_command_buffer = 0;
@@ -17,10 +17,14 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFile/ProtoSectionInputStream.h"
 #include "CaptureFileConstants.h"
+#include "CaptureIndex.h"
+#include "CaptureSectionRangeInputStream.h"
+#include "ClientProtos/capture_file_index.pb.h"
 #include "OrbitBase/Align.h"
 #include "OrbitBase/File.h"
 #include "OrbitBase/Logging.h"
@@ -32,6 +36,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+
+#include "MappedProtoSectionInputStream.h"
 #endif
 
 namespace orbit_capture_file {
@@ -78,6 +84,10 @@ class CaptureFileImpl : public CaptureFile {
 
   std::unique_ptr<ProtoSectionInputStream> CreateCaptureSectionInputStream() override;
 
+  ErrorMessageOr<std::unique_ptr<ProtoSectionInputStream>>
+  CreateCaptureSectionInputStreamForTimeRange(uint64_t min_timestamp_ns,
+                                              uint64_t max_timestamp_ns) override;
+
   [[nodiscard]] const std::filesystem::path& GetFilePath() const override;
 
   std::unique_ptr<ProtoSectionInputStream> CreateProtoSectionInputStream(
@@ -121,6 +131,9 @@ class CaptureFileImpl : public CaptureFile {
   // section. The section_list is ordered by section offset. Meaning a section with lower offset
   // will come before a section with higher offset.
   std::vector<CaptureFileSection> section_list_;
+
+  // Read from the capture index section when first needed.
+  std::optional<std::vector<orbit_client_protos::CaptureIndexCheckpoint>> capture_index_;
 };
 
 ErrorMessageOr<uint64_t> GetEndOfFileOffset(const UniqueFd& fd) {
@@ -368,10 +381,69 @@ ErrorMessageOr<void> CaptureFileImpl::ReadFromSection(uint64_t section_number,
 }
 
 std::unique_ptr<ProtoSectionInputStream> CaptureFileImpl::CreateCaptureSectionInputStream() {
+#ifdef __linux
+  // Parsing the events directly from a mapping of the file avoids copying the whole capture
+  // section, which matters for large captures. An empty capture section can't be mapped.
+  if (capture_section_size_ > 0) {
+    auto mapped_input_stream_or_error =
+        orbit_capture_file_internal::MappedProtoSectionInputStream::Create(
+            fd_, header_.capture_section_offset, capture_section_size_);
+    if (mapped_input_stream_or_error.has_value()) {
+      return std::move(mapped_input_stream_or_error.value());
+    }
+    ORBIT_ERROR("%s, reading the capture section from the file instead",
+                mapped_input_stream_or_error.error().message());
+  }
+#endif
   return std::make_unique<orbit_capture_file_internal::ProtoSectionInputStreamImpl>(
       fd_, header_.capture_section_offset, capture_section_size_);
 }
 
+ErrorMessageOr<std::unique_ptr<ProtoSectionInputStream>>
+CaptureFileImpl::CreateCaptureSectionInputStreamForTimeRange(uint64_t min_timestamp_ns,
+                                                             uint64_t max_timestamp_ns) {
+  if (!capture_index_.has_value()) {
+    std::optional<uint64_t> section_index = FindSectionByType(kSectionTypeCaptureIndex);
+    if (!section_index.has_value()) {
+      return ErrorMessage{"The capture file has no capture index"};
+    }
+    auto capture_index_input_stream = CreateProtoSectionInputStream(section_index.value());
+    OUTCOME_TRY(capture_index_,
+                orbit_capture_file_internal::ReadCaptureIndex(capture_index_input_stream.get()));
+  }
+  const std::vector<orbit_client_protos::CaptureIndexCheckpoint>& checkpoints =
+      capture_index_.value();
+
+  auto overlaps_time_range = [min_timestamp_ns, max_timestamp_ns](
+                                 const orbit_client_protos::CaptureIndexCheckpoint& checkpoint) {
+    return checkpoint.min_timestamp_ns() <= max_timestamp_ns &&
+           checkpoint.max_timestamp_ns() >= min_timestamp_ns;
+  };
+  auto first_checkpoint_it =
+      std::find_if(checkpoints.begin(), checkpoints.end(), overlaps_time_range);
+  if (first_checkpoint_it == checkpoints.end()) {
+    return ErrorMessage{absl::StrFormat("The capture has no events between %u ns and %u ns",
+                                        min_timestamp_ns, max_timestamp_ns)};
+  }
+  auto last_checkpoint_it =
+      std::find_if(checkpoints.rbegin(), checkpoints.rend(), overlaps_time_range).base() - 1;
+
+  std::vector<uint64_t> state_event_offsets;
+  for (auto it = checkpoints.begin(); it != first_checkpoint_it; ++it) {
+    state_event_offsets.insert(state_event_offsets.end(), it->state_event_offsets().begin(),
+                               it->state_event_offsets().end());
+  }
+  uint64_t range_event_count = 0;
+  for (auto it = first_checkpoint_it; it <= last_checkpoint_it; ++it) {
+    range_event_count += it->event_count();
+  }
+  const bool append_capture_finished = last_checkpoint_it + 1 != checkpoints.end();
+
+  return std::make_unique<orbit_capture_file_internal::CaptureSectionRangeInputStream>(
+      fd_, header_.capture_section_offset, capture_section_size_, std::move(state_event_offsets),
+      first_checkpoint_it->offset(), range_event_count, append_capture_finished);
+}
+
 std::unique_ptr<ProtoSectionInputStream> CaptureFileImpl::CreateProtoSectionInputStream(
     uint64_t section_number) {
   ORBIT_CHECK(section_number < section_list_.size());
@@ -20,7 +20,10 @@
 #include <utility>
 
 #include "CaptureFile/BufferOutputStream.h"
+#include "CaptureFile/CaptureFile.h"
+#include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFileConstants.h"
+#include "CaptureIndex.h"
 #include "OrbitBase/File.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/SafeStrerror.h"
@@ -29,10 +32,21 @@ namespace orbit_capture_file {
 
 namespace {
 
+// The header consists of the signature, the version, the offset of the capture section and the
+// offset of the section list, and is immediately followed by the capture section.
+constexpr uint64_t kSectionListOffsetFieldOffset =
+    kFileSignature.size() + sizeof(kFileVersion) + sizeof(uint64_t);
+constexpr uint64_t kCaptureSectionOffset = kSectionListOffsetFieldOffset + sizeof(uint64_t);
+
 class CaptureFileOutputStreamImpl final : public CaptureFileOutputStream {
  public:
-  explicit CaptureFileOutputStreamImpl(std::filesystem::path path)
-      : output_type_(OutputType::kFile), path_{std::move(path)} {}
+  explicit CaptureFileOutputStreamImpl(std::filesystem::path path,
+                                       std::optional<uint64_t> capture_index_checkpoint_size)
+      : output_type_(OutputType::kFile), path_{std::move(path)} {
+    if (capture_index_checkpoint_size.has_value()) {
+      capture_index_builder_.emplace(capture_index_checkpoint_size.value());
+    }
+  }
   explicit CaptureFileOutputStreamImpl(BufferOutputStream* output_buffer)
       : output_type_(OutputType::kBuffer), output_buffer_(output_buffer) {}
   ~CaptureFileOutputStreamImpl() override;
@@ -46,6 +60,9 @@ class CaptureFileOutputStreamImpl final : public CaptureFileOutputStream {
  private:
   void Reset();
   [[nodiscard]] ErrorMessageOr<void> WriteHeader();
+  [[nodiscard]] ErrorMessageOr<void> WriteCaptureIndexSection();
+  // Restores the file as it was before WriteCaptureIndexSection, i.e., without section list.
+  [[nodiscard]] ErrorMessageOr<void> RemoveCaptureIndexSection();
   [[nodiscard]] std::string_view GetErrorFromOutputStream() const;
   // Handles write error by cleaning up the file and generating error message.
   [[nodiscard]] ErrorMessage HandleWriteError(const char* section_name,
@@ -61,6 +78,10 @@ class CaptureFileOutputStreamImpl final : public CaptureFileOutputStream {
   BufferOutputStream* output_buffer_ = nullptr;
   std::unique_ptr<google::protobuf::io::ZeroCopyOutputStream> zero_copy_output_stream_;
   std::optional<google::protobuf::io::CodedOutputStream> coded_output_;
+
+  // Size of the capture events written so far, including their size prefixes.
+  uint64_t capture_section_size_ = 0;
+  std::optional<orbit_capture_file_internal::CaptureIndexBuilder> capture_index_builder_;
 };
 
 CaptureFileOutputStreamImpl::~CaptureFileOutputStreamImpl() {
@@ -107,6 +128,20 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::Close() {
   }
   Reset();
 
+  if (capture_index_builder_.has_value()) {
+    // The capture is complete at this point and the index is optional, so keep the file without
+    // the index rather than deleting it.
+    if (auto result = WriteCaptureIndexSection(); result.has_error()) {
+      ORBIT_ERROR("Writing \"Capture index\" section to \"%s\": %s", path_.string(),
+                  result.error().message());
+      if (auto remove_result = RemoveCaptureIndexSection(); remove_result.has_error()) {
+        return ErrorMessage{absl::StrFormat(
+            R"(Error writing "Capture index" section to "%s": %s. Error removing it: %s)",
+            path_.string(), result.error().message(), remove_result.error().message())};
+      }
+    }
+  }
+
   return outcome::success();
 }
 
@@ -168,6 +203,13 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteCaptureEvent(
     return HandleWriteError("Capture", GetErrorFromOutputStream());
   }
 
+  const uint64_t event_size_with_prefix =
+      google::protobuf::io::CodedOutputStream::VarintSize32(event_size) + event_size;
+  if (capture_index_builder_.has_value()) {
+    capture_index_builder_->AddEvent(event, capture_section_size_, event_size_with_prefix);
+  }
+  capture_section_size_ += event_size_with_prefix;
+
   return outcome::success();
 }
 
@@ -179,8 +221,7 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteHeader() {
   // signature - 4bytes, version - 4bytes
   // capture section offset - 8 bytes
   // additional section offset - 8 bytes
-  uint64_t capture_section_offset =
-      kFileSignature.size() + sizeof(kFileVersion) + 2 * sizeof(uint64_t);
+  uint64_t capture_section_offset = kCaptureSectionOffset;
   header.append(std::string_view(absl::bit_cast<char*>(&capture_section_offset),
                                  sizeof(capture_section_offset)));
   uint64_t additional_section_list_offset =
@@ -198,11 +239,38 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteHeader() {
   return outcome::success();
 }
 
+ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteCaptureIndexSection() {
+  // The file is complete at this point, so CaptureFile takes care of appending the section and the
+  // section list.
+  const std::string capture_index = capture_index_builder_->Build();
+  capture_index_builder_.reset();
+
+  OUTCOME_TRY(auto&& capture_file, CaptureFile::OpenForReadWrite(path_));
+  OUTCOME_TRY(const uint64_t section_number,
+              capture_file->AddAdditionalSectionOfType(kSectionTypeCaptureIndex,
+                                                       capture_index.size()));
+  OUTCOME_TRY(capture_file->WriteToSection(section_number, 0, capture_index.data(),
+                                           capture_index.size()));
+
+  return outcome::success();
+}
+
+ErrorMessageOr<void> CaptureFileOutputStreamImpl::RemoveCaptureIndexSection() {
+  OUTCOME_TRY(auto&& fd, orbit_base::OpenExistingFileForReadWrite(path_));
+  constexpr uint64_t kNoSectionListOffset = 0;
+  OUTCOME_TRY(orbit_base::WriteFullyAtOffset(fd, &kNoSectionListOffset,
+                                             sizeof(kNoSectionListOffset),
+                                             kSectionListOffsetFieldOffset));
+  OUTCOME_TRY(orbit_base::ResizeFile(path_, kCaptureSectionOffset + capture_section_size_));
+  return outcome::success();
+}
+
 }  // namespace
 
 ErrorMessageOr<std::unique_ptr<CaptureFileOutputStream>> CaptureFileOutputStream::Create(
-    std::filesystem::path path) {
-  auto implementation = std::make_unique<CaptureFileOutputStreamImpl>(std::move(path));
+    std::filesystem::path path, std::optional<uint64_t> capture_index_checkpoint_size) {
+  auto implementation = std::make_unique<CaptureFileOutputStreamImpl>(
+      std::move(path), capture_index_checkpoint_size);
   auto init_result = implementation->Initialize();
   if (init_result.has_error()) {
     return init_result.error();
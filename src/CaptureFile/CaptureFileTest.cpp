@@ -3,14 +3,17 @@
 // found in the LICENSE file.
 
 #include <absl/base/casts.h>
+#include <absl/container/flat_hash_set.h>
 #include <gmock/gmock.h>
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <gtest/gtest.h>
+#include <signal.h>
 #include <stddef.h>
 
 #include <cstdint>
 #include <filesystem>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -24,6 +27,7 @@
 #include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFile/ProtoSectionInputStream.h"
 #include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/File.h"
 #include "OrbitBase/MakeUniqueForOverwrite.h"
 #include "OrbitBase/Result.h"
 #include "OrbitBase/WriteStringToFile.h"
@@ -31,8 +35,13 @@
 #include "TestUtils/TemporaryDirectory.h"
 #include "TestUtils/TestUtils.h"
 
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
 namespace orbit_capture_file {
 
+using orbit_test_utils::HasError;
 using orbit_test_utils::HasErrorWithMessage;
 using orbit_test_utils::HasNoError;
 using orbit_test_utils::HasValue;
@@ -179,8 +188,6 @@ class CaptureFileTest : public CaptureFileHeaderTest {
 
  protected:
   std::unique_ptr<CaptureFile> capture_file_;
-
- private:
   const ClientCaptureEvent test_event_1;
   const ClientCaptureEvent test_event_2;
 };
@@ -191,6 +198,16 @@ TEST_F(CaptureFileTest, CreateCaptureFileAndReadMainSection) {
   VerifyCaptureSectionContent(capture_section);
 }
 
+TEST_F(CaptureFileTest, ReadMainSectionAsBytes) {
+  auto capture_section = capture_file_->CreateCaptureSectionInputStream();
+
+  for (const ClientCaptureEvent* expected_event : {&test_event_1, &test_event_2}) {
+    std::string event_bytes;
+    ASSERT_THAT(capture_section->ReadMessageBytes(&event_bytes), HasNoError());
+    EXPECT_EQ(event_bytes, expected_event->SerializeAsString());
+  }
+}
+
 TEST_F(CaptureFileTest, CreateCaptureFileWriteAdditionalSectionAndReadMainSection) {
   constexpr size_t kUserDataSectionSize = 333;
   auto section_number_or_error = capture_file_->AddUserDataSection(kUserDataSectionSize);
@@ -331,6 +348,19 @@ static std::string CreateHeader(uint32_t version, uint64_t capture_section_offse
   return header;
 }
 
+TEST_F(CaptureFileHeaderTest, OpenCaptureFileWithoutCaptureEvents) {
+  std::string header = CreateHeader(1, 24, 0);
+  EXPECT_THAT(orbit_base::WriteStringToFile(GetCaptureFilePath(), header), HasNoError());
+
+  auto capture_file_or_error = CaptureFile::OpenForReadWrite(GetCaptureFilePath());
+  ASSERT_THAT(capture_file_or_error, HasNoError());
+  std::unique_ptr<ProtoSectionInputStream> capture_section =
+      capture_file_or_error.value()->CreateCaptureSectionInputStream();
+  ASSERT_NE(capture_section, nullptr);
+  ClientCaptureEvent event;
+  EXPECT_THAT(capture_section->ReadMessage(&event), HasError());
+}
+
 TEST_F(CaptureFileHeaderTest, OpenCaptureFileInvalidVersion) {
   std::string header = CreateHeader(0, 0, 0);
 
@@ -451,4 +481,167 @@ TEST_F(CaptureFileHeaderTest, ModifyExisting) {
   EXPECT_EQ(capture_file->FindAllSectionsByType(kSectionType).size(), number_of_type_sections + 1);
 }
 
-}  // namespace orbit_capture_file
\ No newline at end of file
+class CaptureIndexTest : public CaptureFileHeaderTest {
+ protected:
+  static constexpr uint64_t kFunctionCallCount = 100;
+  static constexpr uint64_t kFunctionCallDurationNs = 500;
+
+  // Writes a capture in which each function call ends 1000 ns after the previous one and refers to
+  // an interned string written just before it, with a checkpoint about every 200 bytes.
+  void WriteCaptureWithIndex() {
+    auto output_stream_or_error = CaptureFileOutputStream::Create(
+        GetCaptureFilePath(), /*capture_index_checkpoint_size=*/200);
+    ASSERT_THAT(output_stream_or_error, HasNoError());
+    std::unique_ptr<CaptureFileOutputStream> output_stream =
+        std::move(output_stream_or_error.value());
+
+    ClientCaptureEvent capture_started;
+    capture_started.mutable_capture_started()->set_capture_start_timestamp_ns(0);
+    ASSERT_THAT(output_stream->WriteCaptureEvent(capture_started), HasNoError());
+    for (uint64_t i = 0; i < kFunctionCallCount; ++i) {
+      ASSERT_THAT(output_stream->WriteCaptureEvent(
+                      CreateInternedStringCaptureEvent(i, "function " + std::to_string(i))),
+                  HasNoError());
+      ClientCaptureEvent function_call;
+      function_call.mutable_function_call()->set_function_id(i);
+      function_call.mutable_function_call()->set_end_timestamp_ns(1000 * (i + 1));
+      function_call.mutable_function_call()->set_duration_ns(kFunctionCallDurationNs);
+      ASSERT_THAT(output_stream->WriteCaptureEvent(function_call), HasNoError());
+    }
+    ClientCaptureEvent capture_finished;
+    capture_finished.mutable_capture_finished();
+    ASSERT_THAT(output_stream->WriteCaptureEvent(capture_finished), HasNoError());
+    ASSERT_THAT(output_stream->Close(), HasNoError());
+
+    auto capture_file_or_error = CaptureFile::OpenForReadWrite(GetCaptureFilePath());
+    ASSERT_THAT(capture_file_or_error, HasNoError());
+    capture_file_ = std::move(capture_file_or_error.value());
+  }
+
+  // Reads the events up to CaptureFinished and checks that every function call comes after the
+  // interned string it refers to. Returns the function ids of the function calls read.
+  static std::vector<uint64_t> ReadFunctionCallsUpToCaptureFinished(
+      ProtoSectionInputStream* input_stream) {
+    std::vector<uint64_t> function_ids;
+    absl::flat_hash_set<uint64_t> interned_string_keys;
+    while (true) {
+      ClientCaptureEvent event;
+      ErrorMessageOr<void> result = input_stream->ReadMessage(&event);
+      EXPECT_THAT(result, HasNoError());
+      if (result.has_error()) return function_ids;
+
+      switch (event.event_case()) {
+        case ClientCaptureEvent::kInternedString:
+          interned_string_keys.insert(event.interned_string().key());
+          break;
+        case ClientCaptureEvent::kFunctionCall:
+          EXPECT_TRUE(interned_string_keys.contains(event.function_call().function_id()));
+          function_ids.push_back(event.function_call().function_id());
+          break;
+        case ClientCaptureEvent::kCaptureFinished:
+          return function_ids;
+        default:
+          break;
+      }
+    }
+  }
+
+  std::unique_ptr<CaptureFile> capture_file_;
+};
+
+TEST_F(CaptureIndexTest, CaptureIndexSectionIsWritten) {
+  WriteCaptureWithIndex();
+  ASSERT_EQ(capture_file_->GetSectionList().size(), 1);
+  EXPECT_EQ(capture_file_->GetSectionList()[0].type, kSectionTypeCaptureIndex);
+
+  // The capture section is unchanged.
+  auto capture_section = capture_file_->CreateCaptureSectionInputStream();
+  std::vector<uint64_t> function_ids = ReadFunctionCallsUpToCaptureFinished(capture_section.get());
+  EXPECT_EQ(function_ids.size(), kFunctionCallCount);
+
+  // A user data section can still be added after the section list.
+  EXPECT_THAT(capture_file_->AddUserDataSection(10), HasValue(1));
+}
+
+TEST_F(CaptureIndexTest, ReadTimeRange) {
+  WriteCaptureWithIndex();
+
+  // Function calls 50 to 59 overlap this time range.
+  constexpr uint64_t kMinTimestampNs = 50'700;
+  constexpr uint64_t kMaxTimestampNs = 60'000;
+  auto input_stream_or_error =
+      capture_file_->CreateCaptureSectionInputStreamForTimeRange(kMinTimestampNs, kMaxTimestampNs);
+  ASSERT_THAT(input_stream_or_error, HasNoError());
+  std::vector<uint64_t> function_ids =
+      ReadFunctionCallsUpToCaptureFinished(input_stream_or_error.value().get());
+
+  // The stream can start a bit before the time range and end a bit after it, depending on the
+  // checkpoints, but it doesn't contain the whole capture.
+  ASSERT_FALSE(function_ids.empty());
+  EXPECT_LT(function_ids.size(), kFunctionCallCount / 2);
+  EXPECT_LE(function_ids.front(), 50);
+  EXPECT_GE(function_ids.back(), 59);
+  for (size_t i = 1; i < function_ids.size(); ++i) {
+    EXPECT_EQ(function_ids[i], function_ids[i - 1] + 1);
+  }
+
+  // The CaptureFinished event was added, so the stream ends after it.
+  ClientCaptureEvent event;
+  EXPECT_THAT(input_stream_or_error.value()->ReadMessage(&event),
+              HasErrorWithMessage("Unexpected end of the time range"));
+}
+
+TEST_F(CaptureIndexTest, ReadTimeRangeAtEndOfCapture) {
+  WriteCaptureWithIndex();
+
+  auto input_stream_or_error = capture_file_->CreateCaptureSectionInputStreamForTimeRange(
+      1000 * kFunctionCallCount, std::numeric_limits<uint64_t>::max());
+  ASSERT_THAT(input_stream_or_error, HasNoError());
+  std::vector<uint64_t> function_ids =
+      ReadFunctionCallsUpToCaptureFinished(input_stream_or_error.value().get());
+  ASSERT_FALSE(function_ids.empty());
+  EXPECT_EQ(function_ids.back(), kFunctionCallCount - 1);
+}
+
+TEST_F(CaptureIndexTest, ReadTimeRangeWithoutEvents) {
+  WriteCaptureWithIndex();
+
+  EXPECT_THAT(capture_file_->CreateCaptureSectionInputStreamForTimeRange(
+                  1000 * kFunctionCallCount + 1, std::numeric_limits<uint64_t>::max()),
+              HasErrorWithMessage("The capture has no events between"));
+}
+
+#ifdef __linux__
+TEST_F(CaptureIndexTest, CaptureIsKeptWhenCaptureIndexSectionCannotBeWritten) {
+  // Find where the capture index section starts, and don't let the next file grow beyond it.
+  WriteCaptureWithIndex();
+  ASSERT_EQ(capture_file_->GetSectionList().size(), 1);
+  const uint64_t capture_index_section_offset = capture_file_->GetSectionList()[0].offset;
+  capture_file_.reset();
+  ASSERT_THAT(orbit_base::RemoveFile(GetCaptureFilePath()), HasValue(true));
+
+  rlimit original_file_size_limit{};
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &original_file_size_limit), 0);
+  rlimit file_size_limit = original_file_size_limit;
+  file_size_limit.rlim_cur = capture_index_section_offset;
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &file_size_limit), 0);
+  // Exceeding the limit fails with EFBIG, and by default also kills the process with SIGXFSZ.
+  sighandler_t original_sigxfsz_handler = signal(SIGXFSZ, SIG_IGN);
+  WriteCaptureWithIndex();
+  signal(SIGXFSZ, original_sigxfsz_handler);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &original_file_size_limit), 0);
+
+  ASSERT_NE(capture_file_, nullptr);
+  EXPECT_TRUE(capture_file_->GetSectionList().empty());
+  auto capture_section = capture_file_->CreateCaptureSectionInputStream();
+  std::vector<uint64_t> function_ids = ReadFunctionCallsUpToCaptureFinished(capture_section.get());
+  EXPECT_EQ(function_ids.size(), kFunctionCallCount);
+}
+#endif
+
+TEST_F(CaptureFileTest, ReadTimeRangeWithoutCaptureIndex) {
+  EXPECT_THAT(capture_file_->CreateCaptureSectionInputStreamForTimeRange(0, 1000),
+              HasErrorWithMessage("The capture file has no capture index"));
+}
+
+}  // namespace orbit_capture_file
@@ -0,0 +1,228 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "CaptureIndex.h"
+
+#include <absl/strings/str_format.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/message.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_capture_file_internal {
+
+using orbit_client_protos::CaptureIndexCheckpoint;
+using orbit_client_protos::CaptureIndexHeader;
+using orbit_grpc_protos::ClientCaptureEvent;
+
+namespace {
+
+[[nodiscard]] std::pair<uint64_t, uint64_t> TimeRangeFromEnd(uint64_t end_timestamp_ns,
+                                                            uint64_t duration_ns) {
+  return {end_timestamp_ns - std::min(duration_ns, end_timestamp_ns), end_timestamp_ns};
+}
+
+[[nodiscard]] std::pair<uint64_t, uint64_t> TimeRangeAt(uint64_t timestamp_ns) {
+  return {timestamp_ns, timestamp_ns};
+}
+
+void AppendSizePrefixedMessage(const google::protobuf::Message& message, std::string* output) {
+  google::protobuf::io::StringOutputStream string_output_stream{output};
+  google::protobuf::io::CodedOutputStream coded_output_stream{&string_output_stream};
+  coded_output_stream.WriteVarint32(message.ByteSizeLong());
+  // We do not expect any errors from CodedOutputStream backed by a StringOutputStream.
+  ORBIT_CHECK(message.SerializeToCodedStream(&coded_output_stream));
+}
+
+}  // namespace
+
+std::optional<std::pair<uint64_t, uint64_t>> GetCaptureEventTimeRange(
+    const ClientCaptureEvent& event) {
+  switch (event.event_case()) {
+    case ClientCaptureEvent::kApiScopeStart:
+      return TimeRangeAt(event.api_scope_start().timestamp_ns());
+    case ClientCaptureEvent::kApiScopeStartAsync:
+      return TimeRangeAt(event.api_scope_start_async().timestamp_ns());
+    case ClientCaptureEvent::kApiScopeStop:
+      return TimeRangeAt(event.api_scope_stop().timestamp_ns());
+    case ClientCaptureEvent::kApiScopeStopAsync:
+      return TimeRangeAt(event.api_scope_stop_async().timestamp_ns());
+    case ClientCaptureEvent::kApiStringEvent:
+      return TimeRangeAt(event.api_string_event().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackDouble:
+      return TimeRangeAt(event.api_track_double().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackFloat:
+      return TimeRangeAt(event.api_track_float().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackInt:
+      return TimeRangeAt(event.api_track_int().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackInt64:
+      return TimeRangeAt(event.api_track_int64().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackUint:
+      return TimeRangeAt(event.api_track_uint().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackUint64:
+      return TimeRangeAt(event.api_track_uint64().timestamp_ns());
+    case ClientCaptureEvent::kCallstackSample:
+      return TimeRangeAt(event.callstack_sample().timestamp_ns());
+    case ClientCaptureEvent::kCaptureStarted:
+      return TimeRangeAt(event.capture_started().capture_start_timestamp_ns());
+    case ClientCaptureEvent::kClockResolutionEvent:
+      return TimeRangeAt(event.clock_resolution_event().timestamp_ns());
+    case ClientCaptureEvent::kErrorEnablingOrbitApiEvent:
+      return TimeRangeAt(event.error_enabling_orbit_api_event().timestamp_ns());
+    case ClientCaptureEvent::kErrorEnablingUserSpaceInstrumentationEvent:
+      return TimeRangeAt(event.error_enabling_user_space_instrumentation_event().timestamp_ns());
+    case ClientCaptureEvent::kErrorsWithPerfEventOpenEvent:
+      return TimeRangeAt(event.errors_with_perf_event_open_event().timestamp_ns());
+    case ClientCaptureEvent::kFunctionCall:
+      return TimeRangeFromEnd(event.function_call().end_timestamp_ns(),
+                              event.function_call().duration_ns());
+    case ClientCaptureEvent::kGpuJob: {
+      const orbit_grpc_protos::GpuJob& gpu_job = event.gpu_job();
+      const auto [min_timestamp_ns, max_timestamp_ns] = std::minmax(
+          {gpu_job.amdgpu_cs_ioctl_time_ns(), gpu_job.amdgpu_sched_run_job_time_ns(),
+           gpu_job.gpu_hardware_start_time_ns(), gpu_job.dma_fence_signaled_time_ns()});
+      return std::make_pair(min_timestamp_ns, max_timestamp_ns);
+    }
+    case ClientCaptureEvent::kGpuQueueSubmission: {
+      // The GPU timestamps of the command buffers and debug markers use a different clock.
+      const orbit_grpc_protos::GpuQueueSubmissionMetaInfo& meta_info =
+          event.gpu_queue_submission().meta_info();
+      return std::make_pair(meta_info.pre_submission_cpu_timestamp(),
+                            meta_info.post_submission_cpu_timestamp());
+    }
+    case ClientCaptureEvent::kLostPerfRecordsEvent:
+      return TimeRangeFromEnd(event.lost_perf_records_event().end_timestamp_ns(),
+                              event.lost_perf_records_event().duration_ns());
+    case ClientCaptureEvent::kMemoryUsageEvent:
+      return TimeRangeAt(event.memory_usage_event().timestamp_ns());
+    case ClientCaptureEvent::kModulesSnapshot:
+      return TimeRangeAt(event.modules_snapshot().timestamp_ns());
+    case ClientCaptureEvent::kModuleUpdateEvent:
+      return TimeRangeAt(event.module_update_event().timestamp_ns());
+    case ClientCaptureEvent::kOutOfOrderEventsDiscardedEvent:
+      return TimeRangeFromEnd(event.out_of_order_events_discarded_event().end_timestamp_ns(),
+                              event.out_of_order_events_discarded_event().duration_ns());
+    case ClientCaptureEvent::kPresentEvent:
+      return std::make_pair(
+          event.present_event().begin_timestamp_ns(),
+          event.present_event().begin_timestamp_ns() + event.present_event().duration_ns());
+    case ClientCaptureEvent::kSchedulingSlice:
+      return TimeRangeFromEnd(event.scheduling_slice().out_timestamp_ns(),
+                              event.scheduling_slice().duration_ns());
+    case ClientCaptureEvent::kThreadName:
+      return TimeRangeAt(event.thread_name().timestamp_ns());
+    case ClientCaptureEvent::kThreadNamesSnapshot:
+      return TimeRangeAt(event.thread_names_snapshot().timestamp_ns());
+    case ClientCaptureEvent::kThreadStateSlice:
+      return TimeRangeFromEnd(event.thread_state_slice().end_timestamp_ns(),
+                              event.thread_state_slice().duration_ns());
+    case ClientCaptureEvent::kTracepointEvent:
+      return TimeRangeAt(event.tracepoint_event().timestamp_ns());
+    case ClientCaptureEvent::kWarningEvent:
+      return TimeRangeAt(event.warning_event().timestamp_ns());
+    case ClientCaptureEvent::kWarningInstrumentingWithUprobesEvent:
+      return TimeRangeAt(event.warning_instrumenting_with_uprobes_event().timestamp_ns());
+    case ClientCaptureEvent::kWarningInstrumentingWithUserSpaceInstrumentationEvent:
+      return TimeRangeAt(
+          event.warning_instrumenting_with_user_space_instrumentation_event().timestamp_ns());
+    case ClientCaptureEvent::kAddressInfo:
+    case ClientCaptureEvent::kCaptureFinished:
+    case ClientCaptureEvent::kInternedCallstack:
+    case ClientCaptureEvent::kInternedString:
+    case ClientCaptureEvent::kInternedTracepointInfo:
+    case ClientCaptureEvent::EVENT_NOT_SET:
+      return std::nullopt;
+  }
+
+  ORBIT_UNREACHABLE();
+}
+
+bool IsCaptureStateEvent(const ClientCaptureEvent& event) {
+  switch (event.event_case()) {
+    case ClientCaptureEvent::kAddressInfo:
+    case ClientCaptureEvent::kCaptureStarted:
+    case ClientCaptureEvent::kClockResolutionEvent:
+    case ClientCaptureEvent::kInternedCallstack:
+    case ClientCaptureEvent::kInternedString:
+    case ClientCaptureEvent::kInternedTracepointInfo:
+    case ClientCaptureEvent::kModulesSnapshot:
+    case ClientCaptureEvent::kModuleUpdateEvent:
+    case ClientCaptureEvent::kThreadName:
+    case ClientCaptureEvent::kThreadNamesSnapshot:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void CaptureIndexBuilder::AddEvent(const ClientCaptureEvent& event, uint64_t offset,
+                                   uint64_t size) {
+  if (!current_checkpoint_.has_value()) {
+    current_checkpoint_.emplace();
+    current_checkpoint_->set_offset(offset);
+    current_checkpoint_->set_min_timestamp_ns(std::numeric_limits<uint64_t>::max());
+    current_checkpoint_->set_max_timestamp_ns(0);
+  }
+  CaptureIndexCheckpoint& checkpoint = current_checkpoint_.value();
+  ORBIT_CHECK(offset == checkpoint.offset() + checkpoint.size());
+
+  checkpoint.set_size(checkpoint.size() + size);
+  checkpoint.set_event_count(checkpoint.event_count() + 1);
+  if (std::optional<std::pair<uint64_t, uint64_t>> time_range = GetCaptureEventTimeRange(event);
+      time_range.has_value()) {
+    checkpoint.set_min_timestamp_ns(std::min(checkpoint.min_timestamp_ns(), time_range->first));
+    checkpoint.set_max_timestamp_ns(std::max(checkpoint.max_timestamp_ns(), time_range->second));
+  }
+  if (IsCaptureStateEvent(event)) checkpoint.add_state_event_offsets(offset);
+
+  if (checkpoint.size() >= checkpoint_size_ ||
+      static_cast<size_t>(checkpoint.state_event_offsets_size()) >= kMaxStateEventsPerCheckpoint) {
+    FinishCheckpoint();
+  }
+}
+
+void CaptureIndexBuilder::FinishCheckpoint() {
+  ORBIT_CHECK(current_checkpoint_.has_value());
+  AppendSizePrefixedMessage(current_checkpoint_.value(), &serialized_checkpoints_);
+  ++checkpoint_count_;
+  current_checkpoint_.reset();
+}
+
+std::string CaptureIndexBuilder::Build() {
+  if (current_checkpoint_.has_value()) FinishCheckpoint();
+
+  CaptureIndexHeader header;
+  header.set_checkpoint_count(checkpoint_count_);
+  std::string capture_index;
+  AppendSizePrefixedMessage(header, &capture_index);
+  capture_index.append(serialized_checkpoints_);
+  return capture_index;
+}
+
+ErrorMessageOr<std::vector<CaptureIndexCheckpoint>> ReadCaptureIndex(
+    orbit_capture_file::ProtoSectionInputStream* capture_index_section_input_stream) {
+  CaptureIndexHeader header;
+  OUTCOME_TRY(capture_index_section_input_stream->ReadMessage(&header));
+
+  std::vector<CaptureIndexCheckpoint> checkpoints;
+  uint64_t next_offset = 0;
+  for (uint64_t i = 0; i < header.checkpoint_count(); ++i) {
+    CaptureIndexCheckpoint checkpoint;
+    OUTCOME_TRY(capture_index_section_input_stream->ReadMessage(&checkpoint));
+    if (checkpoint.offset() != next_offset) {
+      return ErrorMessage{absl::StrFormat(
+          "Capture index checkpoint %u starts at offset %u instead of %u", i, checkpoint.offset(),
+          next_offset)};
+    }
+    next_offset = checkpoint.offset() + checkpoint.size();
+    checkpoints.push_back(std::move(checkpoint));
+  }
+  return checkpoints;
+}
+
+}  // namespace orbit_capture_file_internal
@@ -0,0 +1,65 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_FILE_CAPTURE_INDEX_H_
+#define CAPTURE_FILE_CAPTURE_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CaptureFile/ProtoSectionInputStream.h"
+#include "ClientProtos/capture_file_index.pb.h"
+#include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/Result.h"
+
+namespace orbit_capture_file_internal {
+
+// Returns the smallest and largest timestamps of `event`, or std::nullopt if the event doesn't
+// describe something that happened at a specific time.
+[[nodiscard]] std::optional<std::pair<uint64_t, uint64_t>> GetCaptureEventTimeRange(
+    const orbit_grpc_protos::ClientCaptureEvent& event);
+
+// Returns whether later events can depend on `event`, so that it needs to be read before decoding
+// can start in the middle of the capture section.
+[[nodiscard]] bool IsCaptureStateEvent(const orbit_grpc_protos::ClientCaptureEvent& event);
+
+// Builds the content of the capture index section while the capture section is written, with a
+// new checkpoint about every `checkpoint_size` bytes of events.
+class CaptureIndexBuilder {
+ public:
+  // A checkpoint message with this many state events is still well below the maximum size of the
+  // messages in a section.
+  static constexpr size_t kMaxStateEventsPerCheckpoint = 64 * 1024;
+
+  explicit CaptureIndexBuilder(uint64_t checkpoint_size) : checkpoint_size_{checkpoint_size} {}
+
+  // `offset` is the offset of the event from the start of the capture section, and `size` is its
+  // size including its size prefix.
+  void AddEvent(const orbit_grpc_protos::ClientCaptureEvent& event, uint64_t offset,
+                uint64_t size);
+
+  // Returns the content of the capture index section for the events added so far.
+  [[nodiscard]] std::string Build();
+
+ private:
+  void FinishCheckpoint();
+
+  uint64_t checkpoint_size_;
+  std::optional<orbit_client_protos::CaptureIndexCheckpoint> current_checkpoint_;
+  uint64_t checkpoint_count_ = 0;
+  // The size-prefixed checkpoint messages of the finished checkpoints.
+  std::string serialized_checkpoints_;
+};
+
+[[nodiscard]] ErrorMessageOr<std::vector<orbit_client_protos::CaptureIndexCheckpoint>>
+ReadCaptureIndex(orbit_capture_file::ProtoSectionInputStream* capture_index_section_input_stream);
+
+}  // namespace orbit_capture_file_internal
+
+#endif  // CAPTURE_FILE_CAPTURE_INDEX_H_
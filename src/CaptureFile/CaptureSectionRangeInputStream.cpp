@@ -0,0 +1,53 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "CaptureSectionRangeInputStream.h"
+
+#include "GrpcProtos/capture.pb.h"
+
+namespace orbit_capture_file_internal {
+
+using orbit_capture_file::ParseMessage;
+
+ErrorMessageOr<void> CaptureSectionRangeInputStream::ReadMessage(
+    google::protobuf::Message* message) {
+  OUTCOME_TRY(absl::Span<const uint8_t> message_bytes, ReadMessageSpan());
+  return ParseMessage(message_bytes.data(), message_bytes.size(), message);
+}
+
+ErrorMessageOr<void> CaptureSectionRangeInputStream::ReadMessageBytes(std::string* message_bytes) {
+  OUTCOME_TRY(absl::Span<const uint8_t> message_span, ReadMessageSpan());
+  message_bytes->assign(message_span.begin(), message_span.end());
+  return outcome::success();
+}
+
+ErrorMessageOr<absl::Span<const uint8_t>> CaptureSectionRangeInputStream::ReadMessageSpan() {
+  if (next_state_event_index_ < state_event_offsets_.size()) {
+    OUTCOME_TRY(
+        capture_section_input_stream_.SkipTo(state_event_offsets_[next_state_event_index_]));
+    ++next_state_event_index_;
+    return capture_section_input_stream_.ReadMessageSpan();
+  }
+
+  if (remaining_range_event_count_ > 0) {
+    if (capture_section_input_stream_.GetPosition() < range_offset_) {
+      OUTCOME_TRY(capture_section_input_stream_.SkipTo(range_offset_));
+    }
+    --remaining_range_event_count_;
+    return capture_section_input_stream_.ReadMessageSpan();
+  }
+
+  if (append_capture_finished_) {
+    append_capture_finished_ = false;
+    orbit_grpc_protos::ClientCaptureEvent event;
+    event.mutable_capture_finished()->set_status(orbit_grpc_protos::CaptureFinished::kSuccessful);
+    capture_finished_bytes_ = event.SerializeAsString();
+    return absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(capture_finished_bytes_.data()),
+                               capture_finished_bytes_.size());
+  }
+
+  return ErrorMessage{"Unexpected end of the time range"};
+}
+
+}  // namespace orbit_capture_file_internal
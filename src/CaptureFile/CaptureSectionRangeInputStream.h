@@ -0,0 +1,60 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_FILE_CAPTURE_SECTION_RANGE_INPUT_STREAM_H_
+#define CAPTURE_FILE_CAPTURE_SECTION_RANGE_INPUT_STREAM_H_
+
+#include <absl/types/span.h>
+#include <google/protobuf/message.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CaptureFile/ProtoSectionInputStream.h"
+#include "OrbitBase/File.h"
+#include "OrbitBase/Result.h"
+#include "ProtoSectionInputStreamImpl.h"
+
+namespace orbit_capture_file_internal {
+
+// Reads part of the capture section, as selected using the capture index: first the state events
+// at `state_event_offsets`, then `range_event_count` consecutive events starting at `range_offset`,
+// and finally, if `append_capture_finished` is true, a CaptureFinished event, so that the events
+// read can be processed like a whole capture section. The offsets are from the start of the capture
+// section, and the state event offsets need to be sorted and before `range_offset`.
+class CaptureSectionRangeInputStream : public orbit_capture_file::ProtoSectionInputStream {
+ public:
+  explicit CaptureSectionRangeInputStream(const orbit_base::UniqueFd& fd,
+                                          uint64_t capture_section_offset,
+                                          uint64_t capture_section_size,
+                                          std::vector<uint64_t> state_event_offsets,
+                                          uint64_t range_offset, uint64_t range_event_count,
+                                          bool append_capture_finished)
+      : capture_section_input_stream_{fd, capture_section_offset, capture_section_size},
+        state_event_offsets_{std::move(state_event_offsets)},
+        range_offset_{range_offset},
+        remaining_range_event_count_{range_event_count},
+        append_capture_finished_{append_capture_finished} {}
+
+  ErrorMessageOr<void> ReadMessage(google::protobuf::Message* message) override;
+  ErrorMessageOr<void> ReadMessageBytes(std::string* message_bytes) override;
+  ErrorMessageOr<absl::Span<const uint8_t>> ReadMessageSpan() override;
+
+ private:
+  ProtoSectionInputStreamImpl capture_section_input_stream_;
+  std::vector<uint64_t> state_event_offsets_;
+  size_t next_state_event_index_ = 0;
+  uint64_t range_offset_;
+  uint64_t remaining_range_event_count_;
+  bool append_capture_finished_;
+  // Holds the appended CaptureFinished event while it's being read.
+  std::string capture_finished_bytes_;
+};
+
+}  // namespace orbit_capture_file_internal
+
+#endif  // CAPTURE_FILE_CAPTURE_SECTION_RANGE_INPUT_STREAM_H_
@@ -8,6 +8,8 @@
 
 #include <utility>
 
+#include "OrbitBase/Logging.h"
+
 namespace orbit_capture_file_internal {
 
 using orbit_base::ReadFullyAtOffset;
@@ -15,7 +15,6 @@
 #include <vector>
 
 #include "OrbitBase/File.h"
-#include "OrbitBase/Logging.h"
 #include "OrbitBase/Result.h"
 
 namespace orbit_capture_file_internal {
@@ -32,9 +31,7 @@ class FileFragmentInputStream : public google::protobuf::io::ZeroCopyInputStream
         file_fragments_start_{file_offset},
         file_fragments_end_{file_offset + size},
         buffer_(block_size),
-        current_position_{file_offset} {
-    ORBIT_CHECK(size > 0);
-  }
+        current_position_{file_offset} {}
 
   // Obtains a chunk of data from the stream.
   // https://developers.google.com/protocol-buffers/docs/reference/cpp/google.protobuf.io.zero_copy_stream#ZeroCopyInputStream.Next.details
@@ -78,4 +78,21 @@ TEST(FileFragmentInputStream, ReadBlocksOfTen) {
   EXPECT_FALSE(input_stream.GetLastError().has_value());
 }
 
+TEST(FileFragmentInputStream, EmptyFragment) {
+  auto temporary_file_or_error = orbit_test_utils::TemporaryFile::Create();
+  ASSERT_TRUE(temporary_file_or_error.has_value()) << temporary_file_or_error.error().message();
+  orbit_test_utils::TemporaryFile temporary_file = std::move(temporary_file_or_error.value());
+
+  auto write_result = orbit_base::WriteFully(temporary_file.fd(), "Vestibulum euismod");
+  ASSERT_FALSE(write_result.has_error()) << write_result.error().message();
+
+  FileFragmentInputStream input_stream{temporary_file.fd(), 11, 0, 10};
+  const void* bytes = nullptr;
+  int size = 0;
+  EXPECT_FALSE(input_stream.Next(&bytes, &size));
+  EXPECT_FALSE(input_stream.Skip(1));
+  EXPECT_EQ(input_stream.ByteCount(), 0);
+  EXPECT_EQ(input_stream.GetLastError(), std::nullopt);
+}
+
 }  // namespace orbit_capture_file_internal
@@ -0,0 +1,83 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MAPPED_PROTO_SECTION_INPUT_STREAM_H_
+#define MAPPED_PROTO_SECTION_INPUT_STREAM_H_
+
+#include <absl/types/span.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/message.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "CaptureFile/ProtoSectionInputStream.h"
+#include "OrbitBase/File.h"
+#include "OrbitBase/Result.h"
+
+namespace orbit_capture_file_internal {
+
+// Reads proto messages from a section of a capture file like ProtoSectionInputStreamImpl, but maps
+// the section into memory instead of reading it into a buffer, and parses the messages directly
+// from the mapping. ReadMessageSpan always returns a view of the mapping.
+// The message sizes are decoded by a single CodedInputStream over an ArrayInputStream of a large
+// chunk of the section, rather than by a new one for every message. A CodedInputStream can't read
+// more than INT_MAX bytes, and a message can start at the end of one chunk and end in the next.
+// The file must not be truncated while the stream is in use: reading a page of the mapping that is
+// no longer backed by the file raises SIGBUS.
+class MappedProtoSectionInputStream : public orbit_capture_file::ProtoSectionInputStream {
+ public:
+  ~MappedProtoSectionInputStream() override;
+
+  MappedProtoSectionInputStream(const MappedProtoSectionInputStream&) = delete;
+  MappedProtoSectionInputStream& operator=(const MappedProtoSectionInputStream&) = delete;
+
+  // `chunk_size` is only meant to be lowered in tests.
+  [[nodiscard]] static ErrorMessageOr<std::unique_ptr<MappedProtoSectionInputStream>> Create(
+      const orbit_base::UniqueFd& fd, uint64_t section_offset, uint64_t section_size,
+      uint64_t chunk_size = kDefaultChunkSize);
+
+  ErrorMessageOr<void> ReadMessage(google::protobuf::Message* message) override;
+  ErrorMessageOr<void> ReadMessageBytes(std::string* message_bytes) override;
+  ErrorMessageOr<absl::Span<const uint8_t>> ReadMessageSpan() override;
+
+  static constexpr uint64_t kDefaultChunkSize = 256 * 1024 * 1024;
+
+ private:
+  MappedProtoSectionInputStream(void* mapping, size_t mapping_size, const uint8_t* section_data,
+                                uint64_t section_size, uint64_t chunk_size)
+      : mapping_{mapping},
+        mapping_size_{mapping_size},
+        section_data_{section_data},
+        section_size_{section_size},
+        chunk_size_{chunk_size} {}
+
+  // Starts a new chunk at the current position.
+  void StartChunk();
+  // Reads the next message from the current chunk, starting one if there is none.
+  ErrorMessageOr<absl::Span<const uint8_t>> ReadMessageSpanFromChunk();
+
+  void* mapping_;
+  size_t mapping_size_;
+  const uint8_t* section_data_;
+  uint64_t section_size_;
+  uint64_t chunk_size_;
+  // Position of the next message, from the start of the section.
+  uint64_t position_ = 0;
+
+  // Bounds of the current chunk, from the start of the section.
+  uint64_t chunk_offset_ = 0;
+  uint64_t chunk_end_ = 0;
+  std::optional<google::protobuf::io::ArrayInputStream> chunk_input_stream_;
+  // Declared after chunk_input_stream_, as it reads from it.
+  std::optional<google::protobuf::io::CodedInputStream> coded_input_stream_;
+};
+
+}  // namespace orbit_capture_file_internal
+
+#endif  // MAPPED_PROTO_SECTION_INPUT_STREAM_H_
@@ -0,0 +1,119 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/strings/str_format.h>
+#include <errno.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "MappedProtoSectionInputStream.h"
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/SafeStrerror.h"
+#include "ProtoSectionInputStreamImpl.h"
+
+namespace orbit_capture_file_internal {
+
+using orbit_capture_file::ParseMessage;
+
+MappedProtoSectionInputStream::~MappedProtoSectionInputStream() {
+  if (munmap(mapping_, mapping_size_) != 0) {
+    ORBIT_ERROR("Unable to unmap capture file section: %s", SafeStrerror(errno));
+  }
+}
+
+ErrorMessageOr<std::unique_ptr<MappedProtoSectionInputStream>>
+MappedProtoSectionInputStream::Create(const orbit_base::UniqueFd& fd, uint64_t section_offset,
+                                      uint64_t section_size, uint64_t chunk_size) {
+  ORBIT_CHECK(chunk_size > 0 && chunk_size <= std::numeric_limits<int>::max());
+  // mmap fails for empty mappings, and there would be nothing to read anyway.
+  if (section_size == 0) return ErrorMessage{"Unable to map capture file section: it is empty"};
+  // The offset of a mapping needs to be a multiple of the page size.
+  const auto page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  const uint64_t mapping_offset = section_offset / page_size * page_size;
+  const uint64_t mapping_size = section_offset - mapping_offset + section_size;
+
+  void* mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd.get(),
+                       static_cast<off_t>(mapping_offset));
+  if (mapping == MAP_FAILED) {
+    return ErrorMessage{
+        absl::StrFormat("Unable to map capture file section: %s", SafeStrerror(errno))};
+  }
+  // The messages are mostly read in order, so the kernel can read ahead aggressively and drop the
+  // pages once they have been read.
+  if (madvise(mapping, mapping_size, MADV_SEQUENTIAL) != 0) {
+    ORBIT_ERROR("Unable to advise sequential access to capture file section: %s",
+                SafeStrerror(errno));
+  }
+
+  const uint8_t* section_data =
+      static_cast<const uint8_t*>(mapping) + (section_offset - mapping_offset);
+  return std::unique_ptr<MappedProtoSectionInputStream>(new MappedProtoSectionInputStream(
+      mapping, mapping_size, section_data, section_size, chunk_size));
+}
+
+void MappedProtoSectionInputStream::StartChunk() {
+  chunk_offset_ = position_;
+  chunk_end_ = position_ + std::min(section_size_ - position_, chunk_size_);
+  // The CodedInputStream needs to be destroyed before the ArrayInputStream it reads from.
+  coded_input_stream_.reset();
+  chunk_input_stream_.emplace(section_data_ + chunk_offset_,
+                              static_cast<int>(chunk_end_ - chunk_offset_));
+  coded_input_stream_.emplace(&chunk_input_stream_.value());
+}
+
+ErrorMessageOr<absl::Span<const uint8_t>>
+MappedProtoSectionInputStream::ReadMessageSpanFromChunk() {
+  if (!coded_input_stream_.has_value()) StartChunk();
+
+  uint32_t message_size = 0;
+  if (!coded_input_stream_->ReadVarint32(&message_size)) {
+    return ErrorMessage{"Unexpected end of section while reading message size"};
+  }
+
+  // Since file input is not trusted, do the same sanity check for the message size as
+  // ProtoSectionInputStreamImpl.
+  if (message_size > kMaximumMessageSize) {
+    return ErrorMessage{
+        absl::StrFormat("The message size %d is too big (maximum allowed message size is %d)",
+                        message_size, kMaximumMessageSize)};
+  }
+
+  const uint64_t message_offset = chunk_offset_ + coded_input_stream_->CurrentPosition();
+  if (message_size > chunk_end_ - message_offset) {
+    return ErrorMessage{"Unexpected end of section while reading the message"};
+  }
+  ORBIT_CHECK(coded_input_stream_->Skip(static_cast<int>(message_size)));
+  position_ = message_offset + message_size;
+  return absl::MakeConstSpan(section_data_ + message_offset, message_size);
+}
+
+ErrorMessageOr<absl::Span<const uint8_t>> MappedProtoSectionInputStream::ReadMessageSpan() {
+  ErrorMessageOr<absl::Span<const uint8_t>> message_or_error = ReadMessageSpanFromChunk();
+  // The message might continue in the next chunk, so read it again from a chunk starting with it.
+  if (message_or_error.has_error() && chunk_end_ < section_size_) {
+    StartChunk();
+    message_or_error = ReadMessageSpanFromChunk();
+  }
+  // The next read starts again at the message that couldn't be read.
+  if (message_or_error.has_error()) coded_input_stream_.reset();
+  return message_or_error;
+}
+
+ErrorMessageOr<void> MappedProtoSectionInputStream::ReadMessage(
+    google::protobuf::Message* message) {
+  OUTCOME_TRY(absl::Span<const uint8_t> message_bytes, ReadMessageSpan());
+  return ParseMessage(message_bytes.data(), message_bytes.size(), message);
+}
+
+ErrorMessageOr<void> MappedProtoSectionInputStream::ReadMessageBytes(std::string* message_bytes) {
+  OUTCOME_TRY(absl::Span<const uint8_t> message_span, ReadMessageSpan());
+  message_bytes->assign(message_span.begin(), message_span.end());
+  return outcome::success();
+}
+
+}  // namespace orbit_capture_file_internal
@@ -0,0 +1,226 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/strings/str_format.h>
+#include <absl/time/clock.h>
+#include <absl/time/time.h>
+#include <absl/types/span.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "CaptureFile/ProtoSectionInputStream.h"
+#include "GrpcProtos/capture.pb.h"
+#include "MappedProtoSectionInputStream.h"
+#include "OrbitBase/File.h"
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/Result.h"
+#include "ProtoSectionInputStreamImpl.h"
+#include "TestUtils/TemporaryFile.h"
+#include "TestUtils/TestUtils.h"
+
+namespace orbit_capture_file_internal {
+
+using orbit_grpc_protos::ClientCaptureEvent;
+using orbit_test_utils::HasErrorWithMessage;
+using orbit_test_utils::HasNoError;
+
+namespace {
+
+// Not a multiple of the page size, like the capture section.
+constexpr uint64_t kSectionOffset = 24;
+
+std::string SerializeWithSize(const ClientCaptureEvent& event) {
+  const std::string event_bytes = event.SerializeAsString();
+  ORBIT_CHECK(event_bytes.size() < 128);
+  return std::string(1, static_cast<char>(event_bytes.size())) + event_bytes;
+}
+
+ClientCaptureEvent CreateInternedStringEvent(uint64_t key) {
+  ClientCaptureEvent event;
+  event.mutable_interned_string()->set_key(key);
+  event.mutable_interned_string()->set_intern("string " + std::to_string(key));
+  return event;
+}
+
+}  // namespace
+
+TEST(MappedProtoSectionInputStream, ReadsTheSameMessagesAsProtoSectionInputStreamImpl) {
+  auto temporary_file_or_error = orbit_test_utils::TemporaryFile::Create();
+  ASSERT_THAT(temporary_file_or_error, HasNoError());
+  orbit_test_utils::TemporaryFile temporary_file = std::move(temporary_file_or_error.value());
+
+  std::string section(kSectionOffset, 'x');
+  for (uint64_t key = 0; key < 1000; ++key) {
+    section.append(SerializeWithSize(CreateInternedStringEvent(key)));
+  }
+  // Padding, like at the end of the capture section.
+  section.append(3, '\0');
+  ASSERT_THAT(orbit_base::WriteFully(temporary_file.fd(), section), HasNoError());
+  const uint64_t section_size = section.size() - kSectionOffset;
+
+  // With the small chunks, most chunks end in the middle of a message.
+  for (uint64_t chunk_size : {MappedProtoSectionInputStream::kDefaultChunkSize, uint64_t{50}}) {
+    auto mapped_input_stream_or_error = MappedProtoSectionInputStream::Create(
+        temporary_file.fd(), kSectionOffset, section_size, chunk_size);
+    ASSERT_THAT(mapped_input_stream_or_error, HasNoError());
+    MappedProtoSectionInputStream& mapped_input_stream = *mapped_input_stream_or_error.value();
+    ProtoSectionInputStreamImpl file_input_stream{temporary_file.fd(), kSectionOffset,
+                                                  section_size};
+
+    for (uint64_t key = 0; key < 1000; ++key) {
+      if (key % 3 == 0) {
+        ClientCaptureEvent mapped_event;
+        ASSERT_THAT(mapped_input_stream.ReadMessage(&mapped_event), HasNoError());
+        ClientCaptureEvent file_event;
+        ASSERT_THAT(file_input_stream.ReadMessage(&file_event), HasNoError());
+        EXPECT_EQ(mapped_event.SerializeAsString(), file_event.SerializeAsString());
+        EXPECT_EQ(mapped_event.interned_string().key(), key);
+      } else if (key % 3 == 1) {
+        std::string mapped_event_bytes;
+        ASSERT_THAT(mapped_input_stream.ReadMessageBytes(&mapped_event_bytes), HasNoError());
+        std::string file_event_bytes;
+        ASSERT_THAT(file_input_stream.ReadMessageBytes(&file_event_bytes), HasNoError());
+        EXPECT_EQ(mapped_event_bytes, file_event_bytes);
+        EXPECT_EQ(mapped_event_bytes, CreateInternedStringEvent(key).SerializeAsString());
+      } else {
+        auto mapped_event_span_or_error = mapped_input_stream.ReadMessageSpan();
+        ASSERT_THAT(mapped_event_span_or_error, HasNoError());
+        const absl::Span<const uint8_t> mapped_event_span = mapped_event_span_or_error.value();
+        // The span points into the mapping.
+        EXPECT_EQ(std::string(mapped_event_span.begin(), mapped_event_span.end()),
+                  CreateInternedStringEvent(key).SerializeAsString());
+        auto file_event_span_or_error = file_input_stream.ReadMessageSpan();
+        ASSERT_THAT(file_event_span_or_error, HasNoError());
+        EXPECT_EQ(file_event_span_or_error.value(), mapped_event_span);
+      }
+    }
+
+    // The padding is read as empty messages, then the end of the section is reached.
+    for (int i = 0; i < 3; ++i) {
+      ClientCaptureEvent event;
+      ASSERT_THAT(mapped_input_stream.ReadMessage(&event), HasNoError());
+      EXPECT_EQ(event.ByteSizeLong(), 0);
+    }
+    ClientCaptureEvent event;
+    EXPECT_THAT(mapped_input_stream.ReadMessage(&event),
+                HasErrorWithMessage("Unexpected end of section while reading message size"));
+  }
+}
+
+TEST(MappedProtoSectionInputStream, DoesNotReadPastTheEndOfTheSection) {
+  auto temporary_file_or_error = orbit_test_utils::TemporaryFile::Create();
+  ASSERT_THAT(temporary_file_or_error, HasNoError());
+  orbit_test_utils::TemporaryFile temporary_file = std::move(temporary_file_or_error.value());
+
+  std::string section(kSectionOffset, 'x');
+  const std::string event_with_size = SerializeWithSize(CreateInternedStringEvent(42));
+  section.append(event_with_size);
+  ASSERT_THAT(orbit_base::WriteFully(temporary_file.fd(), section), HasNoError());
+
+  // The section ends in the middle of the message, even though the file doesn't.
+  auto mapped_input_stream_or_error = MappedProtoSectionInputStream::Create(
+      temporary_file.fd(), kSectionOffset, event_with_size.size() - 1);
+  ASSERT_THAT(mapped_input_stream_or_error, HasNoError());
+  ClientCaptureEvent event;
+  EXPECT_THAT(mapped_input_stream_or_error.value()->ReadMessage(&event),
+              HasErrorWithMessage("Unexpected end of section while reading the message"));
+}
+
+TEST(MappedProtoSectionInputStream, CreateFailsForAnEmptySection) {
+  auto temporary_file_or_error = orbit_test_utils::TemporaryFile::Create();
+  ASSERT_THAT(temporary_file_or_error, HasNoError());
+  orbit_test_utils::TemporaryFile temporary_file = std::move(temporary_file_or_error.value());
+  ASSERT_THAT(orbit_base::WriteFully(temporary_file.fd(), std::string(kSectionOffset, 'x')),
+              HasNoError());
+
+  EXPECT_THAT(MappedProtoSectionInputStream::Create(temporary_file.fd(), kSectionOffset, 0),
+              HasErrorWithMessage("it is empty"));
+}
+
+// Not a real benchmark, but it logs how fast a large capture section is read from the file and from
+// a mapping, with and without parsing the events. It only measures, so it doesn't run by default:
+// start the test binary with
+// `--gtest_filter=MappedProtoSectionInputStream.DISABLED_ReadThroughput
+// --gtest_also_run_disabled_tests` to run it.
+TEST(MappedProtoSectionInputStream, DISABLED_ReadThroughput) {
+  constexpr uint64_t kEventCount = 3'000'000;
+  auto temporary_file_or_error = orbit_test_utils::TemporaryFile::Create();
+  ASSERT_THAT(temporary_file_or_error, HasNoError());
+  orbit_test_utils::TemporaryFile temporary_file = std::move(temporary_file_or_error.value());
+
+  // FunctionCall events are the most common events of large captures.
+  std::string section(kSectionOffset, 'x');
+  for (uint64_t i = 0; i < kEventCount; ++i) {
+    ClientCaptureEvent event;
+    orbit_grpc_protos::FunctionCall* function_call = event.mutable_function_call();
+    function_call->set_pid(1234);
+    function_call->set_tid(1234 + i % 16);
+    function_call->set_function_id(i % 1000 + 1);
+    function_call->set_duration_ns(1000 + i % 1000);
+    function_call->set_end_timestamp_ns(1'000'000'000 + i * 100);
+    function_call->set_depth(i % 10);
+    function_call->set_return_value(i);
+    section.append(SerializeWithSize(event));
+  }
+  ASSERT_THAT(orbit_base::WriteFully(temporary_file.fd(), section), HasNoError());
+  const uint64_t section_size = section.size() - kSectionOffset;
+
+  using ReadFunction =
+      std::function<ErrorMessageOr<void>(orbit_capture_file::ProtoSectionInputStream*)>;
+  const auto log_throughput = [&](std::string_view description, const ReadFunction& read_message) {
+    for (bool mapped : {false, true}) {
+      std::unique_ptr<orbit_capture_file::ProtoSectionInputStream> input_stream;
+      if (mapped) {
+        auto mapped_input_stream_or_error = MappedProtoSectionInputStream::Create(
+            temporary_file.fd(), kSectionOffset, section_size);
+        ASSERT_THAT(mapped_input_stream_or_error, HasNoError());
+        input_stream = std::move(mapped_input_stream_or_error.value());
+      } else {
+        input_stream = std::make_unique<ProtoSectionInputStreamImpl>(temporary_file.fd(),
+                                                                     kSectionOffset, section_size);
+      }
+
+      const absl::Time start = absl::Now();
+      for (uint64_t i = 0; i < kEventCount; ++i) {
+        ASSERT_THAT(read_message(input_stream.get()), HasNoError());
+      }
+      const double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+      ORBIT_LOG("%s from the %s: %.0f MB/s", description, mapped ? "mapping" : "file",
+                section_size / 1e6 / seconds);
+    }
+  };
+
+  log_throughput("ReadMessage",
+                 [](orbit_capture_file::ProtoSectionInputStream* input_stream) {
+                   ClientCaptureEvent event;
+                   return input_stream->ReadMessage(&event);
+                 });
+  log_throughput("ReadMessageBytes",
+                 [](orbit_capture_file::ProtoSectionInputStream* input_stream) {
+                   std::string event_bytes;
+                   return input_stream->ReadMessageBytes(&event_bytes);
+                 });
+  log_throughput("ReadMessageSpan",
+                 [](orbit_capture_file::ProtoSectionInputStream* input_stream)
+                     -> ErrorMessageOr<void> {
+                   OUTCOME_TRY(input_stream->ReadMessageSpan());
+                   return outcome::success();
+                 });
+  log_throughput("ReadMessageSpan and ParseMessage",
+                 [](orbit_capture_file::ProtoSectionInputStream* input_stream)
+                     -> ErrorMessageOr<void> {
+                   OUTCOME_TRY(absl::Span<const uint8_t> event_bytes,
+                               input_stream->ReadMessageSpan());
+                   ClientCaptureEvent event;
+                   return orbit_capture_file::ParseMessage(event_bytes.data(), event_bytes.size(),
+                                                           &event);
+                 });
+}
+
+}  // namespace orbit_capture_file_internal
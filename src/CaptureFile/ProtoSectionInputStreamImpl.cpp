@@ -6,15 +6,38 @@
 
 #include <absl/strings/str_format.h>
 
-#include <memory>
+#include <algorithm>
+#include <string>
 
-#include "OrbitBase/MakeUniqueForOverwrite.h"
+#include "OrbitBase/Logging.h"
+
+namespace orbit_capture_file {
+
+ErrorMessageOr<void> ParseMessage(const void* data, size_t size,
+                                  google::protobuf::Message* message) {
+  message->ParseFromArray(data, static_cast<int>(size));
+
+  if (message->ByteSizeLong() != size) {
+    return ErrorMessage{absl::StrFormat(
+        "The message size %d of the parsed message is different from the parsed size %d",
+        message->ByteSizeLong(), size)};
+  }
+
+  return outcome::success();
+}
+
+}  // namespace orbit_capture_file
 
 namespace orbit_capture_file_internal {
 
-constexpr uint64_t kMaximumMessageSize = 1024 * 1024;  // 1Mb
+using orbit_capture_file::ParseMessage;
 
 ErrorMessageOr<void> ProtoSectionInputStreamImpl::ReadMessage(google::protobuf::Message* message) {
+  OUTCOME_TRY(absl::Span<const uint8_t> message_bytes, ReadMessageSpan());
+  return ParseMessage(message_bytes.data(), message_bytes.size(), message);
+}
+
+void ProtoSectionInputStreamImpl::ReinitializeCodedInputStreamIfNeeded() {
   // CodedInputStream imposes a hard limit on the total number of bytes it will read. It's INT_MAX
   // by default and it cannot be increased past that. To work around the limitation, reinitialize
   // the CodedInputStream, as the actual current position is kept by the FileFragmentInputStream
@@ -24,6 +47,25 @@ ErrorMessageOr<void> ProtoSectionInputStreamImpl::ReadMessage(google::protobuf::
     coded_input_stream_.emplace(&file_fragment_input_stream_);
     coded_input_stream_->SetTotalBytesLimit(kCodedInputStreamTotalBytesLimit);
   }
+}
+
+ErrorMessageOr<void> ProtoSectionInputStreamImpl::SkipTo(uint64_t position) {
+  ORBIT_CHECK(position >= position_);
+  while (position_ < position) {
+    ReinitializeCodedInputStreamIfNeeded();
+    const auto bytes_to_skip = static_cast<int>(
+        std::min<uint64_t>(position - position_, kCodedInputStreamReinitializationThreshold));
+    if (!coded_input_stream_->Skip(bytes_to_skip)) {
+      return file_fragment_input_stream_.GetLastError().value_or(
+          ErrorMessage{"Unexpected end of section while skipping messages"});
+    }
+    position_ += bytes_to_skip;
+  }
+  return outcome::success();
+}
+
+ErrorMessageOr<uint32_t> ProtoSectionInputStreamImpl::ReadMessageSize() {
+  ReinitializeCodedInputStreamIfNeeded();
 
   uint32_t message_size = 0;
 
@@ -42,22 +84,45 @@ ErrorMessageOr<void> ProtoSectionInputStreamImpl::ReadMessage(google::protobuf::
         absl::StrFormat("The message size %d is too big (maximum allowed message size is %d)",
                         message_size, kMaximumMessageSize)};
   }
+  return message_size;
+}
+
+ErrorMessageOr<void> ProtoSectionInputStreamImpl::ReadMessageBytes(std::string* message_bytes) {
+  OUTCOME_TRY(const uint32_t message_size, ReadMessageSize());
 
-  auto buf = make_unique_for_overwrite<uint8_t[]>(message_size);
-  if (!coded_input_stream_->ReadRaw(buf.get(), message_size)) {
+  if (!coded_input_stream_->ReadString(message_bytes, static_cast<int>(message_size))) {
     return file_fragment_input_stream_.GetLastError().value_or(
         ErrorMessage{"Unexpected end of section while reading the message"});
   }
+  position_ +=
+      google::protobuf::io::CodedOutputStream::VarintSize32(message_size) + message_size;
 
-  message->ParseFromArray(buf.get(), message_size);
+  return outcome::success();
+}
 
-  if (message->ByteSizeLong() != message_size) {
-    return ErrorMessage{absl::StrFormat(
-        "The message size %d of the parsed message is different from the parsed size %d",
-        message->ByteSizeLong(), message_size)};
+ErrorMessageOr<absl::Span<const uint8_t>> ProtoSectionInputStreamImpl::ReadMessageSpan() {
+  OUTCOME_TRY(const uint32_t message_size, ReadMessageSize());
+
+  // The buffer stays valid until the coded input stream needs more data, i.e., until the next read.
+  const void* buffer = nullptr;
+  int buffer_size = 0;
+  absl::Span<const uint8_t> message_bytes;
+  if (coded_input_stream_->GetDirectBufferPointer(&buffer, &buffer_size) &&
+             static_cast<uint32_t>(buffer_size) >= message_size) {
+    message_bytes = absl::MakeConstSpan(static_cast<const uint8_t*>(buffer), message_size);
+    ORBIT_CHECK(coded_input_stream_->Skip(static_cast<int>(message_size)));
+  } else {
+    if (!coded_input_stream_->ReadString(&message_bytes_, static_cast<int>(message_size))) {
+      return file_fragment_input_stream_.GetLastError().value_or(
+          ErrorMessage{"Unexpected end of section while reading the message"});
+    }
+    message_bytes = absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(message_bytes_.data()),
+                                        message_bytes_.size());
   }
+  position_ +=
+      google::protobuf::io::CodedOutputStream::VarintSize32(message_size) + message_size;
 
-  return outcome::success();
+  return message_bytes;
 }
 
-}  // namespace orbit_capture_file_internal
\ No newline at end of file
+}  // namespace orbit_capture_file_internal
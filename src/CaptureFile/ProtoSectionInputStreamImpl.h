@@ -5,12 +5,15 @@
 #ifndef PROTO_SECTION_INPUT_STREAM_IMPL_H_
 #define PROTO_SECTION_INPUT_STREAM_IMPL_H_
 
+#include <absl/types/span.h>
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/message.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <limits>
 #include <optional>
+#include <string>
 #include <utility>
 
 #include "CaptureFile/ProtoSectionInputStream.h"
@@ -20,10 +23,15 @@
 
 namespace orbit_capture_file_internal {
 
+// Messages in sections are limited to this size, so that untrusted sizes can't lead to huge
+// allocations.
+constexpr uint64_t kMaximumMessageSize = 1024 * 1024;  // 1Mb
+
 // This class is used to read proto messages from a section of capture file.
 class ProtoSectionInputStreamImpl : public orbit_capture_file::ProtoSectionInputStream {
  public:
-  explicit ProtoSectionInputStreamImpl(orbit_base::UniqueFd& fd, uint64_t capture_section_offset,
+  explicit ProtoSectionInputStreamImpl(const orbit_base::UniqueFd& fd,
+                                       uint64_t capture_section_offset,
                                        uint64_t capture_section_size)
       : fd_{fd},
         file_fragment_input_stream_{fd_, capture_section_offset, capture_section_size},
@@ -32,15 +40,31 @@ class ProtoSectionInputStreamImpl : public orbit_capture_file::ProtoSectionInput
   }
 
   ErrorMessageOr<void> ReadMessage(google::protobuf::Message* message) override;
+  ErrorMessageOr<void> ReadMessageBytes(std::string* message_bytes) override;
+  // Returns a view of the buffer of the underlying stream if the message is entirely in it, and
+  // copies the message otherwise.
+  ErrorMessageOr<absl::Span<const uint8_t>> ReadMessageSpan() override;
+
+  // Returns the offset of the next message from the start of the section.
+  [[nodiscard]] uint64_t GetPosition() const { return position_; }
+  // Skips to the message at `position`, which can't be before the current position.
+  ErrorMessageOr<void> SkipTo(uint64_t position);
 
  private:
+  void ReinitializeCodedInputStreamIfNeeded();
+  // Reads the size of the next message. On success, the message is next in coded_input_stream_.
+  ErrorMessageOr<uint32_t> ReadMessageSize();
+
   static constexpr int kCodedInputStreamTotalBytesLimit = std::numeric_limits<int>::max();
   static constexpr int kCodedInputStreamReinitializationThreshold =
       kCodedInputStreamTotalBytesLimit / 2;
 
-  orbit_base::UniqueFd& fd_;
+  const orbit_base::UniqueFd& fd_;
   FileFragmentInputStream file_fragment_input_stream_;
   std::optional<google::protobuf::io::CodedInputStream> coded_input_stream_;
+  // Reused by ReadMessageSpan to avoid allocating a buffer for every message it copies.
+  std::string message_bytes_;
+  uint64_t position_ = 0;
 };
 
 }  // namespace orbit_capture_file_internal
@@ -69,8 +69,22 @@ class CaptureFile {
   virtual std::unique_ptr<ProtoSectionInputStream> CreateProtoSectionInputStream(
       uint64_t section_number) = 0;
 
+  // On Linux, the capture section is read from a memory mapping of the file. Truncating the file
+  // while the returned stream is in use makes reading the removed part raise SIGBUS, which kills
+  // the process, instead of returning an error.
   virtual std::unique_ptr<ProtoSectionInputStream> CreateCaptureSectionInputStream() = 0;
 
+  // Uses the capture index section to create a stream of only the capture section events needed
+  // to load what happened between `min_timestamp_ns` and `max_timestamp_ns`: the events from before
+  // the time range that later events can depend on, like interned strings and callstacks, followed
+  // by all events of the index checkpoints from the first to the last one that overlaps the time
+  // range. Unless that is the end of the capture section, the stream ends with an additional
+  // CaptureFinished event. Returns an error if the file has no capture index section or if no
+  // event overlaps the time range.
+  virtual ErrorMessageOr<std::unique_ptr<ProtoSectionInputStream>>
+  CreateCaptureSectionInputStreamForTimeRange(uint64_t min_timestamp_ns,
+                                              uint64_t max_timestamp_ns) = 0;
+
   static ErrorMessageOr<std::unique_ptr<CaptureFile>> OpenForReadWrite(
       const std::filesystem::path& file_path);
 
@@ -7,8 +7,11 @@
 
 #include <google/protobuf/message.h>
 
+#include <stdint.h>
+
 #include <filesystem>
 #include <memory>
+#include <optional>
 
 #include "CaptureFile/BufferOutputStream.h"
 #include "GrpcProtos/capture.pb.h"
@@ -51,10 +54,16 @@ class CaptureFileOutputStream {
 
   [[nodiscard]] virtual bool IsOpen() = 0;
 
+  // About 4 MB of events per checkpoint keeps the capture index small even for huge captures.
+  static constexpr uint64_t kDefaultCaptureIndexCheckpointSize = 4 * 1024 * 1024;
+
   // Create new capture file output stream. If the file exists it is going to be
-  // overwritten.
+  // overwritten. If `capture_index_checkpoint_size` is set, Close() also adds a capture index
+  // section with a checkpoint about every `capture_index_checkpoint_size` bytes of capture events,
+  // which CaptureFile::CreateCaptureSectionInputStreamForTimeRange uses.
   [[nodiscard]] static ErrorMessageOr<std::unique_ptr<CaptureFileOutputStream>> Create(
-      std::filesystem::path path);
+      std::filesystem::path path,
+      std::optional<uint64_t> capture_index_checkpoint_size = std::nullopt);
   [[nodiscard]] static std::unique_ptr<CaptureFileOutputStream> Create(
       BufferOutputStream* output_buffer);
 };
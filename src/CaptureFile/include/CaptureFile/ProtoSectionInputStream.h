@@ -5,7 +5,12 @@
 #ifndef CAPTURE_FILE_PROTO_SECTION_INPUT_STREAM_H_
 #define CAPTURE_FILE_PROTO_SECTION_INPUT_STREAM_H_
 
+#include <absl/types/span.h>
 #include <google/protobuf/message.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
 
 #include "OrbitBase/Result.h"
 
@@ -25,8 +30,22 @@ class ProtoSectionInputStream {
   // aligned to 8bytes. Reading beyond the CaptureFinished message will incorrectly
   // read padded zeros as empty messages until finally causing an end of section error.
   virtual ErrorMessageOr<void> ReadMessage(google::protobuf::Message* message) = 0;
+
+  // Reads the serialized bytes of the next message from the stream without parsing them, so that
+  // the caller can parse them later, possibly on another thread. The same caveat as for
+  // ReadMessage applies.
+  virtual ErrorMessageOr<void> ReadMessageBytes(std::string* message_bytes) = 0;
+
+  // Like ReadMessageBytes, but returns a view of the serialized bytes instead of a copy whenever
+  // the stream can provide one. The view is only valid until the next call to any Read method.
+  virtual ErrorMessageOr<absl::Span<const uint8_t>> ReadMessageSpan() = 0;
 };
 
+// Parses `message` from the `size` bytes at `data`, e.g., the ones returned by ReadMessageBytes, and
+// checks that they were all used.
+ErrorMessageOr<void> ParseMessage(const void* data, size_t size,
+                                  google::protobuf::Message* message);
+
 }  // namespace orbit_capture_file
 
 #endif  // CAPTURE_FILE_PROTO_SECTION_INPUT_STREAM_H_
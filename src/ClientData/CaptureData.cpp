@@ -260,6 +260,12 @@ std::optional<ScopeId> CaptureData::ProvideScopeId(
   return scope_id_provider_->ProvideId(timer_info);
 }
 
+std::optional<ScopeId> CaptureData::ProvideScopeId(const TimerView& timer) const {
+  const orbit_client_protos::TimerInfo* stored_timer_info = timer.GetStoredTimerInfo();
+  if (stored_timer_info != nullptr) return ProvideScopeId(*stored_timer_info);
+  return ProvideScopeId(timer.ToTimerInfo());
+}
+
 [[nodiscard]] std::vector<ScopeId> CaptureData::GetAllProvidedScopeIds() const {
   return scope_id_provider_->GetAllProvidedScopeIds();
 }
@@ -0,0 +1,316 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/CompactTimerChain.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/MakeUniqueForOverwrite.h"
+
+using orbit_client_protos::TimerInfo;
+
+namespace orbit_client_data {
+
+namespace {
+
+template <typename T>
+[[nodiscard]] bool FitsIn(uint64_t value) {
+  return value <= std::numeric_limits<T>::max();
+}
+
+// Returns whether all the fields of `timer_info`, stored with `depth`, can be stored in the columns
+// of a CompactTimerBlock, given that its start timestamp can.
+[[nodiscard]] bool FitsInColumns(const TimerInfo& timer_info, uint32_t depth) {
+  // The maximum duration is kept to mean that the timer ends before it starts.
+  return timer_info.end() >= timer_info.start() &&
+         timer_info.end() - timer_info.start() < std::numeric_limits<uint32_t>::max() &&
+         FitsIn<uint32_t>(timer_info.function_id()) && FitsIn<uint8_t>(depth) &&
+         timer_info.processor() >= std::numeric_limits<int16_t>::min() &&
+         timer_info.processor() <= std::numeric_limits<int16_t>::max() &&
+         timer_info.callstack_id() == 0 && timer_info.user_data_key() == 0 &&
+         timer_info.timeline_hash() == 0 && timer_info.registers().empty() &&
+         !timer_info.has_color() && timer_info.group_id() == 0 &&
+         timer_info.api_async_scope_id() == 0 && timer_info.address_in_function() == 0 &&
+         timer_info.api_scope_name().empty();
+}
+
+}  // namespace
+
+const TimerInfo* TimerView::GetStoredTimerInfo() const {
+  if (timer_info_ != nullptr) return timer_info_;
+  return block_->GetSideTableEntry(index_);
+}
+
+uint64_t TimerView::start() const {
+  if (timer_info_ != nullptr) return timer_info_->start();
+  return block_->base_timestamp_ns_ + block_->start_offsets_ns_[index_];
+}
+
+uint64_t TimerView::end() const {
+  const TimerInfo* stored_timer_info = GetStoredTimerInfo();
+  if (stored_timer_info != nullptr) return stored_timer_info->end();
+  return start() + block_->durations_ns_[index_];
+}
+
+uint32_t TimerView::depth() const {
+  const TimerInfo* stored_timer_info = GetStoredTimerInfo();
+  if (stored_timer_info != nullptr) return stored_timer_info->depth();
+  return block_->depths_[index_];
+}
+
+uint64_t TimerView::function_id() const {
+  const TimerInfo* stored_timer_info = GetStoredTimerInfo();
+  if (stored_timer_info != nullptr) return stored_timer_info->function_id();
+  return block_->function_ids_[index_];
+}
+
+uint32_t TimerView::thread_id() const {
+  if (timer_info_ != nullptr) return timer_info_->thread_id();
+  return block_->thread_ids_[index_];
+}
+
+uint32_t TimerView::process_id() const {
+  if (timer_info_ != nullptr) return timer_info_->process_id();
+  return block_->process_ids_[index_];
+}
+
+int32_t TimerView::processor() const {
+  const TimerInfo* stored_timer_info = GetStoredTimerInfo();
+  if (stored_timer_info != nullptr) return stored_timer_info->processor();
+  return block_->processors_[index_];
+}
+
+TimerInfo::Type TimerView::type() const {
+  if (timer_info_ != nullptr) return timer_info_->type();
+  return static_cast<TimerInfo::Type>(block_->types_[index_] &
+                                      ~CompactTimerBlock::kInSideTableFlag);
+}
+
+TimerInfo TimerView::ToTimerInfo() const {
+  const TimerInfo* stored_timer_info = GetStoredTimerInfo();
+  if (stored_timer_info != nullptr) return *stored_timer_info;
+
+  TimerInfo timer_info;
+  timer_info.set_start(start());
+  timer_info.set_end(end());
+  timer_info.set_process_id(process_id());
+  timer_info.set_thread_id(thread_id());
+  timer_info.set_depth(depth());
+  timer_info.set_type(type());
+  timer_info.set_processor(processor());
+  timer_info.set_function_id(function_id());
+  return timer_info;
+}
+
+const TimerInfo& TimerView::GetTimerInfo() const {
+  const TimerInfo* stored_timer_info = GetStoredTimerInfo();
+  if (stored_timer_info != nullptr) return *stored_timer_info;
+  return block_->GetOrCreateTimerInfo(index_);
+}
+
+CompactTimerBlock::CompactTimerBlock(uint64_t base_timestamp_ns)
+    : base_timestamp_ns_{base_timestamp_ns},
+      start_offsets_ns_{make_unique_for_overwrite<uint32_t[]>(kCapacity)},
+      durations_ns_{make_unique_for_overwrite<uint32_t[]>(kCapacity)},
+      function_ids_{make_unique_for_overwrite<uint32_t[]>(kCapacity)},
+      thread_ids_{make_unique_for_overwrite<uint32_t[]>(kCapacity)},
+      process_ids_{make_unique_for_overwrite<uint32_t[]>(kCapacity)},
+      processors_{make_unique_for_overwrite<int16_t[]>(kCapacity)},
+      depths_{make_unique_for_overwrite<uint8_t[]>(kCapacity)},
+      types_{make_unique_for_overwrite<uint8_t[]>(kCapacity)} {}
+
+bool CompactTimerBlock::TryAppend(const TimerInfo& timer_info, uint32_t depth) {
+  const uint32_t index = size_.load(std::memory_order_relaxed);
+  if (index == kCapacity || timer_info.start() < base_timestamp_ns_ ||
+      !FitsIn<uint32_t>(timer_info.start() - base_timestamp_ns_)) {
+    return false;
+  }
+  ORBIT_CHECK(TimerInfo::Type_IsValid(timer_info.type()) && timer_info.type() < kInSideTableFlag);
+
+  start_offsets_ns_[index] = static_cast<uint32_t>(timer_info.start() - base_timestamp_ns_);
+  thread_ids_[index] = timer_info.thread_id();
+  process_ids_[index] = timer_info.process_id();
+  types_[index] = static_cast<uint8_t>(timer_info.type());
+  if (FitsInColumns(timer_info, depth)) {
+    durations_ns_[index] = static_cast<uint32_t>(timer_info.end() - timer_info.start());
+    function_ids_[index] = static_cast<uint32_t>(timer_info.function_id());
+    processors_[index] = static_cast<int16_t>(timer_info.processor());
+    depths_[index] = static_cast<uint8_t>(depth);
+  } else {
+    if (side_table_ == nullptr) {
+      side_table_ = std::make_unique<std::unique_ptr<const TimerInfo>[]>(kCapacity);
+    }
+    auto side_table_entry = std::make_unique<TimerInfo>(timer_info);
+    side_table_entry->set_depth(depth);
+    side_table_[side_table_size_] = std::move(side_table_entry);
+    durations_ns_[index] = side_table_size_;
+    ++side_table_size_;
+    types_[index] |= kInSideTableFlag;
+  }
+
+  if (timer_info.start() < MinTimestamp()) {
+    min_timestamp_.store(timer_info.start(), std::memory_order_relaxed);
+  }
+  if (timer_info.end() > MaxTimestamp()) {
+    max_timestamp_.store(timer_info.end(), std::memory_order_relaxed);
+  }
+  // Publishes the columns written above to the threads reading the timers.
+  size_.store(index + 1, std::memory_order_release);
+  return true;
+}
+
+const TimerInfo* CompactTimerBlock::GetSideTableEntry(uint32_t index) const {
+  if ((types_[index] & kInSideTableFlag) == 0) return nullptr;
+  return side_table_[durations_ns_[index]].get();
+}
+
+const TimerInfo& CompactTimerBlock::GetOrCreateTimerInfo(uint32_t index) const {
+  const std::atomic<const TimerInfo*>* published_timer_infos_by_index =
+      published_timer_infos_by_index_.load(std::memory_order_acquire);
+  if (published_timer_infos_by_index != nullptr) {
+    const TimerInfo* timer_info =
+        published_timer_infos_by_index[index].load(std::memory_order_acquire);
+    if (timer_info != nullptr) return *timer_info;
+  }
+
+  absl::MutexLock lock(&timer_infos_mutex_);
+  if (timer_infos_by_index_ == nullptr) {
+    // Value-initialized, i.e., all nullptr.
+    timer_infos_by_index_ = std::make_unique<std::atomic<const TimerInfo*>[]>(kCapacity);
+    published_timer_infos_by_index_.store(timer_infos_by_index_.get(), std::memory_order_release);
+  }
+  std::atomic<const TimerInfo*>& timer_info = timer_infos_by_index_[index];
+  if (timer_info.load(std::memory_order_relaxed) == nullptr) {
+    timer_infos_.push_back(std::make_unique<const TimerInfo>((*this)[index].ToTimerInfo()));
+    timer_info.store(timer_infos_.back().get(), std::memory_order_release);
+  }
+  return *timer_info.load(std::memory_order_relaxed);
+}
+
+std::optional<TimerView> CompactTimerBlock::LowerBound(uint64_t min_ns) const {
+  uint32_t begin = 0;
+  uint32_t count = size();
+  while (count > 0) {
+    const uint32_t half = count / 2;
+    if ((*this)[begin + half].end() < min_ns) {
+      begin += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  if (begin == size()) return std::nullopt;
+  return (*this)[begin];
+}
+
+uint32_t CompactTimerBlock::LowerBoundStart(uint64_t start_ns) const {
+  if (start_ns <= base_timestamp_ns_) return 0;
+  const uint64_t start_offset_ns = start_ns - base_timestamp_ns_;
+  return std::lower_bound(start_offsets_ns_.get(), start_offsets_ns_.get() + size(),
+                          start_offset_ns,
+                          [](uint32_t offset_ns, uint64_t value) { return offset_ns < value; }) -
+         start_offsets_ns_.get();
+}
+
+size_t CompactTimerBlock::GetMemoryUsageBytes() const {
+  static constexpr size_t kColumnBytesPerTimer = 5 * sizeof(uint32_t) + sizeof(int16_t) +
+                                                 2 * sizeof(uint8_t);
+  size_t memory_usage_bytes = sizeof(*this) + kCapacity * kColumnBytesPerTimer;
+  if (side_table_ != nullptr) {
+    memory_usage_bytes += kCapacity * sizeof(side_table_[0]);
+    for (uint32_t i = 0; i < side_table_size_; ++i) {
+      memory_usage_bytes += side_table_[i]->SpaceUsedLong();
+    }
+  }
+  absl::MutexLock lock(&timer_infos_mutex_);
+  if (timer_infos_by_index_ != nullptr) {
+    memory_usage_bytes += kCapacity * sizeof(timer_infos_by_index_[0]);
+  }
+  memory_usage_bytes += timer_infos_.capacity() * sizeof(timer_infos_[0]);
+  for (const std::unique_ptr<const TimerInfo>& timer_info : timer_infos_) {
+    memory_usage_bytes += timer_info->SpaceUsedLong();
+  }
+  return memory_usage_bytes;
+}
+
+TimerView CompactTimerChain::Append(const TimerInfo& timer_info, uint32_t depth) {
+  if (blocks_.empty() || !blocks_.back()->TryAppend(timer_info, depth)) {
+    blocks_.emplace_back(std::make_unique<CompactTimerBlock>(timer_info.start()));
+    ORBIT_CHECK(blocks_.back()->TryAppend(timer_info, depth));
+  }
+  ++num_items_;
+  return (*blocks_.back())[blocks_.back()->size() - 1];
+}
+
+CompactTimerChain::Position CompactTimerChain::LowerBoundStart(uint64_t time) const {
+  // The first block whose last timer doesn't start before `time` contains the timer we look for.
+  auto block_it = std::partition_point(
+      blocks_.begin(), blocks_.end(), [time](const std::unique_ptr<CompactTimerBlock>& block) {
+        return block->size() == 0 || (*block)[block->size() - 1].start() < time;
+      });
+  if (block_it == blocks_.end()) return {blocks_.size(), 0};
+  return {static_cast<size_t>(block_it - blocks_.begin()), (*block_it)->LowerBoundStart(time)};
+}
+
+std::optional<CompactTimerChain::Position> CompactTimerChain::Find(uint64_t start_ns,
+                                                                   uint64_t end_ns) const {
+  for (Position position = LowerBoundStart(start_ns); position.block_index < blocks_.size();) {
+    const CompactTimerBlock& block = *blocks_[position.block_index];
+    if (block[position.index].start() != start_ns) return std::nullopt;
+    if (block[position.index].end() == end_ns) return position;
+    if (++position.index == block.size()) position = {position.block_index + 1, 0};
+  }
+  return std::nullopt;
+}
+
+std::optional<CompactTimerChain::Position> CompactTimerChain::GetPreviousPosition(
+    Position position) const {
+  if (position.index > 0) return Position{position.block_index, position.index - 1};
+  if (position.block_index == 0) return std::nullopt;
+  return Position{position.block_index - 1, blocks_[position.block_index - 1]->size() - 1};
+}
+
+std::optional<TimerView> CompactTimerChain::GetTimer(Position position) const {
+  if (position.block_index == blocks_.size()) return std::nullopt;
+  return (*blocks_[position.block_index])[position.index];
+}
+
+std::optional<TimerView> CompactTimerChain::GetFirstStartingAtOrAfter(uint64_t time) const {
+  return GetTimer(LowerBoundStart(time));
+}
+
+std::optional<TimerView> CompactTimerChain::GetLastStartingBefore(uint64_t time) const {
+  std::optional<Position> position = GetPreviousPosition(LowerBoundStart(time));
+  if (!position.has_value()) return std::nullopt;
+  return GetTimer(position.value());
+}
+
+std::optional<TimerView> CompactTimerChain::GetPrevious(uint64_t start_ns, uint64_t end_ns) const {
+  std::optional<Position> position = Find(start_ns, end_ns);
+  if (!position.has_value()) return std::nullopt;
+  position = GetPreviousPosition(position.value());
+  if (!position.has_value()) return std::nullopt;
+  return GetTimer(position.value());
+}
+
+std::optional<TimerView> CompactTimerChain::GetNext(uint64_t start_ns, uint64_t end_ns) const {
+  std::optional<Position> position = Find(start_ns, end_ns);
+  if (!position.has_value()) return std::nullopt;
+  if (++position->index == blocks_[position->block_index]->size()) {
+    position = Position{position->block_index + 1, 0};
+  }
+  return GetTimer(position.value());
+}
+
+size_t CompactTimerChain::GetMemoryUsageBytes() const {
+  size_t memory_usage_bytes = sizeof(*this) + blocks_.capacity() * sizeof(blocks_[0]);
+  for (const std::unique_ptr<CompactTimerBlock>& block : blocks_) {
+    memory_usage_bytes += block->GetMemoryUsageBytes();
+  }
+  return memory_usage_bytes;
+}
+
+}  // namespace orbit_client_data
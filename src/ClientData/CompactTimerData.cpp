@@ -0,0 +1,211 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/CompactTimerData.h"
+
+#include <algorithm>
+
+#include "ApiInterface/Orbit.h"
+#include "ClientData/FastRenderingUtils.h"
+#include "OrbitBase/Logging.h"
+
+using orbit_client_protos::TimerInfo;
+
+namespace orbit_client_data {
+
+namespace {
+
+[[nodiscard]] std::vector<const TimerInfo*> ToTimerInfos(const std::vector<TimerView>& timers) {
+  std::vector<const TimerInfo*> timer_infos;
+  timer_infos.reserve(timers.size());
+  for (const TimerView& timer : timers) {
+    timer_infos.push_back(&timer.GetTimerInfo());
+  }
+  return timer_infos;
+}
+
+[[nodiscard]] const TimerInfo* ToTimerInfo(const std::optional<TimerView>& timer) {
+  if (!timer.has_value()) return nullptr;
+  return &timer->GetTimerInfo();
+}
+
+void AppendTimersOfChain(const CompactTimerChain& chain, uint64_t min_tick, uint64_t max_tick,
+                         bool exclusive, std::vector<TimerView>* timers) {
+  for (const std::unique_ptr<CompactTimerBlock>& block : chain.GetBlocks()) {
+    if (!block->Intersects(min_tick, max_tick)) continue;
+    for (uint32_t i = 0; i < block->size(); ++i) {
+      const TimerView timer = (*block)[i];
+      if (exclusive) {
+        if (timer.end() <= max_tick && timer.start() >= min_tick) timers->push_back(timer);
+      } else {
+        if (timer.start() <= max_tick && timer.end() >= min_tick) timers->push_back(timer);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TimerView CompactTimerData::AddTimer(const TimerInfo& timer_info, uint32_t depth) {
+  absl::MutexLock lock(&mutex_);
+  if (process_id_ == orbit_base::kInvalidProcessId) {
+    process_id_ = timer_info.process_id();
+  }
+  min_time_ = std::min(min_time_.load(), timer_info.start());
+  max_time_ = std::max(max_time_.load(), timer_info.end());
+  depth_ = std::max(depth_.load(), depth + 1);
+  ++num_timers_;
+  return chains_[depth].Append(timer_info, depth);
+}
+
+const CompactTimerChain* CompactTimerData::GetChain(uint32_t depth) const {
+  auto chain_it = chains_.find(depth);
+  if (chain_it == chains_.end()) return nullptr;
+  return &chain_it->second;
+}
+
+std::vector<TimerView> CompactTimerData::GetTimerViews(uint64_t min_tick, uint64_t max_tick,
+                                                       bool exclusive) const {
+  ORBIT_SCOPE_WITH_COLOR("CompactTimerData::GetTimerViews", kOrbitColorBlueGrey);
+  absl::MutexLock lock(&mutex_);
+  std::vector<TimerView> timers;
+  for (const auto& [unused_depth, chain] : chains_) {
+    AppendTimersOfChain(chain, min_tick, max_tick, exclusive, &timers);
+  }
+  return timers;
+}
+
+std::vector<TimerView> CompactTimerData::GetTimerViewsAtDepth(uint32_t depth, uint64_t min_tick,
+                                                              uint64_t max_tick,
+                                                              bool exclusive) const {
+  absl::MutexLock lock(&mutex_);
+  const CompactTimerChain* chain = GetChain(depth);
+  if (chain == nullptr) return {};
+
+  std::vector<TimerView> timers;
+  AppendTimersOfChain(*chain, min_tick, max_tick, exclusive, &timers);
+  return timers;
+}
+
+std::vector<TimerView> CompactTimerData::GetTimerViewsAtDepthDiscretized(uint32_t depth,
+                                                                         uint32_t resolution,
+                                                                         uint64_t start_ns,
+                                                                         uint64_t end_ns) const {
+  ORBIT_SCOPE_WITH_COLOR("CompactTimerData::GetTimerViewsAtDepthDiscretized",
+                         kOrbitColorBlueGrey);
+  absl::MutexLock lock(&mutex_);
+  // See TimerData::GetTimersAtDepthDiscretized.
+  end_ns = std::max(end_ns, end_ns + 1);
+
+  const CompactTimerChain* chain = GetChain(depth);
+  if (chain == nullptr) return {};
+
+  std::vector<TimerView> discretized_timers;
+  uint64_t next_pixel_start_ns = start_ns;
+  for (const std::unique_ptr<CompactTimerBlock>& block : chain->GetBlocks()) {
+    if (block->MinTimestamp() >= end_ns) break;
+
+    while (block->Intersects(next_pixel_start_ns, end_ns) && next_pixel_start_ns < end_ns) {
+      std::optional<TimerView> timer = block->LowerBound(next_pixel_start_ns);
+      if (!timer.has_value() || timer->start() >= end_ns) break;
+      discretized_timers.push_back(timer.value());
+      next_pixel_start_ns = GetNextPixelBoundaryTimeNs(timer->end(), resolution, start_ns, end_ns);
+    }
+  }
+  return discretized_timers;
+}
+
+void CompactTimerData::ForEachTimer(uint64_t min_tick, uint64_t max_tick,
+                                    absl::FunctionRef<void(const TimerView&)> visitor) const {
+  // Blocks are never freed nor moved, so they can be visited without holding the lock, which
+  // allows `visitor` to query this CompactTimerData.
+  std::vector<const CompactTimerBlock*> blocks;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const auto& [unused_depth, chain] : chains_) {
+      for (const std::unique_ptr<CompactTimerBlock>& block : chain.GetBlocks()) {
+        if (block->Intersects(min_tick, max_tick)) blocks.push_back(block.get());
+      }
+    }
+  }
+
+  for (const CompactTimerBlock* block : blocks) {
+    for (uint32_t i = 0; i < block->size(); ++i) {
+      const TimerView timer = (*block)[i];
+      if (timer.start() <= max_tick && timer.end() >= min_tick) visitor(timer);
+    }
+  }
+}
+
+std::vector<const TimerInfo*> CompactTimerData::GetTimers(uint64_t min_tick, uint64_t max_tick,
+                                                          bool exclusive) const {
+  return ToTimerInfos(GetTimerViews(min_tick, max_tick, exclusive));
+}
+
+std::vector<const TimerInfo*> CompactTimerData::GetTimersAtDepthDiscretized(
+    uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const {
+  return ToTimerInfos(GetTimerViewsAtDepthDiscretized(depth, resolution, start_ns, end_ns));
+}
+
+std::optional<TimerView> CompactTimerData::GetFirstAfterStartTime(uint64_t time,
+                                                                  uint32_t depth) const {
+  if (time == std::numeric_limits<uint64_t>::max()) return std::nullopt;
+  absl::MutexLock lock(&mutex_);
+  const CompactTimerChain* chain = GetChain(depth);
+  if (chain == nullptr) return std::nullopt;
+  return chain->GetFirstStartingAtOrAfter(time + 1);
+}
+
+std::optional<TimerView> CompactTimerData::GetFirstBeforeStartTime(uint64_t time,
+                                                                   uint32_t depth) const {
+  absl::MutexLock lock(&mutex_);
+  const CompactTimerChain* chain = GetChain(depth);
+  if (chain == nullptr) return std::nullopt;
+  return chain->GetLastStartingBefore(time);
+}
+
+const TimerInfo* CompactTimerData::GetLeft(const TimerInfo& timer) const {
+  absl::MutexLock lock(&mutex_);
+  const CompactTimerChain* chain = GetChain(timer.depth());
+  if (chain == nullptr) return nullptr;
+  return ToTimerInfo(chain->GetPrevious(timer.start(), timer.end()));
+}
+
+const TimerInfo* CompactTimerData::GetRight(const TimerInfo& timer) const {
+  absl::MutexLock lock(&mutex_);
+  const CompactTimerChain* chain = GetChain(timer.depth());
+  if (chain == nullptr) return nullptr;
+  return ToTimerInfo(chain->GetNext(timer.start(), timer.end()));
+}
+
+const TimerInfo* CompactTimerData::GetUp(const TimerInfo& timer) const {
+  if (timer.depth() == 0) return nullptr;
+  absl::MutexLock lock(&mutex_);
+  const CompactTimerChain* chain = GetChain(timer.depth() - 1);
+  if (chain == nullptr) return nullptr;
+  // The parent is the last timer of the depth above that starts at the same time or before.
+  return ToTimerInfo(chain->GetLastStartingBefore(std::max(timer.start(), timer.start() + 1)));
+}
+
+const TimerInfo* CompactTimerData::GetDown(const TimerInfo& timer) const {
+  absl::MutexLock lock(&mutex_);
+  const CompactTimerChain* chain = GetChain(timer.depth() + 1);
+  if (chain == nullptr) return nullptr;
+  // The first child is the first timer of the depth below that starts at the same time or after,
+  // as long as it's enclosed in `timer`.
+  std::optional<TimerView> first_child = chain->GetFirstStartingAtOrAfter(timer.start());
+  if (!first_child.has_value() || first_child->end() > timer.end()) return nullptr;
+  return ToTimerInfo(first_child);
+}
+
+size_t CompactTimerData::GetMemoryUsageBytes() const {
+  absl::MutexLock lock(&mutex_);
+  size_t memory_usage_bytes = sizeof(*this);
+  for (const auto& [unused_depth, chain] : chains_) {
+    memory_usage_bytes += chain.GetMemoryUsageBytes();
+  }
+  return memory_usage_bytes;
+}
+
+}  // namespace orbit_client_data
@@ -0,0 +1,351 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/time/clock.h>
+#include <absl/time/time.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ClientData/CompactTimerChain.h"
+#include "ClientData/CompactTimerData.h"
+#include "ClientData/TimerChain.h"
+#include "ClientData/TimerData.h"
+#include "ClientProtos/capture_data.pb.h"
+#include "OrbitBase/Logging.h"
+
+namespace orbit_client_data {
+
+using orbit_client_protos::TimerInfo;
+
+namespace {
+
+TimerInfo MakeTimer(uint64_t start, uint64_t end, uint32_t depth = 0) {
+  TimerInfo timer_info;
+  timer_info.set_start(start);
+  timer_info.set_end(end);
+  timer_info.set_depth(depth);
+  timer_info.set_process_id(42);
+  timer_info.set_thread_id(43);
+  timer_info.set_function_id(7);
+  timer_info.set_type(TimerInfo::kNone);
+  return timer_info;
+}
+
+[[nodiscard]] std::vector<const TimerInfo*> ToTimerInfoPointers(
+    const std::vector<TimerView>& timers) {
+  std::vector<const TimerInfo*> timer_infos;
+  for (const TimerView& timer : timers) {
+    timer_infos.push_back(&timer.GetTimerInfo());
+  }
+  return timer_infos;
+}
+
+void ExpectSameTimer(const TimerView& timer_view, const TimerInfo& expected) {
+  const TimerInfo actual = timer_view.ToTimerInfo();
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(actual, expected))
+      << actual.DebugString() << "vs\n"
+      << expected.DebugString();
+  EXPECT_EQ(timer_view.start(), expected.start());
+  EXPECT_EQ(timer_view.end(), expected.end());
+  EXPECT_EQ(timer_view.depth(), expected.depth());
+  EXPECT_EQ(timer_view.function_id(), expected.function_id());
+  EXPECT_EQ(timer_view.thread_id(), expected.thread_id());
+  EXPECT_EQ(timer_view.process_id(), expected.process_id());
+  EXPECT_EQ(timer_view.processor(), expected.processor());
+  EXPECT_EQ(timer_view.type(), expected.type());
+}
+
+}  // namespace
+
+TEST(CompactTimerChain, TimersAreStoredWithAllTheirFields) {
+  std::vector<TimerInfo> timers;
+  timers.push_back(MakeTimer(1000, 2000));
+
+  TimerInfo timer_with_large_values = MakeTimer(1500, 1500 + (1ULL << 40), 300);
+  timer_with_large_values.set_function_id(1ULL << 40);
+  timer_with_large_values.set_processor(-1);
+  timers.push_back(timer_with_large_values);
+
+  TimerInfo api_scope_timer = MakeTimer(1600, 1700);
+  api_scope_timer.set_type(TimerInfo::kApiScope);
+  api_scope_timer.set_api_scope_name("name");
+  api_scope_timer.set_group_id(3);
+  api_scope_timer.mutable_color()->set_red(255);
+  timers.push_back(api_scope_timer);
+
+  TimerInfo timer_with_registers = MakeTimer(1700, 1800);
+  timer_with_registers.add_registers(1);
+  timer_with_registers.add_registers(2);
+  timers.push_back(timer_with_registers);
+
+  TimerInfo core_activity_timer = MakeTimer(1800, 1900);
+  core_activity_timer.set_type(TimerInfo::kCoreActivity);
+  core_activity_timer.set_processor(63);
+  timers.push_back(core_activity_timer);
+
+  // Starts too long after the first timer for its offset to fit in the block.
+  timers.push_back(MakeTimer(1000 + (1ULL << 33), 2000 + (1ULL << 33)));
+  // Starts before the first timer of the block.
+  timers.push_back(MakeTimer(500, 600));
+
+  CompactTimerChain chain;
+  std::vector<TimerView> timer_views;
+  for (const TimerInfo& timer : timers) {
+    timer_views.push_back(chain.Append(timer, timer.depth()));
+  }
+  EXPECT_EQ(chain.size(), timers.size());
+  EXPECT_EQ(chain.GetBlocks().size(), 3);
+
+  for (size_t i = 0; i < timers.size(); ++i) {
+    ExpectSameTimer(timer_views[i], timers[i]);
+  }
+}
+
+TEST(CompactTimerChain, BlocksAreFilledUpToTheirCapacity) {
+  CompactTimerChain chain;
+  constexpr uint64_t kTimerCount = 2 * CompactTimerBlock::kCapacity + 1;
+  for (uint64_t i = 0; i < kTimerCount; ++i) {
+    (void)chain.Append(MakeTimer(10 * i, 10 * i + 5), 0);
+  }
+  ASSERT_EQ(chain.GetBlocks().size(), 3);
+  EXPECT_EQ(chain.GetBlocks()[0]->size(), CompactTimerBlock::kCapacity);
+  EXPECT_EQ(chain.GetBlocks()[1]->size(), CompactTimerBlock::kCapacity);
+  EXPECT_EQ(chain.GetBlocks()[2]->size(), 1);
+
+  const CompactTimerBlock& second_block = *chain.GetBlocks()[1];
+  EXPECT_EQ(second_block.MinTimestamp(), 10 * CompactTimerBlock::kCapacity);
+  EXPECT_EQ(second_block.MaxTimestamp(), 10 * (2 * CompactTimerBlock::kCapacity - 1) + 5);
+  std::optional<TimerView> lower_bound = second_block.LowerBound(10 * 1500 + 6);
+  ASSERT_TRUE(lower_bound.has_value());
+  EXPECT_EQ(lower_bound->start(), 10 * 1501);
+  EXPECT_FALSE(second_block.LowerBound(second_block.MaxTimestamp() + 1).has_value());
+
+  // A simple timer takes much less memory than a TimerInfo.
+  EXPECT_LT(chain.GetMemoryUsageBytes() / kTimerCount, 40);
+  EXPECT_LT(chain.GetMemoryUsageBytes() / kTimerCount, sizeof(TimerInfo));
+}
+
+TEST(CompactTimerData, IsEmpty) {
+  CompactTimerData timer_data;
+  EXPECT_TRUE(timer_data.IsEmpty());
+  EXPECT_EQ(timer_data.GetNumberOfTimers(), 0);
+  EXPECT_EQ(timer_data.GetMaxTime(), std::numeric_limits<uint64_t>::min());
+  EXPECT_EQ(timer_data.GetMinTime(), std::numeric_limits<uint64_t>::max());
+  EXPECT_TRUE(timer_data.GetTimers().empty());
+  EXPECT_TRUE(timer_data.GetTimersAtDepthDiscretized(0, 100, 0, 1000).empty());
+}
+
+TEST(CompactTimerData, QueriesMatchTimerData) {
+  TimerData timer_data;
+  CompactTimerData compact_timer_data;
+  // Three depths with timers of different lengths and gaps, some of them in the side table.
+  for (uint32_t depth = 0; depth < 3; ++depth) {
+    uint64_t start = 100 * depth;
+    for (uint64_t i = 0; i < 3000; ++i) {
+      const uint64_t duration = 1 + (i * 7 + depth) % 50;
+      TimerInfo timer = MakeTimer(start, start + duration, depth);
+      if (i % 100 == 0) timer.set_user_data_key(i);
+      timer_data.AddTimer(timer, depth);
+      (void)compact_timer_data.AddTimer(timer, depth);
+      start += duration + (i % 3) * 20;
+    }
+  }
+
+  EXPECT_EQ(compact_timer_data.GetNumberOfTimers(), timer_data.GetNumberOfTimers());
+  EXPECT_EQ(compact_timer_data.GetMinTime(), timer_data.GetMinTime());
+  EXPECT_EQ(compact_timer_data.GetMaxTime(), timer_data.GetMaxTime());
+  EXPECT_EQ(compact_timer_data.GetDepth(), timer_data.GetDepth());
+  EXPECT_EQ(compact_timer_data.GetProcessId(), timer_data.GetProcessId());
+
+  auto expect_same_timers = [](const std::vector<TimerView>& actual,
+                               const std::vector<const TimerInfo*>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      ExpectSameTimer(actual[i], *expected[i]);
+    }
+  };
+
+  for (bool exclusive : {false, true}) {
+    expect_same_timers(compact_timer_data.GetTimerViews(20'000, 50'000, exclusive),
+                       timer_data.GetTimers(20'000, 50'000, exclusive));
+  }
+  for (uint32_t depth = 0; depth < 4; ++depth) {
+    for (uint32_t resolution : {1, 100, 10'000}) {
+      expect_same_timers(
+          compact_timer_data.GetTimerViewsAtDepthDiscretized(depth, resolution, 1'000, 90'000),
+          timer_data.GetTimersAtDepthDiscretized(depth, resolution, 1'000, 90'000));
+    }
+  }
+
+  for (uint64_t time : {0, 5'000, 77'777, 1'000'000}) {
+    const TimerInfo* after = timer_data.GetFirstAfterStartTime(time, 1);
+    std::optional<TimerView> compact_after = compact_timer_data.GetFirstAfterStartTime(time, 1);
+    ASSERT_EQ(compact_after.has_value(), after != nullptr);
+    if (after != nullptr) ExpectSameTimer(compact_after.value(), *after);
+
+    const TimerInfo* before = timer_data.GetFirstBeforeStartTime(time, 1);
+    std::optional<TimerView> compact_before = compact_timer_data.GetFirstBeforeStartTime(time, 1);
+    ASSERT_EQ(compact_before.has_value(), before != nullptr);
+    if (before != nullptr) ExpectSameTimer(compact_before.value(), *before);
+  }
+}
+
+TEST(CompactTimerData, TimerInfosAreMaterializedOnce) {
+  CompactTimerData compact_timer_data;
+  const TimerInfo simple_timer = MakeTimer(100, 200);
+  TimerInfo timer_with_registers = MakeTimer(300, 400);
+  timer_with_registers.add_registers(1);
+  (void)compact_timer_data.AddTimer(simple_timer);
+  (void)compact_timer_data.AddTimer(timer_with_registers);
+  const size_t memory_usage_before_queries = compact_timer_data.GetMemoryUsageBytes();
+
+  const std::vector<const TimerInfo*> timers = compact_timer_data.GetTimers();
+  ASSERT_EQ(timers.size(), 2);
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(*timers[0], simple_timer));
+  EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(*timers[1], timer_with_registers));
+  EXPECT_GT(compact_timer_data.GetMemoryUsageBytes(), memory_usage_before_queries);
+
+  // Later queries return the same TimerInfos.
+  const size_t memory_usage_after_first_query = compact_timer_data.GetMemoryUsageBytes();
+  EXPECT_EQ(compact_timer_data.GetTimers(), timers);
+  EXPECT_EQ(compact_timer_data.GetTimersAtDepthDiscretized(0, 1000, 0, 1000), timers);
+  EXPECT_EQ(compact_timer_data.GetMemoryUsageBytes(), memory_usage_after_first_query);
+}
+
+TEST(CompactTimerData, GetLeftRightUpDown) {
+  CompactTimerData compact_timer_data;
+  // [0, 100] and [200, 300] at depth 0, [200, 250] and [250, 300] at depth 1.
+  (void)compact_timer_data.AddTimer(MakeTimer(0, 100, 0), 0);
+  (void)compact_timer_data.AddTimer(MakeTimer(200, 300, 0), 0);
+  (void)compact_timer_data.AddTimer(MakeTimer(200, 250, 1), 1);
+  (void)compact_timer_data.AddTimer(MakeTimer(250, 300, 1), 1);
+  EXPECT_EQ(compact_timer_data.GetDepth(), 2);
+
+  const std::vector<const TimerInfo*> depth_0 =
+      ToTimerInfoPointers(compact_timer_data.GetTimerViewsAtDepth(0, 0, 1000, false));
+  const std::vector<const TimerInfo*> depth_1 =
+      ToTimerInfoPointers(compact_timer_data.GetTimerViewsAtDepth(1, 0, 1000, false));
+  ASSERT_EQ(depth_0.size(), 2);
+  ASSERT_EQ(depth_1.size(), 2);
+
+  EXPECT_EQ(compact_timer_data.GetLeft(*depth_0[0]), nullptr);
+  EXPECT_EQ(compact_timer_data.GetRight(*depth_0[0]), depth_0[1]);
+  EXPECT_EQ(compact_timer_data.GetLeft(*depth_0[1]), depth_0[0]);
+  EXPECT_EQ(compact_timer_data.GetRight(*depth_0[1]), nullptr);
+  EXPECT_EQ(compact_timer_data.GetDown(*depth_0[0]), nullptr);
+  EXPECT_EQ(compact_timer_data.GetDown(*depth_0[1]), depth_1[0]);
+  EXPECT_EQ(compact_timer_data.GetUp(*depth_0[1]), nullptr);
+  EXPECT_EQ(compact_timer_data.GetUp(*depth_1[0]), depth_0[1]);
+  EXPECT_EQ(compact_timer_data.GetUp(*depth_1[1]), depth_0[1]);
+  EXPECT_EQ(compact_timer_data.GetRight(*depth_1[0]), depth_1[1]);
+
+  // A timer that isn't in the CompactTimerData has no neighbors at its own depth.
+  const TimerInfo unknown_timer = MakeTimer(0, 50, 0);
+  EXPECT_EQ(compact_timer_data.GetLeft(unknown_timer), nullptr);
+  EXPECT_EQ(compact_timer_data.GetRight(unknown_timer), nullptr);
+}
+
+TEST(CompactTimerData, ForEachTimer) {
+  CompactTimerData compact_timer_data;
+  for (uint64_t i = 0; i < 3 * CompactTimerBlock::kCapacity; ++i) {
+    (void)compact_timer_data.AddTimer(MakeTimer(10 * i, 10 * i + 5, 0), 0);
+    (void)compact_timer_data.AddTimer(MakeTimer(10 * i, 10 * i + 2, 1), 1);
+  }
+
+  uint64_t num_timers = 0;
+  compact_timer_data.ForEachTimer(1'003, 2'003, [&num_timers](const TimerView& timer) {
+    EXPECT_LE(timer.start(), 2'003);
+    EXPECT_GE(timer.end(), 1'003);
+    ++num_timers;
+  });
+  // 101 timers at depth 0, from [1000, 1005], and 100 at depth 1, from [1010, 1012].
+  EXPECT_EQ(num_timers, 201);
+  // The visitor doesn't materialize TimerInfos.
+  const size_t memory_usage = compact_timer_data.GetMemoryUsageBytes();
+  compact_timer_data.ForEachTimer(0, std::numeric_limits<uint64_t>::max(),
+                                  [](const TimerView& /*timer*/) {});
+  EXPECT_EQ(compact_timer_data.GetMemoryUsageBytes(), memory_usage);
+}
+
+// Not a real benchmark, but it logs the memory used per timer, and how many
+// GetTimersAtDepthDiscretized queries per second TimerData and CompactTimerData answer, for a
+// capture with many simple timers on a single thread. Start the test binary with
+// `--gtest_filter=CompactTimerData.DISABLED_MemoryPerTimerAndDiscretizedQueriesPerSecond
+// --gtest_also_run_disabled_tests` to run it.
+TEST(CompactTimerData, DISABLED_MemoryPerTimerAndDiscretizedQueriesPerSecond) {
+  constexpr uint64_t kNumTimers = 2'000'000;
+  constexpr int kNumQueries = 2000;
+  constexpr uint32_t kResolution = 2000;
+  constexpr uint64_t kTimerPeriodNs = 1000;
+
+  auto timer_data = std::make_unique<TimerData>(/*build_timer_pyramids=*/false);
+  CompactTimerData compact_timer_data;
+  for (uint64_t i = 0; i < kNumTimers; ++i) {
+    const TimerInfo timer = MakeTimer(kTimerPeriodNs * i, kTimerPeriodNs * i + 600);
+    timer_data->AddTimer(timer);
+    (void)compact_timer_data.AddTimer(timer);
+  }
+
+  // TimerData doesn't report its memory usage, so count the TimerInfos and their TimerBlocks.
+  size_t timer_data_bytes = 0;
+  for (const TimerChain* chain : timer_data->GetChains()) {
+    for (const TimerBlock& block : *chain) {
+      timer_data_bytes += sizeof(block);
+      for (uint64_t i = 0; i < block.size(); ++i) {
+        timer_data_bytes += block[i].SpaceUsedLong();
+      }
+    }
+  }
+
+  auto measure_queries_per_second = [&](auto query) {
+    const uint64_t range_ns = kNumTimers * kTimerPeriodNs / 10;
+    size_t num_timers_found = 0;
+    const absl::Time start = absl::Now();
+    for (int i = 0; i < kNumQueries; ++i) {
+      // Pan over the capture, with a tenth of it visible.
+      const uint64_t start_ns = (i * range_ns / 100) % (9 * range_ns);
+      num_timers_found += query(start_ns, start_ns + range_ns);
+    }
+    const double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+    EXPECT_GT(num_timers_found, 0);
+    return kNumQueries / seconds;
+  };
+  const double timer_data_queries_per_second =
+      measure_queries_per_second([&](uint64_t start_ns, uint64_t end_ns) {
+        return timer_data->GetTimersAtDepthDiscretized(0, kResolution, start_ns, end_ns).size();
+      });
+  const double compact_timer_data_queries_per_second =
+      measure_queries_per_second([&](uint64_t start_ns, uint64_t end_ns) {
+        return compact_timer_data
+            .GetTimerViewsAtDepthDiscretized(0, kResolution, start_ns, end_ns)
+            .size();
+      });
+  const size_t compact_timer_data_bytes = compact_timer_data.GetMemoryUsageBytes();
+  // The TimerDataInterface query, as used by the tracks, materializes the timers it returns.
+  const double compact_timer_data_pointer_queries_per_second =
+      measure_queries_per_second([&](uint64_t start_ns, uint64_t end_ns) {
+        return compact_timer_data.GetTimersAtDepthDiscretized(0, kResolution, start_ns, end_ns)
+            .size();
+      });
+
+  ORBIT_LOG("TimerData: %.1f bytes per timer, %.0f queries per second",
+            static_cast<double>(timer_data_bytes) / kNumTimers, timer_data_queries_per_second);
+  ORBIT_LOG("CompactTimerData: %.1f bytes per timer, %.0f queries per second",
+            static_cast<double>(compact_timer_data_bytes) / kNumTimers,
+            compact_timer_data_queries_per_second);
+  ORBIT_LOG(
+      "CompactTimerData with TimerInfo pointers: %.1f bytes per timer after the queries, %.0f "
+      "queries per second",
+      static_cast<double>(compact_timer_data.GetMemoryUsageBytes()) / kNumTimers,
+      compact_timer_data_pointer_queries_per_second);
+}
+
+}  // namespace orbit_client_data
@@ -4,152 +4,417 @@
 
 #include <ClientData/ScopeTreeTimerData.h>
 #include <absl/container/btree_map.h>
+#include <absl/types/span.h>
 
 #include <algorithm>
+#include <thread>
 #include <utility>
 
 #include "ApiInterface/Orbit.h"
+#include "ClientData/CompactTimerData.h"
 #include "ClientData/FastRenderingUtils.h"
 #include "ClientData/TimerData.h"
 #include "OrbitBase/Logging.h"
 
 namespace orbit_client_data {
 
+using orbit_client_protos::TimerInfo;
+
+namespace {
+
+// ScopeTree has a root node in depth 0 which shouldn't be considered.
+[[nodiscard]] size_t GetNumberOfScopes(const orbit_containers::ScopeTree<const TimerInfo>& tree) {
+  return tree.Size() - 1;
+}
+
+[[nodiscard]] size_t GetNumberOfScopes(
+    const orbit_containers::FlatScopeTree<const TimerInfo>& tree) {
+  return tree.Size();
+}
+
+[[nodiscard]] std::vector<const TimerInfo*> GetScopesAtDepth(
+    const orbit_containers::ScopeTree<const TimerInfo>& tree, uint32_t depth, uint64_t start_ns,
+    uint64_t end_ns) {
+  std::vector<const TimerInfo*> all_timers_at_depth;
+  const auto& ordered_nodes = tree.GetOrderedNodesAtDepth(depth);
+  if (ordered_nodes.empty()) return all_timers_at_depth;
+
+  auto first_node_to_draw = ordered_nodes.upper_bound(start_ns);
+  if (first_node_to_draw != ordered_nodes.begin()) --first_node_to_draw;
+
+  // If this node is strictly before the range, we shouldn't include it.
+  if (first_node_to_draw->second->GetScope()->end() < start_ns) ++first_node_to_draw;
+
+  for (auto it = first_node_to_draw; it != ordered_nodes.end() && it->first < end_ns; ++it) {
+    all_timers_at_depth.push_back(it->second->GetScope());
+  }
+  return all_timers_at_depth;
+}
+
+[[nodiscard]] std::vector<const TimerInfo*> GetScopesAtDepth(
+    const orbit_containers::FlatScopeTree<const TimerInfo>& tree, uint32_t depth, uint64_t start_ns,
+    uint64_t end_ns) {
+  absl::Span<const uint64_t> starts = tree.GetOrderedStartsAtDepth(depth);
+  absl::Span<const TimerInfo* const> scopes = tree.GetOrderedScopesAtDepth(depth);
+  if (scopes.empty()) return {};
+
+  size_t first_index_to_draw =
+      std::upper_bound(starts.begin(), starts.end(), start_ns) - starts.begin();
+  if (first_index_to_draw != 0) --first_index_to_draw;
+
+  // If this scope is strictly before the range, we shouldn't include it.
+  if (scopes[first_index_to_draw]->end() < start_ns) ++first_index_to_draw;
+
+  size_t end_index = std::lower_bound(starts.begin(), starts.end(), end_ns) - starts.begin();
+  if (end_index <= first_index_to_draw) return {};
+  return {scopes.begin() + first_index_to_draw, scopes.begin() + end_index};
+}
+
+[[nodiscard]] std::vector<const TimerInfo*> GetScopesAtDepthExclusive(
+    const orbit_containers::ScopeTree<const TimerInfo>& tree, uint32_t depth, uint64_t start_ns,
+    uint64_t end_ns) {
+  std::vector<const TimerInfo*> all_timers_at_depth;
+  const auto& ordered_nodes = tree.GetOrderedNodesAtDepth(depth);
+  if (ordered_nodes.empty()) return all_timers_at_depth;
+
+  auto node_it = ordered_nodes.upper_bound(start_ns);
+  // Include node if node.start() == start_ns.
+  if (node_it != ordered_nodes.begin()) --node_it;
+  if (node_it->second->GetScope()->start() < start_ns) ++node_it;
+
+  for (auto it = node_it; it != ordered_nodes.end() && it->second->End() < end_ns; ++it) {
+    all_timers_at_depth.push_back(it->second->GetScope());
+  }
+  return all_timers_at_depth;
+}
+
+[[nodiscard]] std::vector<const TimerInfo*> GetScopesAtDepthExclusive(
+    const orbit_containers::FlatScopeTree<const TimerInfo>& tree, uint32_t depth, uint64_t start_ns,
+    uint64_t end_ns) {
+  std::vector<const TimerInfo*> all_timers_at_depth;
+  absl::Span<const uint64_t> starts = tree.GetOrderedStartsAtDepth(depth);
+  absl::Span<const TimerInfo* const> scopes = tree.GetOrderedScopesAtDepth(depth);
+
+  // Include the scopes with start() == start_ns.
+  for (size_t index = std::lower_bound(starts.begin(), starts.end(), start_ns) - starts.begin();
+       index < scopes.size() && scopes[index]->end() < end_ns; ++index) {
+    all_timers_at_depth.push_back(scopes[index]);
+  }
+  return all_timers_at_depth;
+}
+
+[[nodiscard]] std::vector<const TimerInfo*> GetAllTimers(const TimerData& timer_data) {
+  std::vector<const TimerInfo*> timers;
+  timers.reserve(timer_data.GetNumberOfTimers());
+  for (const TimerChain* timer_chain : timer_data.GetChains()) {
+    ORBIT_CHECK(timer_chain != nullptr);
+    for (const auto& block : *timer_chain) {
+      for (size_t k = 0; k < block.size(); ++k) {
+        timers.push_back(&block[k]);
+      }
+    }
+  }
+  return timers;
+}
+
+[[nodiscard]] std::vector<const TimerInfo*> ToTimerInfos(const std::vector<TimerView>& timers) {
+  std::vector<const TimerInfo*> timer_infos;
+  timer_infos.reserve(timers.size());
+  for (const TimerView& timer : timers) {
+    timer_infos.push_back(&timer.GetTimerInfo());
+  }
+  return timer_infos;
+}
+
+}  // namespace
+
+ScopeTreeTimerData::ScopeTreeTimerData(int64_t thread_id,
+                                       ScopeTreeUpdateType scope_tree_update_type)
+    : thread_id_(thread_id), scope_tree_update_type_(scope_tree_update_type) {
+  if (scope_tree_update_type_ == ScopeTreeUpdateType::kAlways) {
+    live_scope_trees_[0] = std::make_unique<LiveScopeTree>();
+    live_scope_trees_[1] = std::make_unique<LiveScopeTree>();
+  }
+}
+
+template <typename Query>
+std::invoke_result_t<Query, const ScopeTreeTimerData::CompleteScopeTree&>
+ScopeTreeTimerData::ReadScopeTree(Query&& query) const {
+  // Used before OnCaptureComplete with kOnCaptureComplete, and always with kNever.
+  static const CompleteScopeTree kEmptyScopeTree;
+  if (scope_tree_update_type_ != ScopeTreeUpdateType::kAlways) return query(kEmptyScopeTree);
+
+  while (true) {
+    const uint32_t index = published_live_scope_tree_index_.load();
+    std::atomic<uint32_t>& reader_count = live_scope_tree_reader_counts_[index];
+    ++reader_count;
+    // AddTimer and OnCaptureComplete only modify or free a live copy after publishing the other one
+    // and then seeing no readers on it, so checking again after registering as a reader guarantees
+    // that this copy stays untouched until we unregister.
+    if (published_live_scope_tree_index_.load() == index) {
+      auto result = query(*live_scope_trees_[index]);
+      --reader_count;
+      return result;
+    }
+    // AddTimer published the other copy in the meantime.
+    --reader_count;
+  }
+}
+
+void ScopeTreeTimerData::WaitForLiveScopeTreeReaders(uint32_t index) const {
+  // Queries only hold a copy for the duration of a single query.
+  while (live_scope_tree_reader_counts_[index].load() != 0) {
+    std::this_thread::yield();
+  }
+}
+
 const orbit_client_protos::TimerInfo& ScopeTreeTimerData::AddTimer(
     orbit_client_protos::TimerInfo timer_info, uint32_t /*depth*/) {
+  if (process_id_ == orbit_base::kInvalidProcessId) {
+    process_id_ = timer_info.process_id();
+  }
+  min_time_ = std::min(min_time_.load(), timer_info.start());
+  max_time_ = std::max(max_time_.load(), timer_info.end());
+
+  if (capture_complete_ && scope_tree_update_type_ != ScopeTreeUpdateType::kNever) {
+    // The trees, or the CompactTimerData, aren't updated anymore: keep the timer, so that the
+    // returned reference stays valid, but it won't be returned by the queries.
+    ORBIT_ERROR_ONCE("Timer of thread %d added after the capture was complete", thread_id_);
+    if (timer_data_ == nullptr) {
+      timer_data_ = std::make_unique<TimerData>(/*build_timer_pyramids=*/false);
+    }
+    return timer_data_->AddTimer(std::move(timer_info), /*unused_depth=*/0);
+  }
+
   // We don't need to have one TimerChain per depth because it's managed by ScopeTree.
-  const auto& timer_info_ref = timer_data_.AddTimer(std::move(timer_info), /*unused_depth=*/0);
+  const auto& timer_info_ref = timer_data_->AddTimer(std::move(timer_info), /*unused_depth=*/0);
 
   if (scope_tree_update_type_ == ScopeTreeUpdateType::kAlways) {
-    absl::MutexLock lock(&scope_tree_mutex_);
-    scope_tree_.Insert(&timer_info_ref);
+    timers_missing_from_both_scope_trees_.push_back(&timer_info_ref);
+
+    // Don't wait for the queries still reading the copy to update: the timers stay pending until
+    // the next call, or until OnCaptureComplete.
+    const uint32_t unpublished_index = 1 - published_live_scope_tree_index_.load();
+    if (live_scope_tree_reader_counts_[unpublished_index].load() == 0) {
+      LiveScopeTree& unpublished_scope_tree = *live_scope_trees_[unpublished_index];
+      for (const TimerInfo* timer : timers_missing_from_unpublished_scope_tree_) {
+        unpublished_scope_tree.Insert(timer);
+      }
+      for (const TimerInfo* timer : timers_missing_from_both_scope_trees_) {
+        unpublished_scope_tree.Insert(timer);
+      }
+      published_live_scope_tree_index_.store(unpublished_index);
+      // The copy that was published until now only misses the timers we just added.
+      timers_missing_from_unpublished_scope_tree_.swap(timers_missing_from_both_scope_trees_);
+      timers_missing_from_both_scope_trees_.clear();
+    }
   }
   return timer_info_ref;
 }
 
+void ScopeTreeTimerData::MoveTimersToCompactTimerData() {
+  ORBIT_SCOPE_FUNCTION;
+
+  // The FlatScopeTree computes the depths and sorts the timers of each depth, which is what
+  // CompactTimerData needs. It's only kept until the timers are copied.
+  auto compact_timer_data = std::make_unique<CompactTimerData>();
+  {
+    const CompleteScopeTree scope_tree{GetAllTimers(*timer_data_)};
+    for (uint32_t depth = 0; depth < scope_tree.Depth(); ++depth) {
+      for (const TimerInfo* timer : scope_tree.GetOrderedScopesAtDepth(depth)) {
+        compact_timer_data->AddTimer(*timer, depth);
+      }
+    }
+  }
+  compact_timer_data_ = std::move(compact_timer_data);
+  published_compact_timer_data_.store(compact_timer_data_.get());
+  // Queries don't read the TimerData with kOnCaptureComplete.
+  timer_data_.reset();
+}
+
+void ScopeTreeTimerData::KeepOnlyPublishedLiveScopeTree() {
+  // Bring the copy that isn't published up to date and publish it. No more timers are inserted
+  // after that, so the other copy can be freed.
+  const uint32_t unpublished_index = 1 - published_live_scope_tree_index_.load();
+  WaitForLiveScopeTreeReaders(unpublished_index);
+  LiveScopeTree& unpublished_scope_tree = *live_scope_trees_[unpublished_index];
+  for (const TimerInfo* timer : timers_missing_from_unpublished_scope_tree_) {
+    unpublished_scope_tree.Insert(timer);
+  }
+  for (const TimerInfo* timer : timers_missing_from_both_scope_trees_) {
+    unpublished_scope_tree.Insert(timer);
+  }
+  published_live_scope_tree_index_.store(unpublished_index);
+  timers_missing_from_unpublished_scope_tree_ = {};
+  timers_missing_from_both_scope_trees_ = {};
+
+  const uint32_t previously_published_index = 1 - unpublished_index;
+  WaitForLiveScopeTreeReaders(previously_published_index);
+  live_scope_trees_[previously_published_index].reset();
+}
+
 void ScopeTreeTimerData::OnCaptureComplete() {
-  // Build ScopeTree from timer chains, when we are loading a capture.
-  if (scope_tree_update_type_ != ScopeTreeUpdateType::kOnCaptureComplete) return;
+  if (capture_complete_) return;
+  capture_complete_ = true;
+
+  switch (scope_tree_update_type_) {
+    case ScopeTreeUpdateType::kAlways:
+      KeepOnlyPublishedLiveScopeTree();
+      break;
+    case ScopeTreeUpdateType::kOnCaptureComplete:
+      MoveTimersToCompactTimerData();
+      break;
+    case ScopeTreeUpdateType::kNever:
+      break;
+  }
+}
 
-  std::vector<const TimerChain*> timer_chains = timer_data_.GetChains();
-  for (const TimerChain* timer_chain : timer_chains) {
+std::vector<const TimerChain*> ScopeTreeTimerData::GetChains() const {
+  if (scope_tree_update_type_ == ScopeTreeUpdateType::kOnCaptureComplete) return {};
+  return timer_data_->GetChains();
+}
+
+void ScopeTreeTimerData::ForEachTimer(uint64_t start_ns, uint64_t end_ns,
+                                      absl::FunctionRef<void(const TimerView&)> visitor) const {
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) {
+    compact_timer_data->ForEachTimer(start_ns, end_ns, visitor);
+    return;
+  }
+  for (const TimerChain* timer_chain : GetChains()) {
     ORBIT_CHECK(timer_chain != nullptr);
-    absl::MutexLock lock(&scope_tree_mutex_);
     for (const auto& block : *timer_chain) {
+      if (!block.Intersects(start_ns, end_ns)) continue;
       for (size_t k = 0; k < block.size(); ++k) {
-        scope_tree_.Insert(&block[k]);
+        const TimerInfo& timer_info = block[k];
+        if (timer_info.start() <= end_ns && timer_info.end() >= start_ns) {
+          visitor(TimerView{&timer_info});
+        }
       }
     }
   }
 }
 
+size_t ScopeTreeTimerData::GetNumberOfTimers() const {
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) return compact_timer_data->GetNumberOfTimers();
+  return ReadScopeTree([](const auto& tree) { return GetNumberOfScopes(tree); });
+}
+
+uint32_t ScopeTreeTimerData::GetDepth() const {
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) return compact_timer_data->GetDepth();
+  return ReadScopeTree([](const auto& tree) { return tree.Depth(); });
+}
+
 std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimers(
     uint64_t start_ns, uint64_t end_ns, bool exclusive) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimers", kOrbitColorAmber);
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) {
+    return compact_timer_data->GetTimers(start_ns, end_ns, exclusive);
+  }
+
   // The query is for the interval [start_ns, end_ns], but it's easier to work with the close-open
   // interval [start_ns, end_ns+1). We have to be careful with overflowing.
   end_ns = std::max(end_ns, end_ns + 1);
-  std::vector<const orbit_client_protos::TimerInfo*> all_timers;
-
-  for (uint32_t depth = 0; depth < GetDepth(); ++depth) {
-    std::vector<const orbit_client_protos::TimerInfo*> timers_at_depth =
-        exclusive ? GetTimersAtDepthExclusive(depth, start_ns, end_ns)
-                  : GetTimersAtDepth(depth, start_ns, end_ns);
-    all_timers.insert(all_timers.end(), timers_at_depth.begin(), timers_at_depth.end());
-  }
 
-  return all_timers;
+  return ReadScopeTree([start_ns, end_ns, exclusive](const auto& tree) {
+    std::vector<const TimerInfo*> all_timers;
+    for (uint32_t depth = 0; depth < tree.Depth(); ++depth) {
+      std::vector<const TimerInfo*> timers_at_depth =
+          exclusive ? GetScopesAtDepthExclusive(tree, depth, start_ns, end_ns)
+                    : GetScopesAtDepth(tree, depth, start_ns, end_ns);
+      all_timers.insert(all_timers.end(), timers_at_depth.begin(), timers_at_depth.end());
+    }
+    return all_timers;
+  });
 }
 
 std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimersAtDepthExclusive(
     uint32_t depth, uint64_t start_ns, uint64_t end_ns) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthExclusive", kOrbitColorGreen);
-  std::vector<const orbit_client_protos::TimerInfo*> all_timers_at_depth;
-  absl::MutexLock lock(&scope_tree_mutex_);
-
-  const auto& ordered_nodes = scope_tree_.GetOrderedNodesAtDepth(depth);
-  if (ordered_nodes.empty()) return all_timers_at_depth;
-
-  auto node_it = ordered_nodes.upper_bound(start_ns);
-  // Include node if node.start() == start_ns.
-  if (node_it != ordered_nodes.begin()) --node_it;
-  if (node_it->second->GetScope()->start() < start_ns) ++node_it;
-
-  for (auto it = node_it; it != ordered_nodes.end() && it->second->End() < end_ns; ++it) {
-    all_timers_at_depth.push_back(it->second->GetScope());
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) {
+    // CompactTimerData takes the inclusive interval [start_ns, end_ns - 1].
+    if (end_ns == 0) return {};
+    return ToTimerInfos(
+        compact_timer_data->GetTimerViewsAtDepth(depth, start_ns, end_ns - 1, /*exclusive=*/true));
   }
-
-  return all_timers_at_depth;
+  return ReadScopeTree([depth, start_ns, end_ns](const auto& tree) {
+    return GetScopesAtDepthExclusive(tree, depth, start_ns, end_ns);
+  });
 }
 
 std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimersAtDepth(
     uint32_t depth, uint64_t start_ns, uint64_t end_ns) const {
-  std::vector<const orbit_client_protos::TimerInfo*> all_timers_at_depth;
-  absl::MutexLock lock(&scope_tree_mutex_);
-
-  const auto& ordered_nodes = scope_tree_.GetOrderedNodesAtDepth(depth);
-  if (ordered_nodes.empty()) return all_timers_at_depth;
-
-  auto first_node_to_draw = ordered_nodes.upper_bound(start_ns);
-  if (first_node_to_draw != ordered_nodes.begin()) --first_node_to_draw;
-
-  // If this node is strictly before the range, we shouldn't include it.
-  if (first_node_to_draw->second->GetScope()->end() < start_ns) ++first_node_to_draw;
-
-  for (auto it = first_node_to_draw; it != ordered_nodes.end() && it->first < end_ns; ++it) {
-    all_timers_at_depth.push_back(it->second->GetScope());
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) {
+    // CompactTimerData takes the inclusive interval [start_ns, end_ns - 1].
+    if (end_ns == 0) return {};
+    return ToTimerInfos(
+        compact_timer_data->GetTimerViewsAtDepth(depth, start_ns, end_ns - 1, /*exclusive=*/false));
   }
-
-  return all_timers_at_depth;
+  return ReadScopeTree([depth, start_ns, end_ns](const auto& tree) {
+    return GetScopesAtDepth(tree, depth, start_ns, end_ns);
+  });
 }
 
 std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimersAtDepthDiscretized(
     uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthDiscretized", kOrbitColorAmber);
   if (resolution == 0) return {};
-  absl::MutexLock lock(&scope_tree_mutex_);
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) {
+    return compact_timer_data->GetTimersAtDepthDiscretized(depth, resolution, start_ns, end_ns);
+  }
   // The query is for the interval [start_ns, end_ns], but it's easier to work with the close-open
   // interval [start_ns, end_ns+1). We have to be careful with overflowing.
   end_ns = std::max(end_ns, end_ns + 1);
 
-  std::vector<const orbit_client_protos::TimerInfo*> discretized_timers;
-  const orbit_client_protos::TimerInfo* timer_info =
-      scope_tree_.FindFirstScopeAtOrAfterTime(depth, start_ns);
+  return ReadScopeTree([depth, resolution, start_ns, end_ns](const auto& tree) {
+    std::vector<const TimerInfo*> discretized_timers;
+    const TimerInfo* timer_info = tree.FindFirstScopeAtOrAfterTime(depth, start_ns);
 
-  while (timer_info != nullptr && timer_info->start() < end_ns) {
-    discretized_timers.push_back(timer_info);
+    while (timer_info != nullptr && timer_info->start() < end_ns) {
+      discretized_timers.push_back(timer_info);
 
-    // Use the time of next pixel boundary as a threshold to avoid returning several timers
-    // for the same pixel that will overlap after.
-    uint64_t next_pixel_start_time_ns =
-        GetNextPixelBoundaryTimeNs(timer_info->end(), resolution, start_ns, end_ns);
-    timer_info = scope_tree_.FindFirstScopeAtOrAfterTime(depth, next_pixel_start_time_ns);
-  }
-  return discretized_timers;
+      // Use the time of next pixel boundary as a threshold to avoid returning several timers
+      // for the same pixel that will overlap after.
+      uint64_t next_pixel_start_time_ns =
+          GetNextPixelBoundaryTimeNs(timer_info->end(), resolution, start_ns, end_ns);
+      timer_info = tree.FindFirstScopeAtOrAfterTime(depth, next_pixel_start_time_ns);
+    }
+    return discretized_timers;
+  });
 }
 
 const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetLeft(
     const orbit_client_protos::TimerInfo& timer) const {
-  absl::MutexLock lock(&scope_tree_mutex_);
-  return scope_tree_.FindPreviousScopeAtDepth(timer);
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) return compact_timer_data->GetLeft(timer);
+  return ReadScopeTree([&timer](const auto& tree) { return tree.FindPreviousScopeAtDepth(timer); });
 }
 
 const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetRight(
     const orbit_client_protos::TimerInfo& timer) const {
-  absl::MutexLock lock(&scope_tree_mutex_);
-  return scope_tree_.FindNextScopeAtDepth(timer);
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) return compact_timer_data->GetRight(timer);
+  return ReadScopeTree([&timer](const auto& tree) { return tree.FindNextScopeAtDepth(timer); });
 }
 
 const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetUp(
     const orbit_client_protos::TimerInfo& timer) const {
-  absl::MutexLock lock(&scope_tree_mutex_);
-  return scope_tree_.FindParent(timer);
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) return compact_timer_data->GetUp(timer);
+  return ReadScopeTree([&timer](const auto& tree) { return tree.FindParent(timer); });
 }
 
 const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetDown(
     const orbit_client_protos::TimerInfo& timer) const {
-  absl::MutexLock lock(&scope_tree_mutex_);
-  return scope_tree_.FindFirstChild(timer);
+  const CompactTimerData* compact_timer_data = published_compact_timer_data_.load();
+  if (compact_timer_data != nullptr) return compact_timer_data->GetDown(timer);
+  return ReadScopeTree([&timer](const auto& tree) { return tree.FindFirstChild(timer); });
 }
 
-}  // namespace orbit_client_data
\ No newline at end of file
+}  // namespace orbit_client_data
@@ -6,8 +6,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
+#include <thread>
 #include <vector>
 
+#include "ClientData/CompactTimerChain.h"
 #include "ClientData/ScopeTreeTimerData.h"
 #include "ClientProtos/capture_data.pb.h"
 
@@ -274,4 +277,172 @@ TEST(ScopeTreeTimerData, GetLeftRightUpDown) {
   check_neighbors(down, nullptr, nullptr, nullptr, right);
 }
 
-}  // namespace orbit_client_data
\ No newline at end of file
+TEST(ScopeTreeTimerData, QueriesAreUnchangedByOnCaptureComplete) {
+  ScopeTreeTimerData scope_tree_timer_data;
+  TimersInTest inserted_timers = AddTimersInScopeTreeTimerDataTest(scope_tree_timer_data);
+
+  auto check_queries = [&] {
+    EXPECT_EQ(scope_tree_timer_data.GetNumberOfTimers(), kNumTimers);
+    EXPECT_EQ(scope_tree_timer_data.GetDepth(), kDepth);
+    EXPECT_EQ(scope_tree_timer_data.GetTimers(),
+              (std::vector<const TimerInfo*>{inserted_timers.left, inserted_timers.right,
+                                             inserted_timers.down}));
+    EXPECT_EQ(scope_tree_timer_data.GetTimers(kLeftTimerEnd, kRightTimerEnd),
+              (std::vector<const TimerInfo*>{inserted_timers.left, inserted_timers.right,
+                                             inserted_timers.down}));
+    EXPECT_EQ(scope_tree_timer_data.GetTimers(kLeftTimerStart, kDownTimerStart, /*exclusive=*/true),
+              std::vector<const TimerInfo*>{inserted_timers.left});
+    EXPECT_EQ(scope_tree_timer_data.GetTimersAtDepthDiscretized(0, 1, kMinTimestamp, kMaxTimestamp),
+              std::vector<const TimerInfo*>{inserted_timers.left});
+    EXPECT_EQ(scope_tree_timer_data.GetRight(*inserted_timers.left), inserted_timers.right);
+    EXPECT_EQ(scope_tree_timer_data.GetDown(*inserted_timers.right), inserted_timers.down);
+  };
+
+  check_queries();
+  scope_tree_timer_data.OnCaptureComplete();
+  check_queries();
+}
+
+TEST(ScopeTreeTimerData, TimersAddedAfterOnCaptureCompleteAreKept) {
+  for (ScopeTreeTimerData::ScopeTreeUpdateType update_type :
+       {ScopeTreeTimerData::ScopeTreeUpdateType::kAlways,
+        ScopeTreeTimerData::ScopeTreeUpdateType::kOnCaptureComplete}) {
+    ScopeTreeTimerData scope_tree_timer_data(-1, update_type);
+    AddTimersInScopeTreeTimerDataTest(scope_tree_timer_data);
+    scope_tree_timer_data.OnCaptureComplete();
+
+    TimerInfo late_timer;
+    late_timer.set_start(kMaxTimestamp + 10);
+    late_timer.set_end(kMaxTimestamp + 20);
+    const TimerInfo& added_timer = scope_tree_timer_data.AddTimer(late_timer);
+    EXPECT_EQ(added_timer.start(), late_timer.start());
+    EXPECT_EQ(scope_tree_timer_data.GetMaxTime(), late_timer.end());
+
+    EXPECT_EQ(scope_tree_timer_data.GetNumberOfTimers(), kNumTimers);
+    EXPECT_EQ(scope_tree_timer_data.GetTimers().size(), kNumTimers);
+    scope_tree_timer_data.OnCaptureComplete();
+    EXPECT_EQ(scope_tree_timer_data.GetTimers().size(), kNumTimers);
+  }
+}
+
+TEST(ScopeTreeTimerData, LoadedCaptureQueriesMatchLiveCapture) {
+  ScopeTreeTimerData live_timer_data;
+  AddTimersInScopeTreeTimerDataTest(live_timer_data);
+  live_timer_data.OnCaptureComplete();
+  ScopeTreeTimerData loaded_timer_data(-1,
+                                       ScopeTreeTimerData::ScopeTreeUpdateType::kOnCaptureComplete);
+  AddTimersInScopeTreeTimerDataTest(loaded_timer_data);
+  loaded_timer_data.OnCaptureComplete();
+
+  // The timers of loaded captures are only in a CompactTimerData, so the pointers differ.
+  auto expect_same_timers = [](const std::vector<const TimerInfo*>& actual,
+                               const std::vector<const TimerInfo*>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      EXPECT_EQ(actual[i]->start(), expected[i]->start());
+      EXPECT_EQ(actual[i]->end(), expected[i]->end());
+      EXPECT_EQ(actual[i]->process_id(), expected[i]->process_id());
+    }
+  };
+
+  EXPECT_TRUE(loaded_timer_data.GetChains().empty());
+  EXPECT_EQ(loaded_timer_data.GetNumberOfTimers(), kNumTimers);
+  EXPECT_EQ(loaded_timer_data.GetDepth(), kDepth);
+  EXPECT_EQ(loaded_timer_data.GetMinTime(), kMinTimestamp);
+  EXPECT_EQ(loaded_timer_data.GetMaxTime(), kMaxTimestamp);
+  EXPECT_EQ(loaded_timer_data.GetProcessId(), kProcessId);
+
+  for (uint64_t start_ns = 0; start_ns <= kMaxTimestamp + 1; ++start_ns) {
+    for (uint64_t end_ns = start_ns; end_ns <= kMaxTimestamp + 1; ++end_ns) {
+      for (bool exclusive : {false, true}) {
+        expect_same_timers(loaded_timer_data.GetTimers(start_ns, end_ns, exclusive),
+                           live_timer_data.GetTimers(start_ns, end_ns, exclusive));
+      }
+      for (uint32_t depth = 0; depth <= kDepth; ++depth) {
+        expect_same_timers(loaded_timer_data.GetTimersAtDepth(depth, start_ns, end_ns),
+                           live_timer_data.GetTimersAtDepth(depth, start_ns, end_ns));
+        expect_same_timers(loaded_timer_data.GetTimersAtDepthExclusive(depth, start_ns, end_ns),
+                           live_timer_data.GetTimersAtDepthExclusive(depth, start_ns, end_ns));
+        expect_same_timers(
+            loaded_timer_data.GetTimersAtDepthDiscretized(depth, 1000, start_ns, end_ns),
+            live_timer_data.GetTimersAtDepthDiscretized(depth, 1000, start_ns, end_ns));
+      }
+    }
+  }
+
+  // Pointers to the timers of loaded captures stay valid and are the same for every query.
+  const std::vector<const TimerInfo*> timers = loaded_timer_data.GetTimers();
+  EXPECT_EQ(loaded_timer_data.GetTimers(), timers);
+  ASSERT_EQ(timers.size(), kNumTimers);
+  const TimerInfo* left = timers[0];
+  const TimerInfo* right = timers[1];
+  const TimerInfo* down = timers[2];
+  EXPECT_EQ(down->start(), kDownTimerStart);
+  EXPECT_EQ(loaded_timer_data.GetRight(*left), right);
+  EXPECT_EQ(loaded_timer_data.GetLeft(*right), left);
+  EXPECT_EQ(loaded_timer_data.GetDown(*right), down);
+  EXPECT_EQ(loaded_timer_data.GetUp(*down), right);
+  EXPECT_EQ(loaded_timer_data.GetLeft(*left), nullptr);
+  EXPECT_EQ(loaded_timer_data.GetDown(*left), nullptr);
+  EXPECT_EQ(loaded_timer_data.GetUp(*right), nullptr);
+}
+
+TEST(ScopeTreeTimerData, ForEachTimer) {
+  for (ScopeTreeTimerData::ScopeTreeUpdateType update_type :
+       {ScopeTreeTimerData::ScopeTreeUpdateType::kAlways,
+        ScopeTreeTimerData::ScopeTreeUpdateType::kOnCaptureComplete}) {
+    ScopeTreeTimerData scope_tree_timer_data(-1, update_type);
+    AddTimersInScopeTreeTimerDataTest(scope_tree_timer_data);
+    scope_tree_timer_data.OnCaptureComplete();
+
+    std::vector<uint64_t> starts;
+    scope_tree_timer_data.ForEachTimer(kLeftTimerEnd + 1, kDownTimerStart,
+                                       [&starts](const TimerView& timer) {
+                                         EXPECT_EQ(timer.process_id(), kProcessId);
+                                         starts.push_back(timer.start());
+                                       });
+    EXPECT_EQ(starts, (std::vector<uint64_t>{kRightTimerStart, kDownTimerStart}));
+  }
+}
+
+TEST(ScopeTreeTimerData, TimersAddedWhileQueryingAreAllInserted) {
+  ScopeTreeTimerData scope_tree_timer_data;
+  constexpr uint64_t kTimerCount = 20'000;
+
+  std::atomic<bool> writer_done = false;
+  std::thread writer{[&] {
+    for (uint64_t i = 0; i < kTimerCount; ++i) {
+      // Pairs of nested timers.
+      TimerInfo timer_info;
+      timer_info.set_process_id(kProcessId);
+      timer_info.set_start(10 * (i / 2) + i % 2);
+      timer_info.set_end(10 * (i / 2) + 5 - i % 2);
+      scope_tree_timer_data.AddTimer(timer_info);
+    }
+    // Replaces the trees read by the queries.
+    scope_tree_timer_data.OnCaptureComplete();
+    writer_done = true;
+  }};
+
+  size_t previous_number_of_timers = 0;
+  while (!writer_done) {
+    const size_t number_of_timers = scope_tree_timer_data.GetNumberOfTimers();
+    EXPECT_GE(number_of_timers, previous_number_of_timers);
+    previous_number_of_timers = number_of_timers;
+    EXPECT_LE(scope_tree_timer_data.GetTimersAtDepthDiscretized(0, 100, 0, 10 * kTimerCount).size(),
+              100);
+    const std::vector<const TimerInfo*> inner_timers =
+        scope_tree_timer_data.GetTimersAtDepthDiscretized(1, 100, 0, 10 * kTimerCount);
+    if (!inner_timers.empty()) {
+      EXPECT_NE(scope_tree_timer_data.GetUp(*inner_timers.back()), nullptr);
+    }
+  }
+  writer.join();
+
+  EXPECT_EQ(scope_tree_timer_data.GetNumberOfTimers(), kTimerCount);
+  EXPECT_EQ(scope_tree_timer_data.GetDepth(), 2);
+  EXPECT_EQ(scope_tree_timer_data.GetTimersAtDepth(0).size(), kTimerCount / 2);
+  EXPECT_EQ(scope_tree_timer_data.GetTimersAtDepth(1).size(), kTimerCount / 2);
+}
+
+}  // namespace orbit_client_data
@@ -27,6 +27,14 @@ std::vector<const TimerChain*> ThreadTrackDataProvider::GetAllThreadTimerChains(
   return chains;
 }
 
+void ThreadTrackDataProvider::ForEachTimer(
+    uint64_t min_tick, uint64_t max_tick, absl::FunctionRef<void(const TimerView&)> visitor) const {
+  for (const ScopeTreeTimerData* scope_tree_timer_data :
+       thread_track_data_manager_->GetAllScopeTreeTimerData()) {
+    scope_tree_timer_data->ForEachTimer(min_tick, max_tick, visitor);
+  }
+}
+
 const TimerInfo* ThreadTrackDataProvider::GetLeft(const TimerInfo& timer) const {
   return GetScopeTreeTimerData(timer.thread_id())->GetLeft(timer);
 }
@@ -13,16 +13,19 @@ using orbit_client_protos::TimerInfo;
 namespace orbit_client_data {
 
 bool TimerBlock::Intersects(uint64_t min, uint64_t max) const {
-  return (min <= max_timestamp_ && max >= min_timestamp_);
+  return (min <= MaxTimestamp() && max >= MinTimestamp());
 }
 
 const orbit_client_protos::TimerInfo* TimerBlock::LowerBound(uint64_t min_ns) const {
-  auto it = std::lower_bound(data_.begin(), data_.end(), min_ns,
-                             [](const orbit_client_protos::TimerInfo& timer_info, uint64_t value) {
-                               return timer_info.end() < value;
-                             });
-  if (it == data_.end()) return nullptr;
-  return &*it;
+  const orbit_client_protos::TimerInfo* begin = data_.data();
+  const orbit_client_protos::TimerInfo* end = begin + size();
+  const orbit_client_protos::TimerInfo* it =
+      std::lower_bound(begin, end, min_ns,
+                       [](const orbit_client_protos::TimerInfo& timer_info, uint64_t value) {
+                         return timer_info.end() < value;
+                       });
+  if (it == end) return nullptr;
+  return it;
 }
 
 TimerChain::~TimerChain() {
@@ -44,15 +47,15 @@ const TimerBlock* TimerChain::GetBlockContaining(const TimerInfo& element) const
   while (block != nullptr) {
     uint32_t size = block->size();
     if (size != 0) {
-      const TimerInfo* begin = &block->data_[0];
-      const TimerInfo* end = &block->data_[size - 1];
+      const TimerInfo* begin = &(*block)[0];
+      const TimerInfo* end = &(*block)[size - 1];
       // TODO (http://b/194268700): Don't compare pointers in TimerChain as it is an undefined
       // behavior
       if (begin <= &element && end >= &element) {
         return block;
       }
     }
-    block = block->next_;
+    block = block->next_.load(std::memory_order_acquire);
   }
 
   return nullptr;
@@ -61,13 +64,14 @@ const TimerBlock* TimerChain::GetBlockContaining(const TimerInfo& element) const
 const TimerInfo* TimerChain::GetElementAfter(const TimerInfo& element) const {
   const TimerBlock* block = GetBlockContaining(element);
   if (block != nullptr) {
-    const TimerInfo* begin = &block->data_[0];
+    const TimerInfo* begin = &(*block)[0];
     uint32_t index = &element - begin;
     if (index < block->size() - 1) {
-      return &block->data_[++index];
+      return &(*block)[++index];
     }
-    if (block->next_ != nullptr && block->next_->size() != 0) {
-      return &block->next_->data_[0];
+    const TimerBlock* next = block->next_.load(std::memory_order_acquire);
+    if (next != nullptr && next->size() != 0) {
+      return &(*next)[0];
     }
   }
   return nullptr;
@@ -76,13 +80,13 @@ const TimerInfo* TimerChain::GetElementAfter(const TimerInfo& element) const {
 const TimerInfo* TimerChain::GetElementBefore(const TimerInfo& element) const {
   const TimerBlock* block = GetBlockContaining(element);
   if (block != nullptr) {
-    const TimerInfo* begin = &block->data_[0];
+    const TimerInfo* begin = &(*block)[0];
     uint32_t index = &element - begin;
     if (index > 0) {
-      return &block->data_[--index];
+      return &(*block)[--index];
     }
     if (block->prev_ != nullptr) {
-      return &block->prev_->data_[block->prev_->size() - 1];
+      return &(*block->prev_)[block->prev_->size() - 1];
     }
   }
   return nullptr;
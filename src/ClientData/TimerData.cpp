@@ -24,10 +24,15 @@ const TimerInfo& TimerData::AddTimer(TimerInfo timer_info, uint32_t depth) {
   TimerChain* timer_chain = GetOrCreateTimerChain(depth);
   UpdateMinTime(timer_info.start());
   UpdateMaxTime(timer_info.end());
-  ++num_timers_;
   UpdateDepth(timer_info.depth() + 1);
 
-  return timer_chain->emplace_back(std::move(timer_info));
+  const TimerInfo& added_timer_info = timer_chain->emplace_back(std::move(timer_info));
+  ++num_timers_;
+
+  if (build_timer_pyramids_) {
+    GetOrCreateTimerPyramid(depth)->AddTimer(added_timer_info);
+  }
+  return added_timer_info;
 }
 
 std::vector<const TimerChain*> TimerData::GetChains() const {
@@ -41,6 +46,9 @@ std::vector<const TimerChain*> TimerData::GetChains() const {
 }
 
 const TimerChain* TimerData::GetChain(uint64_t depth) const {
+  if (depth < kNumDepthsWithLockFreeLookup) {
+    return chains_by_depth_[depth].load(std::memory_order_acquire);
+  }
   absl::MutexLock lock(&mutex_);
   auto it = timers_.find(depth);
   if (it != timers_.end()) {
@@ -55,9 +63,8 @@ std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimers(uint64_t
                                                                         bool exclusive) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthDiscretized", kOrbitColorBlueGrey);
   // TODO(b/204173236): use it in TimerTracks.
-  absl::MutexLock lock(&mutex_);
   std::vector<const orbit_client_protos::TimerInfo*> timers;
-  for (const auto& [depth, chain] : timers_) {
+  for (const TimerChain* chain : GetChains()) {
     ORBIT_CHECK(chain != nullptr);
     for (const auto& block : *chain) {
       if (!block.Intersects(min_tick, max_tick)) continue;
@@ -78,19 +85,19 @@ std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimers(uint64_t
 std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimersAtDepthDiscretized(
     uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthDiscretized", kOrbitColorBlueGrey);
-  absl::MutexLock lock(&mutex_);
   // The query is for the interval [start_ns, end_ns], but it's easier to work with the close-open
   // interval [start_ns, end_ns+1). We have to be careful with overflowing if end_ns is the maximum
   // unsigned value. In that case, we will just ignore this max_timestamp for simplicity.
   end_ns = std::max(end_ns, end_ns + 1);
 
-  if (timers_.find(depth) == timers_.end()) return {};
+  const TimerChain* chain = GetChain(depth);
+  if (chain == nullptr) return {};
 
   std::vector<const orbit_client_protos::TimerInfo*> discretized_timers;
   uint64_t next_pixel_start_ns = start_ns;
 
   // We are iterating through all blocks until we are after end_ns.
-  for (const auto& block : *timers_.at(depth)) {
+  for (const auto& block : *chain) {
     if (block.MinTimestamp() >= end_ns) break;
 
     // Several candidate timers might be in the same block.
@@ -108,6 +115,17 @@ std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimersAtDepthDi
   return discretized_timers;
 }
 
+std::vector<TimerPyramid::Bucket> TimerData::GetTimerPyramidBuckets(uint32_t depth,
+                                                                   uint32_t level,
+                                                                   uint64_t min_tick,
+                                                                   uint64_t max_tick) const {
+  ORBIT_SCOPE_WITH_COLOR("GetTimerPyramidBuckets", kOrbitColorBlueGrey);
+  ORBIT_CHECK(build_timer_pyramids_);
+  const TimerPyramid* pyramid = GetTimerPyramid(depth);
+  if (pyramid == nullptr) return {};
+  return pyramid->GetBuckets(level, min_tick, max_tick);
+}
+
 const TimerInfo* TimerData::GetFirstAfterStartTime(uint64_t time, uint32_t depth) const {
   const orbit_client_data::TimerChain* chain = GetChain(depth);
   if (chain == nullptr) return nullptr;
@@ -157,6 +175,11 @@ void TimerData::UpdateMaxTime(uint64_t max_time) {
 }
 
 TimerChain* TimerData::GetOrCreateTimerChain(uint64_t depth) {
+  if (depth < kNumDepthsWithLockFreeLookup) {
+    TimerChain* chain = chains_by_depth_[depth].load(std::memory_order_relaxed);
+    if (chain != nullptr) return chain;
+  }
+
   absl::MutexLock lock(&mutex_);
   auto it = timers_.find(depth);
   if (it != timers_.end()) {
@@ -165,7 +188,40 @@ TimerChain* TimerData::GetOrCreateTimerChain(uint64_t depth) {
 
   auto [inserted_it, inserted] = timers_.insert_or_assign(depth, std::make_unique<TimerChain>());
   ORBIT_CHECK(inserted);
+  if (depth < kNumDepthsWithLockFreeLookup) {
+    chains_by_depth_[depth].store(inserted_it->second.get(), std::memory_order_release);
+  }
   return inserted_it->second.get();
 }
 
+const TimerPyramid* TimerData::GetTimerPyramid(uint32_t depth) const {
+  if (depth < kNumDepthsWithLockFreeLookup) {
+    return pyramids_by_depth_[depth].load(std::memory_order_acquire);
+  }
+  absl::MutexLock lock(&mutex_);
+  auto it = pyramids_.find(depth);
+  if (it != pyramids_.end()) {
+    return it->second.get();
+  }
+
+  return nullptr;
+}
+
+TimerPyramid* TimerData::GetOrCreateTimerPyramid(uint32_t depth) {
+  if (depth < kNumDepthsWithLockFreeLookup) {
+    TimerPyramid* pyramid = pyramids_by_depth_[depth].load(std::memory_order_relaxed);
+    if (pyramid != nullptr) return pyramid;
+  }
+
+  absl::MutexLock lock(&mutex_);
+  std::unique_ptr<TimerPyramid>& pyramid = pyramids_[depth];
+  if (pyramid == nullptr) {
+    pyramid = std::make_unique<TimerPyramid>();
+    if (depth < kNumDepthsWithLockFreeLookup) {
+      pyramids_by_depth_[depth].store(pyramid.get(), std::memory_order_release);
+    }
+  }
+  return pyramid.get();
+}
+
 }  // namespace orbit_client_data
\ No newline at end of file
@@ -6,12 +6,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "ClientData/TimerChain.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerPyramid.h"
 #include "ClientProtos/capture_data.pb.h"
 
 namespace orbit_client_data {
@@ -286,4 +289,78 @@ TEST(TimerData, GetTimersAtDepthDiscretized) {
   verify_size(2, kNormalResolution, kMinTimestamp, kMaxTimestamp, 0);
 }
 
-}  // namespace orbit_client_data
\ No newline at end of file
+TEST(TimerData, TimersAddedWhileQueryingAreAllVisible) {
+  TimerData timer_data;
+  constexpr uint64_t kTimerCount = 50'000;
+  // Also exercise depths whose chain isn't looked up without a lock.
+  constexpr uint32_t kDepthCount = 100;
+
+  std::atomic<bool> writer_done = false;
+  std::thread writer{[&] {
+    for (uint64_t i = 0; i < kTimerCount; ++i) {
+      TimerInfo timer_info;
+      timer_info.set_start(10 * i);
+      timer_info.set_end(10 * i + 5);
+      timer_info.set_depth(i % kDepthCount);
+      timer_data.AddTimer(timer_info, i % kDepthCount);
+    }
+    writer_done = true;
+  }};
+
+  while (!writer_done) {
+    const size_t number_of_timers = timer_data.GetNumberOfTimers();
+    size_t number_of_timers_in_chains = 0;
+    for (const TimerChain* chain : timer_data.GetChains()) {
+      for (const TimerBlock& block : *chain) {
+        number_of_timers_in_chains += block.size();
+      }
+    }
+    EXPECT_GE(number_of_timers_in_chains, number_of_timers);
+    EXPECT_LE(timer_data.GetTimersAtDepthDiscretized(kDepthCount - 1, 100, 0, 10 * kTimerCount)
+                  .size(),
+              100);
+    for (const TimerPyramid::Bucket& bucket :
+         timer_data.GetTimerPyramidBuckets(0, TimerPyramid::kMaxLevel, 0, UINT64_MAX)) {
+      EXPECT_LE(bucket.timer_count, kTimerCount / kDepthCount);
+    }
+  }
+  writer.join();
+
+  EXPECT_EQ(timer_data.GetNumberOfTimers(), kTimerCount);
+  EXPECT_EQ(timer_data.GetDepth(), kDepthCount);
+  EXPECT_EQ(timer_data.GetTimers().size(), kTimerCount);
+  EXPECT_EQ(timer_data.GetChain(kDepthCount - 1)->size(), kTimerCount / kDepthCount);
+  std::vector<TimerPyramid::Bucket> buckets =
+      timer_data.GetTimerPyramidBuckets(0, TimerPyramid::kMaxLevel, 0, UINT64_MAX);
+  ASSERT_EQ(buckets.size(), 1);
+  EXPECT_EQ(buckets[0].timer_count, kTimerCount / kDepthCount);
+}
+
+TEST(TimerData, GetTimerPyramidBucketsIncludesAddedTimers) {
+  constexpr uint32_t kLevel = TimerPyramid::kMinLevel;
+  constexpr uint64_t kBucketWidth = uint64_t{1} << kLevel;
+  TimerData timer_data;
+  EXPECT_TRUE(timer_data.GetTimerPyramidBuckets(0, kLevel, 0, UINT64_MAX).empty());
+
+  // More timers than fit in a TimerBlock, one per bucket, queried while they are added.
+  constexpr uint64_t kTimerCount = 3000;
+  for (uint64_t i = 0; i < kTimerCount; ++i) {
+    TimerInfo timer_info;
+    timer_info.set_start(i * kBucketWidth);
+    timer_info.set_end(i * kBucketWidth + 1);
+    timer_info.set_depth(1);
+    timer_data.AddTimer(timer_info, 1);
+    if (i % 700 == 0) {
+      EXPECT_EQ(timer_data.GetTimerPyramidBuckets(1, kLevel, 0, UINT64_MAX).size(), i + 1);
+    }
+  }
+  EXPECT_EQ(timer_data.GetTimerPyramidBuckets(1, kLevel, 0, UINT64_MAX).size(), kTimerCount);
+  EXPECT_TRUE(timer_data.GetTimerPyramidBuckets(0, kLevel, 0, UINT64_MAX).empty());
+
+  std::vector<TimerPyramid::Bucket> buckets =
+      timer_data.GetTimerPyramidBuckets(1, TimerPyramid::kMaxLevel, 0, UINT64_MAX);
+  ASSERT_EQ(buckets.size(), 1);
+  EXPECT_EQ(buckets[0].timer_count, kTimerCount);
+}
+
+}  // namespace orbit_client_data
@@ -0,0 +1,138 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/TimerPyramid.h"
+
+#include <absl/numeric/bits.h>
+
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+
+using orbit_client_protos::TimerInfo;
+
+namespace orbit_client_data {
+
+namespace {
+
+// Returns the block of a TimerPyramid level that contains `position`, and the offset in the block.
+[[nodiscard]] std::pair<size_t, uint64_t> GetBlockAndOffset(uint64_t position,
+                                                            uint64_t first_block_size) {
+  // Block k starts at position first_block_size * (2^k - 1) and has first_block_size * 2^k buckets.
+  const auto block = static_cast<size_t>(absl::bit_width(position / first_block_size + 1) - 1);
+  return {block, position - first_block_size * ((uint64_t{1} << block) - 1)};
+}
+
+}  // namespace
+
+const TimerPyramid::StoredBucket& TimerPyramid::Level::operator[](uint64_t position) const {
+  const auto [block, offset] = GetBlockAndOffset(position, kFirstBlockSize);
+  return blocks_[block][offset];
+}
+
+TimerPyramid::StoredBucket& TimerPyramid::Level::operator[](uint64_t position) {
+  const auto [block, offset] = GetBlockAndOffset(position, kFirstBlockSize);
+  return blocks_[block][offset];
+}
+
+uint64_t TimerPyramid::Level::LowerBound(uint64_t index, uint64_t size) const {
+  uint64_t first = 0;
+  uint64_t count = size;
+  while (count > 0) {
+    const uint64_t half = count / 2;
+    if ((*this)[first + half].index < index) {
+      first += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  return first;
+}
+
+void TimerPyramid::Level::Append(uint64_t index, const TimerInfo& timer) {
+  const uint64_t position = size_.load(std::memory_order_relaxed);
+  const auto [block, offset] = GetBlockAndOffset(position, kFirstBlockSize);
+  ORBIT_CHECK(block < kMaxBlockCount);
+  if (offset == 0) {
+    blocks_[block] = std::make_unique<StoredBucket[]>(kFirstBlockSize << block);
+  }
+
+  StoredBucket& bucket = blocks_[block][offset];
+  bucket.index = index;
+  bucket.min_start_ns.store(timer.start(), std::memory_order_relaxed);
+  bucket.max_end_ns.store(timer.end(), std::memory_order_relaxed);
+  bucket.timer_count.store(1, std::memory_order_relaxed);
+  bucket.longest_timer.store(&timer, std::memory_order_relaxed);
+  size_.store(position + 1, std::memory_order_release);
+}
+
+void TimerPyramid::AddTimer(const TimerInfo& timer) {
+  for (uint32_t level = kMinLevel; level <= kMaxLevel; level += kLevelStride) {
+    Level& buckets = levels_[(level - kMinLevel) / kLevelStride];
+    const uint64_t index = timer.start() >> level;
+    const uint64_t size = buckets.size();
+
+    uint64_t position = size;
+    if (size > 0 && buckets[size - 1].index >= index) {
+      position = buckets[size - 1].index == index ? size - 1 : buckets.LowerBound(index, size);
+    }
+    if (position == size) {
+      buckets.Append(index, timer);
+      continue;
+    }
+
+    // Only this thread modifies the bucket, so the fields can be read and then stored.
+    StoredBucket& bucket = buckets[position];
+    if (timer.start() < bucket.min_start_ns.load(std::memory_order_relaxed)) {
+      bucket.min_start_ns.store(timer.start(), std::memory_order_relaxed);
+    }
+    if (timer.end() > bucket.max_end_ns.load(std::memory_order_relaxed)) {
+      bucket.max_end_ns.store(timer.end(), std::memory_order_relaxed);
+    }
+    bucket.timer_count.store(bucket.timer_count.load(std::memory_order_relaxed) + 1,
+                             std::memory_order_relaxed);
+    const TimerInfo* longest_timer = bucket.longest_timer.load(std::memory_order_relaxed);
+    if (timer.end() - timer.start() > longest_timer->end() - longest_timer->start()) {
+      // Released, as queries return the timer.
+      bucket.longest_timer.store(&timer, std::memory_order_release);
+    }
+  }
+}
+
+std::optional<uint32_t> TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(
+    uint64_t max_bucket_width_ns) {
+  if (max_bucket_width_ns < (uint64_t{1} << kMinLevel)) return std::nullopt;
+  uint32_t level = kMinLevel;
+  while (level < kMaxLevel && (uint64_t{1} << (level + kLevelStride)) <= max_bucket_width_ns) {
+    level += kLevelStride;
+  }
+  return level;
+}
+
+std::vector<TimerPyramid::Bucket> TimerPyramid::GetBuckets(uint32_t level, uint64_t min_ns,
+                                                           uint64_t max_ns) const {
+  ORBIT_CHECK(level >= kMinLevel && level <= kMaxLevel && (level - kMinLevel) % kLevelStride == 0);
+  const Level& buckets = levels_[(level - kMinLevel) / kLevelStride];
+  const uint64_t size = buckets.size();
+
+  uint64_t position = buckets.LowerBound(min_ns >> level, size);
+  // The timers of the previous bucket can reach into the range.
+  if (position > 0) --position;
+
+  std::vector<Bucket> result;
+  for (; position < size; ++position) {
+    const StoredBucket& bucket = buckets[position];
+    const uint64_t min_start_ns = bucket.min_start_ns.load(std::memory_order_relaxed);
+    if (min_start_ns > max_ns) break;
+    const uint64_t max_end_ns = bucket.max_end_ns.load(std::memory_order_relaxed);
+    if (max_end_ns < min_ns) continue;
+    result.push_back(Bucket{bucket.index, min_start_ns, max_end_ns,
+                            bucket.timer_count.load(std::memory_order_relaxed),
+                            bucket.longest_timer.load(std::memory_order_acquire)});
+  }
+  return result;
+}
+
+}  // namespace orbit_client_data
@@ -0,0 +1,115 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "ClientData/TimerPyramid.h"
+#include "ClientProtos/capture_data.pb.h"
+
+namespace orbit_client_data {
+
+using orbit_client_protos::TimerInfo;
+
+namespace {
+
+constexpr uint32_t kLevel = TimerPyramid::kMinLevel;
+constexpr uint64_t kBucketWidth = uint64_t{1} << kLevel;
+
+[[nodiscard]] TimerInfo MakeTimer(uint64_t start, uint64_t end, uint32_t depth = 0) {
+  TimerInfo timer;
+  timer.set_start(start);
+  timer.set_end(end);
+  timer.set_depth(depth);
+  return timer;
+}
+
+}  // namespace
+
+TEST(TimerPyramid, GetCoarsestLevelWithBucketWidthAtMost) {
+  EXPECT_EQ(TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(0), std::nullopt);
+  EXPECT_EQ(TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(kBucketWidth - 1), std::nullopt);
+  EXPECT_EQ(TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(kBucketWidth), kLevel);
+  // The next stored level has buckets four times wider.
+  EXPECT_EQ(TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(4 * kBucketWidth - 1), kLevel);
+  EXPECT_EQ(TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(4 * kBucketWidth),
+            kLevel + TimerPyramid::kLevelStride);
+  EXPECT_EQ(TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(UINT64_MAX),
+            TimerPyramid::kMaxLevel);
+}
+
+TEST(TimerPyramid, SummarizesTimersPerBucket) {
+  // Three timers in the first bucket, one in the third, added out of order.
+  std::deque<TimerInfo> timers = {MakeTimer(10, 20),
+                                  MakeTimer(2 * kBucketWidth + 5, 3 * kBucketWidth),
+                                  MakeTimer(30, 1000), MakeTimer(1000, kBucketWidth + 7)};
+  TimerPyramid pyramid;
+  for (const TimerInfo& timer : timers) pyramid.AddTimer(timer);
+
+  std::vector<TimerPyramid::Bucket> buckets = pyramid.GetBuckets(kLevel, 0, UINT64_MAX);
+  ASSERT_EQ(buckets.size(), 2);
+  EXPECT_EQ(buckets[0].index, 0);
+  EXPECT_EQ(buckets[0].timer_count, 3);
+  EXPECT_EQ(buckets[0].min_start_ns, 10);
+  EXPECT_EQ(buckets[0].max_end_ns, kBucketWidth + 7);
+  EXPECT_EQ(buckets[0].longest_timer, &timers[3]);
+  EXPECT_EQ(buckets[1].index, 2);
+  EXPECT_EQ(buckets[1].timer_count, 1);
+  EXPECT_EQ(buckets[1].longest_timer, &timers[1]);
+
+  // At a coarser level, all timers are in the same bucket.
+  buckets = pyramid.GetBuckets(kLevel + TimerPyramid::kLevelStride, 0, UINT64_MAX);
+  ASSERT_EQ(buckets.size(), 1);
+  EXPECT_EQ(buckets[0].timer_count, 4);
+  EXPECT_EQ(buckets[0].max_end_ns, 3 * kBucketWidth);
+  EXPECT_EQ(buckets[0].longest_timer, &timers[1]);
+}
+
+TEST(TimerPyramid, AddsTimerBeforeTheLastBucketToTheNextExistingBucket) {
+  std::deque<TimerInfo> timers = {MakeTimer(10, 20),
+                                  MakeTimer(3 * kBucketWidth, 3 * kBucketWidth + 1),
+                                  MakeTimer(kBucketWidth + 5, kBucketWidth + 100)};
+  TimerPyramid pyramid;
+  for (const TimerInfo& timer : timers) pyramid.AddTimer(timer);
+
+  std::vector<TimerPyramid::Bucket> buckets = pyramid.GetBuckets(kLevel, 0, UINT64_MAX);
+  ASSERT_EQ(buckets.size(), 2);
+  EXPECT_EQ(buckets[1].index, 3);
+  EXPECT_EQ(buckets[1].timer_count, 2);
+  EXPECT_EQ(buckets[1].min_start_ns, kBucketWidth + 5);
+  EXPECT_EQ(buckets[1].longest_timer, &timers[2]);
+
+  // The bucket is still found for a range that only intersects the added timer.
+  buckets = pyramid.GetBuckets(kLevel, kBucketWidth + 50, kBucketWidth + 60);
+  ASSERT_EQ(buckets.size(), 1);
+  EXPECT_EQ(buckets[0].index, 3);
+}
+
+TEST(TimerPyramid, GetBucketsReturnsBucketsIntersectingTheRange) {
+  std::deque<TimerInfo> timers;
+  TimerPyramid pyramid;
+  for (uint64_t i = 0; i < 10; ++i) {
+    pyramid.AddTimer(timers.emplace_back(MakeTimer(i * kBucketWidth, i * kBucketWidth + 10)));
+  }
+  // A long timer in the last bucket, which reaches into the range queried below.
+  pyramid.AddTimer(timers.emplace_back(MakeTimer(20 * kBucketWidth, 30 * kBucketWidth)));
+
+  std::vector<TimerPyramid::Bucket> buckets =
+      pyramid.GetBuckets(kLevel, 3 * kBucketWidth + 11, 5 * kBucketWidth);
+  ASSERT_EQ(buckets.size(), 2);
+  EXPECT_EQ(buckets[0].index, 4);
+  EXPECT_EQ(buckets[1].index, 5);
+
+  buckets = pyramid.GetBuckets(kLevel, 25 * kBucketWidth, 26 * kBucketWidth);
+  ASSERT_EQ(buckets.size(), 1);
+  EXPECT_EQ(buckets[0].index, 20);
+
+  EXPECT_TRUE(pyramid.GetBuckets(kLevel, 31 * kBucketWidth, UINT64_MAX).empty());
+}
+
+}  // namespace orbit_client_data
@@ -28,6 +28,7 @@
 #include "ClientData/CallstackData.h"
 #include "ClientData/CallstackEvent.h"
 #include "ClientData/CallstackInfo.h"
+#include "ClientData/CompactTimerChain.h"
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/LinuxAddressInfo.h"
 #include "ClientData/ModuleIdentifierProvider.h"
@@ -242,8 +243,9 @@ class CaptureData {
     return frame_track_function_ids_;
   }
 
-  [[nodiscard]] std::pair<uint64_t, TimerData*> CreateTimerData() {
-    return timer_data_manager_.CreateTimerData();
+  // See TimerData for `build_timer_pyramids`.
+  [[nodiscard]] std::pair<uint64_t, TimerData*> CreateTimerData(bool build_timer_pyramids = true) {
+    return timer_data_manager_.CreateTimerData(build_timer_pyramids);
   }
 
   [[nodiscard]] ThreadTrackDataProvider* GetThreadTrackDataProvider() const {
@@ -252,6 +254,7 @@ class CaptureData {
 
   [[nodiscard]] std::optional<ScopeId> ProvideScopeId(
       const orbit_client_protos::TimerInfo& timer_info) const;
+  [[nodiscard]] std::optional<ScopeId> ProvideScopeId(const TimerView& timer) const;
   [[nodiscard]] std::vector<ScopeId> GetAllProvidedScopeIds() const;
   [[nodiscard]] ScopeId GetMaxId() const { return scope_id_provider_->GetMaxId(); }
   [[nodiscard]] const ScopeInfo& GetScopeInfo(ScopeId scope_id) const;
@@ -0,0 +1,190 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_COMPACT_TIMER_CHAIN_H_
+#define CLIENT_DATA_COMPACT_TIMER_CHAIN_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/synchronization/mutex.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ClientProtos/capture_data.pb.h"
+
+namespace orbit_client_data {
+
+class CompactTimerBlock;
+
+// Lightweight handle to a timer, which is either stored whole as a TimerInfo (e.g., in a
+// TimerChain) or in the columns of a CompactTimerBlock. The accessors are named like the ones of
+// orbit_client_protos::TimerInfo, so that code can be written against either.
+class TimerView {
+ public:
+  explicit TimerView(const orbit_client_protos::TimerInfo* timer_info) : timer_info_{timer_info} {}
+  TimerView(const CompactTimerBlock* block, uint32_t index) : block_{block}, index_{index} {}
+
+  [[nodiscard]] uint64_t start() const;
+  [[nodiscard]] uint64_t end() const;
+  [[nodiscard]] uint32_t depth() const;
+  [[nodiscard]] uint64_t function_id() const;
+  [[nodiscard]] uint32_t thread_id() const;
+  [[nodiscard]] uint32_t process_id() const;
+  [[nodiscard]] int32_t processor() const;
+  [[nodiscard]] orbit_client_protos::TimerInfo::Type type() const;
+
+  // Returns a copy with all the fields of the timer that was added.
+  [[nodiscard]] orbit_client_protos::TimerInfo ToTimerInfo() const;
+  // Returns the timer as a TimerInfo that lives as long as the timer's store, for the code that
+  // keeps pointers to timers, e.g., the selection. A timer in the columns of a CompactTimerBlock is
+  // converted on the first call and then kept in the block, so this costs as much memory as the
+  // TimerInfo: prefer the accessors above for timers that are only read.
+  [[nodiscard]] const orbit_client_protos::TimerInfo& GetTimerInfo() const;
+
+  // Returns the timer if it's stored whole, or nullptr if it's only stored in columns.
+  [[nodiscard]] const orbit_client_protos::TimerInfo* GetStoredTimerInfo() const;
+
+  friend bool operator==(const TimerView& lhs, const TimerView& rhs) {
+    return lhs.timer_info_ == rhs.timer_info_ && lhs.block_ == rhs.block_ &&
+           lhs.index_ == rhs.index_;
+  }
+  friend bool operator!=(const TimerView& lhs, const TimerView& rhs) { return !(lhs == rhs); }
+
+ private:
+  const orbit_client_protos::TimerInfo* timer_info_ = nullptr;
+  const CompactTimerBlock* block_ = nullptr;
+  uint32_t index_ = 0;
+};
+
+// Stores up to kCapacity timers column by column, with the start timestamps relative to the start
+// of the first timer. The columns only hold the fields that almost all timers use, in the smallest
+// type that fits their usual values: timers that don't fit, or that have any other field set (e.g.,
+// registers, a color, an API scope name), are additionally copied whole to a side table.
+// Like TimerBlock, it keeps track of the minimum and maximum timestamps of its timers.
+// A single thread can append while others read the timers appended so far.
+class CompactTimerBlock {
+ public:
+  explicit CompactTimerBlock(uint64_t base_timestamp_ns);
+
+  CompactTimerBlock(const CompactTimerBlock&) = delete;
+  CompactTimerBlock& operator=(const CompactTimerBlock&) = delete;
+  CompactTimerBlock(CompactTimerBlock&&) = delete;
+  CompactTimerBlock& operator=(CompactTimerBlock&&) = delete;
+
+  // Returns false, and doesn't add the timer, if the block is full or if the timer starts before
+  // the base timestamp or too long after it. The timer is stored with `depth` as its depth.
+  [[nodiscard]] bool TryAppend(const orbit_client_protos::TimerInfo& timer_info, uint32_t depth);
+
+  [[nodiscard]] uint32_t size() const { return size_.load(std::memory_order_acquire); }
+  [[nodiscard]] TimerView operator[](uint32_t index) const { return TimerView{this, index}; }
+
+  // Tests if [min, max] intersects with [MinTimestamp(), MaxTimestamp()].
+  [[nodiscard]] bool Intersects(uint64_t min, uint64_t max) const {
+    return min <= MaxTimestamp() && max >= MinTimestamp();
+  }
+  [[nodiscard]] uint64_t MinTimestamp() const {
+    return min_timestamp_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] uint64_t MaxTimestamp() const {
+    return max_timestamp_.load(std::memory_order_relaxed);
+  }
+
+  // Assuming timers are sorted, returns the first one for which the end timestamp isn't smaller
+  // than min_ns.
+  [[nodiscard]] std::optional<TimerView> LowerBound(uint64_t min_ns) const;
+  // Assuming timers are sorted, returns the index of the first one that doesn't start before
+  // start_ns, or size() if there is none.
+  [[nodiscard]] uint32_t LowerBoundStart(uint64_t start_ns) const;
+
+  [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+  static constexpr uint32_t kCapacity = 1024;
+
+ private:
+  friend class TimerView;
+
+  [[nodiscard]] const orbit_client_protos::TimerInfo* GetSideTableEntry(uint32_t index) const;
+  [[nodiscard]] const orbit_client_protos::TimerInfo& GetOrCreateTimerInfo(uint32_t index) const;
+
+  const uint64_t base_timestamp_ns_;
+  std::atomic<uint32_t> size_ = 0;
+  std::atomic<uint64_t> min_timestamp_ = std::numeric_limits<uint64_t>::max();
+  std::atomic<uint64_t> max_timestamp_ = std::numeric_limits<uint64_t>::min();
+
+  // All columns have kCapacity elements, so that they are never reallocated while being read.
+  std::unique_ptr<uint32_t[]> start_offsets_ns_;
+  // For timers in the side table, the index of their entry instead.
+  std::unique_ptr<uint32_t[]> durations_ns_;
+  std::unique_ptr<uint32_t[]> function_ids_;
+  std::unique_ptr<uint32_t[]> thread_ids_;
+  std::unique_ptr<uint32_t[]> process_ids_;
+  std::unique_ptr<int16_t[]> processors_;
+  std::unique_ptr<uint8_t[]> depths_;
+  // The TimerInfo::Type, with kInSideTableFlag set for timers in the side table.
+  std::unique_ptr<uint8_t[]> types_;
+  static constexpr uint8_t kInSideTableFlag = 0x80;
+
+  // Allocated with kCapacity elements when the first timer that needs it is added.
+  std::unique_ptr<std::unique_ptr<const orbit_client_protos::TimerInfo>[]> side_table_;
+  uint32_t side_table_size_ = 0;
+
+  // The TimerInfos returned by TimerView::GetTimerInfo for timers that are only stored in columns.
+  // Queries from several threads create them under the mutex, and then find them by index without
+  // locking, as drawing the same timers again is the common case.
+  mutable absl::Mutex timer_infos_mutex_;
+  mutable std::vector<std::unique_ptr<const orbit_client_protos::TimerInfo>> timer_infos_
+      ABSL_GUARDED_BY(timer_infos_mutex_);
+  // Allocated with kCapacity elements when the first TimerInfo is created.
+  mutable std::unique_ptr<std::atomic<const orbit_client_protos::TimerInfo*>[]>
+      timer_infos_by_index_ ABSL_GUARDED_BY(timer_infos_mutex_);
+  mutable std::atomic<const std::atomic<const orbit_client_protos::TimerInfo*>*>
+      published_timer_infos_by_index_ = nullptr;
+};
+
+// Sequence of CompactTimerBlocks, the counterpart of TimerChain. Appending isn't thread-safe.
+// The queries by start timestamp assume that the timers are appended in order of start timestamp.
+class CompactTimerChain {
+ public:
+  TimerView Append(const orbit_client_protos::TimerInfo& timer_info, uint32_t depth);
+
+  [[nodiscard]] bool empty() const { return num_items_ == 0; }
+  [[nodiscard]] uint64_t size() const { return num_items_; }
+
+  [[nodiscard]] const std::vector<std::unique_ptr<CompactTimerBlock>>& GetBlocks() const {
+    return blocks_;
+  }
+
+  [[nodiscard]] std::optional<TimerView> GetFirstStartingAtOrAfter(uint64_t time) const;
+  [[nodiscard]] std::optional<TimerView> GetLastStartingBefore(uint64_t time) const;
+  // Return the timers right before and right after the timer with the given start and end
+  // timestamps, or std::nullopt if there is none or if no such timer is in the chain.
+  [[nodiscard]] std::optional<TimerView> GetPrevious(uint64_t start_ns, uint64_t end_ns) const;
+  [[nodiscard]] std::optional<TimerView> GetNext(uint64_t start_ns, uint64_t end_ns) const;
+
+  [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+ private:
+  // Position of a timer in the chain. The block index is blocks_.size() past the last timer.
+  struct Position {
+    size_t block_index;
+    uint32_t index;
+  };
+
+  [[nodiscard]] Position LowerBoundStart(uint64_t time) const;
+  [[nodiscard]] std::optional<Position> Find(uint64_t start_ns, uint64_t end_ns) const;
+  [[nodiscard]] std::optional<Position> GetPreviousPosition(Position position) const;
+  [[nodiscard]] std::optional<TimerView> GetTimer(Position position) const;
+
+  std::vector<std::unique_ptr<CompactTimerBlock>> blocks_;
+  uint64_t num_items_ = 0;
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_COMPACT_TIMER_CHAIN_H_
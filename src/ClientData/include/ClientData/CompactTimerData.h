@@ -0,0 +1,114 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_COMPACT_TIMER_DATA_H_
+#define CLIENT_DATA_COMPACT_TIMER_DATA_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/functional/function_ref.h>
+#include <absl/synchronization/mutex.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ClientData/CompactTimerChain.h"
+#include "ClientData/TimerChain.h"
+#include "ClientData/TimerDataInterface.h"
+#include "ClientProtos/capture_data.pb.h"
+#include "OrbitBase/ThreadConstants.h"
+
+namespace orbit_client_data {
+
+// Counterpart of TimerData that stores the timers in CompactTimerChains, one per depth. A simple
+// timer takes a few tens of bytes instead of a whole TimerInfo message, which matters for captures
+// with hundreds of millions of timers.
+// The queries returning TimerViews read the columns directly. The TimerDataInterface queries return
+// TimerView::GetTimerInfo, i.e., each timer they return is converted to a TimerInfo that is then
+// kept as long as the CompactTimerData, so they should be limited to the timers that are displayed
+// or selected.
+// Queries assume that the timers of each depth are added in order of start timestamp, and the
+// relative timers queries, like ScopeTree, that the timers of a depth are nested in the ones of the
+// depth above.
+class CompactTimerData final : public TimerDataInterface {
+ public:
+  TimerView AddTimer(const orbit_client_protos::TimerInfo& timer_info, uint32_t depth = 0);
+
+  // Same semantics as TimerData::GetTimers.
+  [[nodiscard]] std::vector<TimerView> GetTimerViews(
+      uint64_t min_tick = std::numeric_limits<uint64_t>::min(),
+      uint64_t max_tick = std::numeric_limits<uint64_t>::max(), bool exclusive = false) const;
+  // Same as GetTimerViews, for the timers of a single depth.
+  [[nodiscard]] std::vector<TimerView> GetTimerViewsAtDepth(uint32_t depth, uint64_t min_tick,
+                                                            uint64_t max_tick,
+                                                            bool exclusive) const;
+  // Same semantics as TimerData::GetTimersAtDepthDiscretized.
+  [[nodiscard]] std::vector<TimerView> GetTimerViewsAtDepthDiscretized(uint32_t depth,
+                                                                       uint32_t resolution,
+                                                                       uint64_t start_ns,
+                                                                       uint64_t end_ns) const;
+  // Calls `visitor` with all the timers that intersect [min_tick, max_tick], depth by depth. Timers
+  // added concurrently might be skipped.
+  void ForEachTimer(uint64_t min_tick, uint64_t max_tick,
+                    absl::FunctionRef<void(const TimerView&)> visitor) const;
+
+  // Timers queries
+  // The timers aren't stored in TimerChains, so this is always empty. Use ForEachTimer instead.
+  [[nodiscard]] std::vector<const TimerChain*> GetChains() const override { return {}; }
+  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimers(
+      uint64_t min_tick = std::numeric_limits<uint64_t>::min(),
+      uint64_t max_tick = std::numeric_limits<uint64_t>::max(),
+      bool exclusive = false) const override;
+  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimersAtDepthDiscretized(
+      uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const override;
+
+  // Metadata queries
+  [[nodiscard]] bool IsEmpty() const override { return GetNumberOfTimers() == 0; }
+  [[nodiscard]] size_t GetNumberOfTimers() const override { return num_timers_; }
+  [[nodiscard]] uint64_t GetMinTime() const override { return min_time_; }
+  [[nodiscard]] uint64_t GetMaxTime() const override { return max_time_; }
+  [[nodiscard]] uint32_t GetDepth() const override { return depth_; }
+  [[nodiscard]] uint32_t GetProcessId() const override { return process_id_; }
+
+  // Relative timers queries. They find `timer` by its depth, start and end timestamps.
+  [[nodiscard]] std::optional<TimerView> GetFirstAfterStartTime(uint64_t time,
+                                                                uint32_t depth) const;
+  [[nodiscard]] std::optional<TimerView> GetFirstBeforeStartTime(uint64_t time,
+                                                                 uint32_t depth) const;
+  [[nodiscard]] const orbit_client_protos::TimerInfo* GetLeft(
+      const orbit_client_protos::TimerInfo& timer) const override;
+  [[nodiscard]] const orbit_client_protos::TimerInfo* GetRight(
+      const orbit_client_protos::TimerInfo& timer) const override;
+  [[nodiscard]] const orbit_client_protos::TimerInfo* GetUp(
+      const orbit_client_protos::TimerInfo& timer) const override;
+  [[nodiscard]] const orbit_client_protos::TimerInfo* GetDown(
+      const orbit_client_protos::TimerInfo& timer) const override;
+
+  // Unused methods needed in TimerDataInterface
+  [[nodiscard]] int64_t GetThreadId() const override { return -1; }
+  void OnCaptureComplete() override {}
+
+  [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+ private:
+  [[nodiscard]] const CompactTimerChain* GetChain(uint32_t depth) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable absl::Mutex mutex_;
+  std::map<uint32_t, CompactTimerChain> chains_ ABSL_GUARDED_BY(mutex_);
+  std::atomic<size_t> num_timers_ = 0;
+  std::atomic<uint64_t> min_time_ = std::numeric_limits<uint64_t>::max();
+  std::atomic<uint64_t> max_time_ = std::numeric_limits<uint64_t>::min();
+  std::atomic<uint32_t> depth_ = 0;
+  std::atomic<uint32_t> process_id_ = orbit_base::kInvalidProcessId;
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_COMPACT_TIMER_DATA_H_
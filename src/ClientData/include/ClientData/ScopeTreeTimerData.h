@@ -5,17 +5,24 @@
 #ifndef CLIENT_DATA_SCOPE_TREE_TIMER_DATA_H_
 #define CLIENT_DATA_SCOPE_TREE_TIMER_DATA_H_
 
-#include <absl/base/thread_annotations.h>
-#include <absl/synchronization/mutex.h>
+#include <absl/functional/function_ref.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include <array>
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
+#include "ClientData/CompactTimerChain.h"
+#include "ClientData/CompactTimerData.h"
 #include "ClientData/TimerChain.h"
 #include "ClientProtos/capture_data.pb.h"
+#include "Containers/FlatScopeTree.h"
 #include "Containers/ScopeTree.h"
+#include "OrbitBase/ThreadConstants.h"
 #include "TimerData.h"
 #include "TimerDataInterface.h"
 
@@ -23,21 +30,39 @@ namespace orbit_client_data {
 
 // Stores all the timers from a particular ThreadId. Provides queries to get timers in a certain
 // range as well as metadata from them.
+// AddTimer and OnCaptureComplete are meant to be called by a single thread. The queries can be
+// called concurrently from other threads, and never wait for AddTimer nor the other way around.
+// With kAlways, AddTimer makes its timer visible to the queries unless a query is still reading the
+// copy of the tree to update, in which case the timer becomes visible with a later AddTimer or with
+// OnCaptureComplete, which then frees the other copy. With kOnCaptureComplete, used for loaded
+// captures, timers only become visible on OnCaptureComplete, which moves them to a
+// CompactTimerData: the TimerInfos returned by AddTimer are then freed, and the queries returning
+// TimerInfo pointers return the ones materialized by the CompactTimerData, so ForEachTimer should
+// be preferred to go through all the timers.
+// Timers added after OnCaptureComplete are kept, but not returned by the queries.
+// To never wait for each other, AddTimer and the queries use two copies of the ScopeTree during a
+// live capture (kAlways). The copies only share the TimerInfos, so this doubles the memory and the
+// time spent in the ScopeTree until OnCaptureComplete frees one copy. With 1M nested timers on a
+// thread, a timer takes 152 bytes as a TimerInfo and 116 bytes in each copy, i.e., 387 bytes
+// during the capture and 272 bytes after it, and AddTimer takes 1.25us instead of 0.63us with a
+// single copy.
 class ScopeTreeTimerData final : public TimerDataInterface {
  public:
   enum class ScopeTreeUpdateType { kAlways, kOnCaptureComplete, kNever };
   explicit ScopeTreeTimerData(int64_t thread_id = -1, ScopeTreeUpdateType scope_tree_update_type =
-                                                          ScopeTreeUpdateType::kAlways)
-      : thread_id_(thread_id), scope_tree_update_type_(scope_tree_update_type){};
+                                                          ScopeTreeUpdateType::kAlways);
 
   // We are using a ScopeTree to automatically manage timers and their depth, no need to set it
-  // here.
+  // here. With kOnCaptureComplete, the returned reference is only valid until OnCaptureComplete.
   const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info,
-                                                 uint32_t /*unused_depth*/ = 0) override;
+                                                 uint32_t /*unused_depth*/ = 0);
   // Timers queries
-  [[nodiscard]] std::vector<const TimerChain*> GetChains() const override {
-    return timer_data_.GetChains();
-  }
+  // Always empty with kOnCaptureComplete, as those timers end up in a CompactTimerData.
+  [[nodiscard]] std::vector<const TimerChain*> GetChains() const override;
+  // Calls `visitor` with all the timers that intersect [start_ns, end_ns], without materializing
+  // TimerInfos for timers that are only stored in a CompactTimerData.
+  void ForEachTimer(uint64_t start_ns, uint64_t end_ns,
+                    absl::FunctionRef<void(const TimerView&)> visitor) const;
 
   [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimers(
       uint64_t start_ns = std::numeric_limits<uint64_t>::min(),
@@ -54,18 +79,11 @@ class ScopeTreeTimerData final : public TimerDataInterface {
 
   // Metadata queries
   [[nodiscard]] bool IsEmpty() const override { return GetNumberOfTimers() == 0; };
-  // Special case. ScopeTree has a root node in depth 0 which shouldn't be considered.
-  [[nodiscard]] size_t GetNumberOfTimers() const override {
-    absl::MutexLock lock(&scope_tree_mutex_);
-    return scope_tree_.Size() - 1;
-  }
-  [[nodiscard]] uint64_t GetMinTime() const override { return timer_data_.GetMinTime(); }
-  [[nodiscard]] uint64_t GetMaxTime() const override { return timer_data_.GetMaxTime(); }
-  [[nodiscard]] uint32_t GetDepth() const override {
-    absl::MutexLock lock(&scope_tree_mutex_);
-    return scope_tree_.Depth();
-  }
-  [[nodiscard]] uint32_t GetProcessId() const override { return timer_data_.GetProcessId(); }
+  [[nodiscard]] size_t GetNumberOfTimers() const override;
+  [[nodiscard]] uint64_t GetMinTime() const override { return min_time_; }
+  [[nodiscard]] uint64_t GetMaxTime() const override { return max_time_; }
+  [[nodiscard]] uint32_t GetDepth() const override;
+  [[nodiscard]] uint32_t GetProcessId() const override { return process_id_; }
   [[nodiscard]] int64_t GetThreadId() const override { return thread_id_; }
 
   // Relative timers queries
@@ -81,13 +99,43 @@ class ScopeTreeTimerData final : public TimerDataInterface {
   void OnCaptureComplete() override;
 
  private:
+  using LiveScopeTree = orbit_containers::ScopeTree<const orbit_client_protos::TimerInfo>;
+  using CompleteScopeTree = orbit_containers::FlatScopeTree<const orbit_client_protos::TimerInfo>;
+
+  // Calls `query` on the published LiveScopeTree, or on an empty CompleteScopeTree if there is
+  // none, and returns its result.
+  template <typename Query>
+  std::invoke_result_t<Query, const CompleteScopeTree&> ReadScopeTree(Query&& query) const;
+  void WaitForLiveScopeTreeReaders(uint32_t index) const;
+  void KeepOnlyPublishedLiveScopeTree();
+  void MoveTimersToCompactTimerData();
+
   const int64_t thread_id_;
-  mutable absl::Mutex scope_tree_mutex_;
-  orbit_containers::ScopeTree<const orbit_client_protos::TimerInfo> scope_tree_
-      ABSL_GUARDED_BY(scope_tree_mutex_);
-  ScopeTreeUpdateType scope_tree_update_type_;
+  const ScopeTreeUpdateType scope_tree_update_type_;
+
+  // While the capture is running (kAlways), the timers are inserted into two copies of the
+  // ScopeTree in turns: AddTimer updates the copy that isn't published and then publishes it, and
+  // the queries only read the published copy. A query registers in the reader count of the copy it
+  // reads, and AddTimer only updates a copy without readers.
+  std::array<std::unique_ptr<LiveScopeTree>, 2> live_scope_trees_;
+  std::atomic<uint32_t> published_live_scope_tree_index_ = 0;
+  mutable std::array<std::atomic<uint32_t>, 2> live_scope_tree_reader_counts_{};
+  // Only accessed by AddTimer and OnCaptureComplete.
+  std::vector<const orbit_client_protos::TimerInfo*> timers_missing_from_unpublished_scope_tree_;
+  std::vector<const orbit_client_protos::TimerInfo*> timers_missing_from_both_scope_trees_;
+  bool capture_complete_ = false;
+
+  // With kOnCaptureComplete, replaces timer_data_ and the trees on OnCaptureComplete.
+  std::unique_ptr<CompactTimerData> compact_timer_data_;
+  std::atomic<const CompactTimerData*> published_compact_timer_data_ = nullptr;
 
-  TimerData timer_data_;
+  // The timers are drawn from the ScopeTree, which doesn't need TimerPyramids. Only accessed by
+  // AddTimer and OnCaptureComplete with kOnCaptureComplete, which frees it.
+  std::unique_ptr<TimerData> timer_data_ =
+      std::make_unique<TimerData>(/*build_timer_pyramids=*/false);
+  std::atomic<uint64_t> min_time_ = std::numeric_limits<uint64_t>::max();
+  std::atomic<uint64_t> max_time_ = std::numeric_limits<uint64_t>::min();
+  std::atomic<uint32_t> process_id_ = orbit_base::kInvalidProcessId;
 };
 
 }  // namespace orbit_client_data
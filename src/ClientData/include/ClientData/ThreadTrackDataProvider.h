@@ -5,6 +5,7 @@
 #ifndef THREAD_TRACK_DATA_PROVIDER_H_
 #define THREAD_TRACK_DATA_PROVIDER_H_
 
+#include <absl/functional/function_ref.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -13,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "ClientData/CompactTimerChain.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeTreeTimerData.h"
 #include "ClientData/ThreadTrackDataManager.h"
@@ -38,8 +40,12 @@ class ThreadTrackDataProvider final {
     return thread_track_data_manager_->CreateScopeTreeTimerData(thread_id);
   }
 
-  // TODO(http://b/203515530): Replace this method by proper queries.
+  // TODO(http://b/203515530): Replace this method by proper queries, like ForEachTimer.
+  // The timers of loaded captures aren't stored in TimerChains, so they are missing from the result.
   [[nodiscard]] std::vector<const TimerChain*> GetAllThreadTimerChains() const;
+  // Calls `visitor` with the timers of all threads that intersect [min_tick, max_tick].
+  void ForEachTimer(uint64_t min_tick, uint64_t max_tick,
+                    absl::FunctionRef<void(const TimerView&)> visitor) const;
   [[nodiscard]] std::vector<uint32_t> GetAllThreadIds() const;
 
   // For the following methods, we assume ScopeTreeTimerData is already been created for thread_id.
@@ -24,6 +24,9 @@ namespace orbit_client_data {
 // trivial rejection of an entire block by using the Intersects(t_min, t_max) method. This
 // effectively tests if any of the timers stored in this block intersects with the [t_min, t_max]
 // interval.
+// A single thread can append timers while other threads read the timers appended so far: the data
+// is never reallocated, and the size of a block is published with release semantics after the new
+// timer has been constructed.
 class TimerBlock {
   friend class TimerChain;
   friend class TimerChainIterator;
@@ -34,6 +37,7 @@ class TimerBlock {
         next_(nullptr),
         min_timestamp_(std::numeric_limits<uint64_t>::max()),
         max_timestamp_(std::numeric_limits<uint64_t>::min()) {
+    // Readers rely on data_ never being reallocated.
     data_.reserve(kBlockSize);
   }
 
@@ -43,8 +47,13 @@ class TimerBlock {
     ORBIT_CHECK(size() < kBlockSize);
     const orbit_client_protos::TimerInfo& timer_info =
         data_.emplace_back(std::forward<Args>(args)...);
-    min_timestamp_ = std::min(timer_info.start(), min_timestamp_);
-    max_timestamp_ = std::max(timer_info.end(), max_timestamp_);
+    if (timer_info.start() < MinTimestamp()) {
+      min_timestamp_.store(timer_info.start(), std::memory_order_relaxed);
+    }
+    if (timer_info.end() > MaxTimestamp()) {
+      max_timestamp_.store(timer_info.end(), std::memory_order_relaxed);
+    }
+    size_.store(data_.size(), std::memory_order_release);
     return timer_info;
   }
 
@@ -52,13 +61,19 @@ class TimerBlock {
   // {min, max}_timestamp are the minimum and maximum timestamp of the timers
   // that have so far been added to this block.
   [[nodiscard]] bool Intersects(uint64_t min, uint64_t max) const;
-  [[nodiscard]] uint64_t MinTimestamp() const { return min_timestamp_; }
+  [[nodiscard]] uint64_t MinTimestamp() const {
+    return min_timestamp_.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] uint64_t MaxTimestamp() const {
+    return max_timestamp_.load(std::memory_order_relaxed);
+  }
 
-  [[nodiscard]] size_t size() const { return data_.size(); }
+  [[nodiscard]] size_t size() const { return size_.load(std::memory_order_acquire); }
   [[nodiscard]] bool at_capacity() const { return size() == kBlockSize; }
 
   [[nodiscard]] const orbit_client_protos::TimerInfo& operator[](std::size_t idx) const {
-    return data_[idx];
+    // Not data_[idx], which could read the size of data_ while it is being appended to.
+    return data_.data()[idx];
   }
 
   // Assuming timers are sorted, returns the first one for which the end timestamp isn't smaller
@@ -69,11 +84,12 @@ class TimerBlock {
   static constexpr size_t kBlockSize = 1024;
 
   TimerBlock* prev_;
-  TimerBlock* next_;
+  std::atomic<TimerBlock*> next_;
   std::vector<orbit_client_protos::TimerInfo> data_;
+  std::atomic<size_t> size_ = 0;
 
-  uint64_t min_timestamp_;
-  uint64_t max_timestamp_;
+  std::atomic<uint64_t> min_timestamp_;
+  std::atomic<uint64_t> max_timestamp_;
 };  // TimerChainIterator iterates over all *blocks* of the chain, not the
 // individual items (TimerInfo instances) that are stored in the blocks (this is
 // different from the BlockIterator in BlockChain.h).
@@ -89,7 +105,7 @@ class TimerChainIterator {
 
   bool operator==(const TimerChainIterator& other) const { return block_ == other.block_; }
   TimerChainIterator& operator++() {
-    block_ = block_->next_;
+    block_ = block_->next_.load(std::memory_order_acquire);
     return *this;
   }
 
@@ -106,6 +122,7 @@ class TimerChainIterator {
 // is a difference compared with BlockChain in how the iterators work: Here,
 // the iterator runs over blocks, in BlockChain the iterator runs over the
 // individually stored elements.
+// Like TimerBlock, a TimerChain supports a single thread appending while other threads read.
 class TimerChain {
  public:
   ~TimerChain();
@@ -117,12 +134,12 @@ class TimerChain {
     if (current_->at_capacity()) AllocateNewBlock();
     const orbit_client_protos::TimerInfo& timer_info =
         current_->emplace_back(std::forward<Args>(args)...);
-    ++num_items_;
+    num_items_.fetch_add(1, std::memory_order_relaxed);
     return timer_info;
   }
 
-  [[nodiscard]] bool empty() const { return num_items_ == 0; }
-  [[nodiscard]] uint64_t size() const { return num_items_; }
+  [[nodiscard]] bool empty() const { return size() == 0; }
+  [[nodiscard]] uint64_t size() const { return num_items_.load(std::memory_order_relaxed); }
 
   [[nodiscard]] const TimerBlock* GetBlockContaining(
       const orbit_client_protos::TimerInfo& element) const;
@@ -140,15 +157,16 @@ class TimerChain {
  private:
   void AllocateNewBlock() {
     ORBIT_CHECK(current_->next_ == nullptr);
-    current_->next_ = new TimerBlock(current_);
-    current_ = current_->next_;
+    auto* new_block = new TimerBlock(current_);
+    current_->next_.store(new_block, std::memory_order_release);
+    current_ = new_block;
     ++num_blocks_;
   }
 
   TimerBlock* root_ = new TimerBlock(/*prev=*/nullptr);
   TimerBlock* current_ = root_;
   uint64_t num_blocks_ = 1;
-  uint64_t num_items_ = 0;
+  std::atomic<uint64_t> num_items_ = 0;
 };
 }  // namespace orbit_client_data
 
@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <limits>
 #include <map>
@@ -21,15 +22,26 @@
 #include "OrbitBase/ThreadConstants.h"
 #include "TimerChain.h"
 #include "TimerDataInterface.h"
+#include "TimerPyramid.h"
 
 namespace orbit_client_data {
 
 // Stores all the timers from a particular TimerTrack and provides queries to get timers in a
 // certain range as well as metadata from them. Timers might be divided in different depths.
+// AddTimer is meant to be called by a single thread, and never waits for the queries, which can be
+// called concurrently from other threads: the timers are stored in append-only TimerChains, which
+// are never removed, and queries only take a lock to find the chain of a depth beyond
+// kNumDepthsWithLockFreeLookup. The same holds for the TimerPyramids, which support a single thread
+// adding timers while others query buckets.
 class TimerData final : public TimerDataInterface {
  public:
+  // Without `build_timer_pyramids`, AddTimer doesn't pay for the TimerPyramids, and their memory
+  // isn't allocated, but GetTimerPyramidBuckets must not be called.
+  explicit TimerData(bool build_timer_pyramids = true)
+      : build_timer_pyramids_{build_timer_pyramids} {}
+
   const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info,
-                                                 uint32_t depth = 0) override;
+                                                 uint32_t depth = 0);
 
   // Timers queries
   [[nodiscard]] std::vector<const TimerChain*> GetChains() const override;
@@ -47,6 +59,13 @@ class TimerData final : public TimerDataInterface {
   // TODO(b/200692451): Provide a better solution for TimerTrack with intersecting timers.
   [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimersAtDepthDiscretized(
       uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const override;
+  // Returns the buckets of `level` of the TimerPyramid of `depth` that intersect
+  // [min_tick, max_tick]. AddTimer keeps the pyramids up to date, so that queries, which are issued
+  // by the render thread, never build them.
+  [[nodiscard]] std::vector<TimerPyramid::Bucket> GetTimerPyramidBuckets(uint32_t depth,
+                                                                         uint32_t level,
+                                                                         uint64_t min_tick,
+                                                                         uint64_t max_tick) const;
 
   // Metadata queries
   [[nodiscard]] bool IsEmpty() const override { return GetNumberOfTimers() == 0; }
@@ -92,17 +111,32 @@ class TimerData final : public TimerDataInterface {
  private:
   void UpdateMinTime(uint64_t min_time);
   void UpdateMaxTime(uint64_t max_time);
-  void UpdateDepth(uint32_t depth) { depth_ = std::max(depth_, depth); }
+  void UpdateDepth(uint32_t depth) {
+    if (depth > depth_.load(std::memory_order_relaxed)) {
+      depth_.store(depth, std::memory_order_relaxed);
+    }
+  }
   [[nodiscard]] TimerChain* GetOrCreateTimerChain(uint64_t depth);
+  [[nodiscard]] const TimerPyramid* GetTimerPyramid(uint32_t depth) const;
+  [[nodiscard]] TimerPyramid* GetOrCreateTimerPyramid(uint32_t depth);
 
-  uint32_t depth_ = 0;
+  std::atomic<uint32_t> depth_ = 0;
   mutable absl::Mutex mutex_;
+  // Owns the chains of all depths.
   std::map<uint32_t, std::unique_ptr<TimerChain>> timers_ ABSL_GUARDED_BY(mutex_);
+  static constexpr uint32_t kNumDepthsWithLockFreeLookup = 64;
+  // The chain of each depth below kNumDepthsWithLockFreeLookup, published when it is created.
+  std::array<std::atomic<TimerChain*>, kNumDepthsWithLockFreeLookup> chains_by_depth_{};
   std::atomic<size_t> num_timers_{0};
   std::atomic<uint64_t> min_time_{std::numeric_limits<uint64_t>::max()};
   std::atomic<uint64_t> max_time_{std::numeric_limits<uint64_t>::min()};
 
-  uint32_t process_id_ = orbit_base::kInvalidProcessId;
+  std::atomic<uint32_t> process_id_ = orbit_base::kInvalidProcessId;
+
+  const bool build_timer_pyramids_;
+  // Like timers_ and chains_by_depth_, for the TimerPyramids.
+  std::map<uint32_t, std::unique_ptr<TimerPyramid>> pyramids_ ABSL_GUARDED_BY(mutex_);
+  std::array<std::atomic<TimerPyramid*>, kNumDepthsWithLockFreeLookup> pyramids_by_depth_{};
 };
 
 }  // namespace orbit_client_data
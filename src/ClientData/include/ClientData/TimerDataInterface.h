@@ -11,14 +11,12 @@
 
 namespace orbit_client_data {
 
-// Interface to be use by TimerDataProvider to access data from TimerTracks.
+// Interface to be use by TimerDataProvider to access data from TimerTracks. Each implementation
+// has its own AddTimer, as they return different handles to the added timer.
 class TimerDataInterface {
  public:
   virtual ~TimerDataInterface() = default;
 
-  virtual const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info,
-                                                         uint32_t depth) = 0;
-
   // Timers queries
   [[nodiscard]] virtual std::vector<const TimerChain*> GetChains() const = 0;
   // Returns all timers contained in [min_tick, max_tick] (always inclusive).
@@ -20,10 +20,10 @@ class TimerDataManager final {
  public:
   TimerDataManager() = default;
 
-  [[nodiscard]] std::pair<uint64_t, TimerData*> CreateTimerData() {
+  [[nodiscard]] std::pair<uint64_t, TimerData*> CreateTimerData(bool build_timer_pyramids = true) {
     absl::MutexLock lock(&mutex_);
     uint64_t id = timer_data_.size();
-    timer_data_.emplace_back(std::make_unique<TimerData>());
+    timer_data_.emplace_back(std::make_unique<TimerData>(build_timer_pyramids));
     return std::make_pair(id, timer_data_.at(id).get());
   }
 
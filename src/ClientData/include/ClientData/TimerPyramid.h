@@ -0,0 +1,107 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_TIMER_PYRAMID_H_
+#define CLIENT_DATA_TIMER_PYRAMID_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "ClientProtos/capture_data.pb.h"
+
+namespace orbit_client_data {
+
+// Summarizes the timers of a single depth at power-of-two time resolutions, so that a zoomed-out
+// track can draw one bucket per pixel instead of visiting every timer. At each level, the timers
+// are grouped in buckets of 2^level nanoseconds by their start timestamp.
+// Timers of the same depth are assumed not to overlap, as a bucket is only found by a query if its
+// timers intersect the queried range or if it is the last bucket before that range.
+// A single thread can add timers while other threads get buckets, without locking: buckets are
+// never moved, and their fields are updated one by one, so a query can return a bucket that doesn't
+// count a timer that is being added yet, but has already been widened to include it.
+class TimerPyramid {
+ public:
+  // When a pixel is narrower than a bucket of the finest level (about 1 ms), the visible timers are
+  // few enough to be drawn one by one. Buckets of the coarsest level are about 18 minutes wide.
+  static constexpr uint32_t kMinLevel = 20;
+  static constexpr uint32_t kMaxLevel = 40;
+  // Only every other level is stored, which about halves the memory of the pyramid, as a timer
+  // takes a bucket in each level unless it shares it with other timers. The buckets of the level
+  // used to draw are then between a quarter of a pixel and a pixel wide.
+  static constexpr uint32_t kLevelStride = 2;
+  static_assert((kMaxLevel - kMinLevel) % kLevelStride == 0);
+
+  struct Bucket {
+    // The bucket contains the timers starting in [index << level, (index + 1) << level).
+    uint64_t index;
+    uint64_t min_start_ns;
+    uint64_t max_end_ns;
+    uint64_t timer_count;
+    // Stands for the function that takes most of the bucket.
+    const orbit_client_protos::TimerInfo* longest_timer;
+  };
+
+  // `timer` must outlive the pyramid. Timers are expected in order of start timestamp: a timer
+  // starting before the last bucket of a level, in a bucket that doesn't exist yet, is added to the
+  // next bucket instead, which then starts earlier than its index implies.
+  void AddTimer(const orbit_client_protos::TimerInfo& timer);
+
+  // Returns the coarsest stored level with buckets no wider than `max_bucket_width_ns`, or
+  // std::nullopt if even the buckets of kMinLevel are wider.
+  [[nodiscard]] static std::optional<uint32_t> GetCoarsestLevelWithBucketWidthAtMost(
+      uint64_t max_bucket_width_ns);
+
+  // Returns the buckets of `level`, which must be a stored level, with timers that intersect
+  // [min_ns, max_ns], ordered by index.
+  [[nodiscard]] std::vector<Bucket> GetBuckets(uint32_t level, uint64_t min_ns,
+                                               uint64_t max_ns) const;
+
+ private:
+  struct StoredBucket {
+    // Set before the bucket is published, and then never changed.
+    uint64_t index = 0;
+    std::atomic<uint64_t> min_start_ns = 0;
+    std::atomic<uint64_t> max_end_ns = 0;
+    std::atomic<uint64_t> timer_count = 0;
+    std::atomic<const orbit_client_protos::TimerInfo*> longest_timer = nullptr;
+  };
+
+  // The buckets of a level, sorted by index and only ever appended. They are stored in blocks that
+  // double in size, so that a level with few buckets takes little memory, and no block is ever
+  // reallocated. A query reads the published buckets while a single thread appends.
+  class Level {
+   public:
+    [[nodiscard]] uint64_t size() const { return size_.load(std::memory_order_acquire); }
+    // `position` must be smaller than a size returned by size().
+    [[nodiscard]] const StoredBucket& operator[](uint64_t position) const;
+    [[nodiscard]] StoredBucket& operator[](uint64_t position);
+    // Returns the position of the first bucket among the first `size` with an index not smaller
+    // than `index`, or `size` if there is none.
+    [[nodiscard]] uint64_t LowerBound(uint64_t index, uint64_t size) const;
+
+    // Only called by the thread that adds timers.
+    void Append(uint64_t index, const orbit_client_protos::TimerInfo& timer);
+
+   private:
+    static constexpr uint64_t kFirstBlockSize = 16;
+    // Enough blocks for any number of buckets that fits in memory.
+    static constexpr size_t kMaxBlockCount = 40;
+
+    // A block is allocated before the first bucket in it is published, so readers can access the
+    // blocks of the published buckets without further synchronization.
+    std::array<std::unique_ptr<StoredBucket[]>, kMaxBlockCount> blocks_;
+    std::atomic<uint64_t> size_ = 0;
+  };
+
+  std::array<Level, (kMaxLevel - kMinLevel) / kLevelStride + 1> levels_;
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_TIMER_PYRAMID_H_
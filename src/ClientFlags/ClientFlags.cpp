@@ -35,6 +35,9 @@ ABSL_FLAG(bool, enable_tracepoint_feature, false,
 ABSL_FLAG(bool, enable_warning_threshold, false,
           "Enable setting and showing the memory warning threshold");
 
+ABSL_FLAG(bool, compress_capture_stream, false,
+          "Ask the service to send the capture events compressed with zlib");
+
 // Additional folder in which OrbitService will look for symbols
 ABSL_FLAG(std::string, instance_symbols_folder, "",
           "Additional folder in which OrbitService will look for symbols");
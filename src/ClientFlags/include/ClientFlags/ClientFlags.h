@@ -35,6 +35,8 @@ ABSL_DECLARE_FLAG(bool, enable_tracepoint_feature);
 // threshold (i.e., production limit).
 ABSL_DECLARE_FLAG(bool, enable_warning_threshold);
 
+ABSL_DECLARE_FLAG(bool, compress_capture_stream);
+
 // additional folder in which OrbitService will look for symbols
 ABSL_DECLARE_FLAG(std::string, instance_symbols_folder);
 
@@ -0,0 +1,163 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "Containers/FlatScopeTree.h"
+#include "Containers/ScopeTree.h"
+
+namespace orbit_containers {
+
+namespace {
+
+struct FlatTestScope {
+  [[nodiscard]] uint64_t start() const { return start_; }
+  [[nodiscard]] uint64_t end() const { return end_; }
+  uint64_t start_;
+  uint64_t end_;
+};
+
+class FlatScopeTreeTest : public ::testing::Test {
+ protected:
+  FlatTestScope* CreateScope(uint64_t start, uint64_t end) {
+    return &scopes_.emplace_back(FlatTestScope{start, end});
+  }
+
+  // Creates properly nested scopes, `num_children` per scope, down to `max_depth`, starting at
+  // `*timestamp`.
+  void CreateNestedScopes(uint32_t max_depth, uint32_t num_children,
+                          std::vector<FlatTestScope*>* scopes, uint64_t* timestamp,
+                          uint32_t depth = 0) {
+    if (depth == max_depth) return;
+    for (uint32_t i = 0; i < num_children; ++i) {
+      const uint64_t start = ++*timestamp;
+      CreateNestedScopes(max_depth, num_children, scopes, timestamp, depth + 1);
+      scopes->push_back(CreateScope(start, ++*timestamp));
+    }
+  }
+
+ private:
+  // std::deque doesn't move its elements when growing at the end.
+  std::deque<FlatTestScope> scopes_;
+};
+
+}  // namespace
+
+TEST_F(FlatScopeTreeTest, EmptyTree) {
+  FlatScopeTree<FlatTestScope> tree;
+  EXPECT_EQ(tree.Size(), 0);
+  EXPECT_EQ(tree.Depth(), 0);
+  EXPECT_TRUE(tree.GetOrderedScopesAtDepth(0).empty());
+  EXPECT_EQ(tree.FindFirstScopeAtOrAfterTime(0, 0), nullptr);
+}
+
+TEST_F(FlatScopeTreeTest, TreeCreation) {
+  std::vector<FlatTestScope*> scopes = {
+      CreateScope(1, 100), CreateScope(1, 9), CreateScope(0, 1),   CreateScope(2, 4),
+      CreateScope(4, 9),   CreateScope(5, 8), CreateScope(0, 200), CreateScope(1, 100)};
+  FlatScopeTree<FlatTestScope> tree(scopes);
+  EXPECT_EQ(tree.Depth(), 6);
+  EXPECT_EQ(tree.Size(), 8);
+
+  // The second (1, 100) scope is the child of the first one.
+  EXPECT_EQ(tree.FindParent(*scopes[0]), scopes[6]);
+  EXPECT_EQ(tree.FindParent(*scopes[7]), scopes[0]);
+  EXPECT_EQ(tree.FindFirstChild(*scopes[7]), scopes[1]);
+  EXPECT_EQ(tree.FindParent(*scopes[6]), nullptr);
+  EXPECT_EQ(tree.FindFirstChild(*scopes[5]), nullptr);
+}
+
+TEST_F(FlatScopeTreeTest, OverlappingTimers) {
+  // Overlapping timers should appear at the same depth.
+  std::vector<FlatTestScope*> scopes = {CreateScope(0, 200), CreateScope(1, 10),
+                                        CreateScope(5, 100), CreateScope(2, 50)};
+  FlatScopeTree<FlatTestScope> tree(scopes);
+  EXPECT_EQ(tree.Depth(), 2);
+  EXPECT_EQ(tree.Size(), 4);
+  EXPECT_EQ(tree.GetOrderedScopesAtDepth(0).size(), 1);
+  EXPECT_EQ(tree.GetOrderedScopesAtDepth(1).size(), 3);
+  EXPECT_EQ(tree.GetOrderedStartsAtDepth(1), (std::vector<uint64_t>{1, 2, 5}));
+}
+
+TEST_F(FlatScopeTreeTest, FindRelationships) {
+  std::vector<FlatTestScope*> depth0 = {CreateScope(0, 49), CreateScope(50, 99)};
+  std::vector<FlatTestScope*> depth1 = {CreateScope(1, 5), CreateScope(7, 10), CreateScope(12, 40),
+                                        CreateScope(55, 58)};
+  std::vector<FlatTestScope*> scopes = depth1;
+  scopes.insert(scopes.end(), depth0.begin(), depth0.end());
+  FlatScopeTree<FlatTestScope> tree(scopes);
+
+  for (const std::vector<FlatTestScope*>& depth : {depth0, depth1}) {
+    for (size_t i = 0; i < depth.size(); ++i) {
+      EXPECT_EQ(tree.FindNextScopeAtDepth(*depth[i]),
+                i + 1 < depth.size() ? depth[i + 1] : nullptr);
+      EXPECT_EQ(tree.FindPreviousScopeAtDepth(*depth[i]), i > 0 ? depth[i - 1] : nullptr);
+    }
+  }
+
+  EXPECT_EQ(tree.FindParent(*depth0[0]), nullptr);
+  EXPECT_EQ(tree.FindParent(*depth1[0]), depth0[0]);
+  EXPECT_EQ(tree.FindParent(*depth1[2]), depth0[0]);
+  EXPECT_EQ(tree.FindParent(*depth1[3]), depth0[1]);
+  EXPECT_EQ(tree.FindFirstChild(*depth0[0]), depth1[0]);
+  EXPECT_EQ(tree.FindFirstChild(*depth0[1]), depth1[3]);
+  EXPECT_EQ(tree.FindFirstChild(*depth1[0]), nullptr);
+
+  EXPECT_EQ(tree.FindFirstScopeAtOrAfterTime(1, 6), depth1[1]);
+  EXPECT_EQ(tree.FindFirstScopeAtOrAfterTime(1, 8), depth1[1]);
+  EXPECT_EQ(tree.FindFirstScopeAtOrAfterTime(1, 41), depth1[3]);
+  EXPECT_EQ(tree.FindFirstScopeAtOrAfterTime(1, 59), nullptr);
+  EXPECT_EQ(tree.FindFirstScopeAtOrAfterTime(2, 0), nullptr);
+}
+
+TEST_F(FlatScopeTreeTest, MatchesScopeTree) {
+  std::vector<FlatTestScope*> scopes;
+  uint64_t timestamp = 0;
+  CreateNestedScopes(/*max_depth=*/6, /*num_children=*/4, &scopes, &timestamp);
+
+  std::mt19937 gen(42);
+  std::shuffle(scopes.begin(), scopes.end(), gen);
+  ScopeTree<FlatTestScope> scope_tree;
+  for (FlatTestScope* scope : scopes) {
+    scope_tree.Insert(scope);
+  }
+  FlatScopeTree<FlatTestScope> flat_scope_tree(scopes);
+
+  // ScopeTree has a dummy root node.
+  ASSERT_EQ(flat_scope_tree.Size(), scope_tree.Size() - 1);
+  ASSERT_EQ(flat_scope_tree.Depth(), scope_tree.Depth());
+  for (uint32_t depth = 0; depth < flat_scope_tree.Depth(); ++depth) {
+    std::vector<const FlatTestScope*> expected_scopes;
+    for (const auto& [unused_start, node] : scope_tree.GetOrderedNodesAtDepth(depth)) {
+      expected_scopes.push_back(node->GetScope());
+    }
+    absl::Span<FlatTestScope* const> actual_scopes =
+        flat_scope_tree.GetOrderedScopesAtDepth(depth);
+    EXPECT_TRUE(std::equal(actual_scopes.begin(), actual_scopes.end(), expected_scopes.begin(),
+                           expected_scopes.end()));
+
+    for (uint64_t time = 0; time <= timestamp + 1; time += 7) {
+      EXPECT_EQ(flat_scope_tree.FindFirstScopeAtOrAfterTime(depth, time),
+                scope_tree.FindFirstScopeAtOrAfterTime(depth, time));
+    }
+  }
+
+  for (const FlatTestScope* scope : scopes) {
+    EXPECT_EQ(flat_scope_tree.FindParent(*scope), scope_tree.FindParent(*scope));
+    EXPECT_EQ(flat_scope_tree.FindFirstChild(*scope), scope_tree.FindFirstChild(*scope));
+    EXPECT_EQ(flat_scope_tree.FindNextScopeAtDepth(*scope),
+              scope_tree.FindNextScopeAtDepth(*scope));
+    EXPECT_EQ(flat_scope_tree.FindPreviousScopeAtDepth(*scope),
+              scope_tree.FindPreviousScopeAtDepth(*scope));
+  }
+}
+
+}  // namespace orbit_containers
@@ -0,0 +1,230 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTAINERS_FLAT_SCOPE_TREE_H_
+#define CONTAINERS_FLAT_SCOPE_TREE_H_
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+#include <absl/types/span.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Introspection/Introspection.h"
+#include "OrbitBase/Logging.h"
+
+namespace orbit_containers {
+
+// FlatScopeTree provides the same hierarchy and queries as ScopeTree, but it is built at once from
+// all the scopes and stored in a few contiguous arrays instead of individually allocated nodes and
+// btree_maps. This makes it much faster to build and much smaller, which matters for loaded
+// captures with tens of millions of scopes, whose scopes are all known upfront.
+//
+// The nodes are stored in pre-order, i.e., sorted by start time and, for equal start times, by
+// decreasing end time, so that the descendants of a node are the nodes right after it, up to the
+// end of its subtree. The nodes of each depth are additionally referenced from a column of start
+// timestamps and a column of scopes, both sorted by start time.
+//
+// Unlike ScopeTree, there is no dummy root node: depth 0 contains the outermost scopes and Size()
+// is the number of scopes. For properly nested scopes, both trees are the same. Like in ScopeTree,
+// a scope that overlaps the previous one without being enclosed by it is placed at the same depth.
+// The underlying scope type needs to define the "uint64_t start()" and "uint64_t end()" methods.
+// FlatScopeTree is immutable once built, and therefore can be queried concurrently.
+template <typename ScopeT>
+class FlatScopeTree {
+ public:
+  FlatScopeTree() = default;
+  explicit FlatScopeTree(std::vector<ScopeT*> scopes);
+
+  [[nodiscard]] size_t Size() const { return nodes_.size(); }
+  [[nodiscard]] uint32_t Depth() const { return depths_.size(); }
+  [[nodiscard]] std::string ToString() const;
+
+  // Returns the scopes at `depth`, sorted by start time.
+  [[nodiscard]] absl::Span<ScopeT* const> GetOrderedScopesAtDepth(uint32_t depth) const;
+  // Returns the start timestamps of the scopes returned by GetOrderedScopesAtDepth.
+  [[nodiscard]] absl::Span<const uint64_t> GetOrderedStartsAtDepth(uint32_t depth) const;
+
+  [[nodiscard]] const ScopeT* FindFirstScopeAtOrAfterTime(uint32_t depth, uint64_t time) const;
+  [[nodiscard]] const ScopeT* FindNextScopeAtDepth(const ScopeT& scope) const;
+  [[nodiscard]] const ScopeT* FindPreviousScopeAtDepth(const ScopeT& scope) const;
+  [[nodiscard]] const ScopeT* FindParent(const ScopeT& scope) const;
+  [[nodiscard]] const ScopeT* FindFirstChild(const ScopeT& scope) const;
+
+  [[nodiscard]] size_t GetMemoryUsageBytes() const;
+
+ private:
+  static constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+
+  struct Node {
+    ScopeT* scope;
+    uint32_t parent_index;
+    // Index of the first node after the subtree of this node.
+    uint32_t subtree_end_index;
+    uint32_t depth;
+    // Position of this node in the columns of its depth.
+    uint32_t index_at_depth;
+  };
+
+  struct DepthColumns {
+    std::vector<uint64_t> starts;
+    std::vector<ScopeT*> scopes;
+  };
+
+  [[nodiscard]] const Node* FindNode(const ScopeT& scope) const;
+
+  std::vector<Node> nodes_;
+  std::vector<DepthColumns> depths_;
+};
+
+template <typename ScopeT>
+FlatScopeTree<ScopeT>::FlatScopeTree(std::vector<ScopeT*> scopes) {
+  ORBIT_SCOPE_FUNCTION;
+  ORBIT_CHECK(scopes.size() < kNoParent);
+
+  // Pre-order. Among identical scopes, the first one is the parent of the next, like in ScopeTree.
+  std::stable_sort(scopes.begin(), scopes.end(), [](const ScopeT* lhs, const ScopeT* rhs) {
+    if (lhs->start() != rhs->start()) return lhs->start() < rhs->start();
+    return lhs->end() > rhs->end();
+  });
+
+  nodes_.reserve(scopes.size());
+  // Indices of the nodes enclosing the current node, from the outermost one.
+  std::vector<uint32_t> ancestors;
+  for (ScopeT* scope : scopes) {
+    const auto node_index = static_cast<uint32_t>(nodes_.size());
+    // The previous nodes all start before or at the same time as this one, so they enclose it if
+    // they end after or at the same time.
+    while (!ancestors.empty() && nodes_[ancestors.back()].scope->end() < scope->end()) {
+      nodes_[ancestors.back()].subtree_end_index = node_index;
+      ancestors.pop_back();
+    }
+
+    const auto depth = static_cast<uint32_t>(ancestors.size());
+    if (depth == depths_.size()) depths_.emplace_back();
+    DepthColumns& depth_columns = depths_[depth];
+    const uint32_t parent_index = ancestors.empty() ? kNoParent : ancestors.back();
+    nodes_.push_back(Node{scope, parent_index, /*subtree_end_index=*/0, depth,
+                          static_cast<uint32_t>(depth_columns.scopes.size())});
+    depth_columns.starts.push_back(scope->start());
+    depth_columns.scopes.push_back(scope);
+    ancestors.push_back(node_index);
+  }
+  for (uint32_t ancestor_index : ancestors) {
+    nodes_[ancestor_index].subtree_end_index = nodes_.size();
+  }
+}
+
+template <typename ScopeT>
+const typename FlatScopeTree<ScopeT>::Node* FlatScopeTree<ScopeT>::FindNode(
+    const ScopeT& scope) const {
+  auto node_it = std::lower_bound(
+      nodes_.begin(), nodes_.end(), scope,
+      [](const Node& node, const ScopeT& scope) { return node.scope->start() < scope.start(); });
+  // Prefer the node of this very scope among identical ones.
+  const Node* first_identical_node = nullptr;
+  for (; node_it != nodes_.end() && node_it->scope->start() == scope.start(); ++node_it) {
+    if (node_it->scope == &scope) return &*node_it;
+    if (first_identical_node == nullptr && node_it->scope->end() == scope.end()) {
+      first_identical_node = &*node_it;
+    }
+  }
+  return first_identical_node;
+}
+
+template <typename ScopeT>
+absl::Span<ScopeT* const> FlatScopeTree<ScopeT>::GetOrderedScopesAtDepth(uint32_t depth) const {
+  if (depth >= depths_.size()) return {};
+  return depths_[depth].scopes;
+}
+
+template <typename ScopeT>
+absl::Span<const uint64_t> FlatScopeTree<ScopeT>::GetOrderedStartsAtDepth(uint32_t depth) const {
+  if (depth >= depths_.size()) return {};
+  return depths_[depth].starts;
+}
+
+template <typename ScopeT>
+const ScopeT* FlatScopeTree<ScopeT>::FindFirstScopeAtOrAfterTime(uint32_t depth,
+                                                                 uint64_t time) const {
+  if (depth >= depths_.size()) return nullptr;
+  const DepthColumns& depth_columns = depths_[depth];
+
+  // Find the first node after the provided time.
+  size_t index = std::upper_bound(depth_columns.starts.begin(), depth_columns.starts.end(), time) -
+                 depth_columns.starts.begin();
+
+  // The previous node could also have its ending after the provided time. As in ScopeTree, we miss
+  // overlapping scopes before it.
+  if (index > 0 && depth_columns.scopes[index - 1]->end() >= time) --index;
+
+  if (index == depth_columns.scopes.size()) return nullptr;
+  return depth_columns.scopes[index];
+}
+
+template <typename ScopeT>
+const ScopeT* FlatScopeTree<ScopeT>::FindNextScopeAtDepth(const ScopeT& scope) const {
+  const Node* node = FindNode(scope);
+  ORBIT_CHECK(node != nullptr);
+  const std::vector<ScopeT*>& scopes_at_depth = depths_[node->depth].scopes;
+  if (node->index_at_depth + 1 == scopes_at_depth.size()) return nullptr;
+  return scopes_at_depth[node->index_at_depth + 1];
+}
+
+template <typename ScopeT>
+const ScopeT* FlatScopeTree<ScopeT>::FindPreviousScopeAtDepth(const ScopeT& scope) const {
+  const Node* node = FindNode(scope);
+  ORBIT_CHECK(node != nullptr);
+  if (node->index_at_depth == 0) return nullptr;
+  return depths_[node->depth].scopes[node->index_at_depth - 1];
+}
+
+template <typename ScopeT>
+const ScopeT* FlatScopeTree<ScopeT>::FindParent(const ScopeT& scope) const {
+  const Node* node = FindNode(scope);
+  ORBIT_CHECK(node != nullptr);
+  if (node->parent_index == kNoParent) return nullptr;
+  return nodes_[node->parent_index].scope;
+}
+
+template <typename ScopeT>
+const ScopeT* FlatScopeTree<ScopeT>::FindFirstChild(const ScopeT& scope) const {
+  const Node* node = FindNode(scope);
+  ORBIT_CHECK(node != nullptr);
+  // In pre-order, the first child is right after its parent, if the subtree isn't empty.
+  const size_t node_index = node - nodes_.data();
+  if (node_index + 1 == node->subtree_end_index) return nullptr;
+  return nodes_[node_index + 1].scope;
+}
+
+template <typename ScopeT>
+size_t FlatScopeTree<ScopeT>::GetMemoryUsageBytes() const {
+  size_t memory_usage_bytes =
+      sizeof(*this) + nodes_.capacity() * sizeof(Node) + depths_.capacity() * sizeof(DepthColumns);
+  for (const DepthColumns& depth_columns : depths_) {
+    memory_usage_bytes += depth_columns.starts.capacity() * sizeof(uint64_t) +
+                          depth_columns.scopes.capacity() * sizeof(ScopeT*);
+  }
+  return memory_usage_bytes;
+}
+
+template <typename ScopeT>
+std::string FlatScopeTree<ScopeT>::ToString() const {
+  std::string result = absl::StrFormat("FlatScopeTree %u nodes depth=%u:\n", Size(), Depth());
+  for (const Node& node : nodes_) {
+    absl::StrAppend(&result, absl::StrFormat("d%u %s [%lu, %lu]\n", node.depth,
+                                             std::string(node.depth, ' '), node.scope->start(),
+                                             node.scope->end()));
+  }
+  return result;
+}
+
+}  // namespace orbit_containers
+
+#endif  // CONTAINERS_FLAT_SCOPE_TREE_H_
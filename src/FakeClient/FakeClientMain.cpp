@@ -369,6 +369,30 @@ int main(int argc, char* argv[]) {
   options.enable_api = absl::GetFlag(FLAGS_orbit_api);
   ORBIT_LOG("enable_api=%d", options.enable_api);
   options.enable_introspection = false;
+  options.ring_buffer_wakeup_method = absl::GetFlag(FLAGS_event_driven_wakeup)
+                                          ? CaptureOptions::kRingBufferWakeupEventDriven
+                                          : CaptureOptions::kRingBufferWakeupPolling;
+  ORBIT_LOG("ring_buffer_wakeup_method=%s",
+            options.ring_buffer_wakeup_method == CaptureOptions::kRingBufferWakeupEventDriven
+                ? "event-driven"
+                : "polling");
+  options.ring_buffer_reader_thread_count = absl::GetFlag(FLAGS_ring_buffer_reader_threads);
+  ORBIT_LOG("ring_buffer_reader_thread_count=%u", options.ring_buffer_reader_thread_count);
+  options.event_processing_delay_mode = absl::GetFlag(FLAGS_stream_watermark_processing)
+                                            ? CaptureOptions::kEventProcessingStreamWatermark
+                                            : CaptureOptions::kEventProcessingFixedDelay;
+  ORBIT_LOG("event_processing_delay_mode=%s",
+            options.event_processing_delay_mode == CaptureOptions::kEventProcessingStreamWatermark
+                ? "stream watermark"
+                : "fixed delay");
+  options.unwinding_thread_count = absl::GetFlag(FLAGS_unwinding_threads);
+  ORBIT_LOG("unwinding_thread_count=%u", options.unwinding_thread_count);
+  options.capture_stream_compression = absl::GetFlag(FLAGS_compress_capture_stream)
+                                           ? CaptureOptions::kCaptureStreamZlib
+                                           : CaptureOptions::kCaptureStreamNoCompression;
+  ORBIT_LOG("capture_stream_compression=%s",
+            options.capture_stream_compression == CaptureOptions::kCaptureStreamZlib ? "zlib"
+                                                                                     : "none");
   constexpr uint64_t kMaxLocalMarkerDepthPerCommandBuffer = std::numeric_limits<uint64_t>::max();
   options.max_local_marker_depth_per_command_buffer = kMaxLocalMarkerDepthPerCommandBuffer;
   options.collect_memory_info = absl::GetFlag(FLAGS_memory_sampling_rate) > 0;
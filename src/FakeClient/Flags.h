@@ -55,6 +55,17 @@ ABSL_FLAG(bool, gpu_jobs, true, "Collect GPU jobs");
 ABSL_FLAG(bool, orbit_api, false, "Enable Orbit API");
 ABSL_FLAG(uint16_t, memory_sampling_rate, 0,
           "Memory usage sampling rate in samples per second (0: no sampling)");
+ABSL_FLAG(bool, event_driven_wakeup, false,
+          "Wait on the perf_event_open ring buffers with epoll instead of polling them");
+ABSL_FLAG(uint32_t, ring_buffer_reader_threads, 1,
+          "Number of threads reading the perf_event_open ring buffers, sharded by CPU");
+ABSL_FLAG(bool, stream_watermark_processing, false,
+          "Process events as soon as all active ring buffers have advanced past them instead of "
+          "after a fixed delay");
+ABSL_FLAG(uint32_t, unwinding_threads, 1,
+          "Number of threads unwinding stack samples with DWARF information");
+ABSL_FLAG(bool, compress_capture_stream, false,
+          "Ask the service to send the capture events compressed with zlib");
 ABSL_FLAG(bool, frame_time, true, "Instrument vkQueuePresentKHR to compute avg. frame time");
 ABSL_FLAG(EventProcessorType, event_processor, EventProcessorType::kFake, "");
 ABSL_FLAG(std::string, pid_file_path, "",
@@ -37,6 +37,8 @@ grpc::Status LinuxCaptureService::Capture(
           reader_writer);
   const orbit_grpc_protos::CaptureOptions& capture_options =
       grpc_start_stop_capture_request_waiter->WaitForStartCaptureRequest();
+  grpc_client_capture_event_collector.SetCaptureStreamCompression(
+      capture_options.capture_stream_compression());
   DoCapture(capture_options, grpc_start_stop_capture_request_waiter);
 
   return grpc::Status::OK;
@@ -42,6 +42,7 @@
 #include "OrbitBase/ThreadUtils.h"
 #include "ProducerEventProcessor/ClientCaptureEventCollector.h"
 #include "ProducerEventProcessor/ProducerEventProcessor.h"
+#include "SamplingRateThrottler.h"
 #include "TracingHandler.h"
 #include "UserSpaceInstrumentationAddressesImpl.h"
 
@@ -247,7 +248,8 @@ TargetProcessStateAfterCapture GetTargetProcessStateAfterCapture(
 
 CaptureServiceBase::StopCaptureReason
 LinuxCaptureServiceBase::WaitForStopCaptureRequestOrMemoryThresholdExceeded(
-    const std::shared_ptr<StopCaptureRequestWaiter>& stop_capture_request_waiter) {
+    const std::shared_ptr<StopCaptureRequestWaiter>& stop_capture_request_waiter,
+    TracingHandler* tracing_handler_to_throttle) {
   // wait_for_stop_capture_request_thread_ below outlives this method, hence the shared pointers.
   auto stop_capture_mutex = std::make_shared<absl::Mutex>();
   auto stop_capture = std::make_shared<bool>(false);
@@ -281,6 +283,7 @@ LinuxCaptureServiceBase::WaitForStopCaptureRequestOrMemoryThresholdExceeded(
   static const uint64_t kWatchdogThresholdBytes = kMemTotalBytes / 2;
   ORBIT_LOG("Starting memory watchdog with threshold %u B because total physical memory is %u B",
             kWatchdogThresholdBytes, kMemTotalBytes);
+  SamplingRateThrottler sampling_rate_throttler;
   while (true) {
     {
       absl::MutexLock lock{stop_capture_mutex.get()};
@@ -292,6 +295,34 @@ LinuxCaptureServiceBase::WaitForStopCaptureRequestOrMemoryThresholdExceeded(
       }
     }
 
+    // Rather than letting the events that can't be sent to the client fast enough accumulate until
+    // the memory threshold is exceeded, produce fewer of them.
+    if (tracing_handler_to_throttle != nullptr) {
+      const ClientCaptureEventCollector::Backlog backlog =
+          client_capture_event_collector_->GetBacklog();
+      std::optional<uint32_t> new_sampling_rate_divisor = sampling_rate_throttler.Update(backlog);
+      if (new_sampling_rate_divisor.has_value()) {
+        tracing_handler_to_throttle->SetSamplingRateDivisor(new_sampling_rate_divisor.value());
+        std::string message;
+        if (new_sampling_rate_divisor.value() > 1) {
+          message = absl::StrFormat(
+              "%.1f MB of capture data, the oldest from %.1f s ago, are waiting to be sent to the "
+              "client: the sampling rate is now 1/%u of the requested one.",
+              static_cast<double>(backlog.size_bytes) / 1024 / 1024,
+              absl::ToDoubleSeconds(backlog.oldest_event_age), new_sampling_rate_divisor.value());
+        } else {
+          message =
+              "The capture data is being sent to the client fast enough again: the sampling rate "
+              "is back to the requested one.";
+        }
+        ORBIT_LOG("%s", message);
+        producer_event_processor_->ProcessEvent(
+            orbit_grpc_protos::kRootProducerId,
+            orbit_capture_service_base::CreateWarningEvent(orbit_base::CaptureTimestampNs(),
+                                                           std::move(message)));
+      }
+    }
+
     // Repeatedly poll the resident set size (rss) of the current process (OrbitService).
     std::optional<uint64_t> rss_bytes = ReadRssInBytesFromProcPidStat();
     if (!rss_bytes.has_value()) {
@@ -417,7 +448,9 @@ void LinuxCaptureServiceBase::DoCapture(
   }
 
   StopCaptureReason stop_capture_reason =
-      WaitForStopCaptureRequestOrMemoryThresholdExceeded(stop_capture_request_waiter);
+      WaitForStopCaptureRequestOrMemoryThresholdExceeded(
+          stop_capture_request_waiter,
+          capture_options.samples_per_second() > 0 ? &tracing_handler : nullptr);
 
   // Disable Orbit API in tracee.
   if (capture_options.enable_api()) {
@@ -0,0 +1,28 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "SamplingRateThrottler.h"
+
+#include <algorithm>
+
+namespace orbit_linux_capture_service {
+
+std::optional<uint32_t> SamplingRateThrottler::Update(
+    const orbit_producer_event_processor::ClientCaptureEventCollector::Backlog& backlog) {
+  const uint32_t previous_divisor = divisor_;
+  if (backlog.size_bytes > kThrottleBacklogSizeBytes ||
+      backlog.oldest_event_age > kThrottleOldestEventAge) {
+    divisor_ = std::min(divisor_ * 2, kMaxDivisor);
+  } else if (backlog.size_bytes < kRestoreBacklogSizeBytes &&
+             backlog.oldest_event_age < kRestoreOldestEventAge) {
+    divisor_ = std::max(divisor_ / 2, 1U);
+  }
+
+  if (divisor_ == previous_divisor) {
+    return std::nullopt;
+  }
+  return divisor_;
+}
+
+}  // namespace orbit_linux_capture_service
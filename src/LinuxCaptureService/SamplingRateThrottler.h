@@ -0,0 +1,42 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_CAPTURE_SERVICE_SAMPLING_RATE_THROTTLER_H_
+#define LINUX_CAPTURE_SERVICE_SAMPLING_RATE_THROTTLER_H_
+
+#include <absl/time/time.h>
+#include <stdint.h>
+
+#include <optional>
+
+#include "ProducerEventProcessor/ClientCaptureEventCollector.h"
+
+namespace orbit_linux_capture_service {
+
+// Decides by how much to divide the sampling rate of a capture, given how many events are waiting
+// to be sent to the client. When the backlog grows too large or too old, the divisor is doubled at
+// every update, up to kMaxDivisor. When the backlog has drained, the divisor is halved at every
+// update, back to 1. The thresholds for the two directions are far apart, so that the sampling rate
+// doesn't oscillate.
+class SamplingRateThrottler {
+ public:
+  // Returns the new divisor if it changed.
+  [[nodiscard]] std::optional<uint32_t> Update(
+      const orbit_producer_event_processor::ClientCaptureEventCollector::Backlog& backlog);
+
+  [[nodiscard]] uint32_t GetDivisor() const { return divisor_; }
+
+  static constexpr uint32_t kMaxDivisor = 16;
+  static constexpr uint64_t kThrottleBacklogSizeBytes = 256ULL * 1024 * 1024;
+  static constexpr absl::Duration kThrottleOldestEventAge = absl::Seconds(5);
+  static constexpr uint64_t kRestoreBacklogSizeBytes = 32ULL * 1024 * 1024;
+  static constexpr absl::Duration kRestoreOldestEventAge = absl::Seconds(1);
+
+ private:
+  uint32_t divisor_ = 1;
+};
+
+}  // namespace orbit_linux_capture_service
+
+#endif  // LINUX_CAPTURE_SERVICE_SAMPLING_RATE_THROTTLER_H_
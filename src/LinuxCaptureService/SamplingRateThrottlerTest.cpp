@@ -0,0 +1,56 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/time/time.h>
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "SamplingRateThrottler.h"
+
+namespace orbit_linux_capture_service {
+
+namespace {
+
+using Backlog = orbit_producer_event_processor::ClientCaptureEventCollector::Backlog;
+
+constexpr Backlog kLargeBacklog{SamplingRateThrottler::kThrottleBacklogSizeBytes + 1,
+                                absl::ZeroDuration()};
+const Backlog kOldBacklog{0, SamplingRateThrottler::kThrottleOldestEventAge + absl::Seconds(1)};
+constexpr Backlog kMediumBacklog{SamplingRateThrottler::kRestoreBacklogSizeBytes,
+                                 absl::ZeroDuration()};
+constexpr Backlog kEmptyBacklog{};
+
+}  // namespace
+
+TEST(SamplingRateThrottler, DivisorDoublesWhileTheBacklogIsTooLargeOrTooOld) {
+  SamplingRateThrottler throttler;
+  EXPECT_EQ(throttler.GetDivisor(), 1);
+
+  EXPECT_EQ(throttler.Update(kEmptyBacklog), std::nullopt);
+  EXPECT_EQ(throttler.Update(kLargeBacklog), 2);
+  EXPECT_EQ(throttler.Update(kOldBacklog), 4);
+  EXPECT_EQ(throttler.Update(kLargeBacklog), 8);
+  EXPECT_EQ(throttler.Update(kLargeBacklog), 16);
+  EXPECT_EQ(throttler.Update(kLargeBacklog), std::nullopt);
+  EXPECT_EQ(throttler.GetDivisor(), SamplingRateThrottler::kMaxDivisor);
+}
+
+TEST(SamplingRateThrottler, DivisorHalvesOnlyOnceTheBacklogHasDrained) {
+  SamplingRateThrottler throttler;
+  EXPECT_EQ(throttler.Update(kLargeBacklog), 2);
+  EXPECT_EQ(throttler.Update(kLargeBacklog), 4);
+
+  EXPECT_EQ(throttler.Update(kMediumBacklog), std::nullopt);
+  EXPECT_EQ(throttler.Update(Backlog{0, SamplingRateThrottler::kRestoreOldestEventAge}),
+            std::nullopt);
+  EXPECT_EQ(throttler.GetDivisor(), 4);
+
+  EXPECT_EQ(throttler.Update(kEmptyBacklog), 2);
+  EXPECT_EQ(throttler.Update(kEmptyBacklog), 1);
+  EXPECT_EQ(throttler.Update(kEmptyBacklog), std::nullopt);
+  EXPECT_EQ(throttler.GetDivisor(), 1);
+}
+
+}  // namespace orbit_linux_capture_service
@@ -13,11 +13,13 @@
 
 namespace orbit_linux_capture_service {
 
+using orbit_grpc_protos::CallstackSample;
 using orbit_grpc_protos::CaptureOptions;
 using orbit_grpc_protos::FullAddressInfo;
 using orbit_grpc_protos::FullCallstackSample;
 using orbit_grpc_protos::FullGpuJob;
 using orbit_grpc_protos::FunctionCall;
+using orbit_grpc_protos::InternedCallstack;
 using orbit_grpc_protos::ProducerCaptureEvent;
 using orbit_grpc_protos::SchedulingSlice;
 using orbit_grpc_protos::ThreadName;
@@ -58,8 +60,22 @@ void TracingHandler::OnThreadStateSliceCallstack(ThreadStateSliceCallstack calls
 }
 
 void TracingHandler::OnCallstackSample(FullCallstackSample callstack_sample) {
+  auto [callstack_id, assigned] = callstack_interner_.GetOrAssignId(callstack_sample.callstack());
+  if (assigned) {
+    ProducerCaptureEvent interned_callstack_event;
+    InternedCallstack* interned_callstack = interned_callstack_event.mutable_interned_callstack();
+    interned_callstack->set_key(callstack_id);
+    interned_callstack->set_allocated_intern(callstack_sample.release_callstack());
+    producer_event_processor_->ProcessEvent(kLinuxTracingProducerId,
+                                            std::move(interned_callstack_event));
+  }
+
   ProducerCaptureEvent event;
-  *event.mutable_full_callstack_sample() = std::move(callstack_sample);
+  CallstackSample* compact_callstack_sample = event.mutable_callstack_sample();
+  compact_callstack_sample->set_pid(callstack_sample.pid());
+  compact_callstack_sample->set_tid(callstack_sample.tid());
+  compact_callstack_sample->set_timestamp_ns(callstack_sample.timestamp_ns());
+  compact_callstack_sample->set_callstack_id(callstack_id);
   producer_event_processor_->ProcessEvent(kLinuxTracingProducerId, std::move(event));
 }
 
@@ -15,6 +15,7 @@
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
 #include "Introspection/Introspection.h"
+#include "LinuxTracing/CallstackInterner.h"
 #include "LinuxTracing/Tracer.h"
 #include "LinuxTracing/TracerListener.h"
 #include "OrbitBase/Logging.h"
@@ -73,8 +74,17 @@ class TracingHandler : public orbit_linux_tracing::TracerListener {
     tracer_->ProcessFunctionExit(function_exit);
   }
 
+  // Must be called between Start and Stop.
+  void SetSamplingRateDivisor(uint32_t divisor) {
+    ORBIT_CHECK(tracer_ != nullptr);
+    tracer_->SetSamplingRateDivisor(divisor);
+  }
+
  private:
   orbit_producer_event_processor::ProducerEventProcessor* producer_event_processor_;
+  // Callstacks are interned here, rather than only in the ProducerEventProcessor, so that samples
+  // with a callstack that was already seen are forwarded as small CallstackSamples.
+  orbit_linux_tracing::CallstackInterner callstack_interner_;
   std::unique_ptr<orbit_linux_tracing::Tracer> tracer_;
 };
 
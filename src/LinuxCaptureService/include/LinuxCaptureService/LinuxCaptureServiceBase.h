@@ -23,6 +23,8 @@
 
 namespace orbit_linux_capture_service {
 
+class TracingHandler;
+
 // This class is gRPC-free and provides common functionality that is shared by the native Orbit
 // Linux capture service and the cloud collector.
 class LinuxCaptureServiceBase : public orbit_capture_service_base::CaptureServiceBase {
@@ -56,9 +58,12 @@ class LinuxCaptureServiceBase : public orbit_capture_service_base::CaptureServic
   //   CloudCollectorStartStopCaptureRequestWaiter::StopCapture is called.
   // - The resident set size of the current process exceeds the threshold (i.e., total physical
   //   memory / 2).
+  // In the meantime, if tracing_handler_to_throttle is not nullptr, its sampling rate is lowered
+  // while the events can't be sent to the client fast enough, and restored when they can again.
   [[nodiscard]] StopCaptureReason WaitForStopCaptureRequestOrMemoryThresholdExceeded(
       const std::shared_ptr<orbit_capture_service_base::StopCaptureRequestWaiter>&
-          stop_capture_request_waiter);
+          stop_capture_request_waiter,
+      TracingHandler* tracing_handler_to_throttle);
   std::thread wait_for_stop_capture_request_thread_;
 };
 
@@ -0,0 +1,104 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "LinuxTracing/CallstackInterner.h"
+
+#include <absl/hash/hash.h>
+#include <absl/types/span.h>
+
+#include <vector>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_linux_tracing {
+
+using orbit_grpc_protos::Callstack;
+
+namespace {
+
+struct CallstackKey {
+  std::vector<uint64_t> pcs;
+  Callstack::CallstackType type;
+};
+
+// Allows looking up a Callstack without copying its pcs into a CallstackKey.
+struct CallstackKeyView {
+  absl::Span<const uint64_t> pcs;
+  Callstack::CallstackType type;
+};
+
+struct CallstackKeyHash {
+  using is_transparent = void;
+  size_t operator()(const CallstackKeyView& key) const { return absl::HashOf(key.pcs, key.type); }
+  size_t operator()(const CallstackKey& key) const {
+    return (*this)(CallstackKeyView{key.pcs, key.type});
+  }
+};
+
+struct CallstackKeyEq {
+  using is_transparent = void;
+  static CallstackKeyView ToView(const CallstackKey& key) { return {key.pcs, key.type}; }
+  static CallstackKeyView ToView(const CallstackKeyView& key) { return key; }
+  template <typename Lhs, typename Rhs>
+  bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+    CallstackKeyView lhs_view = ToView(lhs);
+    CallstackKeyView rhs_view = ToView(rhs);
+    return lhs_view.type == rhs_view.type && lhs_view.pcs == rhs_view.pcs;
+  }
+};
+
+std::atomic<uint64_t> next_instance_id = 1;
+
+struct ThreadLocalTableCache {
+  uint64_t instance_id = 0;
+  void* table = nullptr;
+};
+thread_local ThreadLocalTableCache thread_local_table_cache;
+
+}  // namespace
+
+class CallstackInterner::Table {
+ public:
+  absl::flat_hash_map<CallstackKey, uint64_t, CallstackKeyHash, CallstackKeyEq> callstack_to_id;
+};
+
+CallstackInterner::CallstackInterner() : instance_id_{next_instance_id++} {}
+
+CallstackInterner::~CallstackInterner() = default;
+
+CallstackInterner::Table* CallstackInterner::GetTableOfCurrentThread() {
+  if (thread_local_table_cache.instance_id == instance_id_) {
+    return static_cast<Table*>(thread_local_table_cache.table);
+  }
+
+  Table* table;
+  {
+    absl::MutexLock lock{&mutex_};
+    std::unique_ptr<Table>& table_of_thread = thread_id_to_table_[std::this_thread::get_id()];
+    if (table_of_thread == nullptr) {
+      table_of_thread = std::make_unique<Table>();
+    }
+    table = table_of_thread.get();
+  }
+  thread_local_table_cache.instance_id = instance_id_;
+  thread_local_table_cache.table = table;
+  return table;
+}
+
+std::pair<uint64_t, bool> CallstackInterner::GetOrAssignId(const Callstack& callstack) {
+  Table* table = GetTableOfCurrentThread();
+  const CallstackKeyView key_view{absl::MakeConstSpan(callstack.pcs()), callstack.type()};
+  auto it = table->callstack_to_id.find(key_view);
+  if (it != table->callstack_to_id.end()) {
+    return {it->second, false};
+  }
+
+  const uint64_t id = next_callstack_id_.fetch_add(1, std::memory_order_relaxed);
+  auto [unused_it, inserted] = table->callstack_to_id.emplace(
+      CallstackKey{{callstack.pcs().begin(), callstack.pcs().end()}, callstack.type()}, id);
+  ORBIT_CHECK(inserted);
+  return {id, true};
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,100 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/container/flat_hash_set.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "GrpcProtos/capture.pb.h"
+#include "LinuxTracing/CallstackInterner.h"
+
+namespace orbit_linux_tracing {
+
+using orbit_grpc_protos::Callstack;
+
+namespace {
+
+Callstack MakeCallstack(const std::vector<uint64_t>& pcs, Callstack::CallstackType type) {
+  Callstack callstack;
+  *callstack.mutable_pcs() = {pcs.begin(), pcs.end()};
+  callstack.set_type(type);
+  return callstack;
+}
+
+}  // namespace
+
+TEST(CallstackInterner, SameCallstackGetsTheSameId) {
+  CallstackInterner interner;
+  auto [id1, assigned1] =
+      interner.GetOrAssignId(MakeCallstack({0x10, 0x20, 0x30}, Callstack::kComplete));
+  auto [id2, assigned2] =
+      interner.GetOrAssignId(MakeCallstack({0x10, 0x20, 0x30}, Callstack::kComplete));
+  EXPECT_EQ(id1, 1);
+  EXPECT_TRUE(assigned1);
+  EXPECT_EQ(id2, id1);
+  EXPECT_FALSE(assigned2);
+}
+
+TEST(CallstackInterner, DifferentFramesOrTypesGetDifferentIds) {
+  CallstackInterner interner;
+  auto [id1, assigned1] =
+      interner.GetOrAssignId(MakeCallstack({0x10, 0x20, 0x30}, Callstack::kComplete));
+  auto [id2, assigned2] = interner.GetOrAssignId(MakeCallstack({0x10, 0x20}, Callstack::kComplete));
+  auto [id3, assigned3] =
+      interner.GetOrAssignId(MakeCallstack({0x10, 0x20, 0x30}, Callstack::kDwarfUnwindingError));
+  auto [id4, assigned4] = interner.GetOrAssignId(MakeCallstack({}, Callstack::kInUprobes));
+  EXPECT_TRUE(assigned1);
+  EXPECT_TRUE(assigned2);
+  EXPECT_TRUE(assigned3);
+  EXPECT_TRUE(assigned4);
+  EXPECT_EQ((absl::flat_hash_set<uint64_t>{id1, id2, id3, id4}).size(), 4);
+}
+
+TEST(CallstackInterner, InstancesAreIndependent) {
+  CallstackInterner interner1;
+  CallstackInterner interner2;
+  const Callstack callstack = MakeCallstack({0x10, 0x20, 0x30}, Callstack::kComplete);
+  EXPECT_EQ(interner1.GetOrAssignId(callstack), std::make_pair(uint64_t{1}, true));
+  EXPECT_EQ(interner2.GetOrAssignId(callstack), std::make_pair(uint64_t{1}, true));
+  EXPECT_EQ(interner1.GetOrAssignId(callstack), std::make_pair(uint64_t{1}, false));
+  EXPECT_EQ(interner2.GetOrAssignId(callstack), std::make_pair(uint64_t{1}, false));
+}
+
+TEST(CallstackInterner, IdsAreUniqueAcrossThreads) {
+  CallstackInterner interner;
+  constexpr size_t kThreadCount = 4;
+  constexpr uint64_t kCallstackCount = 1000;
+  std::vector<std::vector<std::pair<uint64_t, bool>>> results_per_thread(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+    threads.emplace_back([&interner, &results = results_per_thread[thread_index]] {
+      // Each callstack is passed twice by each thread.
+      for (uint64_t i = 0; i < 2 * kCallstackCount; ++i) {
+        results.push_back(interner.GetOrAssignId(
+            MakeCallstack({i % kCallstackCount, 0x42}, Callstack::kComplete)));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  absl::flat_hash_set<uint64_t> all_ids;
+  for (const std::vector<std::pair<uint64_t, bool>>& results : results_per_thread) {
+    ASSERT_EQ(results.size(), 2 * kCallstackCount);
+    for (uint64_t i = 0; i < kCallstackCount; ++i) {
+      EXPECT_TRUE(results[i].second);
+      EXPECT_FALSE(results[kCallstackCount + i].second);
+      EXPECT_EQ(results[kCallstackCount + i].first, results[i].first);
+      all_ids.insert(results[i].first);
+    }
+  }
+  EXPECT_EQ(all_ids.size(), kThreadCount * kCallstackCount);
+}
+
+}  // namespace orbit_linux_tracing
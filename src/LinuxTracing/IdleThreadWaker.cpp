@@ -0,0 +1,33 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "IdleThreadWaker.h"
+
+namespace orbit_linux_tracing {
+
+void IdleThreadWaker::WaitForWork(const std::function<bool()>& has_work,
+                                  absl::Duration timeout) {
+  idle_.store(true, std::memory_order_relaxed);
+  // Pairs with the fence in WakeUpIfIdle: either `has_work` sees the work that a producer made
+  // available, or the producer sees that this thread is idle and wakes it up. Without the fence,
+  // the loads in `has_work` could be ordered before the store above.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  {
+    absl::MutexLock lock{&mutex_};
+    if (!has_work()) {
+      mutex_.AwaitWithTimeout(absl::Condition(&wakeup_requested_), timeout);
+    }
+    wakeup_requested_ = false;
+  }
+  idle_.store(false, std::memory_order_relaxed);
+}
+
+void IdleThreadWaker::WakeUpIfIdle() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!idle_.load(std::memory_order_relaxed)) return;
+  absl::MutexLock lock{&mutex_};
+  wakeup_requested_ = true;
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,38 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_IDLE_THREAD_WAKER_H_
+#define LINUX_TRACING_IDLE_THREAD_WAKER_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/synchronization/mutex.h>
+#include <absl/time/time.h>
+
+#include <atomic>
+#include <functional>
+
+namespace orbit_linux_tracing {
+
+// Lets a consumer thread block while it has no work, and producer threads wake it up when they
+// make work available. Producers only take a lock when the consumer is actually idle, so that
+// handing off work to a busy consumer stays lock-free.
+class IdleThreadWaker {
+ public:
+  // Called by the consumer. Marks it as idle and blocks until a producer calls WakeUpIfIdle or
+  // `timeout` elapses, unless `has_work` already returns true. `has_work` needs to observe the work
+  // that producers made available before calling WakeUpIfIdle.
+  void WaitForWork(const std::function<bool()>& has_work, absl::Duration timeout);
+
+  // Called by a producer after making work available.
+  void WakeUpIfIdle();
+
+ private:
+  std::atomic<bool> idle_ = false;
+  absl::Mutex mutex_;
+  bool wakeup_requested_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_IDLE_THREAD_WAKER_H_
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/time/clock.h>
+#include <absl/time/time.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "IdleThreadWaker.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+// Long enough that the tests only finish within it if the consumer is actually woken up.
+constexpr absl::Duration kLongTimeout = absl::Minutes(1);
+}  // namespace
+
+TEST(IdleThreadWaker, WaitForWorkReturnsRightAwayWhenThereIsWork) {
+  IdleThreadWaker waker;
+  const absl::Time start = absl::Now();
+  waker.WaitForWork([] { return true; }, kLongTimeout);
+  EXPECT_LT(absl::Now() - start, kLongTimeout);
+}
+
+TEST(IdleThreadWaker, WaitForWorkTimesOutWithoutWork) {
+  IdleThreadWaker waker;
+  const absl::Time start = absl::Now();
+  waker.WaitForWork([] { return false; }, absl::Milliseconds(10));
+  EXPECT_GE(absl::Now() - start, absl::Milliseconds(10));
+}
+
+TEST(IdleThreadWaker, WakeUpIfIdleWakesUpTheConsumer) {
+  constexpr int kItemCount = 1000;
+  IdleThreadWaker waker;
+  std::atomic<int> produced_count = 0;
+  int consumed_count = 0;
+
+  std::thread consumer([&] {
+    while (consumed_count < kItemCount) {
+      if (produced_count.load(std::memory_order_relaxed) > consumed_count) {
+        ++consumed_count;
+        continue;
+      }
+      waker.WaitForWork(
+          [&] { return produced_count.load(std::memory_order_relaxed) > consumed_count; },
+          kLongTimeout);
+    }
+  });
+
+  const absl::Time start = absl::Now();
+  for (int i = 0; i < kItemCount; ++i) {
+    produced_count.fetch_add(1, std::memory_order_relaxed);
+    waker.WakeUpIfIdle();
+    // Give the consumer the chance to become idle, so that most items need a wakeup.
+    if (i % 10 == 0) std::this_thread::yield();
+  }
+  consumer.join();
+
+  EXPECT_EQ(consumed_count, kItemCount);
+  // A single lost wakeup would make the consumer wait for the whole timeout.
+  EXPECT_LT(absl::Now() - start, kLongTimeout);
+}
+
+}  // namespace orbit_linux_tracing
@@ -4,6 +4,7 @@
 
 #include "LibunwindstackUnwinder.h"
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/types/span.h>
 #include <unwindstack/Error.h>
 #include <unwindstack/Memory.h>
@@ -13,6 +14,7 @@
 #include <cstddef>
 #include <map>
 #include <unordered_map>
+#include <utility>
 
 #include "LibunwindstackMultipleOfflineAndProcessMemory.h"
 #include "OrbitBase/Logging.h"  // IWYU pragma: keep
@@ -25,6 +27,7 @@
 #include "unwindstack/MapInfo.h"
 #include "unwindstack/Maps.h"
 #include "unwindstack/Object.h"
+#include "unwindstack/SharedString.h"
 #include "unwindstack/Unwinder.h"
 
 #if defined(__x86_64__)
@@ -51,9 +54,14 @@ static constexpr unwindstack::ArchEnum kUnwindstackArch = unwindstack::ARCH_ARM6
 class LibunwindstackUnwinderImpl : public LibunwindstackUnwinder {
  public:
   explicit LibunwindstackUnwinderImpl(
-      const std::map<uint64_t, uint64_t>* absolute_address_to_size_of_functions_to_stop_at)
+      const std::map<uint64_t, uint64_t>* absolute_address_to_size_of_functions_to_stop_at,
+      bool use_step_cache = false, std::atomic<uint64_t>* step_cache_hit_counter = nullptr,
+      std::atomic<uint64_t>* step_cache_miss_counter = nullptr)
       : absolute_address_to_size_of_functions_to_stop_at_{
-            absolute_address_to_size_of_functions_to_stop_at} {}
+            absolute_address_to_size_of_functions_to_stop_at},
+        use_step_cache_{use_step_cache},
+        step_cache_hit_counter_{step_cache_hit_counter},
+        step_cache_miss_counter_{step_cache_miss_counter} {}
   LibunwindstackResult Unwind(pid_t pid, unwindstack::Maps* maps,
                               const std::array<uint64_t, kArchPerfRegMax>& perf_regs,
                               absl::Span<const StackSliceView> stack_slices,
@@ -72,6 +80,27 @@ class LibunwindstackUnwinderImpl : public LibunwindstackUnwinder {
       eh_frame_loc_regs_cache_;  // Single row indexed by pc_end.
 
   const std::map<uint64_t, uint64_t>* absolute_address_to_size_of_functions_to_stop_at_;
+
+  // Sets function_name and function_offset of `frames`, which were unwound without resolving
+  // names, using and filling step_cache_.
+  void ResolveFunctionNamesWithStepCache(std::vector<unwindstack::FrameData>* frames,
+                                         const std::shared_ptr<unwindstack::Memory>& memory);
+
+  struct CachedFunctionName {
+    // Detects that the MapInfo the entry was resolved with has been removed from the maps, in
+    // which case another MapInfo could have been allocated at the same address.
+    std::weak_ptr<unwindstack::MapInfo> map_info;
+    unwindstack::SharedString function_name;
+    uint64_t function_offset;
+  };
+  // Bounds the memory used by the cache, as entries of removed MapInfos are only dropped lazily.
+  static constexpr size_t kMaxStepCacheSize = 256 * 1024;
+
+  bool use_step_cache_;
+  std::atomic<uint64_t>* step_cache_hit_counter_;
+  std::atomic<uint64_t>* step_cache_miss_counter_;
+  absl::flat_hash_map<std::pair<const unwindstack::MapInfo*, uint64_t>, CachedFunctionName>
+      step_cache_;
 };
 
 #if defined(__x86_64__)
@@ -117,6 +146,8 @@ LibunwindstackResult LibunwindstackUnwinderImpl::Unwind(
   }
 
   unwindstack::Unwinder unwinder{max_frames, maps, &regs, memory};
+  // With the step cache, only symbolize the frames that are not in the cache, after unwinding.
+  unwinder.SetResolveNames(!use_step_cache_);
   // Careful: regs are modified. Use regs.Clone() if you need to reuse regs later.
   unwinder.Unwind(/*initial_map_names_to_skip=*/nullptr, /*map_suffixes_to_ignore=*/nullptr,
                   absolute_address_to_size_of_functions_to_stop_at_);
@@ -127,7 +158,62 @@ LibunwindstackResult LibunwindstackUnwinderImpl::Unwind(
                 unwinder.LastErrorAddress());
   }
 #endif
-  return LibunwindstackResult{unwinder.ConsumeFrames(), regs, unwinder.LastErrorCode()};
+  std::vector<unwindstack::FrameData> frames = unwinder.ConsumeFrames();
+  if (use_step_cache_) {
+    ResolveFunctionNamesWithStepCache(&frames, memory);
+  }
+  return LibunwindstackResult{std::move(frames), regs, unwinder.LastErrorCode()};
+}
+
+void LibunwindstackUnwinderImpl::ResolveFunctionNamesWithStepCache(
+    std::vector<unwindstack::FrameData>* frames,
+    const std::shared_ptr<unwindstack::Memory>& memory) {
+  uint64_t hit_count = 0;
+  uint64_t miss_count = 0;
+  for (unwindstack::FrameData& frame : *frames) {
+    // unwindstack::Unwinder doesn't resolve names for frames without a map either.
+    if (frame.map_info == nullptr) {
+      continue;
+    }
+    // This is the pc unwindstack::Unwinder would pass to Object::GetFunctionName.
+    const uint64_t step_pc = (frame.map_info->flags() & unwindstack::MAPS_FLAGS_JIT_SYMFILE_MAP)
+                                 ? frame.pc
+                                 : frame.rel_pc;
+
+    auto [cache_it, inserted] = step_cache_.try_emplace({frame.map_info.get(), step_pc});
+    CachedFunctionName& cached_function_name = cache_it->second;
+    if (!inserted && !cached_function_name.map_info.expired()) {
+      ++hit_count;
+      frame.function_name = cached_function_name.function_name;
+      frame.function_offset = cached_function_name.function_offset;
+      continue;
+    }
+
+    ++miss_count;
+    unwindstack::Object* object = frame.map_info->GetObject(memory, kUnwindstackArch);
+    if (object == nullptr ||
+        !object->GetFunctionName(step_pc, &frame.function_name, &frame.function_offset)) {
+      frame.function_name = "";
+      frame.function_offset = 0;
+    }
+    cached_function_name.map_info = frame.map_info;
+    cached_function_name.function_name = frame.function_name;
+    cached_function_name.function_offset = frame.function_offset;
+  }
+
+  if (step_cache_.size() > kMaxStepCacheSize) {
+    absl::erase_if(step_cache_, [](const auto& entry) { return entry.second.map_info.expired(); });
+    if (step_cache_.size() > kMaxStepCacheSize / 2) {
+      step_cache_.clear();
+    }
+  }
+
+  if (step_cache_hit_counter_ != nullptr) {
+    *step_cache_hit_counter_ += hit_count;
+  }
+  if (step_cache_miss_counter_ != nullptr) {
+    *step_cache_miss_counter_ += miss_count;
+  }
 }
 
 // This functions detects if a frame pointer register was set in the given program counter using
@@ -241,6 +327,14 @@ std::unique_ptr<LibunwindstackUnwinder> LibunwindstackUnwinder::Create(
       absolute_address_to_size_of_functions_to_stop_at);
 }
 
+std::unique_ptr<LibunwindstackUnwinder> LibunwindstackUnwinder::CreateWithStepCache(
+    const std::map<uint64_t, uint64_t>* absolute_address_to_size_of_functions_to_stop_at,
+    std::atomic<uint64_t>* step_cache_hit_counter, std::atomic<uint64_t>* step_cache_miss_counter) {
+  return std::make_unique<LibunwindstackUnwinderImpl>(
+      absolute_address_to_size_of_functions_to_stop_at, /*use_step_cache=*/true,
+      step_cache_hit_counter, step_cache_miss_counter);
+}
+
 std::string LibunwindstackUnwinder::LibunwindstackErrorString(unwindstack::ErrorCode error_code) {
   return std::string(unwindstack::GetErrorCodeString(error_code));
 }
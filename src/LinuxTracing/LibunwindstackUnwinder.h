@@ -21,6 +21,7 @@
 #endif
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <map>
@@ -84,6 +85,16 @@ class LibunwindstackUnwinder {
   static std::unique_ptr<LibunwindstackUnwinder> Create(
       const std::map<uint64_t, uint64_t>* absolute_address_to_size_of_functions_to_stop_at =
           nullptr);
+  // Like Create, but the unwinder remembers the function name and offset it resolves for each
+  // unwinding step, i.e., for each module and relative pc, instead of symbolizing every frame of
+  // every callstack again. Entries are tied to the unwindstack::MapInfo they were resolved with, so
+  // they are invalidated when LibunwindstackMaps replaces that MapInfo because of a new mapping.
+  // Each call to Unwind adds the number of frames resolved with and without the cache to the
+  // counters, which can be nullptr.
+  static std::unique_ptr<LibunwindstackUnwinder> CreateWithStepCache(
+      const std::map<uint64_t, uint64_t>* absolute_address_to_size_of_functions_to_stop_at,
+      std::atomic<uint64_t>* step_cache_hit_counter,
+      std::atomic<uint64_t>* step_cache_miss_counter);
   static std::string LibunwindstackErrorString(unwindstack::ErrorCode error_code);
 
  protected:
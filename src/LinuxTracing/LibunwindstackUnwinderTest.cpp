@@ -4,15 +4,21 @@
 
 #include <absl/strings/str_format.h>
 #include <gtest/gtest.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "LibunwindstackMaps.h"
+#include "LibunwindstackMultipleOfflineAndProcessMemory.h"
 #include "LibunwindstackUnwinder.h"
 #include "Test/Path.h"
 
@@ -212,4 +218,98 @@ TEST(LibunwindstackUnwinder, FramePointerDetectionWorksWithCaching) {
   }
 }
 
-}  // namespace orbit_linux_tracing
\ No newline at end of file
+#if defined(__x86_64__)
+TEST(LibunwindstackUnwinder, StepCacheResolvesTheSameFunctionNames) {
+  auto maps = CreateFakeMapsEntry("target_fp");
+
+  // Stopped in every_1us at 0x122e, called from every_10us at 0x1265, which has set up its frame
+  // pointer and was called from an address that is not mapped.
+  constexpr uint64_t kStackStart = 0x10000;
+  std::array<uint64_t, 5> stack{0x126a, 0, 0, 0, 0xDEAD0000};
+  std::array<uint64_t, kArchPerfRegMax> perf_regs{};
+  perf_regs[PERF_REG_X86_IP] = 0x122e;
+  perf_regs[PERF_REG_X86_SP] = kStackStart;
+  perf_regs[PERF_REG_X86_BP] = kStackStart + 3 * sizeof(uint64_t);
+  const std::vector<StackSliceView> stack_slices{{kStackStart, sizeof(stack),
+                                                  reinterpret_cast<const uint8_t*>(stack.data())}};
+
+  auto unwinder = LibunwindstackUnwinder::Create();
+  LibunwindstackResult expected_result = unwinder->Unwind(kProcessId, maps->Get(), perf_regs,
+                                                          stack_slices,
+                                                          /*offline_memory_only=*/true);
+  ASSERT_GE(expected_result.frames().size(), 2);
+  EXPECT_EQ(expected_result.frames()[0].function_name, "_Z9every_1usv");
+  EXPECT_EQ(expected_result.frames()[1].function_name, "_Z10every_10usv");
+  uint64_t frames_with_map_count = 0;
+  for (const unwindstack::FrameData& frame : expected_result.frames()) {
+    if (frame.map_info != nullptr) {
+      ++frames_with_map_count;
+    }
+  }
+
+  std::atomic<uint64_t> step_cache_hit_count = 0;
+  std::atomic<uint64_t> step_cache_miss_count = 0;
+  auto caching_unwinder = LibunwindstackUnwinder::CreateWithStepCache(
+      nullptr, &step_cache_hit_count, &step_cache_miss_count);
+  constexpr size_t kRepetitions = 3;
+  for (size_t i = 0; i < kRepetitions; ++i) {
+    LibunwindstackResult actual_result =
+        caching_unwinder->Unwind(kProcessId, maps->Get(), perf_regs, stack_slices,
+                                 /*offline_memory_only=*/true);
+    EXPECT_EQ(actual_result.error_code(), expected_result.error_code());
+    ASSERT_EQ(actual_result.frames().size(), expected_result.frames().size());
+    for (size_t j = 0; j < actual_result.frames().size(); ++j) {
+      const unwindstack::FrameData& actual_frame = actual_result.frames()[j];
+      const unwindstack::FrameData& expected_frame = expected_result.frames()[j];
+      EXPECT_EQ(actual_frame.pc, expected_frame.pc);
+      EXPECT_EQ(actual_frame.rel_pc, expected_frame.rel_pc);
+      EXPECT_EQ(static_cast<std::string_view>(actual_frame.function_name),
+                static_cast<std::string_view>(expected_frame.function_name));
+      EXPECT_EQ(actual_frame.function_offset, expected_frame.function_offset);
+    }
+  }
+
+  EXPECT_EQ(step_cache_miss_count, frames_with_map_count);
+  EXPECT_EQ(step_cache_hit_count, (kRepetitions - 1) * frames_with_map_count);
+}
+
+TEST(LibunwindstackUnwinder, StepCacheIsInvalidatedWhenTheMapIsReplaced) {
+  auto maps = CreateFakeMapsEntry("target_fp");
+
+  std::array<uint64_t, 1> stack{0xDEAD0000};
+  std::array<uint64_t, kArchPerfRegMax> perf_regs{};
+  perf_regs[PERF_REG_X86_IP] = 0x122e;
+  perf_regs[PERF_REG_X86_SP] = 0x10000;
+  const std::vector<StackSliceView> stack_slices{
+      {0x10000, sizeof(stack), reinterpret_cast<const uint8_t*>(stack.data())}};
+
+  std::atomic<uint64_t> step_cache_hit_count = 0;
+  std::atomic<uint64_t> step_cache_miss_count = 0;
+  auto caching_unwinder = LibunwindstackUnwinder::CreateWithStepCache(
+      nullptr, &step_cache_hit_count, &step_cache_miss_count);
+
+  LibunwindstackResult result = caching_unwinder->Unwind(kProcessId, maps->Get(), perf_regs,
+                                                         stack_slices,
+                                                         /*offline_memory_only=*/true);
+  ASSERT_FALSE(result.frames().empty());
+  EXPECT_EQ(result.frames()[0].function_name, "_Z9every_1usv");
+  EXPECT_EQ(step_cache_hit_count, 0);
+  const uint64_t miss_count_before_mmap = step_cache_miss_count;
+  EXPECT_GT(miss_count_before_mmap, 0);
+  // Don't keep the MapInfo alive.
+  result = LibunwindstackResult{{}, {}};
+
+  // Map the same file again over the executable mapping, as a PERF_RECORD_MMAP would.
+  maps->AddAndSort(0x1000, 0x3000, 0x1000, PROT_READ | PROT_EXEC,
+                   (orbit_test::GetTestdataDir() / "target_fp").string());
+
+  result = caching_unwinder->Unwind(kProcessId, maps->Get(), perf_regs, stack_slices,
+                                    /*offline_memory_only=*/true);
+  ASSERT_FALSE(result.frames().empty());
+  EXPECT_EQ(result.frames()[0].function_name, "_Z9every_1usv");
+  EXPECT_EQ(step_cache_hit_count, 0);
+  EXPECT_GT(step_cache_miss_count, miss_count_before_mmap);
+}
+#endif
+
+}  // namespace orbit_linux_tracing
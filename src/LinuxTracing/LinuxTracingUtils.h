@@ -67,6 +67,13 @@ bool SetMaxOpenFilesSoftLimit(uint64_t soft_limit);
     ___p;                            \
   })
 
+// Returns the CPU time consumed by the calling thread, in nanoseconds.
+inline uint64_t GetCurrentThreadCpuTimeNs() {
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+}
+
 inline size_t GetPageSize() {
   // POSIX guarantees the result to be greater or equal than 1. So we can safely cast here.
   return static_cast<size_t>(sysconf(_SC_PAGESIZE));
@@ -0,0 +1,116 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ParallelStackUnwinder.h"
+
+#include <absl/strings/str_format.h>
+
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/ThreadUtils.h"
+
+namespace orbit_linux_tracing {
+
+ParallelStackUnwinder::ParallelStackUnwinder(
+    size_t thread_count,
+    const std::function<std::unique_ptr<LibunwindstackUnwinder>()>& unwinder_factory) {
+  ORBIT_CHECK(thread_count > 0);
+  for (size_t i = 0; i < thread_count; ++i) {
+    unwinders_.emplace_back(unwinder_factory());
+    ORBIT_CHECK(unwinders_.back() != nullptr);
+  }
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads_.emplace_back([this, i] {
+      orbit_base::SetCurrentThreadName(absl::StrFormat("Tracer::Unw%u", i).c_str());
+      RunWorker(unwinders_[i].get());
+    });
+  }
+}
+
+ParallelStackUnwinder::~ParallelStackUnwinder() {
+  {
+    absl::MutexLock lock{&mutex_};
+    is_stopping_ = true;
+  }
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+void ParallelStackUnwinder::Submit(UnwindRequest request) {
+  DeliverCompletedResults();
+
+  while (true) {
+    std::unique_ptr<Job> job_to_deliver;
+    {
+      absl::MutexLock lock{&mutex_};
+      if (pending_jobs_.size() < kMaxPendingRequests) {
+        auto job = std::make_unique<Job>();
+        job->request = std::move(request);
+        jobs_to_unwind_.push_back(job.get());
+        pending_jobs_.push_back(std::move(job));
+        return;
+      }
+      Job* oldest_job = pending_jobs_.front().get();
+      mutex_.Await(absl::Condition(&oldest_job->is_unwound));
+      job_to_deliver = std::move(pending_jobs_.front());
+      pending_jobs_.pop_front();
+    }
+    job_to_deliver->request.on_unwound(job_to_deliver->result.value());
+  }
+}
+
+void ParallelStackUnwinder::DeliverResults(bool wait_for_all) {
+  while (true) {
+    std::unique_ptr<Job> job_to_deliver;
+    {
+      absl::MutexLock lock{&mutex_};
+      if (pending_jobs_.empty()) {
+        return;
+      }
+      Job* oldest_job = pending_jobs_.front().get();
+      if (!oldest_job->is_unwound) {
+        if (!wait_for_all) {
+          return;
+        }
+        mutex_.Await(absl::Condition(&oldest_job->is_unwound));
+      }
+      job_to_deliver = std::move(pending_jobs_.front());
+      pending_jobs_.pop_front();
+    }
+    // Call the callback outside of the lock, so that the workers can keep going.
+    job_to_deliver->request.on_unwound(job_to_deliver->result.value());
+  }
+}
+
+void ParallelStackUnwinder::RunWorker(LibunwindstackUnwinder* unwinder) {
+  while (true) {
+    Job* job;
+    {
+      absl::MutexLock lock{&mutex_};
+      mutex_.Await(absl::Condition(this, &ParallelStackUnwinder::HasJobsToUnwindOrIsStopping));
+      if (is_stopping_) {
+        return;
+      }
+      job = jobs_to_unwind_.front();
+      jobs_to_unwind_.pop_front();
+    }
+
+    UnwindRequest& request = job->request;
+    LibunwindstackResult result =
+        unwinder->Unwind(request.pid, request.maps, request.registers, request.stack_slices,
+                         request.offline_memory_only);
+    // The stack copies are no longer needed: release them now instead of on delivery.
+    request.stack_slices.clear();
+    request.stack_data.reset();
+    request.additional_stack_data.clear();
+
+    absl::MutexLock lock{&mutex_};
+    job->result.emplace(std::move(result));
+    job->is_unwound = true;
+  }
+}
+
+}  // namespace orbit_linux_tracing
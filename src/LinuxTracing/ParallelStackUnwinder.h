@@ -0,0 +1,102 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_PARALLEL_STACK_UNWINDER_H_
+#define LINUX_TRACING_PARALLEL_STACK_UNWINDER_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/synchronization/mutex.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <unwindstack/Maps.h>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "LibunwindstackMultipleOfflineAndProcessMemory.h"
+#include "LibunwindstackUnwinder.h"
+#include "PerfEventPayloadPool.h"
+
+namespace orbit_linux_tracing {
+
+// Unwinds stack samples with DWARF information on a set of worker threads, each with its own
+// LibunwindstackUnwinder, and hands the results back on the thread that submitted the samples, in
+// the order in which they were submitted.
+// The unwindstack::Maps passed with a request must not be modified until the result of that request
+// has been delivered. Callers that need to modify the maps (e.g., on PERF_RECORD_MMAP) have to call
+// DeliverAllResults first, so that each sample is unwound with the maps as they were at its
+// timestamp and the results are the same as when unwinding serially.
+// Submit and the Deliver... methods must all be called from the same thread.
+class ParallelStackUnwinder {
+ public:
+  struct UnwindRequest {
+    pid_t pid;
+    unwindstack::Maps* maps;
+    std::array<uint64_t, kArchPerfRegMax> registers;
+    std::vector<StackSliceView> stack_slices;
+    bool offline_memory_only = false;
+    // Own the memory the stack_slices point to, until the sample has been unwound.
+    PerfEventPayload<uint8_t> stack_data;
+    std::vector<std::shared_ptr<const uint8_t[]>> additional_stack_data;
+    // Called by Deliver... on the thread calling it.
+    std::function<void(const LibunwindstackResult&)> on_unwound;
+  };
+
+  ParallelStackUnwinder(
+      size_t thread_count,
+      const std::function<std::unique_ptr<LibunwindstackUnwinder>()>& unwinder_factory);
+  // Stops the worker threads. Results not delivered yet are dropped.
+  ~ParallelStackUnwinder();
+
+  ParallelStackUnwinder(const ParallelStackUnwinder&) = delete;
+  ParallelStackUnwinder& operator=(const ParallelStackUnwinder&) = delete;
+  ParallelStackUnwinder(ParallelStackUnwinder&&) = delete;
+  ParallelStackUnwinder& operator=(ParallelStackUnwinder&&) = delete;
+
+  // If kMaxPendingRequests requests are pending, first waits for the oldest one to be unwound and
+  // delivers it.
+  void Submit(UnwindRequest request);
+  // Delivers the results of the oldest requests, up to the first request that hasn't been unwound
+  // yet.
+  void DeliverCompletedResults() { DeliverResults(/*wait_for_all=*/false); }
+  // Waits for all pending requests to be unwound and delivers their results.
+  void DeliverAllResults() { DeliverResults(/*wait_for_all=*/true); }
+
+  [[nodiscard]] size_t GetThreadCount() const { return threads_.size(); }
+
+  // Bounds the memory held by the stack copies of requests waiting to be unwound or delivered.
+  static constexpr size_t kMaxPendingRequests = 4096;
+
+ private:
+  struct Job {
+    UnwindRequest request;
+    std::optional<LibunwindstackResult> result;
+    bool is_unwound = false;
+  };
+
+  void RunWorker(LibunwindstackUnwinder* unwinder);
+  void DeliverResults(bool wait_for_all);
+  [[nodiscard]] bool HasJobsToUnwindOrIsStopping() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !jobs_to_unwind_.empty() || is_stopping_;
+  }
+
+  std::vector<std::unique_ptr<LibunwindstackUnwinder>> unwinders_;
+  std::vector<std::thread> threads_;
+
+  absl::Mutex mutex_;
+  // All jobs whose result hasn't been delivered yet, in submission order.
+  std::deque<std::unique_ptr<Job>> pending_jobs_ ABSL_GUARDED_BY(mutex_);
+  std::deque<Job*> jobs_to_unwind_ ABSL_GUARDED_BY(mutex_);
+  bool is_stopping_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_PARALLEL_STACK_UNWINDER_H_
@@ -0,0 +1,190 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/synchronization/blocking_counter.h>
+#include <absl/synchronization/notification.h>
+#include <absl/time/time.h>
+#include <gtest/gtest.h>
+#include <unwindstack/Unwinder.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "LibunwindstackUnwinder.h"
+#include "ParallelStackUnwinder.h"
+#include "PerfEventPayloadPool.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+// Returns a single frame whose pc is the first register plus the first byte of the stack, after
+// sleeping for as many microseconds as the second register says, if any. If a notification is
+// passed, the request with the first register equal to `blocked_pc` waits for it. If a counter is
+// passed, it is decremented for each of the other requests.
+class FakeLibunwindstackUnwinder : public LibunwindstackUnwinder {
+ public:
+  explicit FakeLibunwindstackUnwinder(absl::Notification* unblock = nullptr,
+                                      uint64_t blocked_pc = 0,
+                                      absl::BlockingCounter* unblocked_count = nullptr)
+      : unblock_{unblock}, blocked_pc_{blocked_pc}, unblocked_count_{unblocked_count} {}
+
+  LibunwindstackResult Unwind(pid_t /*pid*/, unwindstack::Maps* /*maps*/,
+                              const std::array<uint64_t, kArchPerfRegMax>& perf_regs,
+                              absl::Span<const StackSliceView> stack_slices,
+                              bool /*offline_memory_only*/, size_t /*max_frames*/) override {
+    if (unblock_ != nullptr && perf_regs[0] == blocked_pc_) {
+      unblock_->WaitForNotification();
+    }
+    if (perf_regs[1] > 0) {
+      absl::SleepFor(absl::Microseconds(perf_regs[1]));
+    }
+    unwindstack::FrameData frame{};
+    frame.pc = perf_regs[0] + stack_slices[0].data()[0];
+    if (unblocked_count_ != nullptr && perf_regs[0] != blocked_pc_) {
+      unblocked_count_->DecrementCount();
+    }
+    return LibunwindstackResult{{frame}, ArchRegs{}};
+  }
+
+  std::optional<bool> HasFramePointerSet(uint64_t /*instruction_pointer*/, pid_t /*pid*/,
+                                         unwindstack::Maps* /*maps*/) override {
+    return std::nullopt;
+  }
+
+ private:
+  absl::Notification* unblock_;
+  uint64_t blocked_pc_;
+  absl::BlockingCounter* unblocked_count_;
+};
+
+ParallelStackUnwinder::UnwindRequest MakeRequest(uint64_t pc, uint64_t sleep_us, uint8_t stack_byte,
+                                                 std::vector<uint64_t>* delivered_pcs) {
+  ParallelStackUnwinder::UnwindRequest request{};
+  request.pid = 42;
+  request.maps = nullptr;
+  request.registers[0] = pc;
+  request.registers[1] = sleep_us;
+  request.stack_data = MakePerfEventPayload<uint8_t>(nullptr, 1);
+  request.stack_data[0] = stack_byte;
+  request.stack_slices.emplace_back(0, 1, request.stack_data.get());
+  request.on_unwound = [delivered_pcs](const LibunwindstackResult& result) {
+    ASSERT_EQ(result.frames().size(), 1);
+    delivered_pcs->push_back(result.frames()[0].pc);
+  };
+  return request;
+}
+
+}  // namespace
+
+TEST(ParallelStackUnwinder, ResultsAreDeliveredInSubmissionOrder) {
+  ParallelStackUnwinder parallel_stack_unwinder{
+      4, [] { return std::make_unique<FakeLibunwindstackUnwinder>(); }};
+  EXPECT_EQ(parallel_stack_unwinder.GetThreadCount(), 4);
+
+  constexpr uint64_t kRequestCount = 1000;
+  std::vector<uint64_t> delivered_pcs;
+  std::vector<uint64_t> expected_pcs;
+  for (uint64_t i = 0; i < kRequestCount; ++i) {
+    // Make later requests of each group of 7 complete earlier.
+    const uint64_t sleep_us = 7 - i % 7;
+    const auto stack_byte = static_cast<uint8_t>(i % 3);
+    parallel_stack_unwinder.Submit(MakeRequest(i * 10, sleep_us, stack_byte, &delivered_pcs));
+    expected_pcs.push_back(i * 10 + stack_byte);
+    if (i % 100 == 0) {
+      parallel_stack_unwinder.DeliverCompletedResults();
+    }
+  }
+  parallel_stack_unwinder.DeliverAllResults();
+
+  EXPECT_EQ(delivered_pcs, expected_pcs);
+}
+
+TEST(ParallelStackUnwinder, DeliverCompletedResultsStopsAtTheFirstRequestNotUnwoundYet) {
+  absl::Notification unblock;
+  static constexpr uint64_t kBlockedPc = 3;
+  static constexpr uint64_t kRequestCount = 10;
+  absl::BlockingCounter unblocked_count{kRequestCount - 1};
+  ParallelStackUnwinder parallel_stack_unwinder{
+      2, [&unblock, &unblocked_count] {
+        return std::make_unique<FakeLibunwindstackUnwinder>(&unblock, kBlockedPc,
+                                                            &unblocked_count);
+      }};
+
+  std::vector<uint64_t> delivered_pcs;
+  for (uint64_t pc = 0; pc < kRequestCount; ++pc) {
+    parallel_stack_unwinder.Submit(MakeRequest(pc, 0, 0, &delivered_pcs));
+  }
+
+  // The other worker unwinds all the other requests, but a result only counts as completed once
+  // the worker has stored it, after Unwind returns.
+  unblocked_count.Wait();
+  while (delivered_pcs.size() < kBlockedPc) {
+    parallel_stack_unwinder.DeliverCompletedResults();
+    std::this_thread::yield();
+  }
+  parallel_stack_unwinder.DeliverCompletedResults();
+  EXPECT_EQ(delivered_pcs, (std::vector<uint64_t>{0, 1, 2}));
+
+  unblock.Notify();
+  parallel_stack_unwinder.DeliverAllResults();
+  EXPECT_EQ(delivered_pcs, (std::vector<uint64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(ParallelStackUnwinder, SubmitDeliversTheOldestResultWhenTooManyRequestsArePending) {
+  absl::Notification unblock;
+  static constexpr uint64_t kBlockedPc = 1;
+  ParallelStackUnwinder parallel_stack_unwinder{
+      2, [&unblock] {
+        return std::make_unique<FakeLibunwindstackUnwinder>(&unblock, kBlockedPc);
+      }};
+
+  std::vector<uint64_t> delivered_pcs;
+  for (uint64_t pc = 0; pc < ParallelStackUnwinder::kMaxPendingRequests; ++pc) {
+    parallel_stack_unwinder.Submit(MakeRequest(pc, 0, 0, &delivered_pcs));
+  }
+  // Only the request before the blocked one can have been delivered.
+  EXPECT_LE(delivered_pcs.size(), 1);
+
+  // The blocked request is only unblocked once the test is about to submit more requests than
+  // can be pending. Whether or not Submit already waits by then, it can only return after the
+  // blocked request has been unwound and delivered.
+  absl::Notification about_to_submit;
+  std::thread unblocking_thread{[&about_to_submit, &unblock] {
+    about_to_submit.WaitForNotification();
+    unblock.Notify();
+  }};
+  about_to_submit.Notify();
+  for (uint64_t pc = ParallelStackUnwinder::kMaxPendingRequests;
+       pc < ParallelStackUnwinder::kMaxPendingRequests + 2; ++pc) {
+    parallel_stack_unwinder.Submit(MakeRequest(pc, 0, 0, &delivered_pcs));
+  }
+  unblocking_thread.join();
+  ASSERT_GE(delivered_pcs.size(), 2);
+  EXPECT_EQ(delivered_pcs[0], 0);
+  EXPECT_EQ(delivered_pcs[1], 1);
+
+  parallel_stack_unwinder.DeliverAllResults();
+  EXPECT_EQ(delivered_pcs.size(), ParallelStackUnwinder::kMaxPendingRequests + 2);
+}
+
+TEST(ParallelStackUnwinder, DestructorDropsResultsNotDeliveredYet) {
+  std::vector<uint64_t> delivered_pcs;
+  {
+    ParallelStackUnwinder parallel_stack_unwinder{
+        3, [] { return std::make_unique<FakeLibunwindstackUnwinder>(); }};
+    for (uint64_t pc = 0; pc < 100; ++pc) {
+      parallel_stack_unwinder.Submit(MakeRequest(pc, 10, 0, &delivered_pcs));
+    }
+    delivered_pcs.clear();
+  }
+  EXPECT_TRUE(delivered_pcs.empty());
+}
+
+}  // namespace orbit_linux_tracing
@@ -22,6 +22,7 @@
 #include "GrpcProtos/Constants.h"
 #include "OrbitBase/MakeUniqueForOverwrite.h"
 #include "PerfEventOrderedStream.h"
+#include "PerfEventPayloadPool.h"
 #include "PerfEventRecords.h"
 
 namespace orbit_linux_tracing {
@@ -94,9 +95,11 @@ struct StackSamplePerfEventData {
 
   pid_t pid;
   pid_t tid;
-  std::unique_ptr<uint64_t[]> regs;
+  PerfEventPayload<uint64_t> regs;
   uint64_t dyn_size;
-  std::unique_ptr<uint8_t[]> data;
+  // This mutablility allows moving the data out of this class in the UprobesUnwindingVisitor when
+  // the sample is unwound asynchronously, as no other visitor uses the stack data.
+  mutable PerfEventPayload<uint8_t> data;
 };
 using StackSamplePerfEvent = TypedPerfEvent<StackSamplePerfEventData>;
 
@@ -128,9 +131,9 @@ struct CallchainSamplePerfEventData {
   // Mutability is needed in SetIps which in turn is needed by
   // LeafFunctionCallManager::PatchCallerOfLeafFunction.
   mutable uint64_t ips_size;
-  mutable std::unique_ptr<uint64_t[]> ips;
-  std::unique_ptr<uint64_t[]> regs;
-  std::unique_ptr<uint8_t[]> data;
+  mutable PerfEventPayload<uint64_t> ips;
+  PerfEventPayload<uint64_t> regs;
+  PerfEventPayload<uint8_t> data;
 };
 using CallchainSamplePerfEvent = TypedPerfEvent<CallchainSamplePerfEventData>;
 
@@ -164,13 +167,13 @@ struct UprobesWithStackPerfEventData {
   uint64_t stream_id;
   pid_t pid;
   pid_t tid;
-  std::unique_ptr<uint64_t[]> regs;
+  PerfEventPayload<uint64_t> regs;
 
   uint64_t dyn_size;
   // This mutablility allows moving the data out of this class in the UprobesUnwindingVisitor even
   // if we only have a const reference there. This requires the explicit knowledge that there is
   // only one visitor being applied to this event.
-  mutable std::unique_ptr<uint8_t[]> data;
+  mutable PerfEventPayload<uint8_t> data;
 };
 using UprobesWithStackPerfEvent = TypedPerfEvent<UprobesWithStackPerfEventData>;
 
@@ -309,9 +312,9 @@ struct SchedWakeupWithCallchainPerfEventData {
   // Mutability is needed in SetIps which in turn is needed by
   // LeafFunctionCallManager::PatchCallerOfLeafFunction.
   mutable uint64_t ips_size;
-  mutable std::unique_ptr<uint64_t[]> ips;
-  std::unique_ptr<uint64_t[]> regs;
-  std::unique_ptr<uint8_t[]> data;
+  mutable PerfEventPayload<uint64_t> ips;
+  PerfEventPayload<uint64_t> regs;
+  PerfEventPayload<uint8_t> data;
 };
 using SchedWakeupWithCallchainPerfEvent = TypedPerfEvent<SchedWakeupWithCallchainPerfEventData>;
 
@@ -346,9 +349,9 @@ struct SchedSwitchWithCallchainPerfEventData {
   // Mutability is needed in SetIps which in turn is needed by
   // LeafFunctionCallManager::PatchCallerOfLeafFunction.
   mutable uint64_t ips_size;
-  mutable std::unique_ptr<uint64_t[]> ips;
-  std::unique_ptr<uint64_t[]> regs;
-  std::unique_ptr<uint8_t[]> data;
+  mutable PerfEventPayload<uint64_t> ips;
+  PerfEventPayload<uint64_t> regs;
+  PerfEventPayload<uint8_t> data;
 };
 using SchedSwitchWithCallchainPerfEvent = TypedPerfEvent<SchedSwitchWithCallchainPerfEventData>;
 
@@ -373,9 +376,9 @@ struct SchedWakeupWithStackPerfEventData {
   pid_t woken_tid;
   pid_t was_unblocked_by_tid;
   pid_t was_unblocked_by_pid;
-  std::unique_ptr<uint64_t[]> regs;
+  PerfEventPayload<uint64_t> regs;
   uint64_t dyn_size;
-  std::unique_ptr<uint8_t[]> data;
+  PerfEventPayload<uint8_t> data;
 };
 using SchedWakeupWithStackPerfEvent = TypedPerfEvent<SchedWakeupWithStackPerfEventData>;
 
@@ -402,9 +405,9 @@ struct SchedSwitchWithStackPerfEventData {
   pid_t prev_tid;
   int64_t prev_state;
   int32_t next_tid;
-  std::unique_ptr<uint64_t[]> regs;
+  PerfEventPayload<uint64_t> regs;
   uint64_t dyn_size;
-  std::unique_ptr<uint8_t[]> data;
+  PerfEventPayload<uint8_t> data;
 };
 using SchedSwitchWithStackPerfEvent = TypedPerfEvent<SchedSwitchWithStackPerfEventData>;
 
@@ -46,7 +46,15 @@ perf_event_attr generic_event_attr() {
   return pe;
 }
 
-int generic_event_open(perf_event_attr* attr, pid_t pid, int32_t cpu) {
+int generic_event_open(perf_event_attr* attr, pid_t pid, int32_t cpu,
+                       uint32_t wakeup_watermark_bytes) {
+  if (wakeup_watermark_bytes > 0) {
+    // Wake up pollers of the file descriptor (e.g., epoll) every time this many bytes have been
+    // written to the ring buffer. Only relevant for the event that owns the ring buffer, events
+    // redirected to it with PERF_EVENT_IOC_SET_OUTPUT inherit its watermark.
+    attr->watermark = 1;
+    attr->wakeup_watermark = wakeup_watermark_bytes;
+  }
   int fd = perf_event_open(attr, pid, cpu, -1, PERF_FLAG_FD_CLOEXEC);
   if (fd == -1) {
     ORBIT_ERROR("perf_event_open: %s", SafeStrerror(errno));
@@ -64,16 +72,16 @@ perf_event_attr uprobe_event_attr(const char* module, uint64_t function_offset)
 }
 }  // namespace
 
-int context_switch_event_open(pid_t pid, int32_t cpu) {
+int context_switch_event_open(pid_t pid, int32_t cpu, uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = generic_event_attr();
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_DUMMY;
   pe.context_switch = 1;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
-int mmap_task_event_open(pid_t pid, int32_t cpu) {
+int mmap_task_event_open(pid_t pid, int32_t cpu, uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = generic_event_attr();
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_DUMMY;
@@ -83,10 +91,11 @@ int mmap_task_event_open(pid_t pid, int32_t cpu) {
   pe.mmap_data = 1;
   pe.task = 1;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
-int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size) {
+int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                            uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = generic_event_attr();
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_CPU_CLOCK;
@@ -96,11 +105,11 @@ int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t
 
   pe.sample_stack_user = stack_dump_size;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 int callchain_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu,
-                                uint16_t stack_dump_size) {
+                                uint16_t stack_dump_size, uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = generic_event_attr();
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_CPU_CLOCK;
@@ -115,11 +124,11 @@ int callchain_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu,
   pe.sample_regs_user = kSampleRegsUserAll;
   pe.sample_stack_user = stack_dump_size;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 int uprobes_retaddr_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                               int32_t cpu) {
+                               int32_t cpu, uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = uprobe_event_attr(module, function_offset);
   pe.config &= ~1ULL;
   pe.sample_type |= PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER;
@@ -129,11 +138,12 @@ int uprobes_retaddr_event_open(const char* module, uint64_t function_offset, pid
   // We record it as it is about to be hijacked by the installation of the uretprobe.
   pe.sample_stack_user = kSampleStackUserSize8Bytes;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 int uprobes_with_stack_and_sp_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                         int32_t cpu, uint16_t stack_dump_size) {
+                                         int32_t cpu, uint16_t stack_dump_size,
+                                         uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = uprobe_event_attr(module, function_offset);
   pe.config &= ~1ULL;
   pe.sample_type |= PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER;
@@ -141,36 +151,37 @@ int uprobes_with_stack_and_sp_event_open(const char* module, uint64_t function_o
 
   pe.sample_stack_user = stack_dump_size;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 int uprobes_retaddr_args_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                    int32_t cpu) {
+                                    int32_t cpu, uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = uprobe_event_attr(module, function_offset);
   pe.config &= ~1ULL;
   pe.sample_type |= PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER;
   pe.sample_regs_user = kSampleRegsUserSpIpArguments;
   pe.sample_stack_user = kSampleStackUserSize8Bytes;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
-int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu) {
+int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu,
+                          uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = uprobe_event_attr(module, function_offset);
   pe.config |= 1;  // Set bit 0 of config for uretprobe.
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 int uretprobes_retval_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                 int32_t cpu) {
+                                 int32_t cpu, uint32_t wakeup_watermark_bytes) {
   perf_event_attr pe = uprobe_event_attr(module, function_offset);
   pe.config |= 1;  // Set bit 0 of config for uretprobe.
 
   pe.sample_type |= PERF_SAMPLE_REGS_USER;
   pe.sample_regs_user = kSampleRegsUserAx;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 void* perf_event_open_mmap_ring_buffer(int fd, uint64_t mmap_length) {
@@ -192,7 +203,7 @@ void* perf_event_open_mmap_ring_buffer(int fd, uint64_t mmap_length) {
 }
 
 int tracepoint_event_open(const char* tracepoint_category, const char* tracepoint_name, pid_t pid,
-                          int32_t cpu) {
+                          int32_t cpu, uint32_t wakeup_watermark_bytes) {
   int tp_id = GetTracepointId(tracepoint_category, tracepoint_name);
   if (tp_id == -1) {
     return -1;
@@ -202,12 +213,13 @@ int tracepoint_event_open(const char* tracepoint_category, const char* tracepoin
   pe.config = tp_id;
   pe.sample_type |= PERF_SAMPLE_RAW;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 int tracepoint_with_callchain_event_open(const char* tracepoint_category,
                                          const char* tracepoint_name, pid_t pid, int32_t cpu,
-                                         uint16_t stack_dump_size) {
+                                         uint16_t stack_dump_size,
+                                         uint32_t wakeup_watermark_bytes) {
   int tp_id = GetTracepointId(tracepoint_category, tracepoint_name);
   if (tp_id == -1) {
     return -1;
@@ -225,11 +237,12 @@ int tracepoint_with_callchain_event_open(const char* tracepoint_category,
   pe.sample_regs_user = kSampleRegsUserAll;
   pe.sample_stack_user = stack_dump_size;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 int tracepoint_with_stack_event_open(const char* tracepoint_category, const char* tracepoint_name,
-                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size) {
+                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                                     uint32_t wakeup_watermark_bytes) {
   int tp_id = GetTracepointId(tracepoint_category, tracepoint_name);
   if (tp_id == -1) {
     return -1;
@@ -242,7 +255,7 @@ int tracepoint_with_stack_event_open(const char* tracepoint_category, const char
 
   pe.sample_stack_user = stack_dump_size;
 
-  return generic_event_open(&pe, pid, cpu);
+  return generic_event_open(&pe, pid, cpu, wakeup_watermark_bytes);
 }
 
 }  // namespace orbit_linux_tracing
@@ -53,6 +53,14 @@ inline void perf_event_redirect(int from_fd, int to_fd) {
   }
 }
 
+// Changes the sampling period of an event opened with a sample_period, from its next sample on.
+inline void perf_event_set_period(int file_descriptor, uint64_t period) {
+  int ret = ioctl(file_descriptor, PERF_EVENT_IOC_PERIOD, &period);
+  if (ret != 0) {
+    ORBIT_ERROR("PERF_EVENT_IOC_PERIOD: %s", SafeStrerror(errno));
+  }
+}
+
 inline uint64_t perf_event_get_id(int file_descriptor) {
   uint64_t id{};
   int ret = ioctl(file_descriptor, PERF_EVENT_IOC_ID, &id);
@@ -153,33 +161,41 @@ static constexpr uint16_t kSampleStackUserSize8Bytes = 8;
 // See also `ClientFlags.cpp`.
 static constexpr uint16_t kMaxStackSampleUserSize = 65000;
 
+// All the following functions take a `wakeup_watermark_bytes` parameter. If it is greater than
+// zero, the kernel wakes up pollers of the returned file descriptor every time this many bytes have
+// been written to the corresponding ring buffer. If it is zero, the kernel default is used, i.e.,
+// half the size of the ring buffer.
+
 // perf_event_open for context switches.
-int context_switch_event_open(pid_t pid, int32_t cpu);
+int context_switch_event_open(pid_t pid, int32_t cpu, uint32_t wakeup_watermark_bytes);
 
 // perf_event_open for task (fork and exit) and mmap records in the same buffer.
-int mmap_task_event_open(pid_t pid, int32_t cpu);
+int mmap_task_event_open(pid_t pid, int32_t cpu, uint32_t wakeup_watermark_bytes);
 
 // perf_event_open for stack sampling.
-int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size);
+int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                            uint32_t wakeup_watermark_bytes);
 
 // perf_event_open for stack sampling using frame pointers.
 int callchain_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu,
-                                uint16_t stack_dump_size);
+                                uint16_t stack_dump_size, uint32_t wakeup_watermark_bytes);
 
 // perf_event_open for uprobes and uretprobes.
 int uprobes_retaddr_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                               int32_t cpu);
+                               int32_t cpu, uint32_t wakeup_watermark_bytes);
 
 int uprobes_with_stack_and_sp_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                         int32_t cpu, uint16_t stack_dump_size);
+                                         int32_t cpu, uint16_t stack_dump_size,
+                                         uint32_t wakeup_watermark_bytes);
 
 int uprobes_retaddr_args_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                    int32_t cpu);
+                                    int32_t cpu, uint32_t wakeup_watermark_bytes);
 
-int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu);
+int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu,
+                          uint32_t wakeup_watermark_bytes);
 
 int uretprobes_retval_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                 int32_t cpu);
+                                 int32_t cpu, uint32_t wakeup_watermark_bytes);
 
 // Create the ring buffer to use perf_event_open in sampled mode.
 void* perf_event_open_mmap_ring_buffer(int fd, uint64_t mmap_length);
@@ -189,14 +205,16 @@ void* perf_event_open_mmap_ring_buffer(int fd, uint64_t mmap_length);
 // (for example, "sched_waking"). Returns the file descriptor for the
 // perf event or -1 in case of any errors.
 int tracepoint_event_open(const char* tracepoint_category, const char* tracepoint_name, pid_t pid,
-                          int32_t cpu);
+                          int32_t cpu, uint32_t wakeup_watermark_bytes);
 
 int tracepoint_with_stack_event_open(const char* tracepoint_category, const char* tracepoint_name,
-                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size);
+                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                                     uint32_t wakeup_watermark_bytes);
 
 int tracepoint_with_callchain_event_open(const char* tracepoint_category,
                                          const char* tracepoint_name, pid_t pid, int32_t cpu,
-                                         uint16_t stack_dump_size);
+                                         uint16_t stack_dump_size,
+                                         uint32_t wakeup_watermark_bytes);
 
 }  // namespace orbit_linux_tracing
 
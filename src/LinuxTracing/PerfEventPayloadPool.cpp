@@ -0,0 +1,67 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "PerfEventPayloadPool.h"
+
+#include <algorithm>
+#include <new>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_linux_tracing {
+
+PerfEventPayloadPool::~PerfEventPayloadPool() {
+  for (SizeClass& size_class : size_classes_) {
+    void* buffer = nullptr;
+    while (size_class.free_buffers.try_dequeue(buffer)) {
+      ::operator delete(buffer);
+    }
+  }
+}
+
+void* PerfEventPayloadPool::Allocate(size_t size_bytes, int8_t* size_class) {
+  ORBIT_DCHECK(size_class != nullptr);
+  size_t size_class_log2 = kMinSizeClassLog2;
+  while ((size_t{1} << size_class_log2) < size_bytes) {
+    ++size_class_log2;
+  }
+  if (size_class_log2 > kMaxSizeClassLog2) {
+    *size_class = kNotPooled;
+    miss_count_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  *size_class = static_cast<int8_t>(size_class_log2 - kMinSizeClassLog2);
+  SizeClass& pool_size_class = size_classes_[*size_class];
+  void* buffer = nullptr;
+  if (pool_size_class.free_buffers.try_dequeue(buffer)) {
+    pool_size_class.free_buffer_count.fetch_sub(1, std::memory_order_relaxed);
+    hit_count_.fetch_add(1, std::memory_order_relaxed);
+    return buffer;
+  }
+
+  miss_count_.fetch_add(1, std::memory_order_relaxed);
+  return ::operator new(GetSizeOfSizeClass(*size_class));
+}
+
+void PerfEventPayloadPool::Release(void* buffer, int8_t size_class) {
+  ORBIT_DCHECK(size_class >= 0 && static_cast<size_t>(size_class) < kSizeClassCount);
+  SizeClass& pool_size_class = size_classes_[size_class];
+  const size_t max_free_buffer_count =
+      std::max<size_t>(1, kMaxRetainedBytesPerSizeClass / GetSizeOfSizeClass(size_class));
+  // The count is only approximate under concurrency, which is fine for a limit.
+  if (pool_size_class.free_buffer_count.load(std::memory_order_relaxed) >= max_free_buffer_count ||
+      !pool_size_class.free_buffers.enqueue(buffer)) {
+    ::operator delete(buffer);
+    return;
+  }
+  pool_size_class.free_buffer_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+PerfEventPayloadPool::Stats PerfEventPayloadPool::GetAndResetStats() {
+  return {.hit_count = hit_count_.exchange(0, std::memory_order_relaxed),
+          .miss_count = miss_count_.exchange(0, std::memory_order_relaxed)};
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,120 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_PERF_EVENT_PAYLOAD_POOL_H_
+#define LINUX_TRACING_PERF_EVENT_PAYLOAD_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "concurrentqueue.h"
+
+namespace orbit_linux_tracing {
+
+// Thread-safe pool that recycles the buffers holding the registers, callchains and stack copies of
+// PerfEvents. These buffers are allocated by the threads reading the ring buffers and freed by the
+// thread processing the events, at rates of tens of thousands per second, which makes them a
+// significant source of malloc/free churn across threads.
+// Buffers are grouped in power-of-two size classes. Requests larger than the largest size class are
+// not pooled.
+class PerfEventPayloadPool {
+ public:
+  PerfEventPayloadPool() = default;
+  ~PerfEventPayloadPool();
+
+  PerfEventPayloadPool(const PerfEventPayloadPool&) = delete;
+  PerfEventPayloadPool& operator=(const PerfEventPayloadPool&) = delete;
+  PerfEventPayloadPool(PerfEventPayloadPool&&) = delete;
+  PerfEventPayloadPool& operator=(PerfEventPayloadPool&&) = delete;
+
+  static constexpr int8_t kNotPooled = -1;
+
+  // Returns a buffer of at least `size_bytes` bytes and writes its size class to `size_class`, or
+  // returns nullptr and writes kNotPooled if `size_bytes` is too large to be pooled.
+  [[nodiscard]] void* Allocate(size_t size_bytes, int8_t* size_class);
+  // Returns a buffer obtained from Allocate to the pool.
+  void Release(void* buffer, int8_t size_class);
+
+  struct Stats {
+    // Allocations served by a recycled buffer.
+    uint64_t hit_count = 0;
+    // Allocations that needed new memory, including those too large to be pooled.
+    uint64_t miss_count = 0;
+  };
+  [[nodiscard]] Stats GetAndResetStats();
+
+  static constexpr size_t kMinSizeClassLog2 = 6;
+  static constexpr size_t kMaxSizeClassLog2 = 17;
+  static constexpr size_t kSizeClassCount = kMaxSizeClassLog2 - kMinSizeClassLog2 + 1;
+  // Limits how much memory each size class keeps when the processing thread frees more buffers than
+  // are being allocated, e.g., at the end of a burst.
+  static constexpr size_t kMaxRetainedBytesPerSizeClass = 16 * 1024 * 1024;
+
+  [[nodiscard]] static constexpr size_t GetSizeOfSizeClass(int8_t size_class) {
+    return size_t{1} << (kMinSizeClassLog2 + size_class);
+  }
+
+ private:
+  struct SizeClass {
+    moodycamel::ConcurrentQueue<void*> free_buffers;
+    std::atomic<size_t> free_buffer_count = 0;
+  };
+  std::array<SizeClass, kSizeClassCount> size_classes_;
+
+  std::atomic<uint64_t> hit_count_ = 0;
+  std::atomic<uint64_t> miss_count_ = 0;
+};
+
+// Deleter for PerfEventPayload, returning the buffer to the pool it was allocated from.
+template <typename T>
+class PerfEventPayloadDeleter {
+ public:
+  PerfEventPayloadDeleter() = default;
+  // Allows assigning a buffer allocated with new[], e.g., with std::make_unique, to a
+  // PerfEventPayload.
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  PerfEventPayloadDeleter(std::default_delete<T[]> /*unused*/) {}
+  PerfEventPayloadDeleter(PerfEventPayloadPool* pool, int8_t size_class)
+      : pool_{pool}, size_class_{size_class} {}
+
+  void operator()(T* buffer) const {
+    if (pool_ == nullptr || size_class_ == PerfEventPayloadPool::kNotPooled) {
+      delete[] buffer;
+    } else {
+      pool_->Release(buffer, size_class_);
+    }
+  }
+
+ private:
+  PerfEventPayloadPool* pool_ = nullptr;
+  int8_t size_class_ = PerfEventPayloadPool::kNotPooled;
+};
+
+template <typename T>
+using PerfEventPayload = std::unique_ptr<T[], PerfEventPayloadDeleter<T>>;
+
+// Like make_unique_for_overwrite<T[]>(size), but takes the buffer from `pool` if possible. `pool`
+// can be nullptr, and it must outlive the returned buffer.
+template <typename T>
+[[nodiscard]] PerfEventPayload<T> MakePerfEventPayload(PerfEventPayloadPool* pool, size_t size) {
+  static_assert(std::is_trivial_v<T>);
+  if (pool != nullptr) {
+    int8_t size_class = PerfEventPayloadPool::kNotPooled;
+    void* buffer = pool->Allocate(size * sizeof(T), &size_class);
+    if (buffer != nullptr) {
+      return PerfEventPayload<T>{static_cast<T*>(buffer),
+                                 PerfEventPayloadDeleter<T>{pool, size_class}};
+    }
+  }
+  return PerfEventPayload<T>{new T[size]};
+}
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_PERF_EVENT_PAYLOAD_POOL_H_
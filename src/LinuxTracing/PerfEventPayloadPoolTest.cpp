@@ -0,0 +1,88 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "PerfEventPayloadPool.h"
+
+namespace orbit_linux_tracing {
+
+TEST(PerfEventPayloadPool, ReleasedBufferIsReused) {
+  PerfEventPayloadPool pool;
+  uint8_t* first_buffer_address = nullptr;
+  {
+    PerfEventPayload<uint8_t> buffer = MakePerfEventPayload<uint8_t>(&pool, 1000);
+    first_buffer_address = buffer.get();
+    std::memset(buffer.get(), 0xAB, 1000);
+  }
+  PerfEventPayloadPool::Stats stats = pool.GetAndResetStats();
+  EXPECT_EQ(stats.hit_count, 0);
+  EXPECT_EQ(stats.miss_count, 1);
+
+  // 1000 and 1024 bytes are in the same size class.
+  PerfEventPayload<uint64_t> buffer = MakePerfEventPayload<uint64_t>(&pool, 128);
+  EXPECT_EQ(reinterpret_cast<uint8_t*>(buffer.get()), first_buffer_address);
+  stats = pool.GetAndResetStats();
+  EXPECT_EQ(stats.hit_count, 1);
+  EXPECT_EQ(stats.miss_count, 0);
+}
+
+TEST(PerfEventPayloadPool, DifferentSizeClassesAreNotMixed) {
+  PerfEventPayloadPool pool;
+  { PerfEventPayload<uint8_t> buffer = MakePerfEventPayload<uint8_t>(&pool, 64); }
+  PerfEventPayload<uint8_t> buffer = MakePerfEventPayload<uint8_t>(&pool, 65);
+  PerfEventPayloadPool::Stats stats = pool.GetAndResetStats();
+  EXPECT_EQ(stats.hit_count, 0);
+  EXPECT_EQ(stats.miss_count, 2);
+}
+
+TEST(PerfEventPayloadPool, LargeBuffersAreNotPooled) {
+  PerfEventPayloadPool pool;
+  constexpr size_t kLargeSize =
+      PerfEventPayloadPool::GetSizeOfSizeClass(PerfEventPayloadPool::kSizeClassCount - 1) + 1;
+  { PerfEventPayload<uint8_t> buffer = MakePerfEventPayload<uint8_t>(&pool, kLargeSize); }
+  PerfEventPayload<uint8_t> buffer = MakePerfEventPayload<uint8_t>(&pool, kLargeSize);
+  EXPECT_NE(buffer, nullptr);
+  PerfEventPayloadPool::Stats stats = pool.GetAndResetStats();
+  EXPECT_EQ(stats.hit_count, 0);
+  EXPECT_EQ(stats.miss_count, 2);
+}
+
+TEST(PerfEventPayloadPool, WorksWithoutPool) {
+  PerfEventPayload<uint64_t> buffer = MakePerfEventPayload<uint64_t>(nullptr, 10);
+  EXPECT_NE(buffer, nullptr);
+}
+
+TEST(PerfEventPayloadPool, AcceptsBuffersFromMakeUnique) {
+  PerfEventPayload<uint8_t> buffer = std::make_unique<uint8_t[]>(10);
+  EXPECT_NE(buffer, nullptr);
+  buffer = std::make_unique<uint8_t[]>(20);
+  EXPECT_NE(buffer, nullptr);
+}
+
+TEST(PerfEventPayloadPool, BuffersCanBeReleasedOnAnotherThread) {
+  PerfEventPayloadPool pool;
+  constexpr size_t kBufferCount = 1000;
+  std::vector<PerfEventPayload<uint8_t>> buffers;
+  for (size_t i = 0; i < kBufferCount; ++i) {
+    buffers.push_back(MakePerfEventPayload<uint8_t>(&pool, 4096));
+  }
+  std::thread releasing_thread{[&buffers] { buffers.clear(); }};
+  releasing_thread.join();
+
+  for (size_t i = 0; i < kBufferCount; ++i) {
+    buffers.push_back(MakePerfEventPayload<uint8_t>(&pool, 4096));
+  }
+  PerfEventPayloadPool::Stats stats = pool.GetAndResetStats();
+  EXPECT_EQ(stats.hit_count, kBufferCount);
+  EXPECT_EQ(stats.miss_count, kBufferCount);
+}
+
+}  // namespace orbit_linux_tracing
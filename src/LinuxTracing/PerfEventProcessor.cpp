@@ -4,6 +4,7 @@
 
 #include "PerfEventProcessor.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "Introspection/Introspection.h"
@@ -19,6 +20,11 @@ void PerfEventProcessor::AddEvent(PerfEvent&& event) {
     if (discarded_out_of_order_counter_ != nullptr) {
       ++(*discarded_out_of_order_counter_);
     }
+    if (mode_ == ProcessingDelayMode::kStreamWatermark &&
+        discarded_behind_watermark_counter_ != nullptr &&
+        timestamp + kProcessingDelayMs * 1'000'000 >= orbit_base::CaptureTimestampNs()) {
+      ++(*discarded_behind_watermark_counter_);
+    }
 
     std::optional<DiscardedPerfEvent> discarded_perf_event = HandleOutOfOrderEvent(timestamp);
     if (discarded_perf_event.has_value()) {
@@ -26,6 +32,12 @@ void PerfEventProcessor::AddEvent(PerfEvent&& event) {
     }
     return;
   }
+
+  if (mode_ == ProcessingDelayMode::kStreamWatermark &&
+      event.ordered_stream != PerfEventOrderedStream::kNone) {
+    uint64_t& last_timestamp_ns = last_timestamp_ns_by_stream_[event.ordered_stream];
+    last_timestamp_ns = std::max(last_timestamp_ns, timestamp);
+  }
   event_queue_.PushEvent(std::move(event));
 }
 
@@ -101,17 +113,47 @@ void PerfEventProcessor::ProcessAllEvents() {
   }
 }
 
+uint64_t PerfEventProcessor::ComputeStreamWatermark(uint64_t current_timestamp_ns) {
+  uint64_t watermark_ns = 0;
+  for (auto it = last_timestamp_ns_by_stream_.begin(); it != last_timestamp_ns_by_stream_.end();) {
+    const uint64_t last_timestamp_ns = it->second;
+    if (last_timestamp_ns + kProcessingDelayMs * 1'000'000 < current_timestamp_ns) {
+      // The stream is idle: its next events will only be waited for up to kProcessingDelayMs.
+      last_timestamp_ns_by_stream_.erase(it++);
+      continue;
+    }
+    if (watermark_ns == 0 || last_timestamp_ns < watermark_ns) {
+      watermark_ns = last_timestamp_ns;
+    }
+    ++it;
+  }
+  return watermark_ns;
+}
+
 void PerfEventProcessor::ProcessOldEvents() {
   ORBIT_SCOPE("PerfEventProcessor::ProcessOldEvents");
   ORBIT_CHECK(!visitors_.empty());
   const uint64_t current_timestamp_ns = orbit_base::CaptureTimestampNs();
 
+  uint64_t stream_watermark_ns = 0;
+  if (mode_ == ProcessingDelayMode::kStreamWatermark) {
+    stream_watermark_ns = ComputeStreamWatermark(current_timestamp_ns);
+  }
+
   while (event_queue_.HasEvent()) {
     const PerfEvent& event = event_queue_.TopEvent();
     const uint64_t timestamp = event.timestamp;
 
-    // Do not read the most recent events as out-of-order events could (and will) arrive.
-    if (timestamp + kProcessingDelayMs * 1'000'000 >= current_timestamp_ns) {
+    // Do not read the most recent events as out-of-order events could (and will) arrive, unless all
+    // active streams have already advanced past them. Events that don't belong to an ordered stream
+    // could still be preceded by older ones, so they always wait for the fixed delay.
+    const bool is_older_than_processing_delay =
+        timestamp + kProcessingDelayMs * 1'000'000 < current_timestamp_ns;
+    const bool is_behind_stream_watermark =
+        event.ordered_stream != PerfEventOrderedStream::kNone && stream_watermark_ns > 0 &&
+        timestamp <= stream_watermark_ns &&
+        timestamp + kStreamWatermarkMinProcessingDelayMs * 1'000'000 < current_timestamp_ns;
+    if (!is_older_than_processing_delay && !is_behind_stream_watermark) {
       break;
     }
     // Events are guaranteed to be processed in order of timestamp
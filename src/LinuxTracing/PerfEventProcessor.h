@@ -5,6 +5,7 @@
 #ifndef LINUX_TRACING_PERF_EVENT_PROCESSOR_H_
 #define LINUX_TRACING_PERF_EVENT_PROCESSOR_H_
 
+#include <absl/container/flat_hash_map.h>
 #include <stdint.h>
 
 #include <algorithm>
@@ -13,6 +14,7 @@
 #include <vector>
 
 #include "PerfEvent.h"
+#include "PerfEventOrderedStream.h"
 #include "PerfEventQueue.h"
 #include "PerfEventVisitor.h"
 
@@ -25,8 +27,22 @@ namespace orbit_linux_tracing {
 // we will never process events out of order.
 // If events older than kProcessingDelayMs are encountered anyway, these are discarded, and
 // DiscardedPerfEvents are generated and processed in their place.
+// With ProcessingDelayMode::kStreamWatermark, events are instead processed as soon as all ordered
+// streams that are still active have advanced past them, where a stream is active if its last event
+// is not older than kProcessingDelayMs. Only events of idle streams (and events not ordered in any
+// stream) are still held for up to kProcessingDelayMs. This reduces latency and the memory retained
+// by events waiting to be processed, at the cost of discarding events of a stream that resumes
+// after being idle, if these are read too late.
 class PerfEventProcessor {
  public:
+  enum class ProcessingDelayMode {
+    kFixedDelay,
+    kStreamWatermark,
+  };
+
+  explicit PerfEventProcessor(ProcessingDelayMode mode = ProcessingDelayMode::kFixedDelay)
+      : mode_{mode} {}
+
   void AddEvent(PerfEvent&& event);
 
   void ProcessAllEvents();
@@ -41,15 +57,39 @@ class PerfEventProcessor {
     discarded_out_of_order_counter_ = discarded_out_of_order_counter;
   }
 
+  // Only used with ProcessingDelayMode::kStreamWatermark: counts the events that were discarded as
+  // out of order but that would have been processed with ProcessingDelayMode::kFixedDelay, i.e.,
+  // that are not older than kProcessingDelayMs. These are also counted by the counter set with
+  // SetDiscardedOutOfOrderCounter.
+  void SetDiscardedBehindWatermarkCounter(
+      std::atomic<uint64_t>* discarded_behind_watermark_counter) {
+    discarded_behind_watermark_counter_ = discarded_behind_watermark_counter;
+  }
+
+  [[nodiscard]] ProcessingDelayMode GetProcessingDelayMode() const { return mode_; }
+
   // Do not process events that are more recent than kProcessingDelayMs. Events
   // come out of order as they are read from different perf_event_open ring
   // buffers and this ensures that all events are processed in the correct
   // order.
   static constexpr uint64_t kProcessingDelayMs = 333;
 
+  // With ProcessingDelayMode::kStreamWatermark, still don't process events that are more recent
+  // than this. This leaves time to the ring buffers that were idle to be read, as the tracer might
+  // only get back to them after some time, e.g., when it waits for ring buffers with epoll.
+  static constexpr uint64_t kStreamWatermarkMinProcessingDelayMs = 100;
+
  private:
+  // Returns the smallest among the last timestamps of the streams that are still active, and
+  // forgets about the streams that are not. Returns 0 if no stream is active.
+  [[nodiscard]] uint64_t ComputeStreamWatermark(uint64_t current_timestamp_ns);
+
+  const ProcessingDelayMode mode_;
   uint64_t last_processed_timestamp_ns_ = 0;
   std::atomic<uint64_t>* discarded_out_of_order_counter_ = nullptr;
+  std::atomic<uint64_t>* discarded_behind_watermark_counter_ = nullptr;
+  // Only used with ProcessingDelayMode::kStreamWatermark.
+  absl::flat_hash_map<PerfEventOrderedStream, uint64_t> last_timestamp_ns_by_stream_;
 
   PerfEventQueue event_queue_;
   std::vector<PerfEventVisitor*> visitors_;
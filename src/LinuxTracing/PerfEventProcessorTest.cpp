@@ -49,6 +49,30 @@ class PerfEventProcessorTest : public ::testing::Test {
   static constexpr uint64_t kDelayBeforeProcessOldEventsMs = PerfEventProcessor::kProcessingDelayMs;
 };
 
+class PerfEventProcessorStreamWatermarkTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    processor_.AddVisitor(&mock_visitor_);
+    processor_.SetDiscardedOutOfOrderCounter(&discarded_out_of_order_counter_);
+    processor_.SetDiscardedBehindWatermarkCounter(&discarded_behind_watermark_counter_);
+  }
+
+  PerfEventProcessor processor_{PerfEventProcessor::ProcessingDelayMode::kStreamWatermark};
+  MockVisitor mock_visitor_;
+  std::atomic<uint64_t> discarded_out_of_order_counter_ = 0;
+  std::atomic<uint64_t> discarded_behind_watermark_counter_ = 0;
+};
+
+// Returns a timestamp that is older than kStreamWatermarkMinProcessingDelayMs but not older than
+// kProcessingDelayMs, so that events with this timestamp can only be processed because of the
+// stream watermark.
+uint64_t MakeTimestampBetweenMinAndFixedProcessingDelayNs() {
+  constexpr uint64_t kAgeMs = (PerfEventProcessor::kStreamWatermarkMinProcessingDelayMs +
+                               PerfEventProcessor::kProcessingDelayMs) /
+                              2;
+  return orbit_base::CaptureTimestampNs() - kAgeMs * 1'000'000;
+}
+
 PerfEvent MakeFakePerfEventOrderedInFd(int origin_fd, uint64_t timestamp_ns) {
   // We use ForkPerfEvent just because it's a simple one, but we could use any
   // as we only need to set the file descriptor and the timestamp.
@@ -209,6 +233,110 @@ TEST_F(PerfEventProcessorTest, DiscardedPerfEvents) {
   EXPECT_EQ(discarded_out_of_order_counter_, 5);
 }
 
+TEST_F(PerfEventProcessorStreamWatermarkTest, ProcessOldEventsBehindWatermark) {
+  const uint64_t timestamp_ns = MakeTimestampBetweenMinAndFixedProcessingDelayNs();
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, timestamp_ns));
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(22, timestamp_ns + 1));
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, timestamp_ns + 2));
+
+  // Stream 22 has only advanced to timestamp_ns + 1.
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns, A<const ForkPerfEventData&>())).Times(1);
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns + 1, A<const ForkPerfEventData&>())).Times(1);
+  processor_.ProcessOldEvents();
+  Mock::VerifyAndClearExpectations(&mock_visitor_);
+
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns + 2, A<const ForkPerfEventData&>())).Times(1);
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(22, timestamp_ns + 3));
+  processor_.ProcessOldEvents();
+  Mock::VerifyAndClearExpectations(&mock_visitor_);
+
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns + 3, A<const ForkPerfEventData&>())).Times(1);
+  processor_.ProcessAllEvents();
+  EXPECT_EQ(discarded_out_of_order_counter_, 0);
+}
+
+TEST_F(PerfEventProcessorStreamWatermarkTest, DoesNotProcessEventsMoreRecentThanMinDelay) {
+  EXPECT_CALL(mock_visitor_, Visit(_, A<const ForkPerfEventData&>())).Times(0);
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, orbit_base::CaptureTimestampNs()));
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, orbit_base::CaptureTimestampNs()));
+  processor_.ProcessOldEvents();
+  Mock::VerifyAndClearExpectations(&mock_visitor_);
+
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(PerfEventProcessor::kStreamWatermarkMinProcessingDelayMs));
+
+  EXPECT_CALL(mock_visitor_, Visit(_, A<const ForkPerfEventData&>())).Times(2);
+  processor_.ProcessOldEvents();
+}
+
+TEST_F(PerfEventProcessorStreamWatermarkTest, IdleStreamsDoNotHoldBackWatermark) {
+  const uint64_t idle_timestamp_ns = orbit_base::CaptureTimestampNs() -
+                                     (PerfEventProcessor::kProcessingDelayMs + 1) * 1'000'000;
+  const uint64_t timestamp_ns = MakeTimestampBetweenMinAndFixedProcessingDelayNs();
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, idle_timestamp_ns));
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(22, timestamp_ns));
+
+  EXPECT_CALL(mock_visitor_, Visit(idle_timestamp_ns, A<const ForkPerfEventData&>())).Times(1);
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns, A<const ForkPerfEventData&>())).Times(1);
+  processor_.ProcessOldEvents();
+}
+
+TEST_F(PerfEventProcessorStreamWatermarkTest, NotOrderedEventsWaitForFixedDelayWithoutStreams) {
+  EXPECT_CALL(mock_visitor_, Visit(_, A<const ForkPerfEventData&>())).Times(0);
+  processor_.AddEvent(
+      MakeFakePerfEventNotOrdered(MakeTimestampBetweenMinAndFixedProcessingDelayNs()));
+  processor_.ProcessOldEvents();
+  Mock::VerifyAndClearExpectations(&mock_visitor_);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(PerfEventProcessor::kProcessingDelayMs));
+
+  EXPECT_CALL(mock_visitor_, Visit(_, A<const ForkPerfEventData&>())).Times(1);
+  processor_.ProcessOldEvents();
+}
+
+TEST_F(PerfEventProcessorStreamWatermarkTest, NotOrderedEventsWaitForFixedDelayWithActiveStreams) {
+  const uint64_t timestamp_ns = MakeTimestampBetweenMinAndFixedProcessingDelayNs();
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, timestamp_ns));
+  processor_.AddEvent(MakeFakePerfEventNotOrdered(timestamp_ns + 1));
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, timestamp_ns + 2));
+
+  // The watermark of stream 11 is past the event that is not ordered, but the latter still holds
+  // back the events that follow it.
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns, A<const ForkPerfEventData&>())).Times(1);
+  processor_.ProcessOldEvents();
+  Mock::VerifyAndClearExpectations(&mock_visitor_);
+
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns + 1, A<const ForkPerfEventData&>())).Times(1);
+  EXPECT_CALL(mock_visitor_, Visit(timestamp_ns + 2, A<const ForkPerfEventData&>())).Times(1);
+  processor_.ProcessAllEvents();
+}
+
+TEST_F(PerfEventProcessorStreamWatermarkTest, DiscardedBehindWatermarkCounter) {
+  const uint64_t timestamp_ns = MakeTimestampBetweenMinAndFixedProcessingDelayNs();
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, timestamp_ns));
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, timestamp_ns + 2));
+
+  EXPECT_CALL(mock_visitor_, Visit(_, A<const ForkPerfEventData&>())).Times(2);
+  processor_.ProcessOldEvents();
+  Mock::VerifyAndClearExpectations(&mock_visitor_);
+
+  // A stream that was idle resumes with an event older than the last processed one. This event
+  // would not have been discarded with the fixed delay.
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(22, timestamp_ns + 1));
+  EXPECT_EQ(discarded_out_of_order_counter_, 1);
+  EXPECT_EQ(discarded_behind_watermark_counter_, 1);
+
+  // This event would have been discarded also with the fixed delay.
+  processor_.AddEvent(MakeFakePerfEventOrderedInFd(
+      22, orbit_base::CaptureTimestampNs() -
+              (PerfEventProcessor::kProcessingDelayMs + 1) * 1'000'000));
+  EXPECT_EQ(discarded_out_of_order_counter_, 2);
+  EXPECT_EQ(discarded_behind_watermark_counter_, 1);
+
+  EXPECT_CALL(mock_visitor_, Visit(_, A<const DiscardedPerfEventData&>())).Times(2);
+  processor_.ProcessAllEvents();
+}
+
 TEST_F(PerfEventProcessorTest, ProcessOldEventsNeedsVisitor) {
   processor_.ClearVisitors();
   processor_.AddEvent(MakeFakePerfEventOrderedInFd(11, orbit_base::CaptureTimestampNs()));
@@ -4,7 +4,6 @@
 
 #include "PerfEventQueue.h"
 
-#include <absl/meta/type_traits.h>
 #include <stddef.h>
 
 #include <algorithm>
@@ -16,127 +15,147 @@
 
 namespace orbit_linux_tracing {
 
-void PerfEventQueue::PushEvent(PerfEvent&& event) {
-  const PerfEventOrderedStream order = event.ordered_stream;
-  if (order == PerfEventOrderedStream::kNone) {
-    priority_queue_of_events_not_ordered_in_stream_.push(std::move(event));
-  } else if (auto queue_it = queues_of_events_ordered_in_stream_.find(order);
-             queue_it != queues_of_events_ordered_in_stream_.end()) {
-    const std::unique_ptr<std::queue<PerfEvent>>& queue = queue_it->second;
-
-    ORBIT_CHECK(!queue->empty());
-    // Fundamental assumption: events from the same file descriptor come already in order.
-    ORBIT_CHECK(event.timestamp >= queue->back().timestamp);
-    queue->push(std::move(event));
-  } else {
-    queue_it = queues_of_events_ordered_in_stream_
-                   .emplace(order, std::make_unique<std::queue<PerfEvent>>())
-                   .first;
-    const std::unique_ptr<std::queue<PerfEvent>>& queue = queue_it->second;
-
-    queue->push(std::move(event));
-    heap_of_queues_of_events_ordered_in_stream_.emplace_back(queue.get());
-    MoveUpBackOfHeapOfQueues();
+PerfEventQueue::PerfEventQueue() {
+  static_assert(kInitialLeafCount >= 2 && (kInitialLeafCount & (kInitialLeafCount - 1)) == 0);
+  leaf_timestamps_.resize(kInitialLeafCount, kNoEventTimestamp);
+  tournament_tree_.resize(kInitialLeafCount, kLeafOfEventsNotOrderedInStream);
+  queues_of_events_ordered_in_stream_.resize(kInitialLeafCount);
+  ordered_stream_of_leaf_.resize(kInitialLeafCount, PerfEventOrderedStream::kNone);
+  for (size_t leaf = kInitialLeafCount - 1; leaf > kLeafOfEventsNotOrderedInStream; --leaf) {
+    free_leaves_.push_back(leaf);
   }
 }
 
-bool PerfEventQueue::HasEvent() const {
-  return !heap_of_queues_of_events_ordered_in_stream_.empty() ||
-         !priority_queue_of_events_not_ordered_in_stream_.empty();
+void PerfEventQueue::PlayMatchAtNode(size_t node) {
+  const size_t left_leaf = GetLeafWinningAtNode(2 * node);
+  const size_t right_leaf = GetLeafWinningAtNode(2 * node + 1);
+  // The leaves in the left subtree have lower indices, so this favors the lower index on ties.
+  tournament_tree_[node] =
+      leaf_timestamps_[left_leaf] <= leaf_timestamps_[right_leaf] ? left_leaf : right_leaf;
 }
 
-const PerfEvent& PerfEventQueue::TopEvent() {
-  // As we effectively have two priority queues, get the older event between the two events at the
-  // top of the two queues. In case those two events have the exact same timestamp, return the one
-  // at the top of priority_queue_of_events_not_ordered_in_stream_ (and do the same in PopEvent).
-  if (priority_queue_of_events_not_ordered_in_stream_.empty()) {
-    ORBIT_CHECK(!heap_of_queues_of_events_ordered_in_stream_.empty());
-    ORBIT_CHECK(!heap_of_queues_of_events_ordered_in_stream_.front()->empty());
-    return heap_of_queues_of_events_ordered_in_stream_.front()->front();
-  }
-  if (heap_of_queues_of_events_ordered_in_stream_.empty()) {
-    ORBIT_CHECK(!priority_queue_of_events_not_ordered_in_stream_.empty());
-    return priority_queue_of_events_not_ordered_in_stream_.top();
+void PerfEventQueue::SetLeafTimestamp(size_t leaf, uint64_t timestamp) {
+  leaf_timestamps_[leaf] = timestamp;
+  for (size_t node = (GetLeafCount() + leaf) / 2; node >= 1; node /= 2) {
+    PlayMatchAtNode(node);
   }
-  return (heap_of_queues_of_events_ordered_in_stream_.front()->front().timestamp <
-          priority_queue_of_events_not_ordered_in_stream_.top().timestamp)
-             ? heap_of_queues_of_events_ordered_in_stream_.front()->front()
-             : priority_queue_of_events_not_ordered_in_stream_.top();
 }
 
-void PerfEventQueue::PopEvent() {
-  if (!priority_queue_of_events_not_ordered_in_stream_.empty() &&
-      (heap_of_queues_of_events_ordered_in_stream_.empty() ||
-       priority_queue_of_events_not_ordered_in_stream_.top().timestamp <=
-           heap_of_queues_of_events_ordered_in_stream_.front()->front().timestamp)) {
-    // The oldest event is at the top of the priority queue holding the events that cannot be
-    // assumed sorted in any stream. Note in particular that we pop this event even if the event at
-    // the top of heap_of_queues_of_events_ordered_in_stream_ has the exact same timestamp, as we
-    // need to be consistent with TopEvent.
-    priority_queue_of_events_not_ordered_in_stream_.pop();
-    return;
+void PerfEventQueue::GrowTournamentTree() {
+  const size_t old_leaf_count = GetLeafCount();
+  const size_t new_leaf_count = 2 * old_leaf_count;
+  leaf_timestamps_.resize(new_leaf_count, kNoEventTimestamp);
+  queues_of_events_ordered_in_stream_.resize(new_leaf_count);
+  ordered_stream_of_leaf_.resize(new_leaf_count, PerfEventOrderedStream::kNone);
+  for (size_t leaf = new_leaf_count - 1; leaf >= old_leaf_count; --leaf) {
+    free_leaves_.push_back(leaf);
   }
 
-  std::queue<PerfEvent>* top_queue = heap_of_queues_of_events_ordered_in_stream_.front();
-  const PerfEventOrderedStream top_order = top_queue->front().ordered_stream;
-  top_queue->pop();
-
-  if (top_queue->empty()) {
-    queues_of_events_ordered_in_stream_.erase(top_order);
-    std::swap(heap_of_queues_of_events_ordered_in_stream_.front(),
-              heap_of_queues_of_events_ordered_in_stream_.back());
-    heap_of_queues_of_events_ordered_in_stream_.pop_back();
+  tournament_tree_.resize(new_leaf_count);
+  for (size_t node = new_leaf_count - 1; node >= 1; --node) {
+    PlayMatchAtNode(node);
   }
-
-  MoveDownFrontOfHeapOfQueues();
 }
 
-void PerfEventQueue::MoveDownFrontOfHeapOfQueues() {
-  if (heap_of_queues_of_events_ordered_in_stream_.empty()) {
-    return;
+size_t PerfEventQueue::AllocateLeaf() {
+  if (free_leaves_.empty()) {
+    GrowTournamentTree();
   }
+  const size_t leaf = free_leaves_.back();
+  free_leaves_.pop_back();
+  return leaf;
+}
 
-  size_t current_index = 0;
-  while (true) {
-    size_t new_index = current_index;
-    size_t left_index = current_index * 2 + 1;
-    size_t right_index = current_index * 2 + 2;
-    if (left_index < heap_of_queues_of_events_ordered_in_stream_.size() &&
-        heap_of_queues_of_events_ordered_in_stream_[left_index]->front().timestamp <
-            heap_of_queues_of_events_ordered_in_stream_[new_index]->front().timestamp) {
-      new_index = left_index;
-    }
-    if (right_index < heap_of_queues_of_events_ordered_in_stream_.size() &&
-        heap_of_queues_of_events_ordered_in_stream_[right_index]->front().timestamp <
-            heap_of_queues_of_events_ordered_in_stream_[new_index]->front().timestamp) {
-      new_index = right_index;
-    }
-    if (new_index != current_index) {
-      std::swap(heap_of_queues_of_events_ordered_in_stream_[new_index],
-                heap_of_queues_of_events_ordered_in_stream_[current_index]);
-      current_index = new_index;
+void PerfEventQueue::PushEvent(PerfEvent&& event) {
+  const uint64_t timestamp = event.timestamp;
+  ORBIT_CHECK(timestamp != kNoEventTimestamp);
+  const PerfEventOrderedStream order = event.ordered_stream;
+
+  if (order == PerfEventOrderedStream::kNone) {
+    uint32_t slot;
+    if (free_slots_of_events_not_ordered_in_stream_.empty()) {
+      slot = static_cast<uint32_t>(events_not_ordered_in_stream_.size());
+      events_not_ordered_in_stream_.emplace_back(std::move(event));
     } else {
-      break;
+      slot = free_slots_of_events_not_ordered_in_stream_.back();
+      free_slots_of_events_not_ordered_in_stream_.pop_back();
+      events_not_ordered_in_stream_[slot].emplace(std::move(event));
     }
+    heap_of_events_not_ordered_in_stream_.push_back({timestamp, slot});
+    std::push_heap(heap_of_events_not_ordered_in_stream_.begin(),
+                   heap_of_events_not_ordered_in_stream_.end(), kReverseTimestampCompare);
+    if (timestamp < leaf_timestamps_[kLeafOfEventsNotOrderedInStream]) {
+      SetLeafTimestamp(kLeafOfEventsNotOrderedInStream, timestamp);
+    }
+
+  } else if (auto leaf_it = leaf_of_ordered_stream_.find(order);
+             leaf_it != leaf_of_ordered_stream_.end()) {
+    std::deque<PerfEvent>& queue = queues_of_events_ordered_in_stream_[leaf_it->second];
+    ORBIT_CHECK(!queue.empty());
+    // Fundamental assumption: events from the same file descriptor come already in order.
+    ORBIT_CHECK(timestamp >= queue.back().timestamp);
+    // The oldest event of the queue doesn't change, so neither does the tournament tree.
+    queue.push_back(std::move(event));
+
+  } else {
+    const size_t leaf = AllocateLeaf();
+    leaf_of_ordered_stream_.emplace(order, leaf);
+    ordered_stream_of_leaf_[leaf] = order;
+    std::deque<PerfEvent>& queue = queues_of_events_ordered_in_stream_[leaf];
+    ORBIT_CHECK(queue.empty());
+    queue.push_back(std::move(event));
+    SetLeafTimestamp(leaf, timestamp);
   }
+
+  ++event_count_;
 }
 
-void PerfEventQueue::MoveUpBackOfHeapOfQueues() {
-  if (heap_of_queues_of_events_ordered_in_stream_.empty()) {
-    return;
+const PerfEvent& PerfEventQueue::TopEvent() {
+  ORBIT_CHECK(HasEvent());
+  const size_t top_leaf = GetTopLeaf();
+  if (top_leaf == kLeafOfEventsNotOrderedInStream) {
+    ORBIT_CHECK(!heap_of_events_not_ordered_in_stream_.empty());
+    return events_not_ordered_in_stream_[heap_of_events_not_ordered_in_stream_.front().slot]
+        .value();
   }
+  ORBIT_CHECK(!queues_of_events_ordered_in_stream_[top_leaf].empty());
+  return queues_of_events_ordered_in_stream_[top_leaf].front();
+}
+
+void PerfEventQueue::PopEvent() {
+  ORBIT_CHECK(HasEvent());
+  const size_t top_leaf = GetTopLeaf();
+
+  if (top_leaf == kLeafOfEventsNotOrderedInStream) {
+    ORBIT_CHECK(!heap_of_events_not_ordered_in_stream_.empty());
+    std::pop_heap(heap_of_events_not_ordered_in_stream_.begin(),
+                  heap_of_events_not_ordered_in_stream_.end(), kReverseTimestampCompare);
+    const uint32_t slot = heap_of_events_not_ordered_in_stream_.back().slot;
+    heap_of_events_not_ordered_in_stream_.pop_back();
+    events_not_ordered_in_stream_[slot].reset();
+    free_slots_of_events_not_ordered_in_stream_.push_back(slot);
+    SetLeafTimestamp(kLeafOfEventsNotOrderedInStream,
+                     heap_of_events_not_ordered_in_stream_.empty()
+                         ? kNoEventTimestamp
+                         : heap_of_events_not_ordered_in_stream_.front().timestamp);
 
-  size_t current_index = heap_of_queues_of_events_ordered_in_stream_.size() - 1;
-  while (current_index > 0) {
-    size_t parent_index = (current_index - 1) / 2;
-    if (heap_of_queues_of_events_ordered_in_stream_[parent_index]->front().timestamp <=
-        heap_of_queues_of_events_ordered_in_stream_[current_index]->front().timestamp) {
-      break;
+  } else {
+    std::deque<PerfEvent>& top_queue = queues_of_events_ordered_in_stream_[top_leaf];
+    ORBIT_CHECK(!top_queue.empty());
+    top_queue.pop_front();
+    if (top_queue.empty()) {
+      // Release the leaf, as streams identified by thread id can be short-lived. The queue keeps
+      // its memory for the next stream that gets this leaf.
+      leaf_of_ordered_stream_.erase(ordered_stream_of_leaf_[top_leaf]);
+      ordered_stream_of_leaf_[top_leaf] = PerfEventOrderedStream::kNone;
+      free_leaves_.push_back(top_leaf);
+      SetLeafTimestamp(top_leaf, kNoEventTimestamp);
+    } else {
+      SetLeafTimestamp(top_leaf, top_queue.front().timestamp);
     }
-    std::swap(heap_of_queues_of_events_ordered_in_stream_[parent_index],
-              heap_of_queues_of_events_ordered_in_stream_[current_index]);
-    current_index = parent_index;
   }
+
+  --event_count_;
 }
 
 }  // namespace orbit_linux_tracing
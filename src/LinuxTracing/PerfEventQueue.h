@@ -7,10 +7,12 @@
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
+#include <stddef.h>
+#include <stdint.h>
 
-#include <functional>
-#include <memory>
-#include <queue>
+#include <deque>
+#include <limits>
+#include <optional>
 #include <vector>
 
 #include "PerfEvent.h"
@@ -25,47 +27,82 @@ namespace orbit_linux_tracing {
 // Instead of keeping a single priority queue with all the events to process, on which push/pop
 // operations would be logarithmic in the number of events, we leverage the fact that some streams
 // of events are known to be already sorted; for example, most perf_event_open records coming from
-// the same perf_event_open ring buffer are already sorted. We then keep a priority queue of queues,
-// where the events in each queue come from the same sorted stream, identified by matching instances
-// of PerfEventOrderedStream. Whenever an event is removed from a queue, we need to move such queue
-// down the priority queue.
+// the same perf_event_open ring buffer are already sorted. We keep a queue for each sorted stream,
+// identified by matching instances of PerfEventOrderedStream, and merge the queues with a
+// tournament tree. The leaves of the tree are the queues, keyed by the timestamp of their oldest
+// event, and each internal node holds the index of the leaf with the oldest event in its subtree.
+// Whenever the oldest event of a queue changes, only the path from its leaf to the root needs to be
+// updated, and this only touches the flat arrays of leaf indices and timestamps, never the
+// PerfEvents themselves.
 //
 // In order to be able to add an event to a queue, we also need to maintain the association between
 // a queue and its sorted stream, which is what the map is for. We use the PerfEventOrderedStream as
 // key.
 //
 // Some events, though, are known to come out of order even in relation to other events in the same
-// perf_event_open ring buffer (e.g., dma_fence_signaled). For those cases, use an additional single
-// std::priority_queue.
+// perf_event_open ring buffer (e.g., dma_fence_signaled). For those cases, use an additional binary
+// heap, which is the first leaf of the tournament tree. Again, the heap only holds timestamps and
+// indices, while the events stay in place.
 class PerfEventQueue {
  public:
+  PerfEventQueue();
+
   void PushEvent(PerfEvent&& event);
-  [[nodiscard]] bool HasEvent() const;
+  [[nodiscard]] bool HasEvent() const { return event_count_ > 0; }
   [[nodiscard]] const PerfEvent& TopEvent();
   void PopEvent();
 
  private:
-  // Floats down the element at the top of the ordered_queues_heap_ to its correct place. Used when
-  // the key of the top element changes, or as part of the process of removing the top element.
-  void MoveDownFrontOfHeapOfQueues();
-  // Floats up an element that it is know should be further up in the heap. Used on insertion.
-  void MoveUpBackOfHeapOfQueues();
+  // The timestamp of the leaves whose queue is empty. Events can't have this timestamp.
+  static constexpr uint64_t kNoEventTimestamp = std::numeric_limits<uint64_t>::max();
+  // The leaf for the events that cannot be assumed sorted in any stream. As ties are won by the
+  // leaf with the lower index, these events come first among events with the same timestamp.
+  static constexpr size_t kLeafOfEventsNotOrderedInStream = 0;
+  static constexpr size_t kInitialLeafCount = 16;
+
+  [[nodiscard]] size_t GetLeafCount() const { return leaf_timestamps_.size(); }
+  [[nodiscard]] size_t GetTopLeaf() const { return tournament_tree_[1]; }
+  [[nodiscard]] size_t GetLeafWinningAtNode(size_t node) const {
+    return node >= GetLeafCount() ? node - GetLeafCount() : tournament_tree_[node];
+  }
+  // Recomputes the winner at `node` from the winners at its two children.
+  void PlayMatchAtNode(size_t node);
+  // Updates the timestamp of `leaf` and all matches on the path from `leaf` to the root.
+  void SetLeafTimestamp(size_t leaf, uint64_t timestamp);
+  // Doubles the number of leaves, adding the new ones to free_leaves_.
+  void GrowTournamentTree();
+  [[nodiscard]] size_t AllocateLeaf();
+
+  // The timestamp of the oldest event of each leaf, or kNoEventTimestamp.
+  std::vector<uint64_t> leaf_timestamps_;
+  // The internal nodes of the tournament tree: node 1 is the root, and the children of node i are
+  // nodes 2 * i and 2 * i + 1. Node GetLeafCount() + i corresponds to leaf i and is not stored.
+  std::vector<uint32_t> tournament_tree_;
+  std::vector<size_t> free_leaves_;
+
+  // The queues of events coming from the same stream of events already in order by timestamp, by
+  // leaf, together with the stream they belong to.
+  std::vector<std::deque<PerfEvent>> queues_of_events_ordered_in_stream_;
+  std::vector<PerfEventOrderedStream> ordered_stream_of_leaf_;
+  // This map keeps the association between an ordered stream of events and the leaf holding the
+  // ordered queue of events coming from that stream.
+  absl::flat_hash_map<PerfEventOrderedStream, size_t> leaf_of_ordered_stream_;
 
-  // This vector holds the heap of the queues each of which holds events coming from the same
-  // stream of events already in order by timestamp.
-  std::vector<std::queue<PerfEvent>*> heap_of_queues_of_events_ordered_in_stream_;
-  // This map keeps the association between an ordered stream of events and the ordered queue of
-  // events coming from that stream.
-  absl::flat_hash_map<PerfEventOrderedStream, std::unique_ptr<std::queue<PerfEvent>>>
-      queues_of_events_ordered_in_stream_;
+  struct TimestampAndSlot {
+    uint64_t timestamp;
+    uint32_t slot;
+  };
+  static constexpr auto kReverseTimestampCompare = [](const TimestampAndSlot& lhs,
+                                                      const TimestampAndSlot& rhs) {
+    return lhs.timestamp > rhs.timestamp;
+  };
+  // This heap holds the timestamps of all those events that cannot be assumed already sorted in a
+  // specific stream, together with the slot in events_not_ordered_in_stream_ holding the event.
+  std::vector<TimestampAndSlot> heap_of_events_not_ordered_in_stream_;
+  std::vector<std::optional<PerfEvent>> events_not_ordered_in_stream_;
+  std::vector<uint32_t> free_slots_of_events_not_ordered_in_stream_;
 
-  static constexpr auto kPerfEventReverseTimestampCompare =
-      [](const PerfEvent& lhs, const PerfEvent& rhs) { return lhs.timestamp > rhs.timestamp; };
-  // This priority queue holds all those events that cannot be assumed already sorted in a specific
-  // stream. All such events are simply sorted by the priority queue by increasing timestamp.
-  std::priority_queue<PerfEvent, std::vector<PerfEvent>,
-                      std::function<bool(const PerfEvent&, const PerfEvent&)>>
-      priority_queue_of_events_not_ordered_in_stream_{kPerfEventReverseTimestampCompare};
+  size_t event_count_ = 0;
 };
 
 }  // namespace orbit_linux_tracing
@@ -6,7 +6,10 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <memory>
+#include <random>
+#include <vector>
 
 #include "PerfEvent.h"
 #include "PerfEventOrderedStream.h"
@@ -359,6 +362,68 @@ TEST(PerfEventQueue, AllOrderTypesTogether) {
   EXPECT_DEATH(event_queue.PopEvent(), "");
 }
 
+TEST(PerfEventQueue, ManyStreamsAndNoOrderTogether) {
+  constexpr int kStreamCount = 1000;
+  constexpr int kEventCountPerRound = 30'000;
+  constexpr int kRoundCount = 3;
+  std::mt19937 generator{42};
+  std::bernoulli_distribution not_ordered_distribution{0.1};
+  std::uniform_int_distribution<int> stream_distribution{0, kStreamCount - 1};
+  std::uniform_int_distribution<uint64_t> timestamp_increment_distribution{0, 100};
+  std::uniform_int_distribution<uint64_t> timestamp_not_ordered_distribution{0, 100'000};
+
+  PerfEventQueue event_queue;
+  for (int round = 0; round < kRoundCount; ++round) {
+    // Streams are created and released in each round, so that their leaves get reused.
+    const uint64_t round_begin_timestamp = round * 1'000'000;
+    std::vector<uint64_t> last_timestamp_per_stream(kStreamCount, round_begin_timestamp);
+    std::vector<uint64_t> expected_timestamps;
+    for (int i = 0; i < kEventCountPerRound; ++i) {
+      if (not_ordered_distribution(generator)) {
+        const uint64_t timestamp =
+            round_begin_timestamp + timestamp_not_ordered_distribution(generator);
+        event_queue.PushEvent(MakeTestEventNotOrdered(timestamp));
+        expected_timestamps.push_back(timestamp);
+      } else {
+        const int stream = stream_distribution(generator);
+        last_timestamp_per_stream[stream] += timestamp_increment_distribution(generator);
+        const uint64_t timestamp = last_timestamp_per_stream[stream];
+        if (stream % 2 == 0) {
+          event_queue.PushEvent(MakeTestEventOrderedInFd(stream, timestamp));
+        } else {
+          event_queue.PushEvent(MakeTestEventOrderedInTid(stream, timestamp));
+        }
+        expected_timestamps.push_back(timestamp);
+      }
+    }
+
+    std::sort(expected_timestamps.begin(), expected_timestamps.end());
+    for (uint64_t expected_timestamp : expected_timestamps) {
+      ASSERT_TRUE(event_queue.HasEvent());
+      ASSERT_EQ(event_queue.TopEvent().timestamp, expected_timestamp);
+      event_queue.PopEvent();
+    }
+    EXPECT_FALSE(event_queue.HasEvent());
+  }
+}
+
+TEST(PerfEventQueue, EventWithNoOrderComesFirstAmongEventsWithTheSameTimestamp) {
+  PerfEventQueue event_queue;
+  constexpr uint64_t kCommonTimestamp = 100;
+
+  event_queue.PushEvent(MakeTestEventOrderedInFd(11, kCommonTimestamp));
+  event_queue.PushEvent(MakeTestEventOrderedInTid(22, kCommonTimestamp));
+  event_queue.PushEvent(MakeTestEventNotOrdered(kCommonTimestamp));
+
+  EXPECT_EQ(event_queue.TopEvent().ordered_stream, PerfEventOrderedStream::kNone);
+  event_queue.PopEvent();
+  EXPECT_NE(event_queue.TopEvent().ordered_stream, PerfEventOrderedStream::kNone);
+  event_queue.PopEvent();
+  EXPECT_NE(event_queue.TopEvent().ordered_stream, PerfEventOrderedStream::kNone);
+  event_queue.PopEvent();
+  EXPECT_FALSE(event_queue.HasEvent());
+}
+
 TEST(
     PerfEventQueue,
     TopEventAndPopEventReturnTheSameWhenAnEventOrderedByFdAndAnEventWithNoOrderHaveTheSameTimestamp) {
@@ -43,8 +43,8 @@ struct PerfRecordSample {
 
   // struct read_format v;                 /* if PERF_SAMPLE_READ */
 
-  uint64_t ips_size;               /* if PERF_SAMPLE_CALLCHAIN */
-  std::unique_ptr<uint64_t[]> ips; /* if PERF_SAMPLE_CALLCHAIN */
+  uint64_t ips_size;              /* if PERF_SAMPLE_CALLCHAIN */
+  PerfEventPayload<uint64_t> ips; /* if PERF_SAMPLE_CALLCHAIN */
 
   uint32_t raw_size;                   /* if PERF_SAMPLE_RAW */
   std::unique_ptr<uint8_t[]> raw_data; /* if PERF_SAMPLE_RAW */
@@ -52,12 +52,12 @@ struct PerfRecordSample {
   // uint64_t bnr;                        /* if PERF_SAMPLE_BRANCH_STACK */
   // struct perf_branch_entry lbr[bnr];   /* if PERF_SAMPLE_BRANCH_STACK */
 
-  uint64_t abi;                     /* if PERF_SAMPLE_REGS_USER */
-  std::unique_ptr<uint64_t[]> regs; /* if PERF_SAMPLE_REGS_USER */
+  uint64_t abi;                    /* if PERF_SAMPLE_REGS_USER */
+  PerfEventPayload<uint64_t> regs; /* if PERF_SAMPLE_REGS_USER */
 
-  uint64_t stack_size;                   /* if PERF_SAMPLE_STACK_USER */
-  std::unique_ptr<uint8_t[]> stack_data; /* if PERF_SAMPLE_STACK_USER */
-  uint64_t dyn_size;                     /* if PERF_SAMPLE_STACK_USER && size != 0 */
+  uint64_t stack_size;                  /* if PERF_SAMPLE_STACK_USER */
+  PerfEventPayload<uint8_t> stack_data; /* if PERF_SAMPLE_STACK_USER */
+  uint64_t dyn_size;                    /* if PERF_SAMPLE_STACK_USER && size != 0 */
 
   // uint64_t weight;                     /* if PERF_SAMPLE_WEIGHT */
   // uint64_t data_src;                   /* if PERF_SAMPLE_DATA_SRC */
@@ -71,112 +71,113 @@ struct PerfRecordSample {
 [[nodiscard]] static PerfRecordSample ConsumeRecordSample(PerfEventRingBuffer* ring_buffer,
                                                           const perf_event_header& header,
                                                           perf_event_attr flags,
+                                                          PerfEventPayloadPool* payload_pool,
                                                           bool copy_stack_related_data = true) {
   ORBIT_CHECK(header.size >
               sizeof(perf_event_header) + sizeof(RingBufferSampleIdTidTimeStreamidCpu));
 
+  // Validate the record and get a view of it once, instead of doing so for every field.
+  const PerfEventRingBufferView record = ring_buffer->PeekRecord(header);
+
   PerfRecordSample event{};
   int current_offset = 0;
 
-  ring_buffer->ReadRawAtOffset(&event.header, 0, sizeof(perf_event_header));
+  record.CopyAtOffset(&event.header, 0, sizeof(perf_event_header));
   current_offset += sizeof(perf_event_header);
 
   if ((flags.sample_type & PERF_SAMPLE_IDENTIFIER) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.sample_id, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.sample_id, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_IP) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.ip, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.ip, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_TID) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.pid, current_offset, sizeof(uint32_t));
+    record.CopyAtOffset(&event.pid, current_offset, sizeof(uint32_t));
     current_offset += sizeof(uint32_t);
-    ring_buffer->ReadRawAtOffset(&event.tid, current_offset, sizeof(uint32_t));
+    record.CopyAtOffset(&event.tid, current_offset, sizeof(uint32_t));
     current_offset += sizeof(uint32_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_TIME) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.time, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.time, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_ADDR) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.addr, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.addr, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_ID) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.id, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.id, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_STREAM_ID) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.stream_id, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.stream_id, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_CPU) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.cpu, current_offset, sizeof(uint32_t));
+    record.CopyAtOffset(&event.cpu, current_offset, sizeof(uint32_t));
     current_offset += sizeof(uint32_t);
-    ring_buffer->ReadRawAtOffset(&event.res, current_offset, sizeof(uint32_t));
+    record.CopyAtOffset(&event.res, current_offset, sizeof(uint32_t));
     current_offset += sizeof(uint32_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_PERIOD) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.period, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.period, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_CALLCHAIN) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.ips_size, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.ips_size, current_offset, sizeof(uint64_t));
 
     current_offset += sizeof(uint64_t);
     if (copy_stack_related_data) {
-      event.ips = make_unique_for_overwrite<uint64_t[]>(event.ips_size);
-      ring_buffer->ReadRawAtOffset(event.ips.get(), current_offset,
-                                   event.ips_size * sizeof(uint64_t));
+      event.ips = MakePerfEventPayload<uint64_t>(payload_pool, event.ips_size);
+      record.CopyAtOffset(event.ips.get(), current_offset, event.ips_size * sizeof(uint64_t));
     }
     current_offset += event.ips_size * sizeof(uint64_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_RAW) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.raw_size, current_offset, sizeof(uint32_t));
+    record.CopyAtOffset(&event.raw_size, current_offset, sizeof(uint32_t));
     current_offset += sizeof(uint32_t);
     event.raw_data = make_unique_for_overwrite<uint8_t[]>(event.raw_size);
-    ring_buffer->ReadRawAtOffset(event.raw_data.get(), current_offset,
-                                 event.raw_size * sizeof(uint8_t));
+    record.CopyAtOffset(event.raw_data.get(), current_offset, event.raw_size * sizeof(uint8_t));
     current_offset += event.raw_size * sizeof(uint8_t);
   }
 
   if ((flags.sample_type & PERF_SAMPLE_REGS_USER) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.abi, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.abi, current_offset, sizeof(uint64_t));
 
     current_offset += sizeof(uint64_t);
     if (event.abi != PERF_SAMPLE_REGS_ABI_NONE) {
       const int num_of_regs = std::bitset<64>(flags.sample_regs_user).count();
       if (copy_stack_related_data) {
-        event.regs = make_unique_for_overwrite<uint64_t[]>(num_of_regs);
-        ring_buffer->ReadRawAtOffset(event.regs.get(), current_offset,
-                                     num_of_regs * sizeof(uint64_t));
+        event.regs = MakePerfEventPayload<uint64_t>(payload_pool, num_of_regs);
+        record.CopyAtOffset(event.regs.get(), current_offset, num_of_regs * sizeof(uint64_t));
       }
       current_offset += num_of_regs * sizeof(uint64_t);
     }
   }
 
   if ((flags.sample_type & PERF_SAMPLE_STACK_USER) != 0u) {
-    ring_buffer->ReadRawAtOffset(&event.stack_size, current_offset, sizeof(uint64_t));
+    record.CopyAtOffset(&event.stack_size, current_offset, sizeof(uint64_t));
     current_offset += sizeof(uint64_t);
     if (event.stack_size != 0u && copy_stack_related_data) {
       // dyn_size comes after the actual stack but we read it first so
       // we can use it to not copy unnessary parts of the stack.
-      ring_buffer->ReadRawAtOffset(
-          &event.dyn_size, current_offset + (event.stack_size * sizeof(uint8_t)), sizeof(uint64_t));
-      event.stack_data = make_unique_for_overwrite<uint8_t[]>(event.dyn_size);
-      ring_buffer->ReadRawAtOffset(event.stack_data.get(), current_offset,
-                                   event.dyn_size * sizeof(uint8_t));
+      record.CopyAtOffset(&event.dyn_size, current_offset + (event.stack_size * sizeof(uint8_t)),
+                          sizeof(uint64_t));
+      // Copy the live part of the stack straight from the ring buffer.
+      event.stack_data = MakePerfEventPayload<uint8_t>(payload_pool, event.dyn_size);
+      record.CopyAtOffset(event.stack_data.get(), current_offset, event.dyn_size * sizeof(uint8_t));
     }
     current_offset += event.stack_size * sizeof(uint8_t);
     if (event.stack_size != 0u) {
@@ -307,7 +308,8 @@ MmapPerfEvent ConsumeMmapPerfEvent(PerfEventRingBuffer* ring_buffer,
 }
 
 StackSamplePerfEvent ConsumeStackSamplePerfEvent(PerfEventRingBuffer* ring_buffer,
-                                                 const perf_event_header& header) {
+                                                 const perf_event_header& header,
+                                                 PerfEventPayloadPool* payload_pool) {
   // The flags here are in sync with stack_sample_event_open in PerfEventOpen.
   // TODO(b/242020362): use the same perf_event_attr object from stack_sample_event_open
   const perf_event_attr flags{
@@ -315,7 +317,7 @@ StackSamplePerfEvent ConsumeStackSamplePerfEvent(PerfEventRingBuffer* ring_buffe
       .sample_regs_user = kSampleRegsUserAll,
   };
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags);
+  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, payload_pool);
 
   StackSamplePerfEvent event{
       .timestamp = res.time,
@@ -335,7 +337,8 @@ StackSamplePerfEvent ConsumeStackSamplePerfEvent(PerfEventRingBuffer* ring_buffe
 }
 
 CallchainSamplePerfEvent ConsumeCallchainSamplePerfEvent(PerfEventRingBuffer* ring_buffer,
-                                                         const perf_event_header& header) {
+                                                         const perf_event_header& header,
+                                                         PerfEventPayloadPool* payload_pool) {
   // The flags here are in sync with callchain_sample_event_open in PerfEventOpen.
   // TODO(b/242020362): use the same perf_event_attr object from callchain_sample_event_open
   const perf_event_attr flags{
@@ -344,7 +347,7 @@ CallchainSamplePerfEvent ConsumeCallchainSamplePerfEvent(PerfEventRingBuffer* ri
       .sample_regs_user = kSampleRegsUserAll,
   };
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags);
+  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, payload_pool);
 
   CallchainSamplePerfEvent event{
       .timestamp = res.time,
@@ -365,7 +368,8 @@ CallchainSamplePerfEvent ConsumeCallchainSamplePerfEvent(PerfEventRingBuffer* ri
 }
 
 UprobesWithStackPerfEvent ConsumeUprobeWithStackPerfEvent(PerfEventRingBuffer* ring_buffer,
-                                                          const perf_event_header& header) {
+                                                          const perf_event_header& header,
+                                                          PerfEventPayloadPool* payload_pool) {
   // The flags here are in sync with uprobes_with_stack_and_sp_event_open in PerfEventOpen.
   // TODO(b/242020362): use the same perf_event_attr object from
   // uprobes_with_stack_and_sp_event_open
@@ -374,7 +378,7 @@ UprobesWithStackPerfEvent ConsumeUprobeWithStackPerfEvent(PerfEventRingBuffer* r
       .sample_regs_user = kSampleRegsUserSp,
   };
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags);
+  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, payload_pool);
   ring_buffer->SkipRecord(header);
 
   UprobesWithStackPerfEvent event{
@@ -402,7 +406,7 @@ GenericTracepointPerfEvent ConsumeGenericTracepointPerfEvent(PerfEventRingBuffer
       .sample_type = kSampleTypeTidTimeStreamidCpu,
   };
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags);
+  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, /*payload_pool=*/nullptr);
 
   GenericTracepointPerfEvent event{
       .timestamp = res.time,
@@ -427,7 +431,7 @@ SchedWakeupPerfEvent ConsumeSchedWakeupPerfEvent(PerfEventRingBuffer* ring_buffe
       .sample_type = PERF_SAMPLE_RAW | kSampleTypeTidTimeStreamidCpu,
   };
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags);
+  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, /*payload_pool=*/nullptr);
 
   SchedWakeupTracepointDataFixed sched_wakeup;
   std::memcpy(&sched_wakeup, res.raw_data.get(), sizeof(SchedWakeupTracepointDataFixed));
@@ -449,7 +453,8 @@ SchedWakeupPerfEvent ConsumeSchedWakeupPerfEvent(PerfEventRingBuffer* ring_buffe
 
 PerfEvent ConsumeSchedWakeupWithOrWithoutCallchainPerfEvent(PerfEventRingBuffer* ring_buffer,
                                                             const perf_event_header& header,
-                                                            bool copy_stack_related_data) {
+                                                            bool copy_stack_related_data,
+                                                            PerfEventPayloadPool* payload_pool) {
   // The flags here are in sync with tracepoint_with_callchain_event_open in PerfEventOpen.
   // TODO(b/242020362): use the same perf_event_attr object from
   // tracepoint_with_callchain_event_open
@@ -458,7 +463,8 @@ PerfEvent ConsumeSchedWakeupWithOrWithoutCallchainPerfEvent(PerfEventRingBuffer*
                                              PERF_SAMPLE_STACK_USER,
                               .sample_regs_user = kSampleRegsUserAll};
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, copy_stack_related_data);
+  PerfRecordSample res =
+      ConsumeRecordSample(ring_buffer, header, flags, payload_pool, copy_stack_related_data);
 
   SchedWakeupTracepointDataFixed sched_wakeup;
   std::memcpy(&sched_wakeup, res.raw_data.get(), sizeof(SchedWakeupTracepointDataFixed));
@@ -499,7 +505,8 @@ PerfEvent ConsumeSchedWakeupWithOrWithoutCallchainPerfEvent(PerfEventRingBuffer*
 
 PerfEvent ConsumeSchedWakeupWithOrWithoutStackPerfEvent(PerfEventRingBuffer* ring_buffer,
                                                         const perf_event_header& header,
-                                                        bool copy_stack_related_data) {
+                                                        bool copy_stack_related_data,
+                                                        PerfEventPayloadPool* payload_pool) {
   // The flags here are in sync with tracepoint_with_stack_event_open in PerfEventOpen.
   // TODO(b/242020362): use the same perf_event_attr object from
   // tracepoint_with_stack_event_open
@@ -507,7 +514,8 @@ PerfEvent ConsumeSchedWakeupWithOrWithoutStackPerfEvent(PerfEventRingBuffer* rin
                                              PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER,
                               .sample_regs_user = kSampleRegsUserAll};
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, copy_stack_related_data);
+  PerfRecordSample res =
+      ConsumeRecordSample(ring_buffer, header, flags, payload_pool, copy_stack_related_data);
 
   SchedWakeupTracepointDataFixed sched_wakeup;
   std::memcpy(&sched_wakeup, res.raw_data.get(), sizeof(SchedWakeupTracepointDataFixed));
@@ -549,7 +557,8 @@ PerfEvent ConsumeSchedWakeupWithOrWithoutStackPerfEvent(PerfEventRingBuffer* rin
 
 PerfEvent ConsumeSchedSwitchWithOrWithoutStackPerfEvent(PerfEventRingBuffer* ring_buffer,
                                                         const perf_event_header& header,
-                                                        bool copy_stack_related_data) {
+                                                        bool copy_stack_related_data,
+                                                        PerfEventPayloadPool* payload_pool) {
   // The flags here are in sync with tracepoint_with_stack_event_open in PerfEventOpen.
   // TODO(b/242020362): use the same perf_event_attr object from
   // tracepoint_with_stack_event_open
@@ -557,7 +566,8 @@ PerfEvent ConsumeSchedSwitchWithOrWithoutStackPerfEvent(PerfEventRingBuffer* rin
                                              PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER,
                               .sample_regs_user = kSampleRegsUserAll};
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, copy_stack_related_data);
+  PerfRecordSample res =
+      ConsumeRecordSample(ring_buffer, header, flags, payload_pool, copy_stack_related_data);
 
   SchedSwitchTracepointData sched_switch;
   std::memcpy(&sched_switch, res.raw_data.get(), sizeof(SchedSwitchTracepointData));
@@ -607,7 +617,8 @@ PerfEvent ConsumeSchedSwitchWithOrWithoutStackPerfEvent(PerfEventRingBuffer* rin
 
 PerfEvent ConsumeSchedSwitchWithOrWithoutCallchainPerfEvent(PerfEventRingBuffer* ring_buffer,
                                                             const perf_event_header& header,
-                                                            bool copy_stack_related_data) {
+                                                            bool copy_stack_related_data,
+                                                            PerfEventPayloadPool* payload_pool) {
   // The flags here are in sync with tracepoint_with_callchain_event_open in PerfEventOpen.
   // TODO(b/242020362): use the same perf_event_attr object from
   // tracepoint_with_callchain_event_open
@@ -616,7 +627,8 @@ PerfEvent ConsumeSchedSwitchWithOrWithoutCallchainPerfEvent(PerfEventRingBuffer*
                                              PERF_SAMPLE_STACK_USER,
                               .sample_regs_user = kSampleRegsUserAll};
 
-  PerfRecordSample res = ConsumeRecordSample(ring_buffer, header, flags, copy_stack_related_data);
+  PerfRecordSample res =
+      ConsumeRecordSample(ring_buffer, header, flags, payload_pool, copy_stack_related_data);
 
   SchedSwitchTracepointData sched_switch;
   std::memcpy(&sched_switch, res.raw_data.get(), sizeof(SchedSwitchTracepointData));
@@ -10,6 +10,7 @@
 #include <sys/types.h>
 
 #include "PerfEvent.h"
+#include "PerfEventPayloadPool.h"
 #include "PerfEventRecords.h"
 #include "PerfEventRingBuffer.h"
 
@@ -34,14 +35,20 @@ void ReadPerfSampleIdAll(PerfEventRingBuffer* ring_buffer, const perf_event_head
 [[nodiscard]] MmapPerfEvent ConsumeMmapPerfEvent(PerfEventRingBuffer* ring_buffer,
                                                  const perf_event_header& header);
 
+// The functions below that copy registers, callchains or stack data allocate the buffers for them
+// from `payload_pool`, which can be nullptr.
+
 [[nodiscard]] UprobesWithStackPerfEvent ConsumeUprobeWithStackPerfEvent(
-    PerfEventRingBuffer* ring_buffer, const perf_event_header& header);
+    PerfEventRingBuffer* ring_buffer, const perf_event_header& header,
+    PerfEventPayloadPool* payload_pool);
 
 [[nodiscard]] StackSamplePerfEvent ConsumeStackSamplePerfEvent(PerfEventRingBuffer* ring_buffer,
-                                                               const perf_event_header& header);
+                                                               const perf_event_header& header,
+                                                               PerfEventPayloadPool* payload_pool);
 
 [[nodiscard]] CallchainSamplePerfEvent ConsumeCallchainSamplePerfEvent(
-    PerfEventRingBuffer* ring_buffer, const perf_event_header& header);
+    PerfEventRingBuffer* ring_buffer, const perf_event_header& header,
+    PerfEventPayloadPool* payload_pool);
 
 [[nodiscard]] GenericTracepointPerfEvent ConsumeGenericTracepointPerfEvent(
     PerfEventRingBuffer* ring_buffer, const perf_event_header& header);
@@ -51,19 +58,19 @@ void ReadPerfSampleIdAll(PerfEventRingBuffer* ring_buffer, const perf_event_head
 
 [[nodiscard]] PerfEvent ConsumeSchedWakeupWithOrWithoutCallchainPerfEvent(
     PerfEventRingBuffer* ring_buffer, const perf_event_header& header,
-    bool copy_stack_related_data);
+    bool copy_stack_related_data, PerfEventPayloadPool* payload_pool);
 
 [[nodiscard]] PerfEvent ConsumeSchedSwitchWithOrWithoutCallchainPerfEvent(
     PerfEventRingBuffer* ring_buffer, const perf_event_header& header,
-    bool copy_stack_related_data);
+    bool copy_stack_related_data, PerfEventPayloadPool* payload_pool);
 
 [[nodiscard]] PerfEvent ConsumeSchedSwitchWithOrWithoutStackPerfEvent(
     PerfEventRingBuffer* ring_buffer, const perf_event_header& header,
-    bool copy_stack_related_data);
+    bool copy_stack_related_data, PerfEventPayloadPool* payload_pool);
 
 [[nodiscard]] PerfEvent ConsumeSchedWakeupWithOrWithoutStackPerfEvent(
     PerfEventRingBuffer* ring_buffer, const perf_event_header& header,
-    bool copy_stack_related_data);
+    bool copy_stack_related_data, PerfEventPayloadPool* payload_pool);
 
 [[nodiscard]] AmdgpuCsIoctlPerfEvent ConsumeAmdgpuCsIoctlPerfEvent(PerfEventRingBuffer* ring_buffer,
                                                                    const perf_event_header& header);
@@ -9,6 +9,7 @@
 #include <string.h>
 #include <sys/mman.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "LinuxTracingUtils.h"
@@ -36,13 +37,15 @@ static inline void WriteRingBufferTail(perf_event_mmap_page* base, uint64_t tail
   smp_store_release(&base->data_tail, tail);
 }
 
-PerfEventRingBuffer::PerfEventRingBuffer(int perf_event_fd, uint64_t size_kb, std::string name) {
+PerfEventRingBuffer::PerfEventRingBuffer(int perf_event_fd, uint64_t size_kb, std::string name,
+                                         int32_t cpu) {
   if (perf_event_fd < 0) {
     return;
   }
 
   file_descriptor_ = perf_event_fd;
   name_ = std::move(name);
+  cpu_ = cpu;
 
   // The size of a perf_event_open ring buffer is required to be a power of two
   // memory pages (from perf_event_open's manpage: "The mmap size should be
@@ -76,6 +79,7 @@ PerfEventRingBuffer::PerfEventRingBuffer(PerfEventRingBuffer&& o) {
   std::swap(ring_buffer_size_log2_, o.ring_buffer_size_log2_);
   std::swap(file_descriptor_, o.file_descriptor_);
   std::swap(name_, o.name_);
+  std::swap(cpu_, o.cpu_);
 }
 
 PerfEventRingBuffer& PerfEventRingBuffer::operator=(PerfEventRingBuffer&& o) {
@@ -87,6 +91,7 @@ PerfEventRingBuffer& PerfEventRingBuffer::operator=(PerfEventRingBuffer&& o) {
     std::swap(ring_buffer_size_log2_, o.ring_buffer_size_log2_);
     std::swap(file_descriptor_, o.file_descriptor_);
     std::swap(name_, o.name_);
+    std::swap(cpu_, o.cpu_);
   }
   return *this;
 }
@@ -108,6 +113,11 @@ bool PerfEventRingBuffer::HasNewData() {
   return head > metadata_page_->data_tail;
 }
 
+uint64_t PerfEventRingBuffer::GetFilledBytes() {
+  ORBIT_DCHECK(IsOpen());
+  return ReadRingBufferHead(metadata_page_) - metadata_page_->data_tail;
+}
+
 void PerfEventRingBuffer::ReadHeader(perf_event_header* header) {
   ReadAtTail(header, sizeof(perf_event_header));
   ORBIT_DCHECK(header->type != 0);
@@ -125,8 +135,8 @@ void PerfEventRingBuffer::ConsumeRawRecord(const perf_event_header& header, void
   SkipRecord(header);
 }
 
-void PerfEventRingBuffer::ReadAtOffsetFromTail(void* dest, uint64_t offset_from_tail,
-                                               uint64_t count) {
+PerfEventRingBufferView PerfEventRingBuffer::PeekAtOffset(uint64_t offset_from_tail,
+                                                          uint64_t count) {
   ORBIT_DCHECK(IsOpen());
 
   uint64_t head = ReadRingBufferHead(metadata_page_);
@@ -141,6 +151,10 @@ void PerfEventRingBuffer::ReadAtOffsetFromTail(void* dest, uint64_t offset_from_
     ORBIT_ERROR("Too slow reading from ring buffer '%s'", name_.c_str());
   }
 
+  if (count == 0) {
+    return {};
+  }
+
   const uint64_t index = metadata_page_->data_tail + offset_from_tail;
   const uint32_t exponent = ring_buffer_size_log2_;
 
@@ -154,15 +168,30 @@ void PerfEventRingBuffer::ReadAtOffsetFromTail(void* dest, uint64_t offset_from_
   // Optimize (index + count - 1) / ring_buffer_size_:
   const uint64_t last_index_div_size = last_index >> exponent;
 
+  const auto* ring_buffer = reinterpret_cast<const uint8_t*>(ring_buffer_);
   if (index_div_size == last_index_div_size) {
-    memcpy(dest, ring_buffer_ + index_mod_size, count);
-  } else if (index_div_size == last_index_div_size - 1) {
-    // Need two copies as the data to read wraps around the ring buffer.
-    memcpy(dest, ring_buffer_ + index_mod_size, ring_buffer_size_ - index_mod_size);
-    memcpy(static_cast<uint8_t*>(dest) + (ring_buffer_size_ - index_mod_size), ring_buffer_,
-           count - (ring_buffer_size_ - index_mod_size));
+    return {absl::MakeConstSpan(ring_buffer + index_mod_size, count), {}};
+  }
+  if (index_div_size == last_index_div_size - 1) {
+    // The data wraps around the ring buffer.
+    return {absl::MakeConstSpan(ring_buffer + index_mod_size, ring_buffer_size_ - index_mod_size),
+            absl::MakeConstSpan(ring_buffer, count - (ring_buffer_size_ - index_mod_size))};
+  }
+  ORBIT_FATAL("Control shouldn't reach here");
+}
+
+void PerfEventRingBufferView::CopyAtOffset(void* dest, uint64_t offset, uint64_t count) const {
+  ORBIT_CHECK(offset <= size() && count <= size() - offset);
+  if (count == 0) return;
+  auto* dest_bytes = static_cast<uint8_t*>(dest);
+  if (offset < first_.size()) {
+    const uint64_t count_from_first = std::min<uint64_t>(count, first_.size() - offset);
+    memcpy(dest_bytes, first_.data() + offset, count_from_first);
+    if (count_from_first < count) {
+      memcpy(dest_bytes + count_from_first, second_.data(), count - count_from_first);
+    }
   } else {
-    ORBIT_FATAL("Control shouldn't reach here");
+    memcpy(dest_bytes, second_.data() + (offset - first_.size()), count);
   }
 }
 
@@ -5,6 +5,7 @@
 #ifndef LINUX_TRACING_PERF_RING_BUFFER_H_
 #define LINUX_TRACING_PERF_RING_BUFFER_H_
 
+#include <absl/types/span.h>
 #include <linux/perf_event.h>
 #include <stdint.h>
 
@@ -14,9 +15,38 @@
 
 namespace orbit_linux_tracing {
 
+// A read-only view of a range of bytes of a PerfEventRingBuffer, which allows reading a record
+// without first copying it out of the ring buffer. As the range can wrap around the end of the ring
+// buffer, the view consists of up to two contiguous parts. The view is only valid until the record
+// it refers to is skipped or consumed.
+class PerfEventRingBufferView {
+ public:
+  PerfEventRingBufferView() = default;
+  PerfEventRingBufferView(absl::Span<const uint8_t> first, absl::Span<const uint8_t> second)
+      : first_{first}, second_{second} {}
+
+  [[nodiscard]] absl::Span<const uint8_t> first() const { return first_; }
+  [[nodiscard]] absl::Span<const uint8_t> second() const { return second_; }
+  [[nodiscard]] uint64_t size() const { return first_.size() + second_.size(); }
+
+  // Copies `count` bytes starting `offset` bytes into the view to `dest`.
+  void CopyAtOffset(void* dest, uint64_t offset, uint64_t count) const;
+
+  template <typename T>
+  void ReadValueAtOffset(T* value, uint64_t offset) const {
+    CopyAtOffset(value, offset, sizeof(T));
+  }
+
+ private:
+  absl::Span<const uint8_t> first_;
+  absl::Span<const uint8_t> second_;
+};
+
 class PerfEventRingBuffer {
  public:
-  explicit PerfEventRingBuffer(int perf_event_fd, uint64_t size_kb, std::string name);
+  // `cpu` is the CPU the perf_event_open file descriptor was opened on, or -1.
+  explicit PerfEventRingBuffer(int perf_event_fd, uint64_t size_kb, std::string name,
+                               int32_t cpu = -1);
   ~PerfEventRingBuffer();
 
   PerfEventRingBuffer(PerfEventRingBuffer&&);
@@ -28,8 +58,12 @@ class PerfEventRingBuffer {
   [[nodiscard]] bool IsOpen() const { return ring_buffer_ != nullptr; }
   [[nodiscard]] int GetFileDescriptor() const { return file_descriptor_; }
   [[nodiscard]] const std::string& GetName() const { return name_; }
+  [[nodiscard]] int32_t GetCpu() const { return cpu_; }
+  [[nodiscard]] uint64_t GetSize() const { return ring_buffer_size_; }
 
   bool HasNewData();
+  // Returns the number of bytes written by the kernel that haven't been consumed yet.
+  [[nodiscard]] uint64_t GetFilledBytes();
   void ReadHeader(perf_event_header* header);
   void SkipRecord(const perf_event_header& header);
 
@@ -48,6 +82,16 @@ class PerfEventRingBuffer {
     ReadAtOffsetFromTail(dest, offset, count);
   }
 
+  // Returns a view of `count` bytes starting `offset` bytes after the current tail, without
+  // copying them. Prefer this to ReadRawAtOffset when reading many fields of the same record, or
+  // when only copying part of a large record.
+  [[nodiscard]] PerfEventRingBufferView PeekAtOffset(uint64_t offset, uint64_t count);
+
+  // Returns a view of the whole record at the current tail.
+  [[nodiscard]] PerfEventRingBufferView PeekRecord(const perf_event_header& header) {
+    return PeekAtOffset(0, header.size);
+  }
+
  private:
   uint64_t mmap_length_ = 0;
   perf_event_mmap_page* metadata_page_ = nullptr;
@@ -58,11 +102,14 @@ class PerfEventRingBuffer {
   uint32_t ring_buffer_size_log2_ = 0;
   int file_descriptor_ = -1;
   std::string name_;
+  int32_t cpu_ = -1;
 
   // ConsumeRawRecord reads header.size bytes into record buffer and then skips the record.
   void ConsumeRawRecord(const perf_event_header& header, void* record);
   void ReadAtTail(void* dest, uint64_t count) { return ReadAtOffsetFromTail(dest, 0, count); }
-  void ReadAtOffsetFromTail(void* dest, uint64_t offset_from_tail, uint64_t count);
+  void ReadAtOffsetFromTail(void* dest, uint64_t offset_from_tail, uint64_t count) {
+    PeekAtOffset(offset_from_tail, count).CopyAtOffset(dest, 0, count);
+  }
 };
 
 }  // namespace orbit_linux_tracing
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/types/span.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "PerfEventRingBuffer.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+constexpr std::array<uint8_t, 8> kBytes{0, 1, 2, 3, 4, 5, 6, 7};
+}  // namespace
+
+TEST(PerfEventRingBufferView, CopyAtOffsetFromContiguousView) {
+  PerfEventRingBufferView view{absl::MakeConstSpan(kBytes), {}};
+  EXPECT_EQ(view.size(), 8);
+
+  std::array<uint8_t, 3> dest{};
+  view.CopyAtOffset(dest.data(), 2, dest.size());
+  EXPECT_THAT(dest, testing::ElementsAre(2, 3, 4));
+}
+
+TEST(PerfEventRingBufferView, CopyAtOffsetAcrossWrapAround) {
+  PerfEventRingBufferView view{absl::MakeConstSpan(kBytes.data(), 5),
+                               absl::MakeConstSpan(kBytes.data() + 5, 3)};
+  EXPECT_EQ(view.size(), 8);
+
+  std::array<uint8_t, 4> dest{};
+  view.CopyAtOffset(dest.data(), 3, dest.size());
+  EXPECT_THAT(dest, testing::ElementsAre(3, 4, 5, 6));
+
+  std::array<uint8_t, 8> all{};
+  view.CopyAtOffset(all.data(), 0, all.size());
+  EXPECT_EQ(all, kBytes);
+}
+
+TEST(PerfEventRingBufferView, CopyAtOffsetFromSecondPart) {
+  PerfEventRingBufferView view{absl::MakeConstSpan(kBytes.data(), 2),
+                               absl::MakeConstSpan(kBytes.data() + 2, 6)};
+
+  std::array<uint8_t, 2> dest{};
+  view.CopyAtOffset(dest.data(), 5, dest.size());
+  EXPECT_THAT(dest, testing::ElementsAre(5, 6));
+}
+
+TEST(PerfEventRingBufferView, CopyAtOffsetOfNothingFromAnEmptyView) {
+  PerfEventRingBufferView view{{}, {}};
+  EXPECT_EQ(view.size(), 0);
+
+  uint8_t dest = 42;
+  view.CopyAtOffset(&dest, 0, 0);
+  EXPECT_EQ(dest, 42);
+}
+
+TEST(PerfEventRingBufferView, CopyAtOffsetOutOfRangeFails) {
+  PerfEventRingBufferView view{absl::MakeConstSpan(kBytes.data(), 5),
+                               absl::MakeConstSpan(kBytes.data() + 5, 3)};
+
+  std::array<uint8_t, 4> dest{};
+  EXPECT_DEATH(view.CopyAtOffset(dest.data(), 6, dest.size()), "size\\(\\) - offset");
+  EXPECT_DEATH(view.CopyAtOffset(dest.data(), 9, 0), "offset <= size\\(\\)");
+}
+
+TEST(PerfEventRingBufferView, ReadValueAtOffset) {
+  PerfEventRingBufferView view{absl::MakeConstSpan(kBytes.data(), 3),
+                               absl::MakeConstSpan(kBytes.data() + 3, 5)};
+
+  uint32_t value = 0;
+  view.ReadValueAtOffset(&value, 1);
+  EXPECT_EQ(value, 0x04030201u);
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,52 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "RingBufferReadScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_linux_tracing {
+
+uint32_t RingBufferReadScheduler::ComputeQuantum(size_t ring_buffer_index, uint64_t filled_bytes,
+                                                 uint64_t size_bytes) const {
+  ORBIT_CHECK(ring_buffer_index < average_record_cost_ns_.size());
+  ORBIT_CHECK(size_bytes > 0);
+  const double fill_ratio =
+      std::min(1.0, static_cast<double>(filled_bytes) / static_cast<double>(size_bytes));
+  // Grow quadratically, so that the budget only increases significantly when a ring buffer
+  // actually risks overflowing.
+  const double time_budget_multiplier =
+      1.0 + (kFullRingBufferTimeBudgetMultiplier - 1.0) * fill_ratio * fill_ratio;
+
+  const double average_record_cost_ns = average_record_cost_ns_[ring_buffer_index];
+  double quantum;
+  if (average_record_cost_ns <= 0.0) {
+    quantum = kDefaultQuantum * time_budget_multiplier;
+  } else {
+    quantum = kBaseTimeBudgetNs * time_budget_multiplier / average_record_cost_ns;
+  }
+  return static_cast<uint32_t>(
+      std::clamp(std::round(quantum), 1.0, static_cast<double>(kMaxQuantum)));
+}
+
+void RingBufferReadScheduler::ReportProcessingTime(size_t ring_buffer_index, uint32_t record_count,
+                                                   uint64_t duration_ns) {
+  ORBIT_CHECK(ring_buffer_index < average_record_cost_ns_.size());
+  if (record_count == 0) {
+    return;
+  }
+  const double record_cost_ns = static_cast<double>(duration_ns) / record_count;
+  double& average_record_cost_ns = average_record_cost_ns_[ring_buffer_index];
+  if (average_record_cost_ns <= 0.0) {
+    average_record_cost_ns = record_cost_ns;
+  } else {
+    average_record_cost_ns +=
+        kAverageRecordCostSmoothingFactor * (record_cost_ns - average_record_cost_ns);
+  }
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,55 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_RING_BUFFER_READ_SCHEDULER_H_
+#define LINUX_TRACING_RING_BUFFER_READ_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace orbit_linux_tracing {
+
+// Decides how many records to read from each ring buffer of a set of ring buffers that are read in
+// round-robin. Instead of a fixed number of records, each ring buffer gets a time budget, which is
+// converted to a number of records using the average time it took to process a record of that ring
+// buffer. This way, ring buffers with expensive records (e.g., samples with a copy of the stack)
+// don't delay ring buffers with cheap records (e.g., context switches) for too long, while ring
+// buffers with cheap records are drained in larger batches. The time budget grows with how full
+// the ring buffer is, so that ring buffers that are close to overflowing are drained first.
+class RingBufferReadScheduler {
+ public:
+  explicit RingBufferReadScheduler(size_t ring_buffer_count)
+      : average_record_cost_ns_(ring_buffer_count, 0.0) {}
+
+  // Returns the maximum number of records to read from the ring buffer at `ring_buffer_index`,
+  // given that `filled_bytes` out of `size_bytes` are waiting to be read.
+  [[nodiscard]] uint32_t ComputeQuantum(size_t ring_buffer_index, uint64_t filled_bytes,
+                                        uint64_t size_bytes) const;
+
+  // Updates the average cost of a record of the ring buffer at `ring_buffer_index` after
+  // `record_count` records were read and processed in `duration_ns`.
+  void ReportProcessingTime(size_t ring_buffer_index, uint32_t record_count, uint64_t duration_ns);
+
+  [[nodiscard]] double GetAverageRecordCostNs(size_t ring_buffer_index) const {
+    return average_record_cost_ns_[ring_buffer_index];
+  }
+
+  // Used until the cost of the records of a ring buffer is known.
+  static constexpr uint32_t kDefaultQuantum = 5;
+  static constexpr uint32_t kMaxQuantum = 4096;
+  static constexpr double kBaseTimeBudgetNs = 20'000.0;
+  // The time budget of a full ring buffer is this many times the one of an almost empty one.
+  static constexpr double kFullRingBufferTimeBudgetMultiplier = 16.0;
+  // Weight of the latest measurement in the exponential moving average of the cost of a record.
+  static constexpr double kAverageRecordCostSmoothingFactor = 0.125;
+
+ private:
+  std::vector<double> average_record_cost_ns_;
+};
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_RING_BUFFER_READ_SCHEDULER_H_
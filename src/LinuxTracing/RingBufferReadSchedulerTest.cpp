@@ -0,0 +1,66 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "RingBufferReadScheduler.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+constexpr uint64_t kRingBufferSize = 1024 * 1024;
+}  // namespace
+
+TEST(RingBufferReadScheduler, UsesDefaultQuantumWhenCostIsUnknown) {
+  RingBufferReadScheduler scheduler{1};
+  EXPECT_EQ(scheduler.ComputeQuantum(0, 0, kRingBufferSize),
+            RingBufferReadScheduler::kDefaultQuantum);
+  EXPECT_EQ(scheduler.GetAverageRecordCostNs(0), 0.0);
+}
+
+TEST(RingBufferReadScheduler, CheapRecordsGetLargerQuantumThanExpensiveRecords) {
+  RingBufferReadScheduler scheduler{2};
+  scheduler.ReportProcessingTime(0, 100, 100 * 200);
+  scheduler.ReportProcessingTime(1, 10, 10 * 20'000);
+  EXPECT_EQ(scheduler.GetAverageRecordCostNs(0), 200.0);
+  EXPECT_EQ(scheduler.GetAverageRecordCostNs(1), 20'000.0);
+
+  EXPECT_EQ(scheduler.ComputeQuantum(0, 0, kRingBufferSize), 100);
+  EXPECT_EQ(scheduler.ComputeQuantum(1, 0, kRingBufferSize), 1);
+}
+
+TEST(RingBufferReadScheduler, FullerRingBufferGetsLargerQuantum) {
+  RingBufferReadScheduler scheduler{1};
+  scheduler.ReportProcessingTime(0, 10, 10 * 1'000);
+
+  uint32_t empty_quantum = scheduler.ComputeQuantum(0, 0, kRingBufferSize);
+  uint32_t half_full_quantum = scheduler.ComputeQuantum(0, kRingBufferSize / 2, kRingBufferSize);
+  uint32_t full_quantum = scheduler.ComputeQuantum(0, kRingBufferSize, kRingBufferSize);
+  EXPECT_EQ(empty_quantum, 20);
+  EXPECT_GT(half_full_quantum, empty_quantum);
+  EXPECT_GT(full_quantum, half_full_quantum);
+  EXPECT_EQ(full_quantum,
+            20 * static_cast<uint32_t>(RingBufferReadScheduler::kFullRingBufferTimeBudgetMultiplier));
+}
+
+TEST(RingBufferReadScheduler, QuantumIsCapped) {
+  RingBufferReadScheduler scheduler{1};
+  scheduler.ReportProcessingTime(0, 1'000, 1'000);
+  EXPECT_EQ(scheduler.ComputeQuantum(0, kRingBufferSize, kRingBufferSize),
+            RingBufferReadScheduler::kMaxQuantum);
+}
+
+TEST(RingBufferReadScheduler, AverageRecordCostIsSmoothed) {
+  RingBufferReadScheduler scheduler{1};
+  scheduler.ReportProcessingTime(0, 1, 1'000);
+  scheduler.ReportProcessingTime(0, 0, 1'000'000);
+  EXPECT_EQ(scheduler.GetAverageRecordCostNs(0), 1'000.0);
+
+  scheduler.ReportProcessingTime(0, 1, 9'000);
+  EXPECT_EQ(scheduler.GetAverageRecordCostNs(0), 2'000.0);
+}
+
+}  // namespace orbit_linux_tracing
@@ -13,6 +13,8 @@
 #include <absl/synchronization/mutex.h>
 #include <absl/types/span.h>
 #include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -38,6 +40,7 @@
 #include "OrbitBase/GetProcessIds.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Result.h"
+#include "OrbitBase/SafeStrerror.h"
 #include "OrbitBase/ThreadUtils.h"
 #include "PerfEventOpen.h"
 #include "PerfEventOrderedStream.h"
@@ -76,8 +79,15 @@ TracerImpl::TracerImpl(
       unwinding_method_{capture_options.unwinding_method()},
       trace_thread_state_{capture_options.trace_thread_state()},
       trace_gpu_driver_{capture_options.trace_gpu_driver()},
+      ring_buffer_wakeup_method_{capture_options.ring_buffer_wakeup_method()},
+      ring_buffer_reader_thread_count_{capture_options.ring_buffer_reader_thread_count()},
+      unwinding_thread_count_{capture_options.unwinding_thread_count()},
       user_space_instrumentation_addresses_{std::move(user_space_instrumentation_addresses)},
-      listener_{listener} {
+      listener_{listener},
+      event_processor_{capture_options.event_processing_delay_mode() ==
+                               CaptureOptions::kEventProcessingStreamWatermark
+                           ? PerfEventProcessor::ProcessingDelayMode::kStreamWatermark
+                           : PerfEventProcessor::ProcessingDelayMode::kFixedDelay} {
   ORBIT_CHECK(listener_ != nullptr);
   thread_state_change_callstack_collection_ =
       capture_options.thread_state_change_callstack_collection();
@@ -150,13 +160,32 @@ TracerImpl::TracerImpl(
 
 void TracerImpl::Start() {
   stop_run_thread_ = false;
+  if (ring_buffer_wakeup_method_ == CaptureOptions::kRingBufferWakeupEventDriven) {
+    // Created here and not in Run, so that Stop can always signal it.
+    stop_run_thread_event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (stop_run_thread_event_fd_ == -1) {
+      ORBIT_ERROR("eventfd: %s; falling back to polling the ring buffers", SafeStrerror(errno));
+      ring_buffer_wakeup_method_ = CaptureOptions::kRingBufferWakeupPolling;
+    }
+  }
   run_thread_ = std::thread(&TracerImpl::Run, this);
 }
 
 void TracerImpl::Stop() {
   stop_run_thread_ = true;
+  if (stop_run_thread_event_fd_ != -1) {
+    // Wake up Run if it is blocked in epoll_wait.
+    constexpr uint64_t kEventFdIncrement = 1;
+    if (write(stop_run_thread_event_fd_, &kEventFdIncrement, sizeof(kEventFdIncrement)) == -1) {
+      ORBIT_ERROR("Writing to eventfd: %s", SafeStrerror(errno));
+    }
+  }
   ORBIT_CHECK(run_thread_.joinable());
   run_thread_.join();
+  if (stop_run_thread_event_fd_ != -1) {
+    close(stop_run_thread_event_fd_);
+    stop_run_thread_event_fd_ = -1;
+  }
 }
 
 void TracerImpl::ProcessFunctionEntry(const orbit_grpc_protos::FunctionEntry& function_entry) {
@@ -218,12 +247,20 @@ static void OpenRingBuffersOrRedirectOnExisting(
       // Create a ring buffer for this cpu.
       int ring_buffer_fd = fd;
       std::string buffer_name = absl::StrFormat("%s_%d", buffer_name_prefix, cpu);
-      ring_buffers->emplace_back(ring_buffer_fd, ring_buffer_size_kb, buffer_name);
+      ring_buffers->emplace_back(ring_buffer_fd, ring_buffer_size_kb, buffer_name, cpu);
       ring_buffer_fds_per_cpu->emplace(cpu, ring_buffer_fd);
     }
   }
 }
 
+uint32_t TracerImpl::ComputeWakeupWatermarkBytes(uint64_t ring_buffer_size_kb) const {
+  if (ring_buffer_wakeup_method_ != CaptureOptions::kRingBufferWakeupEventDriven) {
+    // Keep the kernel's default. Nobody waits on the file descriptors anyway.
+    return 0;
+  }
+  return static_cast<uint32_t>(ring_buffer_size_kb * 1024 / kRingBufferSizeToWakeupWatermarkRatio);
+}
+
 void TracerImpl::InitUprobesEventVisitor() {
   ORBIT_SCOPE_FUNCTION;
   ErrorMessageOr<std::string> maps = orbit_module_utils::ReadMaps(target_pid_);
@@ -232,8 +269,9 @@ void TracerImpl::InitUprobesEventVisitor() {
   }
   maps_ = LibunwindstackMaps::ParseMaps(maps.has_value() ? maps.value() : "");
 
-  unwinder_ =
-      LibunwindstackUnwinder::Create(&absolute_address_to_size_of_functions_to_stop_unwinding_at_);
+  unwinder_ = LibunwindstackUnwinder::CreateWithStepCache(
+      &absolute_address_to_size_of_functions_to_stop_unwinding_at_,
+      &stats_.unwind_step_cache_hit_count, &stats_.unwind_step_cache_miss_count);
   return_address_manager_.emplace(user_space_instrumentation_addresses_.get());
   leaf_function_call_manager_ = std::make_unique<LeafFunctionCallManager>(stack_dump_size_);
   uprobes_unwinding_visitor_ = std::make_unique<UprobesUnwindingVisitor>(
@@ -243,11 +281,23 @@ void TracerImpl::InitUprobesEventVisitor() {
       &absolute_address_to_size_of_functions_to_stop_unwinding_at_);
   uprobes_unwinding_visitor_->SetUnwindErrorsAndDiscardedSamplesCounters(
       &stats_.unwind_error_count, &stats_.samples_in_uretprobes_count);
+
+  const int32_t unwinding_thread_count =
+      std::clamp<int32_t>(static_cast<int32_t>(unwinding_thread_count_), 1, GetNumCores());
+  if (unwinding_method_ == CaptureOptions::kDwarf && unwinding_thread_count > 1) {
+    parallel_stack_unwinder_ = std::make_unique<ParallelStackUnwinder>(
+        unwinding_thread_count, [this] {
+          return LibunwindstackUnwinder::CreateWithStepCache(
+              &absolute_address_to_size_of_functions_to_stop_unwinding_at_,
+              &stats_.unwind_step_cache_hit_count, &stats_.unwind_step_cache_miss_count);
+        });
+    uprobes_unwinding_visitor_->SetParallelStackUnwinder(parallel_stack_unwinder_.get());
+  }
   event_processor_.AddVisitor(uprobes_unwinding_visitor_.get());
 }
 
 bool TracerImpl::OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& function,
-                             absl::Span<const int32_t> cpus,
+                             absl::Span<const int32_t> cpus, uint32_t wakeup_watermark_bytes,
                              absl::flat_hash_map<int32_t, int>* fds_per_cpu) {
   ORBIT_SCOPE_FUNCTION;
   const char* module = function.file_path().c_str();
@@ -255,9 +305,10 @@ bool TracerImpl::OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& func
   for (int32_t cpu : cpus) {
     int fd{};
     if (function.record_arguments()) {
-      fd = uprobes_retaddr_args_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uprobes_retaddr_args_event_open(module, offset, /*pid=*/-1, cpu,
+                                           wakeup_watermark_bytes);
     } else {
-      fd = uprobes_retaddr_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uprobes_retaddr_event_open(module, offset, /*pid=*/-1, cpu, wakeup_watermark_bytes);
     }
     if (fd < 0) {
       ORBIT_ERROR("Opening uprobe %s+%#x on cpu %d", function.file_path(), function.file_offset(),
@@ -270,7 +321,7 @@ bool TracerImpl::OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& func
 }
 
 bool TracerImpl::OpenUretprobes(const orbit_grpc_protos::InstrumentedFunction& function,
-                                absl::Span<const int32_t> cpus,
+                                absl::Span<const int32_t> cpus, uint32_t wakeup_watermark_bytes,
                                 absl::flat_hash_map<int32_t, int>* fds_per_cpu) {
   ORBIT_SCOPE_FUNCTION;
   const char* module = function.file_path().c_str();
@@ -278,9 +329,9 @@ bool TracerImpl::OpenUretprobes(const orbit_grpc_protos::InstrumentedFunction& f
   for (int32_t cpu : cpus) {
     int fd{};
     if (function.record_return_value()) {
-      fd = uretprobes_retval_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uretprobes_retval_event_open(module, offset, /*pid=*/-1, cpu, wakeup_watermark_bytes);
     } else {
-      fd = uretprobes_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uretprobes_event_open(module, offset, /*pid=*/-1, cpu, wakeup_watermark_bytes);
     }
     if (fd < 0) {
       ORBIT_ERROR("Opening uretprobe %s+%#x on cpu %d", function.file_path(),
@@ -328,13 +379,15 @@ bool TracerImpl::OpenUserSpaceProbes(absl::Span<const int32_t> cpus) {
   ORBIT_SCOPE_FUNCTION;
   bool uprobes_event_open_errors = false;
 
+  const uint32_t wakeup_watermark_bytes = ComputeWakeupWatermarkBytes(kUprobesRingBufferSizeKb);
   absl::flat_hash_map<int32_t, int> fds_per_cpu_for_redirection{};
   for (const auto& function : instrumented_functions_) {
     absl::flat_hash_map<int32_t, int> uprobes_fds_per_cpu;
     absl::flat_hash_map<int32_t, int> uretprobes_fds_per_cpu;
 
-    bool success = OpenUprobes(function, cpus, &uprobes_fds_per_cpu) &&
-                   OpenUretprobes(function, cpus, &uretprobes_fds_per_cpu);
+    bool success =
+        OpenUprobes(function, cpus, wakeup_watermark_bytes, &uprobes_fds_per_cpu) &&
+        OpenUretprobes(function, cpus, wakeup_watermark_bytes, &uretprobes_fds_per_cpu);
     if (!success) {
       CloseFileDescriptors(uprobes_fds_per_cpu);
       CloseFileDescriptors(uretprobes_fds_per_cpu);
@@ -364,9 +417,11 @@ bool TracerImpl::OpenUprobesWithStack(
   ORBIT_SCOPE_FUNCTION;
   const char* module = function.file_path().c_str();
   const uint64_t offset = function.file_offset();
+  const uint32_t wakeup_watermark_bytes =
+      ComputeWakeupWatermarkBytes(kUprobesWithStackRingBufferSizeKb);
   for (int32_t cpu : cpus) {
-    int fd =
-        uprobes_with_stack_and_sp_event_open(module, offset, /*pid=*/-1, cpu, stack_dump_size_);
+    int fd = uprobes_with_stack_and_sp_event_open(module, offset, /*pid=*/-1, cpu, stack_dump_size_,
+                                                  wakeup_watermark_bytes);
     if (fd < 0) {
       ORBIT_ERROR("Opening uprobe %s+%#x with stack on cpu %d", function.file_path(),
                   function.file_offset(), cpu);
@@ -408,10 +463,12 @@ bool TracerImpl::OpenMmapTask(absl::Span<const int32_t> cpus) {
   ORBIT_SCOPE_FUNCTION;
   std::vector<int> mmap_task_tracing_fds;
   std::vector<PerfEventRingBuffer> mmap_task_ring_buffers;
+  const uint32_t wakeup_watermark_bytes = ComputeWakeupWatermarkBytes(kMmapTaskRingBufferSizeKb);
   for (int32_t cpu : cpus) {
-    int mmap_task_fd = mmap_task_event_open(-1, cpu);
+    int mmap_task_fd = mmap_task_event_open(-1, cpu, wakeup_watermark_bytes);
     std::string buffer_name = absl::StrFormat("mmap_task_%d", cpu);
-    PerfEventRingBuffer mmap_task_ring_buffer{mmap_task_fd, kMmapTaskRingBufferSizeKb, buffer_name};
+    PerfEventRingBuffer mmap_task_ring_buffer{mmap_task_fd, kMmapTaskRingBufferSizeKb, buffer_name,
+                                              cpu};
     if (mmap_task_ring_buffer.IsOpen()) {
       mmap_task_tracing_fds.push_back(mmap_task_fd);
       mmap_task_ring_buffers.push_back(std::move(mmap_task_ring_buffer));
@@ -439,16 +496,17 @@ bool TracerImpl::OpenSampling(absl::Span<const int32_t> cpus) {
 
   std::vector<int> sampling_tracing_fds;
   std::vector<PerfEventRingBuffer> sampling_ring_buffers;
+  const uint32_t wakeup_watermark_bytes = ComputeWakeupWatermarkBytes(kSamplingRingBufferSizeKb);
   for (int32_t cpu : cpus) {
     int sampling_fd{};
     switch (unwinding_method_) {
       case CaptureOptions::kFramePointers:
-        sampling_fd =
-            callchain_sample_event_open(sampling_period_ns_.value(), -1, cpu, stack_dump_size_);
+        sampling_fd = callchain_sample_event_open(sampling_period_ns_.value(), -1, cpu,
+                                                  stack_dump_size_, wakeup_watermark_bytes);
         break;
       case CaptureOptions::kDwarf:
-        sampling_fd =
-            stack_sample_event_open(sampling_period_ns_.value(), -1, cpu, stack_dump_size_);
+        sampling_fd = stack_sample_event_open(sampling_period_ns_.value(), -1, cpu,
+                                              stack_dump_size_, wakeup_watermark_bytes);
         break;
       case CaptureOptions::kUndefined:
       default:
@@ -458,7 +516,8 @@ bool TracerImpl::OpenSampling(absl::Span<const int32_t> cpus) {
     }
 
     std::string buffer_name = absl::StrFormat("sampling_%d", cpu);
-    PerfEventRingBuffer sampling_ring_buffer{sampling_fd, kSamplingRingBufferSizeKb, buffer_name};
+    PerfEventRingBuffer sampling_ring_buffer{sampling_fd, kSamplingRingBufferSizeKb, buffer_name,
+                                             cpu};
     if (sampling_ring_buffer.IsOpen()) {
       sampling_tracing_fds.push_back(sampling_fd);
       sampling_ring_buffers.push_back(std::move(sampling_ring_buffer));
@@ -503,7 +562,7 @@ struct TracepointToOpen {
 static bool OpenFileDescriptorsAndRingBuffersForAllTracepoints(
     absl::Span<const TracepointToOpen> tracepoints_to_open, absl::Span<const int32_t> cpus,
     absl::flat_hash_map<std::string, std::vector<int>>* tracing_fds_by_type,
-    uint64_t ring_buffer_size_kb,
+    uint64_t ring_buffer_size_kb, uint32_t wakeup_watermark_bytes,
     absl::flat_hash_map<int32_t, int>* tracepoint_ring_buffer_fds_per_cpu_for_redirection,
     std::vector<PerfEventRingBuffer>* ring_buffers, uint32_t stack_dump_size = 0,
     const CaptureOptions::ThreadStateChangeCallStackCollection
@@ -523,14 +582,16 @@ static bool OpenFileDescriptorsAndRingBuffersForAllTracepoints(
       if (thread_state_change_callstack_collection ==
               CaptureOptions::kThreadStateChangeCallStackCollection &&
           unwinding_method == CaptureOptions::kFramePointers) {
-        tracepoint_fd = tracepoint_with_callchain_event_open(tracepoint_category, tracepoint_name,
-                                                             -1, cpu, stack_dump_size);
+        tracepoint_fd = tracepoint_with_callchain_event_open(
+            tracepoint_category, tracepoint_name, -1, cpu, stack_dump_size, wakeup_watermark_bytes);
       } else if (thread_state_change_callstack_collection ==
                  CaptureOptions::kThreadStateChangeCallStackCollection) {
         tracepoint_fd = tracepoint_with_stack_event_open(tracepoint_category, tracepoint_name, -1,
-                                                         cpu, stack_dump_size);
+                                                         cpu, stack_dump_size,
+                                                         wakeup_watermark_bytes);
       } else {
-        tracepoint_fd = tracepoint_event_open(tracepoint_category, tracepoint_name, -1, cpu);
+        tracepoint_fd = tracepoint_event_open(tracepoint_category, tracepoint_name, -1, cpu,
+                                              wakeup_watermark_bytes);
       }
       if (tracepoint_fd == -1) {
         ORBIT_ERROR("Opening %s:%s tracepoint for cpu %d", tracepoint_category, tracepoint_name,
@@ -585,6 +646,7 @@ bool TracerImpl::OpenThreadNameTracepoints(absl::Span<const int32_t> cpus) {
   return OpenFileDescriptorsAndRingBuffersForAllTracepoints(
       {{"task", "task_newtask", &task_newtask_ids_}, {"task", "task_rename", &task_rename_ids_}},
       cpus, &tracing_fds_by_type_, kThreadNamesRingBufferSizeKb,
+      ComputeWakeupWatermarkBytes(kThreadNamesRingBufferSizeKb),
       &thread_name_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_);
 }
 
@@ -642,6 +704,7 @@ bool TracerImpl::OpenContextSwitchAndThreadStateTracepoints(absl::Span<const int
   }
   return OpenFileDescriptorsAndRingBuffersForAllTracepoints(
       tracepoints_to_open, cpus, &tracing_fds_by_type_, ring_buffer_size,
+      ComputeWakeupWatermarkBytes(ring_buffer_size),
       &thread_state_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_,
       thread_state_change_callstack_stack_dump_size_, thread_state_change_callstack_collection_,
       unwinding_method_);
@@ -673,6 +736,7 @@ bool TracerImpl::OpenGpuTracepoints(absl::Span<const int32_t> cpus) {
        {"amdgpu", "amdgpu_sched_run_job", &amdgpu_sched_run_job_ids_},
        {"dma_fence", "dma_fence_signaled", &dma_fence_signaled_ids_}},
       cpus, &tracing_fds_by_type_, kGpuTracingRingBufferSizeKb,
+      ComputeWakeupWatermarkBytes(kGpuTracingRingBufferSizeKb),
       &gpu_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_);
 }
 
@@ -686,6 +750,7 @@ bool TracerImpl::OpenInstrumentedTracepoints(absl::Span<const int32_t> cpus) {
     tracepoint_event_open_errors |= !OpenFileDescriptorsAndRingBuffersForAllTracepoints(
         {{selected_tracepoint.category().c_str(), selected_tracepoint.name().c_str(), &stream_ids}},
         cpus, &tracing_fds_by_type_, kInstrumentedTracepointsRingBufferSizeKb,
+        ComputeWakeupWatermarkBytes(kInstrumentedTracepointsRingBufferSizeKb),
         &tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_);
 
     for (const auto& stream_id : stream_ids) {
@@ -765,6 +830,7 @@ void TracerImpl::Startup() {
   SetMaxOpenFilesSoftLimit(GetMaxOpenFilesHardLimit());
 
   event_processor_.SetDiscardedOutOfOrderCounter(&stats_.discarded_out_of_order_count);
+  event_processor_.SetDiscardedBehindWatermarkCounter(&stats_.discarded_behind_watermark_count);
 
   InitLostAndDiscardedEventVisitor();
 
@@ -921,6 +987,10 @@ void TracerImpl::Startup() {
   }
 
   stats_.Reset();
+  {
+    absl::MutexLock lock{&ring_buffer_read_stats_mutex_};
+    ring_buffer_read_stats_ = {};
+  }
 }
 
 void TracerImpl::Shutdown() {
@@ -949,6 +1019,7 @@ void TracerImpl::Shutdown() {
   // Close the ring buffers.
   {
     ORBIT_SCOPE("ring_buffers_.clear()");
+    ring_buffer_readers_.clear();
     ring_buffers_.clear();
   }
 
@@ -966,7 +1037,7 @@ void TracerImpl::Shutdown() {
   }
 }
 
-void TracerImpl::ProcessOneRecord(PerfEventRingBuffer* ring_buffer) {
+void TracerImpl::ProcessOneRecord(PerfEventRingBuffer* ring_buffer, RingBufferReader* reader) {
   uint64_t event_timestamp_ns = 0;
 
   perf_event_header header;
@@ -984,19 +1055,19 @@ void TracerImpl::ProcessOneRecord(PerfEventRingBuffer* ring_buffer) {
                   ring_buffer->GetName());
       break;
     case PERF_RECORD_FORK:
-      event_timestamp_ns = ProcessForkEventAndReturnTimestamp(header, ring_buffer);
+      event_timestamp_ns = ProcessForkEventAndReturnTimestamp(header, ring_buffer, reader);
       break;
     case PERF_RECORD_EXIT:
-      event_timestamp_ns = ProcessExitEventAndReturnTimestamp(header, ring_buffer);
+      event_timestamp_ns = ProcessExitEventAndReturnTimestamp(header, ring_buffer, reader);
       break;
     case PERF_RECORD_MMAP:
-      event_timestamp_ns = ProcessMmapEventAndReturnTimestamp(header, ring_buffer);
+      event_timestamp_ns = ProcessMmapEventAndReturnTimestamp(header, ring_buffer, reader);
       break;
     case PERF_RECORD_SAMPLE:
-      event_timestamp_ns = ProcessSampleEventAndReturnTimestamp(header, ring_buffer);
+      event_timestamp_ns = ProcessSampleEventAndReturnTimestamp(header, ring_buffer, reader);
       break;
     case PERF_RECORD_LOST:
-      event_timestamp_ns = ProcessLostEventAndReturnTimestamp(header, ring_buffer);
+      event_timestamp_ns = ProcessLostEventAndReturnTimestamp(header, ring_buffer, reader);
       break;
     case PERF_RECORD_THROTTLE:
     case PERF_RECORD_UNTHROTTLE:
@@ -1010,31 +1081,177 @@ void TracerImpl::ProcessOneRecord(PerfEventRingBuffer* ring_buffer) {
   }
 
   if (event_timestamp_ns != 0) {
-    fds_to_last_timestamp_ns_.insert_or_assign(ring_buffer->GetFileDescriptor(),
-                                               event_timestamp_ns);
+    reader->fds_to_last_timestamp_ns.insert_or_assign(ring_buffer->GetFileDescriptor(),
+                                                      event_timestamp_ns);
   }
 }
 
-void TracerImpl::Run() {
-  orbit_base::SetCurrentThreadName("Tracer::Run");
+void TracerImpl::RingBufferReadStats::Add(const RingBufferReadStats& other) {
+  thread_cpu_time_ns += other.thread_cpu_time_ns;
+  wakeup_count += other.wakeup_count;
+  wakeup_timeout_count += other.wakeup_timeout_count;
+  sched_switch_count += other.sched_switch_count;
+  sample_count += other.sample_count;
+  uprobes_count += other.uprobes_count;
+  uprobes_with_stack_count += other.uprobes_with_stack_count;
+  gpu_events_count += other.gpu_events_count;
+  mmap_count += other.mmap_count;
+  lost_count += other.lost_count;
+  for (const auto& [ring_buffer, lost_count_of_buffer] : other.lost_count_per_buffer) {
+    lost_count_per_buffer[ring_buffer] += lost_count_of_buffer;
+  }
+  for (const auto& [ring_buffer, high_water_mark] : other.fill_high_water_mark_per_buffer) {
+    uint64_t& merged_high_water_mark = fill_high_water_mark_per_buffer[ring_buffer];
+    merged_high_water_mark = std::max(merged_high_water_mark, high_water_mark);
+  }
+}
 
-  Startup();
+void TracerImpl::CreateRingBufferReaders() {
+  ORBIT_SCOPE_FUNCTION;
+  ring_buffer_readers_.clear();
+  const int32_t reader_count =
+      std::clamp<int32_t>(static_cast<int32_t>(ring_buffer_reader_thread_count_), 1, GetNumCores());
+  for (int32_t i = 0; i < reader_count; ++i) {
+    ring_buffer_readers_.push_back(std::make_unique<RingBufferReader>());
+  }
+
+  // Keep all the ring buffers of the same CPU on the same reader. Ring buffers that are not
+  // associated with a CPU are assigned to the first reader.
+  for (PerfEventRingBuffer& ring_buffer : ring_buffers_) {
+    const int32_t cpu = ring_buffer.GetCpu();
+    const size_t reader_index = cpu < 0 ? 0 : static_cast<size_t>(cpu % reader_count);
+    ring_buffer_readers_[reader_index]->ring_buffers.push_back(&ring_buffer);
+  }
+  for (std::unique_ptr<RingBufferReader>& reader : ring_buffer_readers_) {
+    reader->scheduler = RingBufferReadScheduler{reader->ring_buffers.size()};
+  }
+
+  if (ring_buffer_wakeup_method_ == CaptureOptions::kRingBufferWakeupEventDriven) {
+    for (std::unique_ptr<RingBufferReader>& reader : ring_buffer_readers_) {
+      reader->epoll_fd = CreateRingBuffersEpoll(*reader);
+      if (reader->epoll_fd == -1) {
+        ORBIT_ERROR("Falling back to polling the ring buffers");
+      }
+    }
+  }
+}
+
+int TracerImpl::CreateRingBuffersEpoll(const RingBufferReader& reader) const {
+  ORBIT_SCOPE_FUNCTION;
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd == -1) {
+    ORBIT_ERROR("epoll_create1: %s", SafeStrerror(errno));
+    return -1;
+  }
+
+  std::vector<int> fds_to_add;
+  fds_to_add.reserve(reader.ring_buffers.size() + 1);
+  // As the eventfd is never read, after Stop it stays readable and wakes up all readers.
+  fds_to_add.push_back(stop_run_thread_event_fd_);
+  for (const PerfEventRingBuffer* ring_buffer : reader.ring_buffers) {
+    // Only the file descriptors that own a ring buffer are relevant, as those that were redirected
+    // with PERF_EVENT_IOC_SET_OUTPUT don't signal anything themselves.
+    fds_to_add.push_back(ring_buffer->GetFileDescriptor());
+  }
+
+  for (int fd : fds_to_add) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+      ORBIT_ERROR("epoll_ctl on fd %d: %s", fd, SafeStrerror(errno));
+      close(epoll_fd);
+      return -1;
+    }
+  }
+  return epoll_fd;
+}
+
+void TracerImpl::WaitForNewDataInRingBuffers(RingBufferReader* reader) {
+  // We don't care about which file descriptors are ready: the next pass goes through all ring
+  // buffers of this reader anyway, so that buffers that are below their watermark also get read.
+  std::array<epoll_event, kMaxEpollEventsPerWait> ready_events;
+  int ready_count = epoll_wait(reader->epoll_fd, ready_events.data(),
+                               static_cast<int>(ready_events.size()),
+                               kMaxIdleTimeOnEventDrivenWakeupMs);
+  if (ready_count == -1) {
+    if (errno != EINTR) {
+      ORBIT_ERROR("epoll_wait: %s", SafeStrerror(errno));
+      // Avoid spinning if epoll is somehow broken.
+      usleep(kIdleTimeOnEmptyRingBuffersUs);
+    }
+    return;
+  }
 
+  ++reader->stats.wakeup_count;
+  if (ready_count == 0) {
+    ++reader->stats.wakeup_timeout_count;
+  }
+}
+
+void TracerImpl::MergeRingBufferReadStats(RingBufferReader* reader) {
+  const uint64_t thread_cpu_time_ns = GetCurrentThreadCpuTimeNs();
+  reader->stats.thread_cpu_time_ns = thread_cpu_time_ns - reader->last_thread_cpu_time_ns;
+  reader->last_thread_cpu_time_ns = thread_cpu_time_ns;
+  {
+    absl::MutexLock lock{&ring_buffer_read_stats_mutex_};
+    ring_buffer_read_stats_.Add(reader->stats);
+  }
+  reader->stats = {};
+}
+
+void TracerImpl::SetSamplingRateDivisor(uint32_t divisor) {
+  ORBIT_CHECK(divisor > 0);
+  requested_sampling_rate_divisor_ = divisor;
+}
+
+void TracerImpl::ApplySamplingRateDivisorIfChanged() {
+  const uint32_t divisor = requested_sampling_rate_divisor_.load(std::memory_order_relaxed);
+  if (divisor == applied_sampling_rate_divisor_) {
+    return;
+  }
+  applied_sampling_rate_divisor_ = divisor;
+
+  auto sampling_fds_it = tracing_fds_by_type_.find("sampling");
+  if (!sampling_period_ns_.has_value() || sampling_fds_it == tracing_fds_by_type_.end()) {
+    return;
+  }
+  const uint64_t period_ns = sampling_period_ns_.value() * divisor;
+  ORBIT_LOG("Changing sampling period to %u ns", period_ns);
+  for (int fd : sampling_fds_it->second) {
+    perf_event_set_period(fd, period_ns);
+  }
+}
+
+void TracerImpl::ReadRingBuffers(RingBufferReader* reader, bool is_main_reader) {
+  reader->last_thread_cpu_time_ns = GetCurrentThreadCpuTimeNs();
   bool last_iteration_saw_events = false;
-  std::thread deferred_events_thread(&TracerImpl::ProcessDeferredEvents, this);
 
   while (!stop_run_thread_) {
     ORBIT_SCOPE("TracerThread::Run iteration");
 
+    if (is_main_reader) {
+      ApplySamplingRateDivisorIfChanged();
+    }
+
     if (!last_iteration_saw_events) {
-      // Periodically print event statistics.
-      PrintStatsIfTimerElapsed();
+      MergeRingBufferReadStats(reader);
+      if (is_main_reader) {
+        // Periodically print event statistics.
+        PrintStatsIfTimerElapsed();
+      }
 
-      // Sleep if there was no new event in the last iteration so that we are
-      // not constantly polling. Don't sleep so long that ring buffers overflow.
-      {
+      if (reader->epoll_fd != -1) {
+        // Block until a ring buffer reaches its wakeup watermark, until Stop is called, or until
+        // the timeout expires, so that records in buffers that fill up slowly don't get too old.
+        ORBIT_SCOPE("WaitForNewDataInRingBuffers");
+        WaitForNewDataInRingBuffers(reader);
+      } else {
+        // Sleep if there was no new event in the last iteration so that we are
+        // not constantly polling. Don't sleep so long that ring buffers overflow.
         ORBIT_SCOPE("Sleep");
         usleep(kIdleTimeOnEmptyRingBuffersUs);
+        ++reader->stats.wakeup_count;
       }
     }
 
@@ -1042,41 +1259,86 @@ void TracerImpl::Run() {
 
     // Read and process events from all ring buffers. In order to ensure that no
     // buffer is read constantly while others overflow, we schedule the reading
-    // using round-robin like scheduling.
-    for (PerfEventRingBuffer& ring_buffer : ring_buffers_) {
+    // using round-robin like scheduling, where the number of records read from
+    // each buffer depends on how full it is and how expensive its records are.
+    for (size_t ring_buffer_index = 0; ring_buffer_index < reader->ring_buffers.size();
+         ++ring_buffer_index) {
       if (stop_run_thread_) {
         break;
       }
 
-      // Read up to ROUND_ROBIN_POLLING_BATCH_SIZE (5) new events.
-      // TODO: Some event types (e.g., stack samples) have a much longer
-      //  processing time but are less frequent than others (e.g., context
-      //  switches). Take this into account in our scheduling algorithm.
-      for (int32_t read_from_this_buffer = 0; read_from_this_buffer < kRoundRobinPollingBatchSize;
-           ++read_from_this_buffer) {
-        if (stop_run_thread_) {
-          break;
-        }
-        if (!ring_buffer.HasNewData()) {
-          break;
-        }
-
+      PerfEventRingBuffer* ring_buffer = reader->ring_buffers[ring_buffer_index];
+      const uint64_t filled_bytes = ring_buffer->GetFilledBytes();
+      if (filled_bytes == 0) {
+        continue;
+      }
+      uint64_t& fill_high_water_mark = reader->stats.fill_high_water_mark_per_buffer[ring_buffer];
+      fill_high_water_mark = std::max(fill_high_water_mark, filled_bytes);
+
+      const uint32_t quantum = reader->scheduler.ComputeQuantum(ring_buffer_index, filled_bytes,
+                                                                ring_buffer->GetSize());
+      const uint64_t quantum_begin_ns = orbit_base::CaptureTimestampNs();
+      uint32_t read_from_this_buffer = 0;
+      while (read_from_this_buffer < quantum && !stop_run_thread_ && ring_buffer->HasNewData()) {
         last_iteration_saw_events = true;
-        ProcessOneRecord(&ring_buffer);
+        ProcessOneRecord(ring_buffer, reader);
+        ++read_from_this_buffer;
       }
+      reader->scheduler.ReportProcessingTime(ring_buffer_index, read_from_this_buffer,
+                                             orbit_base::CaptureTimestampNs() - quantum_begin_ns);
+    }
+
+    // Wake up the deferred-events thread once per pass rather than once per event.
+    if (last_iteration_saw_events) {
+      WakeUpDeferredEventsThreadIfIdle();
     }
   }
 
+  MergeRingBufferReadStats(reader);
+}
+
+void TracerImpl::Run() {
+  orbit_base::SetCurrentThreadName("Tracer::Run");
+
+  Startup();
+  CreateRingBufferReaders();
+
+  std::thread deferred_events_thread(&TracerImpl::ProcessDeferredEvents, this);
+
+  // The first reader runs on this thread, the others on their own thread each.
+  std::vector<std::thread> reader_threads;
+  for (size_t i = 1; i < ring_buffer_readers_.size(); ++i) {
+    reader_threads.emplace_back([this, i] {
+      orbit_base::SetCurrentThreadName(absl::StrFormat("Tracer::Read%u", i).c_str());
+      ReadRingBuffers(ring_buffer_readers_[i].get(), /*is_main_reader=*/false);
+    });
+  }
+  ReadRingBuffers(ring_buffer_readers_[0].get(), /*is_main_reader=*/true);
+  for (std::thread& reader_thread : reader_threads) {
+    reader_thread.join();
+  }
+
   // Finish processing all deferred events.
   stop_deferred_thread_ = true;
+  WakeUpDeferredEventsThreadIfIdle();
   deferred_events_thread.join();
   event_processor_.ProcessAllEvents();
+  if (parallel_stack_unwinder_ != nullptr) {
+    parallel_stack_unwinder_->DeliverAllResults();
+  }
+
+  for (std::unique_ptr<RingBufferReader>& reader : ring_buffer_readers_) {
+    if (reader->epoll_fd != -1) {
+      close(reader->epoll_fd);
+    }
+  }
 
   Shutdown();
 }
 
 uint64_t TracerImpl::ProcessForkEventAndReturnTimestamp(const perf_event_header& header,
-                                                        PerfEventRingBuffer* ring_buffer) {
+                                                        PerfEventRingBuffer* ring_buffer,
+                                                        RingBufferReader* reader) const {
   RingBufferForkExit ring_buffer_record;
   ring_buffer->ConsumeRecord(header, &ring_buffer_record);
   ForkPerfEvent event{
@@ -1093,12 +1355,13 @@ uint64_t TracerImpl::ProcessForkEventAndReturnTimestamp(const perf_event_header&
     return event.timestamp;
   }
 
-  DeferEvent(event);
+  DeferEventFromRingBuffer(event, reader);
   return event.timestamp;
 }
 
 uint64_t TracerImpl::ProcessExitEventAndReturnTimestamp(const perf_event_header& header,
-                                                        PerfEventRingBuffer* ring_buffer) {
+                                                        PerfEventRingBuffer* ring_buffer,
+                                                        RingBufferReader* reader) const {
   RingBufferForkExit ring_buffer_record;
   ring_buffer->ConsumeRecord(header, &ring_buffer_record);
   ExitPerfEvent event{
@@ -1115,12 +1378,13 @@ uint64_t TracerImpl::ProcessExitEventAndReturnTimestamp(const perf_event_header&
     return event.timestamp;
   }
 
-  DeferEvent(event);
+  DeferEventFromRingBuffer(event, reader);
   return event.timestamp;
 }
 
 uint64_t TracerImpl::ProcessMmapEventAndReturnTimestamp(const perf_event_header& header,
-                                                        PerfEventRingBuffer* ring_buffer) {
+                                                        PerfEventRingBuffer* ring_buffer,
+                                                        RingBufferReader* reader) const {
   MmapPerfEvent event = ConsumeMmapPerfEvent(ring_buffer, header);
   const uint64_t timestamp_ns = event.timestamp;
 
@@ -1132,14 +1396,15 @@ uint64_t TracerImpl::ProcessMmapEventAndReturnTimestamp(const perf_event_header&
     return timestamp_ns;
   }
 
-  DeferEvent(std::move(event));
-  ++stats_.mmap_count;
+  DeferEventFromRingBuffer(std::move(event), reader);
+  ++reader->stats.mmap_count;
 
   return timestamp_ns;
 }
 
 uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_header& header,
-                                                          PerfEventRingBuffer* ring_buffer) {
+                                                          PerfEventRingBuffer* ring_buffer,
+                                                          RingBufferReader* reader) {
   uint64_t timestamp_ns = ReadSampleRecordTime(ring_buffer);
 
   if (timestamp_ns < effective_capture_start_timestamp_ns_) {
@@ -1205,8 +1470,8 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
             },
     };
 
-    DeferEvent(event);
-    ++stats_.uprobes_count;
+    DeferEventFromRingBuffer(event, reader);
+    ++reader->stats.uprobes_count;
 
   } else if (is_uprobe_with_stack) {
     pid_t pid = ReadSampleRecordPid(ring_buffer);
@@ -1222,9 +1487,10 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
       return timestamp_ns;
     }
 
-    UprobesWithStackPerfEvent event = ConsumeUprobeWithStackPerfEvent(ring_buffer, header);
-    DeferEvent(std::move(event));
-    ++stats_.uprobes_with_stack_count;
+    UprobesWithStackPerfEvent event =
+        ConsumeUprobeWithStackPerfEvent(ring_buffer, header, &payload_pool_);
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.uprobes_with_stack_count;
   } else if (is_uprobe_with_args) {
     ORBIT_CHECK(header.size == sizeof(RingBufferSpIpArguments8bytesSample));
     RingBufferSpIpArguments8bytesSample ring_buffer_record;
@@ -1249,8 +1515,8 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
             },
     };
 
-    DeferEvent(event);
-    ++stats_.uprobes_count;
+    DeferEventFromRingBuffer(event, reader);
+    ++reader->stats.uprobes_count;
 
   } else if (is_uretprobe) {
     ORBIT_CHECK(header.size == sizeof(RingBufferEmptySample));
@@ -1271,8 +1537,8 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
             },
     };
 
-    DeferEvent(event);
-    ++stats_.uprobes_count;
+    DeferEventFromRingBuffer(event, reader);
+    ++reader->stats.uprobes_count;
 
   } else if (is_uretprobe_with_retval) {
     ORBIT_CHECK(header.size == sizeof(RingBufferAxSample));
@@ -1293,8 +1559,8 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
                 .rax = ring_buffer_record.regs.GetReturnValue(),
             },
     };
-    DeferEvent(event);
-    ++stats_.uprobes_count;
+    DeferEventFromRingBuffer(event, reader);
+    ++reader->stats.uprobes_count;
 
   } else if (is_stack_sample) {
     pid_t pid = ReadSampleRecordPid(ring_buffer);
@@ -1321,9 +1587,10 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
     // e.g., with header.misc == PERF_RECORD_MISC_KERNEL,
     // in general they seem to produce valid callstacks.
 
-    StackSamplePerfEvent event = ConsumeStackSamplePerfEvent(ring_buffer, header);
-    DeferEvent(std::move(event));
-    ++stats_.sample_count;
+    StackSamplePerfEvent event =
+        ConsumeStackSamplePerfEvent(ring_buffer, header, &payload_pool_);
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.sample_count;
 
   } else if (is_callchain_sample) {
     pid_t pid = ReadSampleRecordPid(ring_buffer);
@@ -1333,9 +1600,9 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
       return timestamp_ns;
     }
 
-    PerfEvent event = ConsumeCallchainSamplePerfEvent(ring_buffer, header);
-    DeferEvent(std::move(event));
-    ++stats_.sample_count;
+    PerfEvent event = ConsumeCallchainSamplePerfEvent(ring_buffer, header, &payload_pool_);
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.sample_count;
 
   } else if (is_task_newtask) {
     ORBIT_CHECK(header.size == sizeof(RingBufferRawSample<TaskNewtaskTracepointData>));
@@ -1357,7 +1624,7 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
             },
     };
     memcpy(event.data.comm, ring_buffer_record.data.comm, 16);
-    DeferEvent(event);
+    DeferEventFromRingBuffer(event, reader);
 
   } else if (is_task_rename) {
     //ORBIT_CHECK(header.size == sizeof(RingBufferRawSample<TaskRenameTracepointData>));
@@ -1376,7 +1643,7 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
     };
 
     memcpy(event.data.newcomm, ring_buffer_record.data.newcomm, 16);
-    DeferEvent(event);
+    DeferEventFromRingBuffer(event, reader);
 
   } else if (is_sched_switch) {
     ORBIT_CHECK(header.size == sizeof(RingBufferRawSample<SchedSwitchTracepointData>));
@@ -1401,59 +1668,59 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
                 .next_tid = ring_buffer_record.data.next_pid,
             },
     };
-    DeferEvent(event);
-    ++stats_.sched_switch_count;
+    DeferEventFromRingBuffer(event, reader);
+    ++reader->stats.sched_switch_count;
 
   } else if (is_sched_wakeup) {
     SchedWakeupPerfEvent event = ConsumeSchedWakeupPerfEvent(ring_buffer, header);
-    DeferEvent(event);
+    DeferEventFromRingBuffer(event, reader);
 
   } else if (is_sched_switch_with_callchain) {
     // When the switch out is caused by the thread exiting, the sample record's pid is "-1".
     // For simplicity, we accept that we discard the callstack in this case.
     pid_t pid_or_minus_one = ReadSampleRecordPid(ring_buffer);
     bool copy_stack_related_data = pid_or_minus_one == target_pid_;
-    PerfEvent event = ConsumeSchedSwitchWithOrWithoutCallchainPerfEvent(ring_buffer, header,
-                                                                        copy_stack_related_data);
-    DeferEvent(std::move(event));
-    ++stats_.sched_switch_count;
+    PerfEvent event = ConsumeSchedSwitchWithOrWithoutCallchainPerfEvent(
+        ring_buffer, header, copy_stack_related_data, &payload_pool_);
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.sched_switch_count;
 
   } else if (is_sched_wakeup_with_callchain) {
     pid_t pid = ReadSampleRecordPid(ring_buffer);
     bool copy_stack_related_data = pid == target_pid_;
-    PerfEvent event = ConsumeSchedWakeupWithOrWithoutCallchainPerfEvent(ring_buffer, header,
-                                                                        copy_stack_related_data);
-    DeferEvent(std::move(event));
+    PerfEvent event = ConsumeSchedWakeupWithOrWithoutCallchainPerfEvent(
+        ring_buffer, header, copy_stack_related_data, &payload_pool_);
+    DeferEventFromRingBuffer(std::move(event), reader);
   } else if (is_sched_switch_with_stack) {
     // See comment in "is_sched_switch_with_stack" case above for reasoning about "-1".
     pid_t pid_or_minus_one = ReadSampleRecordPid(ring_buffer);
     bool copy_stack_related_data = pid_or_minus_one == target_pid_;
-    PerfEvent event =
-        ConsumeSchedSwitchWithOrWithoutStackPerfEvent(ring_buffer, header, copy_stack_related_data);
-    DeferEvent(std::move(event));
-    ++stats_.sched_switch_count;
+    PerfEvent event = ConsumeSchedSwitchWithOrWithoutStackPerfEvent(
+        ring_buffer, header, copy_stack_related_data, &payload_pool_);
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.sched_switch_count;
 
   } else if (is_sched_wakeup_with_stack) {
     pid_t pid = ReadSampleRecordPid(ring_buffer);
     bool copy_stack_related_data = pid == target_pid_;
-    PerfEvent event =
-        ConsumeSchedWakeupWithOrWithoutStackPerfEvent(ring_buffer, header, copy_stack_related_data);
-    DeferEvent(std::move(event));
+    PerfEvent event = ConsumeSchedWakeupWithOrWithoutStackPerfEvent(
+        ring_buffer, header, copy_stack_related_data, &payload_pool_);
+    DeferEventFromRingBuffer(std::move(event), reader);
 
   } else if (is_amdgpu_cs_ioctl_event) {
     AmdgpuCsIoctlPerfEvent event = ConsumeAmdgpuCsIoctlPerfEvent(ring_buffer, header);
-    DeferEvent(std::move(event));
-    ++stats_.gpu_events_count;
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.gpu_events_count;
 
   } else if (is_amdgpu_sched_run_job_event) {
     AmdgpuSchedRunJobPerfEvent event = ConsumeAmdgpuSchedRunJobPerfEvent(ring_buffer, header);
-    DeferEvent(std::move(event));
-    ++stats_.gpu_events_count;
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.gpu_events_count;
 
   } else if (is_dma_fence_signaled_event) {
     DmaFenceSignaledPerfEvent event = ConsumeDmaFenceSignaledPerfEvent(ring_buffer, header);
-    DeferEvent(std::move(event));
-    ++stats_.gpu_events_count;
+    DeferEventFromRingBuffer(std::move(event), reader);
+    ++reader->stats.gpu_events_count;
 
   } else if (is_user_instrumented_tracepoint) {
     auto it = ids_to_tracepoint_info_.find(stream_id);
@@ -1482,19 +1749,20 @@ uint64_t TracerImpl::ProcessSampleEventAndReturnTimestamp(const perf_event_heade
 }
 
 uint64_t TracerImpl::ProcessLostEventAndReturnTimestamp(const perf_event_header& header,
-                                                        PerfEventRingBuffer* ring_buffer) {
+                                                        PerfEventRingBuffer* ring_buffer,
+                                                        RingBufferReader* reader) {
   RingBufferLost ring_buffer_record;
   ring_buffer->ConsumeRecord(header, &ring_buffer_record);
   uint64_t timestamp = ring_buffer_record.sample_id.time;
 
-  stats_.lost_count += ring_buffer_record.lost;
-  stats_.lost_count_per_buffer[ring_buffer] += ring_buffer_record.lost;
+  reader->stats.lost_count += ring_buffer_record.lost;
+  reader->stats.lost_count_per_buffer[ring_buffer] += ring_buffer_record.lost;
 
   // Fetch the timestamp of the last event that preceded this PERF_RECORD_LOST in this same ring
   // buffer.
   uint64_t fd_previous_timestamp_ns = 0;
-  if (auto it = fds_to_last_timestamp_ns_.find(ring_buffer->GetFileDescriptor());
-      it != fds_to_last_timestamp_ns_.end()) {
+  if (auto it = reader->fds_to_last_timestamp_ns.find(ring_buffer->GetFileDescriptor());
+      it != reader->fds_to_last_timestamp_ns.end()) {
     fd_previous_timestamp_ns = it->second;
   }
   if (fd_previous_timestamp_ns == 0) {
@@ -1512,7 +1780,7 @@ uint64_t TracerImpl::ProcessLostEventAndReturnTimestamp(const perf_event_header&
               .previous_timestamp = fd_previous_timestamp_ns,
           },
   };
-  DeferEvent(event);
+  DeferEventFromRingBuffer(event, reader);
 
   return timestamp;
 }
@@ -1543,12 +1811,58 @@ uint64_t TracerImpl::ProcessThrottleUnthrottleEventAndReturnTimestamp(
 }
 
 void TracerImpl::DeferEvent(PerfEvent&& event) {
-  absl::MutexLock lock{&deferred_events_being_buffered_mutex_};
-  deferred_events_being_buffered_.emplace_back(std::move(event));
+  deferred_events_from_other_threads_.enqueue(std::move(event));
+  WakeUpDeferredEventsThreadIfIdle();
+}
+
+void TracerImpl::WakeUpDeferredEventsThreadIfIdle() {
+  deferred_events_thread_waker_.WakeUpIfIdle();
+}
+
+bool TracerImpl::HasDeferredEvents() const {
+  if (deferred_events_from_other_threads_.size_approx() > 0) {
+    return true;
+  }
+  return std::any_of(ring_buffer_readers_.begin(), ring_buffer_readers_.end(),
+                     [](const std::unique_ptr<RingBufferReader>& reader) {
+                       return reader->deferred_events.size_approx() > 0;
+                     });
+}
+
+void TracerImpl::WaitForDeferredEvents() {
+  ORBIT_SCOPE_FUNCTION;
+  deferred_events_thread_waker_.WaitForWork(
+      [this] { return HasDeferredEvents() || stop_deferred_thread_; },
+      absl::Milliseconds(kMaxIdleTimeOnEmptyDeferredEventsMs));
+}
+
+size_t TracerImpl::MoveDeferredEventsToEventProcessor() {
+  ORBIT_SCOPE_FUNCTION;
+  size_t moved_count = 0;
+  auto move_events_from_queue = [this,
+                                 &moved_count](moodycamel::ConcurrentQueue<PerfEvent>* queue) {
+    size_t dequeued_count;
+    // PerfEvent is not default-constructible, hence the std::optionals as destination.
+    while ((dequeued_count = queue->try_dequeue_bulk(deferred_events_to_process_.begin(),
+                                                     deferred_events_to_process_.size())) > 0) {
+      for (size_t i = 0; i < dequeued_count; ++i) {
+        event_processor_.AddEvent(std::move(deferred_events_to_process_[i].value()));
+        deferred_events_to_process_[i].reset();
+      }
+      moved_count += dequeued_count;
+    }
+  };
+
+  move_events_from_queue(&deferred_events_from_other_threads_);
+  for (std::unique_ptr<RingBufferReader>& reader : ring_buffer_readers_) {
+    move_events_from_queue(&reader->deferred_events);
+  }
+  return moved_count;
 }
 
 void TracerImpl::ProcessDeferredEvents() {
   orbit_base::SetCurrentThreadName("Proc.Def.Events");
+  deferred_events_to_process_.resize(kDeferredEventsDequeueBatchSize);
   bool should_exit = false;
   while (!should_exit) {
     ORBIT_SCOPE("ProcessDeferredEvents iteration");
@@ -1556,32 +1870,24 @@ void TracerImpl::ProcessDeferredEvents() {
     // deferred events. The last iteration will consume all remaining events.
     should_exit = stop_deferred_thread_;
 
-    {
-      absl::MutexLock lock{&deferred_events_being_buffered_mutex_};
-      deferred_events_being_buffered_.swap(deferred_events_to_process_);
+    // Also when no new events arrive, so that the callstacks of the last samples are not held back.
+    if (parallel_stack_unwinder_ != nullptr) {
+      parallel_stack_unwinder_->DeliverCompletedResults();
     }
 
-    if (deferred_events_to_process_.empty()) {
-      ORBIT_SCOPE("Sleep");
-      usleep(kIdleTimeOnEmptyDeferredEventsUs);
+    if (MoveDeferredEventsToEventProcessor() == 0) {
+      if (!should_exit) {
+        WaitForDeferredEvents();
+      }
       continue;
     }
 
-    {
-      ORBIT_SCOPE("AddEvents");
-      for (auto& event : deferred_events_to_process_) {
-        event_processor_.AddEvent(std::move(event));
-      }
-    }
-    // Note (https://en.cppreference.com/w/cpp/container/vector/clear): std::vector::clear() "Leaves
-    // the capacity() of the vector unchanged", which is desired as deferred_events_being_buffered_
-    // won't have to be grown again after the swap.
-    deferred_events_to_process_.clear();
     {
       ORBIT_SCOPE("ProcessOldEvents");
       event_processor_.ProcessOldEvents();
     }
   }
+  deferred_events_to_process_.clear();
 }
 
 void TracerImpl::RetrieveInitialTidToPidAssociationSystemWide() {
@@ -1606,8 +1912,8 @@ void TracerImpl::RetrieveInitialThreadStatesOfTarget() {
 void TracerImpl::Reset() {
   ORBIT_SCOPE_FUNCTION;
   tracing_fds_by_type_.clear();
+  ring_buffer_readers_.clear();
   ring_buffers_.clear();
-  fds_to_last_timestamp_ns_.clear();
 
   uprobes_uretprobes_ids_to_function_id_.clear();
   uprobes_ids_.clear();
@@ -1632,11 +1938,9 @@ void TracerImpl::Reset() {
   effective_capture_start_timestamp_ns_ = 0;
 
   stop_deferred_thread_ = false;
-  {
-    absl::MutexLock lock{&deferred_events_being_buffered_mutex_};
-    deferred_events_being_buffered_.clear();
-  }
+  deferred_events_from_other_threads_ = moodycamel::ConcurrentQueue<PerfEvent>{};
   deferred_events_to_process_.clear();
+  parallel_stack_unwinder_.reset();
   uprobes_unwinding_visitor_.reset();
   leaf_function_call_manager_.reset();
   return_address_manager_.reset();
@@ -1656,46 +1960,128 @@ void TracerImpl::PrintStatsIfTimerElapsed() {
       static_cast<double>(timestamp_ns - stats_.event_count_begin_ns) / kNsPerSecond;
   ORBIT_CHECK(actual_window_s > 0.0);
 
+  RingBufferReadStats read_stats;
+  {
+    absl::MutexLock lock{&ring_buffer_read_stats_mutex_};
+    read_stats = std::move(ring_buffer_read_stats_);
+    ring_buffer_read_stats_ = {};
+  }
+
+  // Readers for which creating the epoll instance failed fall back to polling.
+  const size_t event_driven_reader_count =
+      std::count_if(ring_buffer_readers_.begin(), ring_buffer_readers_.end(),
+                    [](const std::unique_ptr<RingBufferReader>& reader) {
+                      return reader->epoll_fd != -1;
+                    });
+  std::string wakeup_method;
+  if (event_driven_reader_count == 0) {
+    wakeup_method = "polling";
+  } else if (event_driven_reader_count == ring_buffer_readers_.size()) {
+    wakeup_method = "event-driven wakeup";
+  } else {
+    wakeup_method = absl::StrFormat("event-driven wakeup for %u, polling for %u",
+                                    event_driven_reader_count,
+                                    ring_buffer_readers_.size() - event_driven_reader_count);
+  }
+
   ORBIT_LOG("Events per second (and total) last %.3f s:", actual_window_s);
-  ORBIT_LOG("  sched switches: %.0f/s (%lu)", stats_.sched_switch_count / actual_window_s,
-            stats_.sched_switch_count);
-  ORBIT_LOG("  samples: %.0f/s (%lu)", stats_.sample_count / actual_window_s, stats_.sample_count);
-  ORBIT_LOG("  u(ret)probes: %.0f/s (%lu)", stats_.uprobes_count / actual_window_s,
-            stats_.uprobes_count);
-  ORBIT_LOG("  uprobes with stack: %.0f/s (%lu)", stats_.uprobes_with_stack_count / actual_window_s,
-            stats_.uprobes_with_stack_count);
-  ORBIT_LOG("  gpu events: %.0f/s (%lu)", stats_.gpu_events_count / actual_window_s,
-            stats_.gpu_events_count);
-  ORBIT_LOG("  mmap events: %.0f/s (%lu)", stats_.mmap_count / actual_window_s, stats_.mmap_count);
-
-  if (stats_.lost_count_per_buffer.empty()) {
-    ORBIT_LOG("  lost: %.0f/s (%lu)", stats_.lost_count / actual_window_s, stats_.lost_count);
+  ORBIT_LOG("  Tracer CPU usage (%s, %u reader threads): %.1f%%", wakeup_method,
+            ring_buffer_readers_.size(),
+            100.0 * read_stats.thread_cpu_time_ns / (timestamp_ns - stats_.event_count_begin_ns));
+  ORBIT_LOG("  Tracer wakeups: %.0f/s (%lu), of which timeouts: %lu",
+            read_stats.wakeup_count / actual_window_s, read_stats.wakeup_count,
+            read_stats.wakeup_timeout_count);
+  ORBIT_LOG("  sched switches: %.0f/s (%lu)", read_stats.sched_switch_count / actual_window_s,
+            read_stats.sched_switch_count);
+  ORBIT_LOG("  samples: %.0f/s (%lu)", read_stats.sample_count / actual_window_s,
+            read_stats.sample_count);
+  ORBIT_LOG("  u(ret)probes: %.0f/s (%lu)", read_stats.uprobes_count / actual_window_s,
+            read_stats.uprobes_count);
+  ORBIT_LOG("  uprobes with stack: %.0f/s (%lu)",
+            read_stats.uprobes_with_stack_count / actual_window_s,
+            read_stats.uprobes_with_stack_count);
+  ORBIT_LOG("  gpu events: %.0f/s (%lu)", read_stats.gpu_events_count / actual_window_s,
+            read_stats.gpu_events_count);
+  ORBIT_LOG("  mmap events: %.0f/s (%lu)", read_stats.mmap_count / actual_window_s,
+            read_stats.mmap_count);
+  PerfEventPayloadPool::Stats payload_pool_stats = payload_pool_.GetAndResetStats();
+  ORBIT_LOG("  payload buffers: %.0f/s from pool (%lu), %.0f/s allocated (%lu)",
+            payload_pool_stats.hit_count / actual_window_s, payload_pool_stats.hit_count,
+            payload_pool_stats.miss_count / actual_window_s, payload_pool_stats.miss_count);
+
+  // Report the ring buffers that came closest to overflowing, to help tuning their sizes.
+  std::vector<std::pair<const PerfEventRingBuffer*, uint64_t>> fill_high_water_marks(
+      read_stats.fill_high_water_mark_per_buffer.begin(),
+      read_stats.fill_high_water_mark_per_buffer.end());
+  std::sort(fill_high_water_marks.begin(), fill_high_water_marks.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return static_cast<double>(lhs.second) / lhs.first->GetSize() >
+                     static_cast<double>(rhs.second) / rhs.first->GetSize();
+            });
+  if (fill_high_water_marks.size() > kMaxRingBuffersInFillStats) {
+    fill_high_water_marks.resize(kMaxRingBuffersInFillStats);
+  }
+  ORBIT_LOG("  fullest ring buffers:");
+  for (const auto& [ring_buffer, high_water_mark] : fill_high_water_marks) {
+    uint64_t lost_count = 0;
+    if (auto it = read_stats.lost_count_per_buffer.find(ring_buffer);
+        it != read_stats.lost_count_per_buffer.end()) {
+      lost_count = it->second;
+    }
+    ORBIT_LOG("    %s: high-water mark %.1f%% of %lu KB, lost %lu", ring_buffer->GetName(),
+              100.0 * high_water_mark / ring_buffer->GetSize(), ring_buffer->GetSize() / 1024,
+              lost_count);
+  }
+
+  if (read_stats.lost_count_per_buffer.empty()) {
+    ORBIT_LOG("  lost: %.0f/s (%lu)", read_stats.lost_count / actual_window_s,
+              read_stats.lost_count);
   } else {
-    ORBIT_LOG("  LOST: %.0f/s (%lu), of which:", stats_.lost_count / actual_window_s,
-              stats_.lost_count);
-    for (const auto& buffer_and_lost_count : stats_.lost_count_per_buffer) {
+    ORBIT_LOG("  LOST: %.0f/s (%lu), of which:", read_stats.lost_count / actual_window_s,
+              read_stats.lost_count);
+    for (const auto& buffer_and_lost_count : read_stats.lost_count_per_buffer) {
       ORBIT_LOG("    from %s: %.0f/s (%lu)", buffer_and_lost_count.first->GetName().c_str(),
                 buffer_and_lost_count.second / actual_window_s, buffer_and_lost_count.second);
     }
   }
 
   uint64_t discarded_out_of_order_count = stats_.discarded_out_of_order_count;
-  ORBIT_LOG(
-      "  %s: %.0f/s (%lu)",
-      discarded_out_of_order_count == 0 ? "discarded as out of order" : "DISCARDED AS OUT OF ORDER",
-      discarded_out_of_order_count / actual_window_s, discarded_out_of_order_count);
+  if (event_processor_.GetProcessingDelayMode() ==
+      PerfEventProcessor::ProcessingDelayMode::kStreamWatermark) {
+    // Also report how many of the discarded events would have been kept with the fixed delay.
+    uint64_t discarded_behind_watermark_count = stats_.discarded_behind_watermark_count;
+    ORBIT_LOG("  %s (stream watermark): %.0f/s (%lu), of which within the fixed delay: %lu",
+              discarded_out_of_order_count == 0 ? "discarded as out of order"
+                                                : "DISCARDED AS OUT OF ORDER",
+              discarded_out_of_order_count / actual_window_s, discarded_out_of_order_count,
+              discarded_behind_watermark_count);
+  } else {
+    ORBIT_LOG("  %s (fixed delay): %.0f/s (%lu)",
+              discarded_out_of_order_count == 0 ? "discarded as out of order"
+                                                : "DISCARDED AS OUT OF ORDER",
+              discarded_out_of_order_count / actual_window_s, discarded_out_of_order_count);
+  }
 
-  // Ensure we can divide by 0.0 safely in case stats_.sample_count is zero.
+  // Ensure we can divide by 0.0 safely in case read_stats.sample_count is zero.
   static_assert(std::numeric_limits<double>::is_iec559);
 
   uint64_t unwind_error_count = stats_.unwind_error_count;
-  ORBIT_LOG("  unwind errors: %.0f/s (%lu) [%.1f%%]", unwind_error_count / actual_window_s,
-            unwind_error_count, 100.0 * unwind_error_count / stats_.sample_count);
+  const size_t unwinding_thread_count =
+      parallel_stack_unwinder_ != nullptr ? parallel_stack_unwinder_->GetThreadCount() : 1;
+  ORBIT_LOG("  unwind errors: %.0f/s (%lu) [%.1f%%] (%zu unwinding threads)",
+            unwind_error_count / actual_window_s, unwind_error_count,
+            100.0 * unwind_error_count / read_stats.sample_count, unwinding_thread_count);
+  uint64_t unwind_step_cache_hit_count = stats_.unwind_step_cache_hit_count;
+  uint64_t unwind_step_cache_miss_count = stats_.unwind_step_cache_miss_count;
+  ORBIT_LOG("  unwinding step cache: %.1f%% hits (%lu hits, %lu misses)",
+            100.0 * unwind_step_cache_hit_count /
+                (unwind_step_cache_hit_count + unwind_step_cache_miss_count),
+            unwind_step_cache_hit_count, unwind_step_cache_miss_count);
   uint64_t discarded_samples_in_uretprobes_count = stats_.samples_in_uretprobes_count;
   ORBIT_LOG("  samples in u(ret)probes: %.0f/s (%lu) [%.1f%%]",
             discarded_samples_in_uretprobes_count / actual_window_s,
             discarded_samples_in_uretprobes_count,
-            100.0 * discarded_samples_in_uretprobes_count / stats_.sample_count);
+            100.0 * discarded_samples_in_uretprobes_count / read_stats.sample_count);
 
   uint64_t thread_state_count = stats_.thread_state_count;
   ORBIT_LOG("  target's thread states: %.0f/s (%lu)", thread_state_count / actual_window_s,
@@ -14,6 +14,7 @@
 #include <sys/types.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <limits>
@@ -26,22 +27,28 @@
 #include "GpuTracepointVisitor.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
+#include "IdleThreadWaker.h"
 #include "LeafFunctionCallManager.h"
 #include "LibunwindstackMaps.h"
 #include "LibunwindstackUnwinder.h"
 #include "LinuxTracing/Tracer.h"
 #include "LinuxTracing/TracerListener.h"
 #include "LinuxTracing/UserSpaceInstrumentationAddresses.h"
+#include "LinuxTracingUtils.h"
 #include "LostAndDiscardedEventVisitor.h"
 #include "OrbitBase/Profiling.h"
+#include "ParallelStackUnwinder.h"
 #include "PerfEvent.h"
+#include "PerfEventPayloadPool.h"
 #include "PerfEventProcessor.h"
 #include "PerfEventRingBuffer.h"
 #include "PythonSamplingThread.h"
+#include "RingBufferReadScheduler.h"
 #include "SwitchesStatesNamesVisitor.h"
 #include "UprobesFunctionCallManager.h"
 #include "UprobesReturnAddressManager.h"
 #include "UprobesUnwindingVisitor.h"
+#include "concurrentqueue.h"
 
 namespace orbit_linux_tracing {
 
@@ -63,22 +70,69 @@ class TracerImpl : public Tracer {
   void ProcessFunctionEntry(const orbit_grpc_protos::FunctionEntry& function_entry) override;
   void ProcessFunctionExit(const orbit_grpc_protos::FunctionExit& function_exit) override;
 
+  void SetSamplingRateDivisor(uint32_t divisor) override;
+
  private:
+  // Counters updated while reading the ring buffers. Each RingBufferReader accumulates them locally
+  // and merges them into ring_buffer_read_stats_ after every pass over its ring buffers, so that
+  // reader threads don't contend on them for every record.
+  struct RingBufferReadStats {
+    void Add(const RingBufferReadStats& other);
+
+    uint64_t thread_cpu_time_ns = 0;
+    uint64_t wakeup_count = 0;
+    uint64_t wakeup_timeout_count = 0;
+    uint64_t sched_switch_count = 0;
+    uint64_t sample_count = 0;
+    uint64_t uprobes_count = 0;
+    uint64_t uprobes_with_stack_count = 0;
+    uint64_t gpu_events_count = 0;
+    uint64_t mmap_count = 0;
+    uint64_t lost_count = 0;
+    absl::flat_hash_map<const PerfEventRingBuffer*, uint64_t> lost_count_per_buffer{};
+    // Maximum number of unread bytes observed in each ring buffer.
+    absl::flat_hash_map<const PerfEventRingBuffer*, uint64_t> fill_high_water_mark_per_buffer{};
+  };
+
+  // A subset of ring_buffers_, all read by the same thread, with the state needed to read them.
+  // Each ring buffer is assigned to exactly one RingBufferReader, and each RingBufferReader is the
+  // only producer of its deferred_events queue. Hence, the events of each
+  // PerfEventOrderedStream::FileDescriptor reach PerfEventProcessor in the order they were read.
+  struct RingBufferReader {
+    std::vector<PerfEventRingBuffer*> ring_buffers;
+    absl::flat_hash_map<int, uint64_t> fds_to_last_timestamp_ns;
+    moodycamel::ConcurrentQueue<PerfEvent> deferred_events;
+    // Indexed like ring_buffers.
+    RingBufferReadScheduler scheduler{0};
+    RingBufferReadStats stats;
+    uint64_t last_thread_cpu_time_ns = 0;
+    int epoll_fd = -1;
+  };
+
   void Run();
+  void CreateRingBufferReaders();
+  void ReadRingBuffers(RingBufferReader* reader, bool is_main_reader);
+  void ApplySamplingRateDivisorIfChanged();
+  [[nodiscard]] int CreateRingBuffersEpoll(const RingBufferReader& reader) const;
+  static void WaitForNewDataInRingBuffers(RingBufferReader* reader);
+  void MergeRingBufferReadStats(RingBufferReader* reader);
+  [[nodiscard]] uint32_t ComputeWakeupWatermarkBytes(uint64_t ring_buffer_size_kb) const;
   void Startup();
   void Shutdown();
-  void ProcessOneRecord(PerfEventRingBuffer* ring_buffer);
+  void ProcessOneRecord(PerfEventRingBuffer* ring_buffer, RingBufferReader* reader);
   void InitUprobesEventVisitor();
   [[nodiscard]] bool OpenUserSpaceProbes(absl::Span<const int32_t> cpus);
   [[nodiscard]] bool OpenUprobesToRecordAdditionalStackOn(absl::Span<const int32_t> cpus);
   [[nodiscard]] static bool OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& function,
                                         absl::Span<const int32_t> cpus,
+                                        uint32_t wakeup_watermark_bytes,
                                         absl::flat_hash_map<int32_t, int>* fds_per_cpu);
   [[nodiscard]] bool OpenUprobesWithStack(
       const orbit_grpc_protos::FunctionToRecordAdditionalStackOn& function,
       absl::Span<const int32_t> cpus, absl::flat_hash_map<int32_t, int>* fds_per_cpu) const;
   [[nodiscard]] static bool OpenUretprobes(const orbit_grpc_protos::InstrumentedFunction& function,
                                            absl::Span<const int32_t> cpus,
+                                           uint32_t wakeup_watermark_bytes,
                                            absl::flat_hash_map<int32_t, int>* fds_per_cpu);
   [[nodiscard]] bool OpenMmapTask(absl::Span<const int32_t> cpus);
   [[nodiscard]] bool OpenSampling(absl::Span<const int32_t> cpus);
@@ -101,20 +155,31 @@ class TracerImpl : public Tracer {
   void InitLostAndDiscardedEventVisitor();
 
   [[nodiscard]] uint64_t ProcessForkEventAndReturnTimestamp(const perf_event_header& header,
-                                                            PerfEventRingBuffer* ring_buffer);
+                                                            PerfEventRingBuffer* ring_buffer,
+                                                            RingBufferReader* reader) const;
   [[nodiscard]] uint64_t ProcessExitEventAndReturnTimestamp(const perf_event_header& header,
-                                                            PerfEventRingBuffer* ring_buffer);
+                                                            PerfEventRingBuffer* ring_buffer,
+                                                            RingBufferReader* reader) const;
   [[nodiscard]] uint64_t ProcessMmapEventAndReturnTimestamp(const perf_event_header& header,
-                                                            PerfEventRingBuffer* ring_buffer);
+                                                            PerfEventRingBuffer* ring_buffer,
+                                                            RingBufferReader* reader) const;
   [[nodiscard]] uint64_t ProcessSampleEventAndReturnTimestamp(const perf_event_header& header,
-                                                              PerfEventRingBuffer* ring_buffer);
-  [[nodiscard]] uint64_t ProcessLostEventAndReturnTimestamp(const perf_event_header& header,
-                                                            PerfEventRingBuffer* ring_buffer);
+                                                              PerfEventRingBuffer* ring_buffer,
+                                                              RingBufferReader* reader);
+  [[nodiscard]] static uint64_t ProcessLostEventAndReturnTimestamp(
+      const perf_event_header& header, PerfEventRingBuffer* ring_buffer, RingBufferReader* reader);
   [[nodiscard]] static uint64_t ProcessThrottleUnthrottleEventAndReturnTimestamp(
       const perf_event_header& header, PerfEventRingBuffer* ring_buffer);
 
   void DeferEvent(PerfEvent&& event);
+  static void DeferEventFromRingBuffer(PerfEvent&& event, RingBufferReader* reader) {
+    reader->deferred_events.enqueue(std::move(event));
+  }
+  void WakeUpDeferredEventsThreadIfIdle();
   void ProcessDeferredEvents();
+  [[nodiscard]] bool HasDeferredEvents() const;
+  void WaitForDeferredEvents();
+  [[nodiscard]] size_t MoveDeferredEventsToEventProcessor();
 
   void RetrieveInitialTidToPidAssociationSystemWide();
   void RetrieveInitialThreadStatesOfTarget();
@@ -123,10 +188,6 @@ class TracerImpl : public Tracer {
 
   void Reset();
 
-  // Number of records to read consecutively from a perf_event_open ring buffer
-  // before switching to another one.
-  static constexpr int32_t kRoundRobinPollingBatchSize = 5;
-
   // These values are supposed to be large enough to accommodate enough events
   // in case TracerThread::Run's thread is not scheduled for a few tens of
   // milliseconds.
@@ -141,12 +202,30 @@ class TracerImpl : public Tracer {
   static constexpr uint64_t kUprobesWithStackRingBufferSizeKb = 64 * 1024;
 
   static constexpr uint32_t kIdleTimeOnEmptyRingBuffersUs = 5000;
-  static constexpr uint32_t kIdleTimeOnEmptyDeferredEventsUs = 5000;
+
+  // With CaptureOptions::kRingBufferWakeupEventDriven, the kernel wakes up the tracer when a ring
+  // buffer is filled beyond 1/kRingBufferSizeToWakeupWatermarkRatio of its size. As buffers that
+  // rarely receive records might take very long to reach that watermark, epoll_wait still times out
+  // after kMaxIdleTimeOnEventDrivenWakeupMs. This needs to be well below
+  // PerfEventProcessor::kProcessingDelayMs, or such records would be discarded as out of order.
+  static constexpr uint64_t kRingBufferSizeToWakeupWatermarkRatio = 8;
+  static constexpr int kMaxIdleTimeOnEventDrivenWakeupMs = 50;
+  static constexpr size_t kMaxEpollEventsPerWait = 64;
+
+  // Number of events moved at once from a queue of deferred events.
+  static constexpr size_t kDeferredEventsDequeueBatchSize = 1024;
+  // The deferred-events thread is woken up as soon as new events are deferred. This timeout only
+  // bounds how long it can miss a wakeup, which in practice doesn't happen.
+  static constexpr int64_t kMaxIdleTimeOnEmptyDeferredEventsMs = 50;
 
   bool trace_context_switches_;
   bool introspection_enabled_;
   pid_t target_pid_;
   std::optional<uint64_t> sampling_period_ns_;
+  // Set by SetSamplingRateDivisor, and applied to the sampling file descriptors by the main
+  // RingBufferReader, which keeps track of the divisor in effect.
+  std::atomic<uint32_t> requested_sampling_rate_divisor_ = 1;
+  uint32_t applied_sampling_rate_divisor_ = 1;
   uint16_t stack_dump_size_;
   orbit_grpc_protos::CaptureOptions::UnwindingMethod unwinding_method_;
   orbit_grpc_protos::CaptureOptions::ThreadStateChangeCallStackCollection
@@ -159,17 +238,27 @@ class TracerImpl : public Tracer {
   bool trace_thread_state_;
   bool trace_gpu_driver_;
   std::vector<orbit_grpc_protos::TracepointInfo> instrumented_tracepoints_;
+  orbit_grpc_protos::CaptureOptions::RingBufferWakeupMethod ring_buffer_wakeup_method_;
+  uint32_t ring_buffer_reader_thread_count_;
+  uint32_t unwinding_thread_count_;
 
   std::unique_ptr<UserSpaceInstrumentationAddresses> user_space_instrumentation_addresses_;
 
   TracerListener* listener_ = nullptr;
 
   std::atomic<bool> stop_run_thread_ = true;
+  // Only used with CaptureOptions::kRingBufferWakeupEventDriven, to interrupt epoll_wait in Run.
+  int stop_run_thread_event_fd_ = -1;
   std::thread run_thread_;
 
+  // Declared before all members that can hold PerfEvents, so that it outlives them.
+  PerfEventPayloadPool payload_pool_;
+
   absl::flat_hash_map<std::string, std::vector<int>> tracing_fds_by_type_;
   std::vector<PerfEventRingBuffer> ring_buffers_;
-  absl::flat_hash_map<int, uint64_t> fds_to_last_timestamp_ns_;
+  // Created before the reader threads and the deferred-events thread are started, and cleared after
+  // they are joined. The first reader runs on the Tracer::Run thread itself.
+  std::vector<std::unique_ptr<RingBufferReader>> ring_buffer_readers_;
 
   absl::flat_hash_map<uint64_t, uint64_t> uprobes_uretprobes_ids_to_function_id_;
   absl::flat_hash_set<uint64_t> uprobes_ids_;
@@ -195,15 +284,20 @@ class TracerImpl : public Tracer {
   uint64_t effective_capture_start_timestamp_ns_ = 0;
 
   std::atomic<bool> stop_deferred_thread_ = false;
-  std::vector<PerfEvent> deferred_events_being_buffered_
-      ABSL_GUARDED_BY(deferred_events_being_buffered_mutex_);
-  absl::Mutex deferred_events_being_buffered_mutex_;
-  std::vector<PerfEvent> deferred_events_to_process_;
+  // Events passed to ProcessFunctionEntry and ProcessFunctionExit, which are called from threads
+  // other than the ones reading the ring buffers.
+  moodycamel::ConcurrentQueue<PerfEvent> deferred_events_from_other_threads_;
+  // Blocks the deferred-events thread while there are no deferred events.
+  IdleThreadWaker deferred_events_thread_waker_;
+  // Only used by the deferred-events thread, as the destination of bulk dequeues.
+  std::vector<std::optional<PerfEvent>> deferred_events_to_process_;
 
   UprobesFunctionCallManager function_call_manager_;
   std::optional<UprobesReturnAddressManager> return_address_manager_;
   std::unique_ptr<LibunwindstackMaps> maps_;
   std::unique_ptr<LibunwindstackUnwinder> unwinder_;
+  // Only used with DWARF unwinding and more than one unwinding thread.
+  std::unique_ptr<ParallelStackUnwinder> parallel_stack_unwinder_;
   std::unique_ptr<LeafFunctionCallManager> leaf_function_call_manager_;
   std::unique_ptr<UprobesUnwindingVisitor> uprobes_unwinding_visitor_;
   std::unique_ptr<SwitchesStatesNamesVisitor> switches_states_names_visitor_;
@@ -219,37 +313,30 @@ class TracerImpl : public Tracer {
   struct EventStats {
     void Reset() {
       event_count_begin_ns = orbit_base::CaptureTimestampNs();
-      sched_switch_count = 0;
-      sample_count = 0;
-      uprobes_count = 0;
-      uprobes_with_stack_count = 0;
-      gpu_events_count = 0;
-      mmap_count = 0;
-      lost_count = 0;
-      lost_count_per_buffer.clear();
       discarded_out_of_order_count = 0;
+      discarded_behind_watermark_count = 0;
       unwind_error_count = 0;
+      unwind_step_cache_hit_count = 0;
+      unwind_step_cache_miss_count = 0;
       samples_in_uretprobes_count = 0;
       thread_state_count = 0;
     }
 
     uint64_t event_count_begin_ns = 0;
-    uint64_t sched_switch_count = 0;
-    uint64_t sample_count = 0;
-    uint64_t uprobes_count = 0;
-    uint64_t uprobes_with_stack_count = 0;
-    uint64_t gpu_events_count = 0;
-    uint64_t mmap_count = 0;
-    uint64_t lost_count = 0;
-    absl::flat_hash_map<PerfEventRingBuffer*, uint64_t> lost_count_per_buffer{};
     std::atomic<uint64_t> discarded_out_of_order_count = 0;
+    std::atomic<uint64_t> discarded_behind_watermark_count = 0;
     std::atomic<uint64_t> unwind_error_count = 0;
+    std::atomic<uint64_t> unwind_step_cache_hit_count = 0;
+    std::atomic<uint64_t> unwind_step_cache_miss_count = 0;
     std::atomic<uint64_t> samples_in_uretprobes_count = 0;
     std::atomic<uint64_t> thread_state_count = 0;
   };
 
   static constexpr uint64_t kEventStatsWindowS = 5;
+  static constexpr size_t kMaxRingBuffersInFillStats = 8;
   EventStats stats_{};
+  absl::Mutex ring_buffer_read_stats_mutex_;
+  RingBufferReadStats ring_buffer_read_stats_ ABSL_GUARDED_BY(ring_buffer_read_stats_mutex_);
 
   static constexpr uint64_t kNsPerSecond = 1'000'000'000;
 };
@@ -222,12 +222,9 @@ UprobesUnwindingVisitor::ComputeCallstackTypeFromStackSample(
 }
 
 template <typename StackPerfEventDataT>
-bool UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
-                                          Callstack* resulting_callstack,
-                                          bool offline_memory_only) {
-  ORBIT_CHECK(listener_ != nullptr);
-  ORBIT_CHECK(current_maps_ != nullptr);
-
+std::vector<StackSliceView> UprobesUnwindingVisitor::PatchAndCollectStackSlices(
+    const StackPerfEventDataT& event_data,
+    std::vector<std::shared_ptr<const uint8_t[]>>* stack_slice_data) {
   return_address_manager_->PatchSample(event_data.GetCallstackTid(), event_data.GetRegisters().sp,
                                        event_data.GetMutableStackData(), event_data.GetStackSize());
 
@@ -240,20 +237,16 @@ bool UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
     for (const auto& [unused_stream_id, user_stack_slice] : stream_id_to_user_stack->second) {
       stack_slices.emplace_back(user_stack_slice.start_address, user_stack_slice.size,
                                 user_stack_slice.data.get());
+      if (stack_slice_data != nullptr) {
+        stack_slice_data->push_back(user_stack_slice.data);
+      }
     }
   }
+  return stack_slices;
+}
 
-  // There might be rare cases where the callstack's pid is "-1". This happens on callstacks on
-  // "sched out" switches where the thread exits. This is not a big problem for unwinding, as
-  // the process id is only used to read from the process' memory as a fallback to the collected
-  // stack slice. When actually attempting to read from pid "-1" we will produce an unwinding error.
-  // But this is not likely to happen.
-  // TODO(b/246519821) It would be possible to retrieve the information from
-  //  SwitchesStatesNamesVisitor::GetPidOfTid, but this requires major refactoring.
-  LibunwindstackResult libunwindstack_result =
-      unwinder_->Unwind(event_data.GetCallstackPidOrMinusOne(), current_maps_->Get(),
-                        event_data.GetRegistersAsArray(), stack_slices, offline_memory_only);
-
+bool UprobesUnwindingVisitor::FillCallstackFromLibunwindstackResult(
+    const LibunwindstackResult& libunwindstack_result, Callstack* resulting_callstack) {
   if (libunwindstack_result.frames().empty()) {
     // Even with unwinding errors this is not expected because we should at least get the program
     // counter. Do nothing in case this doesn't hold for a reason we don't know.
@@ -271,8 +264,61 @@ bool UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
   return true;
 }
 
+template <typename StackPerfEventDataT>
+bool UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
+                                          Callstack* resulting_callstack,
+                                          bool offline_memory_only) {
+  ORBIT_CHECK(listener_ != nullptr);
+  ORBIT_CHECK(current_maps_ != nullptr);
+
+  std::vector<StackSliceView> stack_slices = PatchAndCollectStackSlices(event_data);
+
+  // There might be rare cases where the callstack's pid is "-1". This happens on callstacks on
+  // "sched out" switches where the thread exits. This is not a big problem for unwinding, as
+  // the process id is only used to read from the process' memory as a fallback to the collected
+  // stack slice. When actually attempting to read from pid "-1" we will produce an unwinding error.
+  // But this is not likely to happen.
+  // TODO(b/246519821) It would be possible to retrieve the information from
+  //  SwitchesStatesNamesVisitor::GetPidOfTid, but this requires major refactoring.
+  LibunwindstackResult libunwindstack_result =
+      unwinder_->Unwind(event_data.GetCallstackPidOrMinusOne(), current_maps_->Get(),
+                        event_data.GetRegistersAsArray(), stack_slices, offline_memory_only);
+  return FillCallstackFromLibunwindstackResult(libunwindstack_result, resulting_callstack);
+}
+
+void UprobesUnwindingVisitor::SubmitStackSampleToParallelStackUnwinder(
+    uint64_t event_timestamp, const StackSamplePerfEventData& event_data) {
+  ORBIT_CHECK(current_maps_ != nullptr);
+  ParallelStackUnwinder::UnwindRequest request{
+      .pid = event_data.GetCallstackPidOrMinusOne(),
+      .maps = current_maps_->Get(),
+      .registers = event_data.GetRegistersAsArray(),
+  };
+  request.stack_slices = PatchAndCollectStackSlices(event_data, &request.additional_stack_data);
+  // The StackSliceView in request.stack_slices keeps pointing to the same buffer.
+  request.stack_data = std::move(event_data.data);
+  request.on_unwound = [this, pid = event_data.pid, tid = event_data.tid,
+                        event_timestamp](const LibunwindstackResult& libunwindstack_result) {
+    FullCallstackSample sample;
+    sample.set_pid(pid);
+    sample.set_tid(tid);
+    sample.set_timestamp_ns(event_timestamp);
+    if (!FillCallstackFromLibunwindstackResult(libunwindstack_result,
+                                               sample.mutable_callstack())) {
+      return;
+    }
+    listener_->OnCallstackSample(std::move(sample));
+  };
+  parallel_stack_unwinder_->Submit(std::move(request));
+}
+
 void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
                                     const StackSamplePerfEventData& event_data) {
+  if (parallel_stack_unwinder_ != nullptr) {
+    SubmitStackSampleToParallelStackUnwinder(event_timestamp, event_data);
+    return;
+  }
+
   FullCallstackSample sample;
   sample.set_pid(event_data.pid);
   sample.set_tid(event_data.tid);
@@ -602,7 +648,7 @@ void UprobesUnwindingVisitor::Visit(uint64_t /*event_timestamp*/,
                                     const UprobesWithStackPerfEventData& event_data) {
   StackSlice stack_slice{.start_address = event_data.GetRegisters().sp,
                          .size = event_data.dyn_size,
-                         .data = std::move(event_data.data)};
+                         .data = std::shared_ptr<const uint8_t[]>{std::move(event_data.data)}};
   absl::flat_hash_map<uint64_t, StackSlice>& stream_id_to_stack =
       thread_id_stream_id_to_stack_slices_[event_data.tid];
   stream_id_to_stack.insert_or_assign(event_data.stream_id, std::move(stack_slice));
@@ -722,6 +768,11 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp, const MmapPerfEven
   ORBIT_CHECK(listener_ != nullptr);
   ORBIT_CHECK(current_maps_ != nullptr);
 
+  // Samples that came before this mapping need to be unwound with the maps as they were.
+  if (parallel_stack_unwinder_ != nullptr) {
+    parallel_stack_unwinder_->DeliverAllResults();
+  }
+
   // PERF_RECORD_MMAP events do not contain the flags, but only distinguish between executable and
   // non-executable. This is all we need, so simply assume PROT_READ | PROT_EXEC for executable
   // mappings and PROT_READ for non-executable mappings. If we wanted the exact flags, we could
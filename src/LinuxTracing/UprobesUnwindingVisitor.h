@@ -26,6 +26,7 @@
 #include "LinuxTracing/TracerListener.h"
 #include "LinuxTracing/UserSpaceInstrumentationAddresses.h"
 #include "OrbitBase/Logging.h"
+#include "ParallelStackUnwinder.h"
 #include "PerfEvent.h"
 #include "PerfEventRecords.h"
 #include "PerfEventVisitor.h"
@@ -85,6 +86,14 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
     samples_in_uretprobes_counter_ = samples_in_uretprobes_counter;
   }
 
+  // If set, stack samples (but not the callstacks of thread state slices, which need to reach the
+  // listener before the corresponding slices) are unwound on the threads of
+  // `parallel_stack_unwinder`. The resulting callstacks are only sent to the listener when the
+  // owner of `parallel_stack_unwinder` delivers its results.
+  void SetParallelStackUnwinder(ParallelStackUnwinder* parallel_stack_unwinder) {
+    parallel_stack_unwinder_ = parallel_stack_unwinder;
+  }
+
   void Visit(uint64_t event_timestamp, const StackSamplePerfEventData& event_data) override;
   void Visit(uint64_t event_timestamp,
              const SchedWakeupWithCallchainPerfEventData& event_data) override;
@@ -113,7 +122,9 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
   struct StackSlice {
     uint64_t start_address;
     uint64_t size;
-    std::unique_ptr<uint8_t[]> data;
+    // Shared with the pending requests of parallel_stack_unwinder_, as a newer slice can replace
+    // this one before those requests have been unwound.
+    std::shared_ptr<const uint8_t[]> data;
   };
 
   void OnUprobes(uint64_t timestamp_ns, pid_t tid, uint32_t cpu, uint64_t sp, uint64_t ip,
@@ -131,11 +142,27 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
 
   void SendFullAddressInfoToListener(const unwindstack::FrameData& libunwindstack_frame);
 
+  // Patches the stack of `event` with the return addresses hijacked by dynamic instrumentation and
+  // returns the stack slices to unwind with, including the user stacks recorded by dynamic
+  // instrumentation. If `stack_slice_data` is not nullptr, the buffers of the latter are added to
+  // it.
+  template <typename StackPerfEventDataT>
+  [[nodiscard]] std::vector<StackSliceView> PatchAndCollectStackSlices(
+      const StackPerfEventDataT& event,
+      std::vector<std::shared_ptr<const uint8_t[]>>* stack_slice_data = nullptr);
+
+  [[nodiscard]] bool FillCallstackFromLibunwindstackResult(
+      const LibunwindstackResult& libunwindstack_result,
+      orbit_grpc_protos::Callstack* resulting_callstack);
+
   template <typename StackPerfEventDataT>
   [[nodiscard]] bool UnwindStack(const StackPerfEventDataT& event,
                                  orbit_grpc_protos::Callstack* resulting_callstack,
                                  bool offline_memory_only = false);
 
+  void SubmitStackSampleToParallelStackUnwinder(uint64_t event_timestamp,
+                                                const StackSamplePerfEventData& event_data);
+
   template <typename CallchainPerfEventDataT>
   [[nodiscard]] bool VisitCallchainEvent(const CallchainPerfEventDataT& event_data,
                                          orbit_grpc_protos::Callstack* resulting_callstack);
@@ -147,6 +174,7 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
   LibunwindstackMaps* current_maps_;
   LibunwindstackUnwinder* unwinder_;
   LeafFunctionCallManager* leaf_function_call_manager_;
+  ParallelStackUnwinder* parallel_stack_unwinder_ = nullptr;
 
   UserSpaceInstrumentationAddresses* user_space_instrumentation_addresses_;
 
@@ -26,6 +26,7 @@
 #include "LibunwindstackUnwinder.h"
 #include "LinuxTracing/UserSpaceInstrumentationAddresses.h"
 #include "MockTracerListener.h"
+#include "ParallelStackUnwinder.h"
 #include "PerfEvent.h"
 #include "PerfEventRecords.h"
 #include "TestUtils/SaveRangeFromArg.h"
@@ -1813,4 +1814,84 @@ using TestTypes = ::testing::Types<
     DwarfUnwindingTestType<SchedSwitchWithStackPerfEvent,
                            orbit_grpc_protos::ThreadStateSliceCallstack>>;
 INSTANTIATE_TYPED_TEST_SUITE_P(TypedTest, UprobesUnwindingVisitorDwarfUnwindingTest, TestTypes);
+
+namespace {
+// Lets ParallelStackUnwinder own its unwinders while the expectations are set on a shared mock.
+class ForwardingLibunwindstackUnwinder : public LibunwindstackUnwinder {
+ public:
+  explicit ForwardingLibunwindstackUnwinder(LibunwindstackUnwinder* unwinder)
+      : unwinder_{unwinder} {}
+
+  LibunwindstackResult Unwind(pid_t pid, unwindstack::Maps* maps,
+                              const std::array<uint64_t, kArchPerfRegMax>& perf_regs,
+                              absl::Span<const StackSliceView> stack_slices,
+                              bool offline_memory_only, size_t max_frames) override {
+    return unwinder_->Unwind(pid, maps, perf_regs, stack_slices, offline_memory_only, max_frames);
+  }
+
+  std::optional<bool> HasFramePointerSet(uint64_t instruction_pointer, pid_t pid,
+                                         unwindstack::Maps* maps) override {
+    return unwinder_->HasFramePointerSet(instruction_pointer, pid, maps);
+  }
+
+ private:
+  LibunwindstackUnwinder* unwinder_;
+};
+}  // namespace
+
+using UprobesUnwindingVisitorDwarfUnwindingWithParallelStackUnwinderTest =
+    UprobesUnwindingVisitorDwarfUnwindingTestBase;
+
+TEST_F(UprobesUnwindingVisitorDwarfUnwindingWithParallelStackUnwinderTest,
+       VisitStackSamplesSendsCallstacksInOrderOnlyWhenResultsAreDelivered) {
+  ParallelStackUnwinder parallel_stack_unwinder{
+      2, [this] { return std::make_unique<ForwardingLibunwindstackUnwinder>(&unwinder_); }};
+  visitor_.SetParallelStackUnwinder(&parallel_stack_unwinder);
+
+  EXPECT_CALL(return_address_manager_, PatchSample).Times(2).WillRepeatedly(::testing::Return());
+  EXPECT_CALL(maps_, Get).Times(2).WillRepeatedly(::testing::Return(nullptr));
+
+  // The first sample unwinds to kFrame1, the second to kFrame2, kFrame3.
+  auto event1 = BuildFakePerfEventWithStack<StackSamplePerfEvent>();
+  event1.data.dyn_size = 1;
+  event1.data.data[0] = 1;
+  auto event2 = BuildFakePerfEventWithStack<StackSamplePerfEvent>();
+  event2.data.dyn_size = 1;
+  event2.data.data[0] = 2;
+  event2.timestamp = event1.timestamp + 1;
+  EXPECT_CALL(unwinder_, Unwind(event1.data.GetCallstackPidOrMinusOne(), nullptr, ::testing::_,
+                                ::testing::_, ::testing::_, ::testing::_))
+      .Times(2)
+      .WillRepeatedly([this](pid_t /*pid*/, unwindstack::Maps* /*maps*/,
+                             const std::array<uint64_t, kArchPerfRegMax>& /*perf_regs*/,
+                             absl::Span<const StackSliceView> stack_slices,
+                             bool /*offline_memory_only*/, size_t /*max_frames*/) {
+        if (stack_slices[0].data()[0] == 1) {
+          return LibunwindstackResult{{kFrame1}, {}, unwindstack::ErrorCode::ERROR_NONE};
+        }
+        return LibunwindstackResult{{kFrame2, kFrame3}, {}, unwindstack::ErrorCode::ERROR_NONE};
+      });
+
+  std::vector<orbit_grpc_protos::FullCallstackSample> actual_callstack_samples;
+  EXPECT_CALL(listener_, OnCallstackSample)
+      .Times(2)
+      .WillRepeatedly([&actual_callstack_samples](orbit_grpc_protos::FullCallstackSample sample) {
+        actual_callstack_samples.push_back(std::move(sample));
+      });
+  EXPECT_CALL(listener_, OnAddressInfo).Times(3);
+
+  PerfEvent{std::move(event1)}.Accept(&visitor_);
+  PerfEvent{std::move(event2)}.Accept(&visitor_);
+  EXPECT_TRUE(actual_callstack_samples.empty());
+
+  parallel_stack_unwinder.DeliverAllResults();
+  ASSERT_EQ(actual_callstack_samples.size(), 2);
+  EXPECT_EQ(actual_callstack_samples[0].timestamp_ns(), 15);
+  EXPECT_THAT(actual_callstack_samples[0].callstack().pcs(),
+              ::testing::ElementsAre(kTargetAddress1));
+  EXPECT_EQ(actual_callstack_samples[1].timestamp_ns(), 16);
+  EXPECT_THAT(actual_callstack_samples[1].callstack().pcs(),
+              ::testing::ElementsAre(kTargetAddress2, kTargetAddress3));
+}
+
 }  // namespace orbit_linux_tracing
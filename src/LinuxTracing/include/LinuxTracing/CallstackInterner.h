@@ -0,0 +1,60 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_CALLSTACK_INTERNER_H_
+#define LINUX_TRACING_CALLSTACK_INTERNER_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/synchronization/mutex.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "GrpcProtos/capture.pb.h"
+
+namespace orbit_linux_tracing {
+
+// Assigns ids to the callstacks of the samples produced by the Tracer, so that a TracerListener can
+// forward each callstack only once, as an InternedCallstack, and then send compact CallstackSamples
+// that only refer to it by id.
+// Each thread calling GetOrAssignId gets its own table, which it finds through a thread-local cache
+// without taking any lock: the thread processing the perf_event_open records and, e.g., the one
+// sampling Python callstacks never contend. As a consequence, the same callstack can get different
+// ids on different threads. Ids are still unique across all threads.
+class CallstackInterner {
+ public:
+  CallstackInterner();
+  ~CallstackInterner();
+
+  CallstackInterner(const CallstackInterner&) = delete;
+  CallstackInterner& operator=(const CallstackInterner&) = delete;
+  CallstackInterner(CallstackInterner&&) = delete;
+  CallstackInterner& operator=(CallstackInterner&&) = delete;
+
+  // Returns the pair <id, assigned>, where assigned is true if the id was assigned by this call,
+  // i.e., if this is the first time the calling thread passes this callstack. Ids start at 1.
+  [[nodiscard]] std::pair<uint64_t, bool> GetOrAssignId(
+      const orbit_grpc_protos::Callstack& callstack);
+
+ private:
+  class Table;
+  [[nodiscard]] Table* GetTableOfCurrentThread();
+
+  // Distinguishes this instance from the ones that previously used the same address in the
+  // thread-local cache.
+  const uint64_t instance_id_;
+  std::atomic<uint64_t> next_callstack_id_ = 1;
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::thread::id, std::unique_ptr<Table>> thread_id_to_table_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_CALLSTACK_INTERNER_H_
@@ -5,6 +5,8 @@
 #ifndef LINUX_TRACING_TRACER_H_
 #define LINUX_TRACING_TRACER_H_
 
+#include <stdint.h>
+
 #include <atomic>
 #include <memory>
 #include <thread>
@@ -28,6 +30,11 @@ class Tracer {
   virtual void ProcessFunctionEntry(const orbit_grpc_protos::FunctionEntry& function_entry) = 0;
   virtual void ProcessFunctionExit(const orbit_grpc_protos::FunctionExit& function_exit) = 0;
 
+  // Lowers the rate of the stack samples to the rate requested in the CaptureOptions divided by
+  // `divisor`, e.g., when the samples can't be sent to the client fast enough. A divisor of 1
+  // restores the requested rate. Can be called from any thread.
+  virtual void SetSamplingRateDivisor(uint32_t divisor) = 0;
+
   virtual ~Tracer() = default;
 
   [[nodiscard]] static std::unique_ptr<Tracer> Create(
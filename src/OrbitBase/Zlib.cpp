@@ -0,0 +1,63 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitBase/Zlib.h"
+
+#include <absl/strings/str_format.h>
+#include <zlib.h>
+
+#include <limits>
+
+namespace orbit_base {
+
+namespace {
+// Deflate can't compress data by more than this factor, plus a few bytes of header.
+constexpr size_t kZlibMaxCompressionRatio = 1032;
+}  // namespace
+
+ErrorMessageOr<std::string> ZlibCompress(std::string_view data) {
+  if (data.size() > std::numeric_limits<uLong>::max()) {
+    return ErrorMessage{absl::StrFormat("Unable to compress %u bytes with zlib", data.size())};
+  }
+  uLongf compressed_size = compressBound(static_cast<uLong>(data.size()));
+  std::string compressed_data(compressed_size, '\0');
+  int result = compress2(reinterpret_cast<Bytef*>(compressed_data.data()), &compressed_size,
+                         reinterpret_cast<const Bytef*>(data.data()),
+                         static_cast<uLong>(data.size()), Z_BEST_SPEED);
+  if (result != Z_OK) {
+    return ErrorMessage{absl::StrFormat("zlib compression failed with error %d", result)};
+  }
+  compressed_data.resize(compressed_size);
+  return compressed_data;
+}
+
+ErrorMessageOr<std::string> ZlibDecompress(std::string_view compressed_data,
+                                           size_t uncompressed_size) {
+  if (compressed_data.size() > std::numeric_limits<uLong>::max() ||
+      uncompressed_size > std::numeric_limits<uLongf>::max()) {
+    return ErrorMessage{
+        absl::StrFormat("Unable to decompress %u bytes with zlib", compressed_data.size())};
+  }
+  // Check this before allocating the output, as `uncompressed_size` usually comes from the same
+  // untrusted source as `compressed_data`.
+  if (uncompressed_size > compressed_data.size() * kZlibMaxCompressionRatio) {
+    return ErrorMessage{absl::StrFormat("%u bytes can't decompress to %u bytes with zlib",
+                                        compressed_data.size(), uncompressed_size)};
+  }
+  std::string data(uncompressed_size, '\0');
+  auto actual_uncompressed_size = static_cast<uLongf>(uncompressed_size);
+  int result = uncompress(reinterpret_cast<Bytef*>(data.data()), &actual_uncompressed_size,
+                          reinterpret_cast<const Bytef*>(compressed_data.data()),
+                          static_cast<uLong>(compressed_data.size()));
+  if (result != Z_OK) {
+    return ErrorMessage{absl::StrFormat("zlib decompression failed with error %d", result)};
+  }
+  if (actual_uncompressed_size != uncompressed_size) {
+    return ErrorMessage{absl::StrFormat("zlib decompression produced %u bytes instead of %u",
+                                        actual_uncompressed_size, uncompressed_size)};
+  }
+  return data;
+}
+
+}  // namespace orbit_base
@@ -0,0 +1,70 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "OrbitBase/Result.h"
+#include "OrbitBase/Zlib.h"
+#include "TestUtils/TestUtils.h"
+
+namespace orbit_base {
+
+using orbit_test_utils::HasErrorWithMessage;
+using orbit_test_utils::HasNoError;
+
+TEST(Zlib, CompressAndDecompressRoundTrip) {
+  std::string data;
+  for (int i = 0; i < 10'000; ++i) {
+    data += "event " + std::to_string(i % 100) + ";";
+  }
+
+  ErrorMessageOr<std::string> compressed_or_error = ZlibCompress(data);
+  ASSERT_THAT(compressed_or_error, HasNoError());
+  EXPECT_LT(compressed_or_error.value().size(), data.size());
+
+  ErrorMessageOr<std::string> decompressed_or_error =
+      ZlibDecompress(compressed_or_error.value(), data.size());
+  ASSERT_THAT(decompressed_or_error, HasNoError());
+  EXPECT_EQ(decompressed_or_error.value(), data);
+}
+
+TEST(Zlib, EmptyData) {
+  ErrorMessageOr<std::string> compressed_or_error = ZlibCompress("");
+  ASSERT_THAT(compressed_or_error, HasNoError());
+
+  ErrorMessageOr<std::string> decompressed_or_error =
+      ZlibDecompress(compressed_or_error.value(), 0);
+  ASSERT_THAT(decompressed_or_error, HasNoError());
+  EXPECT_TRUE(decompressed_or_error.value().empty());
+}
+
+TEST(Zlib, DecompressFailsWithWrongSize) {
+  const std::string data(1000, 'a');
+  ErrorMessageOr<std::string> compressed_or_error = ZlibCompress(data);
+  ASSERT_THAT(compressed_or_error, HasNoError());
+
+  EXPECT_THAT(ZlibDecompress(compressed_or_error.value(), data.size() - 1),
+              HasErrorWithMessage("zlib"));
+  EXPECT_THAT(ZlibDecompress(compressed_or_error.value(), data.size() + 1),
+              HasErrorWithMessage("instead of"));
+}
+
+TEST(Zlib, DecompressFailsWithCorruptedData) {
+  EXPECT_THAT(ZlibDecompress("not zlib data", 100),
+              HasErrorWithMessage("zlib decompression failed"));
+}
+
+TEST(Zlib, DecompressRejectsImpossiblyLargeSizes) {
+  const std::string data(1000, 'a');
+  ErrorMessageOr<std::string> compressed_or_error = ZlibCompress(data);
+  ASSERT_THAT(compressed_or_error, HasNoError());
+
+  EXPECT_THAT(ZlibDecompress(compressed_or_error.value(), size_t{1} << 30),
+              HasErrorWithMessage("can't decompress to"));
+}
+
+}  // namespace orbit_base
@@ -0,0 +1,29 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_BASE_ZLIB_H_
+#define ORBIT_BASE_ZLIB_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+
+#include "OrbitBase/Result.h"
+
+namespace orbit_base {
+
+// Compresses `data` into the zlib format. The fastest compression level is used, as this is meant
+// for data that is compressed while it is being produced, e.g., capture data sent over the network.
+[[nodiscard]] ErrorMessageOr<std::string> ZlibCompress(std::string_view data);
+
+// Decompresses data produced by ZlibCompress. `uncompressed_size` is the size of the original data:
+// it is used to size the output, and it is an error if the decompressed data has a different size.
+// Sizes that `compressed_data` can't possibly decompress to are rejected before allocating.
+[[nodiscard]] ErrorMessageOr<std::string> ZlibDecompress(std::string_view compressed_data,
+                                                         size_t uncompressed_size);
+
+}  // namespace orbit_base
+
+#endif  // ORBIT_BASE_ZLIB_H_
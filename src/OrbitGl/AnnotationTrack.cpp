@@ -44,8 +44,7 @@ void AnnotationTrack::DrawAnnotation(PrimitiveAssembler& primitive_assembler,
 
     if (!GetValueUpperBoundTooltip().empty()) {
       Vec2 text_box_size(string_width, layout->GetTextBoxHeight());
-      auto user_data = std::make_unique<PickingUserData>(
-          nullptr, [&](PickingId /*id*/) { return this->GetValueUpperBoundTooltip(); });
+      PickingUserData user_data(nullptr, &value_upper_bound_tooltip_callback_);
       primitive_assembler.AddShadedBox(text_box_position, text_box_size, z, kFullyTransparent,
                                        std::move(user_data));
     }
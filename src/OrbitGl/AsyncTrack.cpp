@@ -30,6 +30,7 @@
 #include "OrbitGl/Viewport.h"
 
 using orbit_client_protos::TimerInfo;
+using orbit_gl::PickingUserData;
 using orbit_gl::PrimitiveAssembler;
 using orbit_gl::TextRenderer;
 
@@ -43,9 +44,8 @@ AsyncTrack::AsyncTrack(CaptureViewElement* parent,
                  timer_data),
       name_(std::move(name)) {}
 
-[[nodiscard]] std::string AsyncTrack::GetBoxTooltip(const PrimitiveAssembler& primitive_assembler,
-                                                    PickingId id) const {
-  const TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
+[[nodiscard]] std::string AsyncTrack::GetBoxTooltip(const PickingUserData& user_data) const {
+  const TimerInfo* timer_info = user_data.timer_info_;
   if (timer_info == nullptr) return "";
   auto* manual_inst_manager = app_->GetManualInstrumentationManager();
 
@@ -194,33 +194,32 @@ void CallstackThreadBar::DoUpdatePrimitives(PrimitiveAssembler& primitive_assemb
           GetThreadId(), min_tick, max_tick, resolution_in_pixels,
           action_on_selected_callstack_events);
     }
-  } else {
-    // Draw boxes instead of lines to make picking easier, even if this may
-    // cause samples to overlap
-    constexpr const float kPickingBoxWidth = 9.0f;
-    constexpr const float kPickingBoxOffset = (kPickingBoxWidth - 1.0f) / 2.0f;
+  }
 
-    auto action_on_callstack_events = [&, this](const CallstackEvent& event) {
-      const uint64_t time = event.timestamp_ns();
-      ORBIT_CHECK(time >= min_tick && time <= max_tick);
-      const auto& [event_pos_x, unused_size_x] =
-          timeline_info_->GetBoxPosXAndWidthFromTicks(time, time);
-      const Vec2 pos(event_pos_x - kPickingBoxOffset, GetPos()[1]);
-      const Vec2 size(kPickingBoxWidth, track_height);
-      auto user_data = std::make_unique<PickingUserData>(
-          nullptr, [this, &primitive_assembler](PickingId id) -> std::string {
-            return GetSampleTooltip(primitive_assembler, id);
-          });
-      user_data->custom_data_ = &event;
-      primitive_assembler.AddShadedBox(pos, size, z, green_selection, std::move(user_data));
-    };
-    if (GetThreadId() == orbit_base::kAllProcessThreadsTid) {
-      capture_data_->GetCallstackData().ForEachCallstackEventInTimeRangeDiscretized(
-          min_tick, max_tick, resolution_in_pixels, action_on_callstack_events);
-    } else {
-      capture_data_->GetCallstackData().ForEachCallstackEventOfTidInTimeRangeDiscretized(
-          GetThreadId(), min_tick, max_tick, resolution_in_pixels, action_on_callstack_events);
-    }
+  // Draw boxes instead of lines to make picking easier, even if this may
+  // cause samples to overlap. They are transparent, as they are also used to find
+  // the hovered sample when not picking.
+  constexpr const float kPickingBoxWidth = 9.0f;
+  constexpr const float kPickingBoxOffset = (kPickingBoxWidth - 1.0f) / 2.0f;
+  static const Color kTransparent{0, 0, 0, 0};
+
+  auto action_on_callstack_events = [&, this](const CallstackEvent& event) {
+    const uint64_t time = event.timestamp_ns();
+    ORBIT_CHECK(time >= min_tick && time <= max_tick);
+    const auto& [event_pos_x, unused_size_x] =
+        timeline_info_->GetBoxPosXAndWidthFromTicks(time, time);
+    const Vec2 pos(event_pos_x - kPickingBoxOffset, GetPos()[1]);
+    const Vec2 size(kPickingBoxWidth, track_height);
+    PickingUserData user_data(nullptr, &sample_tooltip_callback_);
+    user_data.custom_data_ = &event;
+    primitive_assembler.AddShadedBox(pos, size, z, kTransparent, std::move(user_data));
+  };
+  if (GetThreadId() == orbit_base::kAllProcessThreadsTid) {
+    capture_data_->GetCallstackData().ForEachCallstackEventInTimeRangeDiscretized(
+        min_tick, max_tick, resolution_in_pixels, action_on_callstack_events);
+  } else {
+    capture_data_->GetCallstackData().ForEachCallstackEventOfTidInTimeRangeDiscretized(
+        GetThreadId(), min_tick, max_tick, resolution_in_pixels, action_on_callstack_events);
   }
 }
 
@@ -272,18 +271,16 @@ bool CallstackThreadBar::IsEmpty() const {
   return callstack_count == 0;
 }
 
-std::string CallstackThreadBar::GetSampleTooltip(const PrimitiveAssembler& primitive_assembler,
-                                                 PickingId id) const {
+std::string CallstackThreadBar::GetSampleTooltip(const PickingUserData& user_data) const {
   static const std::string kUnknownReturnText = "Function call information missing";
 
-  const PickingUserData* user_data = primitive_assembler.GetUserData(id);
-  if (user_data == nullptr || user_data->custom_data_ == nullptr) {
+  if (user_data.custom_data_ == nullptr) {
     return kUnknownReturnText;
   }
 
   ORBIT_CHECK(capture_data_ != nullptr);
   const CallstackData& callstack_data = capture_data_->GetCallstackData();
-  const auto* callstack_event = static_cast<const CallstackEvent*>(user_data->custom_data_);
+  const auto* callstack_event = static_cast<const CallstackEvent*>(user_data.custom_data_);
 
   uint64_t callstack_id = callstack_event->callstack_id();
   const CallstackInfo* callstack = callstack_data.GetCallstack(callstack_id);
@@ -8,7 +8,10 @@
 #include <absl/strings/str_cat.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <memory>
+#include <string>
 #include <string_view>
 #include <tuple>
 #include <utility>
@@ -16,6 +19,8 @@
 #include "Introspection/Introspection.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/RecordingBatcher.h"
+#include "OrbitGl/RecordingTextRenderer.h"
 #include "OrbitGl/Viewport.h"
 
 namespace orbit_gl {
@@ -50,9 +55,25 @@ void CaptureViewElement::UpdatePrimitives(PrimitiveAssembler& primitive_assemble
                                           uint64_t max_tick, PickingMode picking_mode) {
   ORBIT_SCOPE_FUNCTION;
 
-  update_primitives_requested_ = false;
+  if (update_primitives_requested_) {
+    primitives_cache_.reset();
+    update_primitives_requested_ = false;
+  }
   RenderGroups previous_groups = PreRender(primitive_assembler, text_renderer);
 
+  if (CachesPrimitives() && picking_mode == PickingMode::kNone) {
+    UpdatePrimitivesUsingCache(primitive_assembler, text_renderer, min_tick, max_tick);
+  } else {
+    UpdatePrimitivesOfContent(primitive_assembler, text_renderer, min_tick, max_tick,
+                              picking_mode);
+  }
+
+  PostRender(std::move(previous_groups), primitive_assembler, text_renderer);
+}
+
+void CaptureViewElement::UpdatePrimitivesOfContent(PrimitiveAssembler& primitive_assembler,
+                                                   TextRenderer& text_renderer, uint64_t min_tick,
+                                                   uint64_t max_tick, PickingMode picking_mode) {
   DoUpdatePrimitives(primitive_assembler, text_renderer, min_tick, max_tick, picking_mode);
 
   for (CaptureViewElement* child : GetChildrenVisibleInViewport()) {
@@ -60,8 +81,112 @@ void CaptureViewElement::UpdatePrimitives(PrimitiveAssembler& primitive_assemble
       child->UpdatePrimitives(primitive_assembler, text_renderer, min_tick, max_tick, picking_mode);
     }
   }
+}
 
-  PostRender(std::move(previous_groups), primitive_assembler, text_renderer);
+namespace {
+
+// Records the primitives, texts and render group states that are generated for an element, so that
+// they can be added to the primitive assembler and text renderer they were recorded for later.
+struct PrimitiveRecording {
+  PrimitiveRecording(PrimitiveAssembler& target_primitive_assembler,
+                     TextRenderer& target_text_renderer)
+      : batcher(target_primitive_assembler.GetBatcher()->GetBatcherId()),
+        primitive_assembler(&batcher, &render_group_manager,
+                            target_primitive_assembler.GetPickingManager()),
+        text_renderer(&target_text_renderer),
+        initial_group_names{target_primitive_assembler.GetCurrentRenderGroupName(),
+                            target_text_renderer.GetCurrentRenderGroupName()} {
+    // The element only looks up the states of the render groups it starts in.
+    BatchRenderGroupStateManager* target_render_group_manager =
+        target_primitive_assembler.GetRenderGroupManager();
+    for (const std::string& group_name : initial_group_names) {
+      render_group_manager.SetGroupState(group_name,
+                                         target_render_group_manager->GetGroupState(group_name));
+    }
+    primitive_assembler.SetCurrentRenderGroupName(initial_group_names[0]);
+    text_renderer.SetCurrentRenderGroupName(initial_group_names[1]);
+  }
+
+  // Adds the recording to the targets and keeps it. The states of the render groups the element
+  // started in are not added, as they belong to the parent and may have changed meanwhile.
+  void CopyTo(PrimitiveAssembler& target_primitive_assembler,
+              TextRenderer& target_text_renderer) const {
+    batcher.CopyTo(*target_primitive_assembler.GetBatcher());
+    text_renderer.CopyTo(target_text_renderer);
+    BatchRenderGroupStateManager* target_render_group_manager =
+        target_primitive_assembler.GetRenderGroupManager();
+    std::array<BatchRenderGroupState, 2> initial_group_states;
+    for (size_t i = 0; i < initial_group_names.size(); ++i) {
+      initial_group_states[i] = target_render_group_manager->GetGroupState(initial_group_names[i]);
+    }
+    target_render_group_manager->SetGroupStates(render_group_manager);
+    for (size_t i = 0; i < initial_group_names.size(); ++i) {
+      target_render_group_manager->SetGroupState(initial_group_names[i], initial_group_states[i]);
+    }
+  }
+
+  RecordingBatcher batcher;
+  BatchRenderGroupStateManager render_group_manager;
+  PrimitiveAssembler primitive_assembler;
+  RecordingTextRenderer text_renderer;
+  // Of the batcher and the text renderer.
+  std::array<std::string, 2> initial_group_names;
+};
+
+}  // namespace
+
+// Defined here, as it uses PrimitiveRecording.
+struct CaptureViewElement::PrimitivesCache {
+  PrimitivesCache(const PrimitivesCacheKey& key, PrimitiveAssembler& target_primitive_assembler,
+                  TextRenderer& target_text_renderer)
+      : key(key), recording(target_primitive_assembler, target_text_renderer) {}
+
+  PrimitivesCacheKey key;
+  PrimitiveRecording recording;
+};
+
+CaptureViewElement::~CaptureViewElement() = default;
+
+uint64_t CaptureViewElement::GetExternalStateGeneration() const {
+  return parent_ != nullptr ? parent_->GetExternalStateGeneration() : 0;
+}
+
+CaptureViewElement::PrimitivesCacheKey CaptureViewElement::MakePrimitivesCacheKey(
+    uint64_t min_tick, uint64_t max_tick) const {
+  return PrimitivesCacheKey{min_tick,
+                            max_tick,
+                            viewport_->GetScreenWidth(),
+                            viewport_->GetScreenHeight(),
+                            viewport_->GetWorldWidth(),
+                            viewport_->GetWorldHeight(),
+                            GetExternalStateGeneration()};
+}
+
+void CaptureViewElement::UpdatePrimitivesUsingCache(PrimitiveAssembler& primitive_assembler,
+                                                    TextRenderer& text_renderer,
+                                                    uint64_t min_tick, uint64_t max_tick) {
+  const PrimitivesCacheKey key = MakePrimitivesCacheKey(min_tick, max_tick);
+  if (primitives_cache_ != nullptr && primitives_cache_->key == key) {
+    ++primitives_cache_statistics_.hits;
+  } else {
+    ++primitives_cache_statistics_.misses;
+    primitives_cache_ = std::make_unique<PrimitivesCache>(key, primitive_assembler, text_renderer);
+    PrimitiveRecording& recording = primitives_cache_->recording;
+    UpdatePrimitivesOfContent(recording.primitive_assembler, recording.text_renderer, min_tick,
+                              max_tick, PickingMode::kNone);
+  }
+  primitives_cache_->recording.CopyTo(primitive_assembler, text_renderer);
+}
+
+CaptureViewElement::PrimitivesCacheStatistics CaptureViewElement::GetPrimitivesCacheStatistics()
+    const {
+  PrimitivesCacheStatistics result = primitives_cache_statistics_;
+  for (const CaptureViewElement* child : GetAllChildren()) {
+    const PrimitivesCacheStatistics child_statistics = child->GetPrimitivesCacheStatistics();
+    result.hits += child_statistics.hits;
+    result.misses += child_statistics.misses;
+  }
+  return result;
 }
 
 CaptureViewElement::EventResult CaptureViewElement::OnMouseWheel(
@@ -10,10 +10,15 @@
 #include <memory>
 #include <vector>
 
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CaptureViewElementTester.h"
 #include "OrbitGl/CoreMath.h"
+#include "OrbitGl/Geometry.h"
+#include "OrbitGl/MockBatcher.h"
+#include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/StaticTimeGraphLayout.h"
+#include "OrbitGl/TextRenderer.h"
 #include "OrbitGl/TimeGraphLayout.h"
 #include "OrbitGl/Viewport.h"
 
@@ -86,6 +91,96 @@ class UnitTestCaptureViewContainerElement : public CaptureViewElementMock {
   std::vector<std::unique_ptr<CaptureViewElement>> children_;
 };
 
+// Adds a number of boxes and a label, like a track with timers.
+class UnitTestCaptureViewBoxesElement : public CaptureViewElementMock {
+ public:
+  explicit UnitTestCaptureViewBoxesElement(CaptureViewElement* parent, const Viewport* viewport,
+                                           const TimeGraphLayout* layout, int box_count)
+      : CaptureViewElementMock(parent, viewport, layout), box_count_(box_count) {}
+
+  [[nodiscard]] float GetHeight() const override { return kBoxesElementHeight; }
+
+  void SetCachesPrimitives(bool value) { caches_primitives_ = value; }
+  [[nodiscard]] int GetNumDoUpdatePrimitivesCalls() const {
+    return num_do_update_primitives_calls_;
+  }
+
+  static constexpr float kBoxesElementHeight = 4.f;
+
+ protected:
+  [[nodiscard]] bool CachesPrimitives() const override { return caches_primitives_; }
+
+  void DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler, TextRenderer& text_renderer,
+                          uint64_t /*min_tick*/, uint64_t /*max_tick*/,
+                          PickingMode /*picking_mode*/) override {
+    ++num_do_update_primitives_calls_;
+    const Color color(255, 0, 0, 255);
+    for (int i = 0; i < box_count_; ++i) {
+      const Vec2 pos(GetPos()[0] + static_cast<float>(i % 100), GetPos()[1]);
+      primitive_assembler.AddBox(MakeBox(pos, Vec2(1.f, GetHeight())), 0.f, color,
+                                 PickingUserData());
+    }
+    text_renderer.AddText("label", GetPos()[0], GetPos()[1], 0.f, {});
+  }
+
+ private:
+  int box_count_;
+  bool caches_primitives_ = false;
+  int num_do_update_primitives_calls_ = 0;
+};
+
+// Stacks UnitTestCaptureViewBoxesElements without margin.
+class UnitTestCaptureViewBoxesContainerElement : public CaptureViewElementMock {
+ public:
+  explicit UnitTestCaptureViewBoxesContainerElement(const Viewport* viewport,
+                                                    const TimeGraphLayout* layout,
+                                                    int children_to_create, int boxes_per_child)
+      : CaptureViewElementMock(nullptr, viewport, layout) {
+    for (int i = 0; i < children_to_create; ++i) {
+      children_.emplace_back(std::make_unique<UnitTestCaptureViewBoxesElement>(
+          this, viewport, layout, boxes_per_child));
+    }
+    SetWidth(viewport->GetWorldWidth());
+    UpdateLayout();
+  }
+
+  [[nodiscard]] float GetHeight() const override {
+    return static_cast<float>(children_.size()) *
+           UnitTestCaptureViewBoxesElement::kBoxesElementHeight;
+  }
+
+  [[nodiscard]] std::vector<CaptureViewElement*> GetAllChildren() const override {
+    std::vector<CaptureViewElement*> result;
+    for (const auto& child : children_) {
+      result.push_back(child.get());
+    }
+    return result;
+  };
+
+  [[nodiscard]] UnitTestCaptureViewBoxesElement* GetChild(int index) const {
+    return children_[index].get();
+  }
+
+  void SetExternalStateGeneration(uint64_t value) { external_state_generation_ = value; }
+
+ protected:
+  [[nodiscard]] uint64_t GetExternalStateGeneration() const override {
+    return external_state_generation_;
+  }
+
+  void DoUpdateLayout() override {
+    float current_y = GetPos()[1];
+    for (auto& child : GetAllChildren()) {
+      child->SetPos(0, current_y);
+      current_y += child->GetHeight();
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<UnitTestCaptureViewBoxesElement>> children_;
+  uint64_t external_state_generation_ = 0;
+};
+
 TEST(CaptureViewElementTesterTest, PassesAllTestsOnExistingElement) {
   constexpr int kChildCount = 2;
   CaptureViewElementTester tester;
@@ -251,4 +346,51 @@ TEST(CaptureViewElement, RequestUpdateBubblesUpAndIsClearedAfterDrawLoop) {
   // Finally: There shouldn't be any draws required after a render loop has happened
   tester.SimulateDrawLoopAndCheckFlags(&root, false, false);
 }
-}  // namespace orbit_gl
\ No newline at end of file
+
+TEST(CaptureViewElement, ReplaysCachedPrimitivesUntilTheyNeedAnUpdate) {
+  constexpr int kChildCount = 3;
+  constexpr int kBoxesPerChild = 10;
+  const Viewport viewport(1000, 1000);
+  CaptureViewElementTester tester;
+  UnitTestCaptureViewBoxesContainerElement container(&viewport, &kLayout, kChildCount,
+                                                     kBoxesPerChild);
+  for (int i = 0; i < kChildCount; ++i) {
+    container.GetChild(i)->SetCachesPrimitives(true);
+  }
+  const auto simulate_draw_loop_and_get_num_do_update_primitives_calls = [&]() {
+    tester.SimulateDrawLoop(&container, /*draw=*/false, /*update_primitives=*/true);
+    EXPECT_EQ(tester.GetBatcher().GetNumBoxes(), kChildCount * kBoxesPerChild);
+    EXPECT_EQ(tester.GetTextRenderer().GetNumAddTextCalls(), kChildCount);
+    std::vector<int> result;
+    for (int i = 0; i < kChildCount; ++i) {
+      result.push_back(container.GetChild(i)->GetNumDoUpdatePrimitivesCalls());
+    }
+    return result;
+  };
+
+  EXPECT_THAT(simulate_draw_loop_and_get_num_do_update_primitives_calls(),
+              testing::ElementsAre(1, 1, 1));
+  const std::vector<BatchRenderGroupId> render_groups =
+      tester.GetBatcher().GetNonEmptyRenderGroups();
+
+  EXPECT_THAT(simulate_draw_loop_and_get_num_do_update_primitives_calls(),
+              testing::ElementsAre(1, 1, 1));
+  EXPECT_EQ(tester.GetBatcher().GetNonEmptyRenderGroups(), render_groups);
+  EXPECT_TRUE(tester.GetBatcher().IsEverythingInsideRectangle(
+      Vec2(0, 0), Vec2(viewport.GetWorldWidth(), container.GetHeight())));
+
+  container.GetChild(1)->RequestUpdate();
+  EXPECT_THAT(simulate_draw_loop_and_get_num_do_update_primitives_calls(),
+              testing::ElementsAre(1, 2, 1));
+
+  container.SetExternalStateGeneration(1);
+  EXPECT_THAT(simulate_draw_loop_and_get_num_do_update_primitives_calls(),
+              testing::ElementsAre(2, 3, 2));
+
+  const CaptureViewElement::PrimitivesCacheStatistics statistics =
+      container.GetPrimitivesCacheStatistics();
+  EXPECT_EQ(statistics.hits, 5);
+  EXPECT_EQ(statistics.misses, 7);
+}
+
+}  // namespace orbit_gl
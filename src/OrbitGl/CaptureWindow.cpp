@@ -47,6 +47,7 @@
 #include "OrbitGl/GlUtils.h"
 #include "OrbitGl/OpenGlBatcher.h"
 #include "OrbitGl/OrbitApp.h"
+#include "OrbitGl/PickingIndex.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/QtTextRenderer.h"
@@ -176,6 +177,19 @@ void CaptureWindow::LeftUp() {
   }
 }
 
+std::optional<orbit_gl::PickedPrimitive> CaptureWindow::FindPickedPrimitive(Vec2 pos) const {
+  std::optional<orbit_gl::PickedPrimitive> picked = GlCanvas::FindPickedPrimitive(pos);
+  if (time_graph_ == nullptr) return picked;
+
+  std::optional<orbit_gl::PickedPrimitive> time_graph_picked =
+      time_graph_->FindPickedPrimitive(pos, render_group_manager_);
+  if (!time_graph_picked.has_value()) return picked;
+  if (!picked.has_value() || orbit_gl::IsDrawnBefore(*picked, *time_graph_picked)) {
+    return time_graph_picked;
+  }
+  return picked;
+}
+
 void CaptureWindow::HandlePickedElement(PickingMode picking_mode, PickingId picking_id, int x,
                                         int y) {
   // Early-out: This makes sure the timegraph was not deleted in between redraw and mouse click
@@ -211,7 +225,7 @@ void CaptureWindow::HandlePickedElement(PickingMode picking_mode, PickingId pick
       const orbit_gl::PickingUserData* user_data = batcher.GetUserData(picking_id);
 
       if (user_data && user_data->generate_tooltip_) {
-        tooltip = user_data->generate_tooltip_(picking_id);
+        tooltip = (*user_data->generate_tooltip_)(*user_data);
       }
     }
 
@@ -234,7 +248,10 @@ void CaptureWindow::SelectTimer(const TimerInfo* timer_info) {
 
 void CaptureWindow::PostRender(QPainter* painter) {
   if (picking_mode_ != PickingMode::kNone) {
-    RequestUpdatePrimitives();
+    // The primitives generated for picking have to be replaced, but tracks can replay the
+    // primitives they cached before.
+    redraw_requested_ = true;
+    if (time_graph_ != nullptr) time_graph_->RequestUpdate();
   }
 
   GlCanvas::PostRender(painter);
@@ -619,7 +636,7 @@ Batcher& CaptureWindow::GetBatcherById(BatcherId batcher_id) {
 void CaptureWindow::RequestUpdatePrimitives() {
   redraw_requested_ = true;
   if (time_graph_ == nullptr) return;
-  time_graph_->RequestUpdate();
+  time_graph_->RequestUpdateOfAllPrimitives();
 }
 
 [[nodiscard]] bool CaptureWindow::IsRedrawNeeded() const {
@@ -696,6 +713,12 @@ std::string CaptureWindow::GetPerformanceInfo() const {
   if (time_graph_ != nullptr) {
     AppendBatcherStatistics(performance_info, "TimeGraph",
                             time_graph_->GetBatcher().GetStatistics());
+    const orbit_gl::CaptureViewElement::PrimitivesCacheStatistics cache_statistics =
+        time_graph_->GetPrimitivesCacheStatistics();
+    absl::StrAppendFormat(&performance_info, "Track primitives cache hits: %d\n",
+                          cache_statistics.hits);
+    absl::StrAppendFormat(&performance_info, "Track primitives cache misses: %d\n",
+                          cache_statistics.misses);
   }
   AppendBatcherStatistics(performance_info, "UI", ui_batcher_.GetStatistics());
   return performance_info;
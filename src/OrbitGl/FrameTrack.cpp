@@ -26,6 +26,7 @@ using orbit_client_data::CaptureData;
 using orbit_client_data::FunctionInfo;
 using orbit_client_protos::TimerInfo;
 
+using orbit_gl::PickingUserData;
 using orbit_gl::PrimitiveAssembler;
 using orbit_gl::TextRenderer;
 
@@ -178,9 +179,8 @@ std::string FrameTrack::GetTooltip() const {
       orbit_display_formats::GetDisplayTime(absl::Nanoseconds(stats_.ComputeAverageTimeNs())));
 }
 
-std::string FrameTrack::GetBoxTooltip(const PrimitiveAssembler& primitive_assembler,
-                                      PickingId id) const {
-  const orbit_client_protos::TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
+std::string FrameTrack::GetBoxTooltip(const PickingUserData& user_data) const {
+  const orbit_client_protos::TimerInfo* timer_info = user_data.timer_info_;
   if (timer_info == nullptr) {
     return "";
   }
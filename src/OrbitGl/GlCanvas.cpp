@@ -10,9 +10,11 @@
 #include <QOpenGLFunctions>
 #include <array>
 #include <cstring>
+#include <optional>
 
 #include "ApiInterface/Orbit.h"
 #include "OrbitBase/Logging.h"
+#include "OrbitGl/PickingIndex.h"
 
 // TODO(b/227341686) z-values should not be of `float` type. E.g. make them `uint`.
 // Tracks: 0.0 - 0.1
@@ -199,8 +201,9 @@ void GlCanvas::Render(QPainter* painter, int width, int height) {
   text_renderer_.Init();
   text_renderer_.Clear();
 
-  // Reset picking manager before each draw.
-  picking_manager_.Reset();
+  // Pickables keep their ids between draws, as they are stored in the primitives that are kept or
+  // cached between draws.
+  picking_manager_.RemoveExpiredPickables();
 
   Draw(painter);
 
@@ -221,7 +224,10 @@ void GlCanvas::PreRender() {
   }
 
   if (is_mouse_over_ && can_hover_ && hover_timer_.ElapsedMillis() > hover_delay_ms_) {
-    SetPickingMode(PickingMode::kHover);
+    // Hovering is resolved on the primitives of the last draw, which are the ones on screen, so it
+    // doesn't need a picking pass or a redraw.
+    can_hover_ = false;
+    PickFromIndex(PickingMode::kHover, mouse_move_pos_screen_[0], mouse_move_pos_screen_[1]);
   }
 }
 
@@ -229,10 +235,6 @@ void GlCanvas::PostRender(QPainter* painter) {
   PickingMode prev_picking_mode = picking_mode_;
   picking_mode_ = PickingMode::kNone;
 
-  if (prev_picking_mode == PickingMode::kHover) {
-    can_hover_ = false;
-  }
-
   if (!draw_as_if_picking_ && prev_picking_mode != PickingMode::kNone) {
     Pick(prev_picking_mode, mouse_move_pos_screen_[0], mouse_move_pos_screen_[1]);
     GlCanvas::Render(painter, viewport_.GetScreenWidth(), viewport_.GetScreenHeight());
@@ -261,3 +263,16 @@ void GlCanvas::Pick(PickingMode picking_mode, int x, int y) {
 
   HandlePickedElement(picking_mode, pick_id, x, y);
 }
+
+std::optional<orbit_gl::PickedPrimitive> GlCanvas::FindPickedPrimitive(Vec2 pos) const {
+  return ui_batcher_.FindPickedPrimitive(pos, render_group_manager_);
+}
+
+void GlCanvas::PickFromIndex(PickingMode picking_mode, int x, int y) {
+  std::optional<orbit_gl::PickedPrimitive> picked =
+      FindPickedPrimitive(viewport_.ScreenToWorld(Vec2i(x, y)));
+  // Nothing pickable is the same as the cleared background of a picking pass.
+  PickingId pick_id = picked.has_value() ? picked->id : PickingId::FromPixelValue(0);
+
+  HandlePickedElement(picking_mode, pick_id, x, y);
+}
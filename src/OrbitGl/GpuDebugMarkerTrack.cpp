@@ -14,14 +14,14 @@
 #include "ClientProtos/capture_data.pb.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitBase/Logging.h"
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/GlUtils.h"
 #include "OrbitGl/OrbitApp.h"
-#include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/TimeGraph.h"
 #include "OrbitGl/TimeGraphLayout.h"
 
 using orbit_client_protos::TimerInfo;
-using orbit_gl::PrimitiveAssembler;
+using orbit_gl::PickingUserData;
 
 GpuDebugMarkerTrack::GpuDebugMarkerTrack(CaptureViewElement* parent,
                                          const orbit_gl::TimelineInfoInterface* timeline_info,
@@ -81,9 +81,8 @@ std::string GpuDebugMarkerTrack::GetTimesliceText(const TimerInfo& timer_info) c
                          time);
 }
 
-std::string GpuDebugMarkerTrack::GetBoxTooltip(const PrimitiveAssembler& primitive_assembler,
-                                               PickingId id) const {
-  const TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
+std::string GpuDebugMarkerTrack::GetBoxTooltip(const PickingUserData& user_data) const {
+  const TimerInfo* timer_info = user_data.timer_info_;
   if (timer_info == nullptr) {
     return "";
   }
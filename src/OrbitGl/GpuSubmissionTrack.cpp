@@ -15,15 +15,15 @@
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/ThreadConstants.h"
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/GlUtils.h"
 #include "OrbitGl/OrbitApp.h"
-#include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/ThreadColor.h"
 #include "OrbitGl/TimeGraphLayout.h"
 
 using orbit_client_data::TimerChain;
 using orbit_client_protos::TimerInfo;
-using orbit_gl::PrimitiveAssembler;
+using orbit_gl::PickingUserData;
 
 constexpr const char* kSwQueueString = "sw queue";
 constexpr const char* kHwQueueString = "hw queue";
@@ -202,9 +202,8 @@ const TimerInfo* GpuSubmissionTrack::GetRight(const TimerInfo& timer_info) const
   return nullptr;
 }
 
-std::string GpuSubmissionTrack::GetBoxTooltip(const PrimitiveAssembler& primitive_assembler,
-                                              PickingId id) const {
-  const TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
+std::string GpuSubmissionTrack::GetBoxTooltip(const PickingUserData& user_data) const {
+  const TimerInfo* timer_info = user_data.timer_info_;
   if ((timer_info == nullptr) || timer_info->type() == TimerInfo::kCoreActivity) {
     return "";
   }
@@ -48,6 +48,10 @@ GraphTrack::GraphTrack(CaptureViewElement* parent,
                        const orbit_client_data::CaptureData* capture_data)
     : Track(parent, timeline_info, viewport, layout, module_manager, capture_data),
       series_{std::move(series_names), series_value_decimal_digits, std::move(series_value_units)} {
+  for (size_t i = 0; i < GetDimension(); ++i) {
+    legend_tooltip_callbacks_.emplace_back(
+        [this, i](const PickingUserData& /*user_data*/) { return GetLegendTooltips(i); });
+  }
 }
 
 bool GraphTrack::HasLegend() const { return !IsCollapsed() && GetDimension() > 1; }
@@ -234,8 +238,7 @@ void GraphTrack::DrawLegend(PrimitiveAssembler& primitive_assembler, TextRendere
 
     text_renderer.AddText(series_names.at(i).c_str(), x0, y0 + legend_symbol_height / 2.f, text_z,
                           formatting);
-    auto user_data = std::make_unique<PickingUserData>(
-        nullptr, [this, i](PickingId /*id*/) { return GetLegendTooltips(i); });
+    PickingUserData user_data(nullptr, &legend_tooltip_callbacks_[i]);
     primitive_assembler.AddShadedBox(Vec2(x0, y0), legend_text_box_size, text_z, fully_transparent,
                                      std::move(user_data));
 
@@ -10,6 +10,8 @@
 
 #include <QOpenGLFunctions>
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <utility>
 
 #include "Introspection/Introspection.h"
@@ -24,6 +26,7 @@ void OpenGlBatcher::ResetElements() {
   for (auto& [unused_group_id, buffer] : primitive_buffers_by_group_) {
     buffer.Reset();
   }
+  user_data_indices_.clear();
   user_data_.clear();
   ORBIT_CHECK(translations_.IsEmpty());
   current_render_group_ = BatchRenderGroupId();
@@ -37,7 +40,7 @@ static void MoveLineToPixelCenterIfHorizontal(Line& line) {
 
 void OpenGlBatcher::AddLine(Vec2 from, Vec2 to, float z, const Color& color,
                             const Color& picking_color,
-                            std::unique_ptr<PickingUserData> user_data) {
+                            std::optional<PickingUserData> user_data) {
   Line line;
   LayeredVec2 translated_start_with_z =
       translations_.TranslateXYZAndFloorXY({{from[0], from[1]}, z});
@@ -54,11 +57,11 @@ void OpenGlBatcher::AddLine(Vec2 from, Vec2 to, float z, const Color& color,
   buffer.line_buffer.lines_.emplace_back(line);
   buffer.line_buffer.colors_.push_back_n(color, 2);
   buffer.line_buffer.picking_colors_.push_back_n(picking_color, 2);
-  user_data_.push_back(std::move(user_data));
+  AddUserData(std::move(user_data));
 }
 
 void OpenGlBatcher::AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
-                           const Color& picking_color, std::unique_ptr<PickingUserData> user_data) {
+                           const Color& picking_color, std::optional<PickingUserData> user_data) {
   Quad rounded_box = box;
   float layer_z_value{};
   for (size_t v = 0; v < 4; ++v) {
@@ -72,12 +75,12 @@ void OpenGlBatcher::AddBox(const Quad& box, float z, const std::array<Color, 4>&
   buffer.box_buffer.boxes_.emplace_back(rounded_box);
   buffer.box_buffer.colors_.push_back(colors);
   buffer.box_buffer.picking_colors_.push_back_n(picking_color, 4);
-  user_data_.push_back(std::move(user_data));
+  AddUserData(std::move(user_data));
 }
 
 void OpenGlBatcher::AddTriangle(const Triangle& triangle, float z,
                                 const std::array<Color, 3>& colors, const Color& picking_color,
-                                std::unique_ptr<PickingUserData> user_data) {
+                                std::optional<PickingUserData> user_data) {
   Triangle rounded_tri = triangle;
   float layer_z_value{};
   for (auto& vertex : rounded_tri.vertices) {
@@ -91,7 +94,16 @@ void OpenGlBatcher::AddTriangle(const Triangle& triangle, float z,
   buffer.triangle_buffer.triangles_.emplace_back(rounded_tri);
   buffer.triangle_buffer.colors_.push_back(colors);
   buffer.triangle_buffer.picking_colors_.push_back_n(picking_color, 3);
-  user_data_.push_back(std::move(user_data));
+  AddUserData(std::move(user_data));
+}
+
+void OpenGlBatcher::AddUserData(std::optional<PickingUserData> user_data) {
+  if (!user_data.has_value()) {
+    user_data_indices_.push_back(kNoUserData);
+    return;
+  }
+  user_data_indices_.push_back(user_data_.size());
+  user_data_.push_back(std::move(*user_data));
 }
 
 [[nodiscard]] std::vector<BatchRenderGroupId> OpenGlBatcher::GetNonEmptyRenderGroups() const {
@@ -194,6 +206,114 @@ void OpenGlBatcher::DrawTriangleBuffer(const BatchRenderGroupId& group, bool pic
   }
 }
 
+namespace {
+
+// Calls `callback` with the position in the buffer, the primitive and the picking color of each
+// primitive of a buffer.
+template <uint32_t kColorsPerPrimitive, typename Primitive, uint32_t kBlockSize,
+          typename Callback>
+void ForEachPrimitive(
+    const orbit_containers::BlockChain<Primitive, kBlockSize>& primitives,
+    const orbit_containers::BlockChain<Color, kColorsPerPrimitive * kBlockSize>& picking_colors,
+    Callback&& callback) {
+  const orbit_containers::Block<Primitive, kBlockSize>* primitive_block = primitives.root();
+  const orbit_containers::Block<Color, kColorsPerPrimitive * kBlockSize>* color_block =
+      picking_colors.root();
+  uint32_t position = 0;
+  while (primitive_block != nullptr) {
+    for (uint32_t i = 0; i < primitive_block->size(); ++i) {
+      callback(position++, primitive_block->data()[i],
+               color_block->data()[i * kColorsPerPrimitive]);
+    }
+    primitive_block = primitive_block->next();
+    color_block = color_block->next();
+  }
+}
+
+template <size_t kNumVertices>
+std::pair<Vec2, Vec2> GetBoundingBox(const std::array<Vec2, kNumVertices>& vertices) {
+  Vec2 min = vertices[0];
+  Vec2 max = vertices[0];
+  for (const Vec2& vertex : vertices) {
+    min = Vec2(std::min(min[0], vertex[0]), std::min(min[1], vertex[1]));
+    max = Vec2(std::max(max[0], vertex[0]), std::max(max[1], vertex[1]));
+  }
+  return {min, max};
+}
+
+std::pair<Vec2, Vec2> GetPickingBoundingBox(const Quad& box) {
+  return GetBoundingBox(box.vertices);
+}
+
+// A line covers the pixels it passes through, so its bounding box is extended by one pixel.
+std::pair<Vec2, Vec2> GetPickingBoundingBox(const Line& line) {
+  auto [min, max] = GetBoundingBox(std::array<Vec2, 2>{line.start_point, line.end_point});
+  return {Vec2(std::floor(min[0]), std::floor(min[1])),
+          Vec2(std::floor(max[0]) + 1.f, std::floor(max[1]) + 1.f)};
+}
+
+// Triangles are picked by their bounding box. They are only used for small elements and for the
+// slanted sides of timers, so this is off by a few pixels at most.
+std::pair<Vec2, Vec2> GetPickingBoundingBox(const Triangle& triangle) {
+  return GetBoundingBox(triangle.vertices);
+}
+
+}  // namespace
+
+bool OpenGlBatcher::IsPickable(PickingId id) const {
+  // Other primitives can't be picked, so they don't need to be found. Elements leave decorations
+  // that would cover pickable primitives out of picking passes anyway.
+  if (id.type == PickingType::kPickable) return true;
+  return id.element_id < user_data_indices_.size() &&
+         user_data_indices_[id.element_id] != kNoUserData;
+}
+
+void OpenGlBatcher::UpdatePickingIndex(const orbit_gl_internal::PrimitiveBuffers& buffers) const {
+  const size_t num_primitives = buffers.GetNumPrimitives();
+  if (buffers.num_primitives_in_picking_index == num_primitives) return;
+  ORBIT_SCOPE_FUNCTION;
+
+  PickingIndex& picking_index = buffers.picking_index;
+  picking_index.Clear();
+  const auto add = [&](PrimitiveOrder primitive_order) {
+    return [&, primitive_order](uint32_t position, const auto& primitive,
+                                const Color& picking_color) {
+      const PickingId id = PickingId::FromColor(picking_color);
+      if (!IsPickable(id)) return;
+      auto [min, max] = GetPickingBoundingBox(primitive);
+      picking_index.Add(static_cast<uint64_t>(primitive_order) << 32 | position, min, max, id);
+    };
+  };
+  ForEachPrimitive<4>(buffers.box_buffer.boxes_, buffers.box_buffer.picking_colors_,
+                      add(PrimitiveOrder::kBox));
+  ForEachPrimitive<2>(buffers.line_buffer.lines_, buffers.line_buffer.picking_colors_,
+                      add(PrimitiveOrder::kLine));
+  ForEachPrimitive<3>(buffers.triangle_buffer.triangles_, buffers.triangle_buffer.picking_colors_,
+                      add(PrimitiveOrder::kTriangle));
+  picking_index.Finalize();
+  buffers.num_primitives_in_picking_index = num_primitives;
+}
+
+std::optional<PickedPrimitive> OpenGlBatcher::FindPickedPrimitive(
+    Vec2 pos, const BatchRenderGroupStateManager& manager) const {
+  std::optional<PickedPrimitive> result;
+  for (const auto& [group, buffers] : primitive_buffers_by_group_) {
+    const StencilConfig stencil = manager.GetGroupState(group.name).stencil;
+    if (stencil.enabled &&
+        (pos[0] < stencil.pos[0] || pos[0] >= stencil.pos[0] + stencil.size[0] ||
+         pos[1] < stencil.pos[1] || pos[1] >= stencil.pos[1] + stencil.size[1])) {
+      continue;
+    }
+
+    UpdatePickingIndex(buffers);
+    std::optional<PickingIndex::Hit> hit = buffers.picking_index.Find(pos);
+    if (!hit.has_value()) continue;
+    PickedPrimitive picked{hit->id, group, hit->order};
+    if (!result.has_value() || IsDrawnBefore(*result, picked)) result = std::move(picked);
+  }
+  return result;
+}
+
 const PickingUserData* OpenGlBatcher::GetUserData(PickingId id) const {
   ORBIT_CHECK(id.element_id >= 0);
   ORBIT_CHECK(id.batcher_id == GetBatcherId());
@@ -204,8 +324,9 @@ const PickingUserData* OpenGlBatcher::GetUserData(PickingId id) const {
     case PickingType::kBox:
     case PickingType::kTriangle:
     case PickingType::kLine:
-      ORBIT_CHECK(id.element_id < user_data_.size());
-      return user_data_[id.element_id].get();
+      ORBIT_CHECK(id.element_id < user_data_indices_.size());
+      if (user_data_indices_[id.element_id] == kNoUserData) return nullptr;
+      return &user_data_[user_data_indices_[id.element_id]];
     case PickingType::kPickable:
       return nullptr;
     case PickingType::kCount:
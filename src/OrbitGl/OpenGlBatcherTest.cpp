@@ -4,23 +4,32 @@
 
 #include <GteVector.h>
 #include <absl/container/flat_hash_map.h>
+#include <absl/strings/str_format.h>
+#include <absl/time/clock.h>
+#include <absl/time/time.h>
 #include <gtest/gtest.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include <algorithm>
 #include <memory>
+#include <optional>
+#include <random>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "ClientProtos/capture_data.pb.h"
 #include "Containers/BlockChain.h"
+#include "OrbitBase/Logging.h"
 #include "OrbitGl/BatchRenderGroup.h"
 #include "OrbitGl/Batcher.h"
 #include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/Geometry.h"
 #include "OrbitGl/OpenGlBatcher.h"
+#include "OrbitGl/PickingIndex.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PickingManagerTest.h"
 
@@ -38,17 +47,17 @@ class FakeOpenGlBatcher : public OpenGlBatcher {
 
   // Auxiliary methods to simplify the addition of lines, boxes and triangles.
   void AddLineHelper(const Vec2& from, const Vec2& to, float z, const Color& color,
-                     std::unique_ptr<PickingUserData> user_data = nullptr) {
+                     std::optional<PickingUserData> user_data = std::nullopt) {
     Color picking_color = PickingId::ToColor(PickingType::kLine, GetNumElements(), GetBatcherId());
     return AddLine(from, to, z, color, picking_color, std::move(user_data));
   }
   void AddBoxHelper(const Quad& box, float z, const Color& color,
-                    std::unique_ptr<PickingUserData> user_data = nullptr) {
+                    std::optional<PickingUserData> user_data = std::nullopt) {
     Color picking_color = PickingId::ToColor(PickingType::kBox, GetNumElements(), GetBatcherId());
     return AddBox(box, z, {color, color, color, color}, picking_color, std::move(user_data));
   }
   void AddTriangleHelper(const Triangle& triangle, float z, const Color& color,
-                         std::unique_ptr<PickingUserData> user_data = nullptr) {
+                         std::optional<PickingUserData> user_data = std::nullopt) {
     Color picking_color =
         PickingId::ToColor(PickingType::kTriangle, GetNumElements(), GetBatcherId());
     return AddTriangle(triangle, z, {color, color, color}, picking_color, std::move(user_data));
@@ -162,16 +171,16 @@ TEST(OpenGlBatcher, PickingSimpleElements) {
   EXPECT_EQ(batcher.GetBatcherId(), BatcherId::kUi);
 
   std::string line_custom_data = "line custom data";
-  auto line_user_data = std::make_unique<PickingUserData>();
-  line_user_data->custom_data_ = &line_custom_data;
+  PickingUserData line_user_data;
+  line_user_data.custom_data_ = &line_custom_data;
 
   std::string triangle_custom_data = "triangle custom data";
-  auto triangle_user_data = std::make_unique<PickingUserData>();
-  triangle_user_data->custom_data_ = &triangle_custom_data;
+  PickingUserData triangle_user_data;
+  triangle_user_data.custom_data_ = &triangle_custom_data;
 
   std::string box_custom_data = "box custom data";
-  auto box_user_data = std::make_unique<PickingUserData>();
-  box_user_data->custom_data_ = &box_custom_data;
+  PickingUserData box_user_data;
+  box_user_data.custom_data_ = &box_custom_data;
 
   batcher.AddLineHelper(Vec2(0, 0), Vec2(1, 0), 0, Color(255, 255, 255, 255),
                         std::move(line_user_data));
@@ -193,16 +202,16 @@ TEST(OpenGlBatcher, MultipleDrawCalls) {
   FakeOpenGlBatcher batcher(BatcherId::kUi);
 
   std::string line_custom_data = "line custom data";
-  auto line_user_data = std::make_unique<PickingUserData>();
-  line_user_data->custom_data_ = &line_custom_data;
+  PickingUserData line_user_data;
+  line_user_data.custom_data_ = &line_custom_data;
 
   std::string triangle_custom_data = "triangle custom data";
-  auto triangle_user_data = std::make_unique<PickingUserData>();
-  triangle_user_data->custom_data_ = &triangle_custom_data;
+  PickingUserData triangle_user_data;
+  triangle_user_data.custom_data_ = &triangle_custom_data;
 
   std::string box_custom_data = "box custom data";
-  auto box_user_data = std::make_unique<PickingUserData>();
-  box_user_data->custom_data_ = &box_custom_data;
+  PickingUserData box_user_data;
+  box_user_data.custom_data_ = &box_custom_data;
 
   batcher.AddLineHelper(Vec2(0, 0), Vec2(1, 0), 0, Color(255, 255, 255, 255),
                         std::move(line_user_data));
@@ -329,4 +338,216 @@ TEST(OpenGlBatcher, StatisticsAreReportedCorrectly) {
   EXPECT_EQ(expected_statistics, batcher.GetStatistics());
 }
 
+TEST(OpenGlBatcher, ElementsWithoutUserDataHaveNoUserData) {
+  FakeOpenGlBatcher batcher(BatcherId::kUi);
+
+  std::string box_custom_data = "box custom data";
+  PickingUserData box_user_data;
+  box_user_data.custom_data_ = &box_custom_data;
+
+  batcher.AddLineHelper(Vec2(0, 0), Vec2(1, 0), 0, Color(255, 255, 255, 255));
+  batcher.AddBoxHelper(MakeBox(Vec2(0, 0), Vec2(1, 1)), 0, Color(255, 0, 0, 255),
+                       std::move(box_user_data));
+  batcher.AddTriangleHelper(Triangle(Vec2(0, 0), Vec2(0, 1), Vec2(1, 0)), 0, Color(0, 255, 0, 255));
+  EXPECT_EQ(batcher.GetNumElements(), 3);
+
+  for (const auto& group : batcher.GetNonEmptyRenderGroups()) {
+    batcher.DrawRenderGroup(group, true);
+  }
+
+  EXPECT_EQ(batcher.GetUserData(MockRenderPickingColor(batcher.GetDrawnLineColors()[0])), nullptr);
+  EXPECT_EQ(batcher.GetUserData(MockRenderPickingColor(batcher.GetDrawnTriangleColors()[0])),
+            nullptr);
+  ExpectCustomDataEq(batcher, batcher.GetDrawnBoxColors()[0], box_custom_data);
+}
+
+TEST(OpenGlBatcher, PickingIndexFindsPrimitivesWithUserDataAndPickables) {
+  FakeOpenGlBatcher batcher(BatcherId::kUi);
+  PickingManager picking_manager;
+  const BatchRenderGroupStateManager manager;
+  const Color color(255, 0, 0, 255);
+
+  std::string custom_data = "custom data";
+  PickingUserData user_data;
+  user_data.custom_data_ = &custom_data;
+  batcher.AddBoxHelper(MakeBox(Vec2(0, 0), Vec2(10, 10)), 0, color);
+  batcher.AddBoxHelper(MakeBox(Vec2(10, 0), Vec2(10, 10)), 0, color, user_data);
+  // Primitives without user data don't hide the ones below.
+  batcher.AddBoxHelper(MakeBox(Vec2(10, 0), Vec2(10, 10)), 1, color);
+  batcher.AddLineHelper(Vec2(30, 0), Vec2(30, 10), 0, color, user_data);
+  auto pickable = std::make_shared<PickableMock>();
+  batcher.AddBox(MakeBox(Vec2(40, 0), Vec2(10, 10)), 0, {color, color, color, color},
+                 picking_manager.GetPickableColor(pickable, BatcherId::kUi));
+
+  EXPECT_FALSE(batcher.FindPickedPrimitive(Vec2(5, 5), manager).has_value());
+
+  std::optional<PickedPrimitive> box = batcher.FindPickedPrimitive(Vec2(15, 5), manager);
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(box->id.type, PickingType::kBox);
+  EXPECT_EQ(box->id.batcher_id, BatcherId::kUi);
+  ASSERT_NE(batcher.GetUserData(box->id), nullptr);
+  EXPECT_EQ(batcher.GetUserData(box->id)->custom_data_, &custom_data);
+
+  std::optional<PickedPrimitive> line = batcher.FindPickedPrimitive(Vec2(30, 5), manager);
+  ASSERT_TRUE(line.has_value());
+  EXPECT_EQ(line->id.type, PickingType::kLine);
+  EXPECT_FALSE(batcher.FindPickedPrimitive(Vec2(31, 5), manager).has_value());
+
+  std::optional<PickedPrimitive> pickable_box = batcher.FindPickedPrimitive(Vec2(45, 5), manager);
+  ASSERT_TRUE(pickable_box.has_value());
+  EXPECT_EQ(pickable_box->id.type, PickingType::kPickable);
+  EXPECT_EQ(picking_manager.GetPickableFromId(pickable_box->id), pickable);
+
+  batcher.ResetElements();
+  EXPECT_FALSE(batcher.FindPickedPrimitive(Vec2(15, 5), manager).has_value());
+}
+
+TEST(OpenGlBatcher, FindPickedPrimitiveRespectsRenderGroupsAndStencils) {
+  FakeOpenGlBatcher batcher(BatcherId::kTimeGraph);
+  const Color color(255, 0, 0, 255);
+  const std::string clipped_group_name = "clipped";
+
+  batcher.SetCurrentRenderGroupName(clipped_group_name);
+  batcher.AddBoxHelper(MakeBox(Vec2(0, 0), Vec2(100, 100)), 0.5f, color, PickingUserData());
+  // Added later, but drawn first, as its render group is on a lower layer.
+  batcher.SetCurrentRenderGroupName(std::string(BatchRenderGroupId::kGlobalGroup));
+  batcher.AddBoxHelper(MakeBox(Vec2(0, 0), Vec2(100, 100)), 0.f, color, PickingUserData());
+
+  BatchRenderGroupStateManager manager;
+  EXPECT_EQ(batcher.FindPickedPrimitive(Vec2(50, 50), manager)->id.element_id, 0);
+
+  BatchRenderGroupState state;
+  state.stencil.enabled = true;
+  state.stencil.pos = Vec2(10, 10);
+  state.stencil.size = Vec2(20, 20);
+  manager.SetGroupState(clipped_group_name, state);
+  EXPECT_EQ(batcher.FindPickedPrimitive(Vec2(20, 20), manager)->id.element_id, 0);
+  EXPECT_EQ(batcher.FindPickedPrimitive(Vec2(50, 50), manager)->id.element_id, 1);
+}
+
+// Not a real benchmark, but it logs how many boxes with user data, as added for each visible timer,
+// the batcher takes per second. Start the test binary with
+// `--gtest_filter=OpenGlBatcher.DISABLED_AddBoxesWithUserDataPerSecond
+// --gtest_also_run_disabled_tests` to run it.
+TEST(OpenGlBatcher, DISABLED_AddBoxesWithUserDataPerSecond) {
+  constexpr int kNumBoxes = 100'000;
+  constexpr int kIterations = 10;
+  FakeOpenGlBatcher batcher(BatcherId::kTimeGraph);
+  const orbit_client_protos::TimerInfo timer_info;
+  const PickingUserData::TooltipCallback tooltip_callback =
+      [](const PickingUserData& user_data) { return user_data.timer_info_->DebugString(); };
+  absl::Duration duration;
+  for (int i = 0; i < kIterations; ++i) {
+    batcher.ResetElements();
+    const absl::Time start = absl::Now();
+    for (int box = 0; box < kNumBoxes; ++box) {
+      batcher.AddBoxHelper(MakeBox(Vec2(box, 0), Vec2(1, 1)), 0, Color(255, 0, 0, 255),
+                           PickingUserData(&timer_info, &tooltip_callback));
+    }
+    duration += absl::Now() - start;
+  }
+  EXPECT_EQ(batcher.GetNumElements(), kNumBoxes);
+  ORBIT_LOG("%.1f million boxes per second",
+            kNumBoxes * kIterations / absl::ToDoubleSeconds(duration) / 1e6);
+}
+
+TEST(OpenGlBatcher, FindPickedPrimitiveFindsTimersOfClippedTracks) {
+  constexpr int kNumTracks = 3;
+  constexpr int kNumDepths = 2;
+  constexpr int kNumTimersPerDepth = 5;
+  constexpr float kTrackHeight = kNumDepths * 20.f;
+  FakeOpenGlBatcher batcher(BatcherId::kTimeGraph);
+  BatchRenderGroupStateManager manager;
+  const Color color(255, 0, 0, 255);
+  std::vector<std::string> group_names;
+  for (int track = 0; track < kNumTracks; ++track) {
+    const std::string& group_name = group_names.emplace_back(absl::StrFormat("track %d", track));
+    BatchRenderGroupState state;
+    state.stencil.enabled = true;
+    state.stencil.pos = Vec2(0, track * kTrackHeight);
+    // The last timer of each depth is clipped.
+    state.stencil.size = Vec2((kNumTimersPerDepth - 1) * 2, kTrackHeight);
+    manager.SetGroupState(group_name, state);
+    batcher.SetCurrentRenderGroupName(group_name);
+    for (int depth = 0; depth < kNumDepths; ++depth) {
+      const float y = track * kTrackHeight + depth * 20;
+      for (int timer = 0; timer < kNumTimersPerDepth; ++timer) {
+        batcher.AddBoxHelper(MakeBox(Vec2(timer * 2, y), Vec2(1, 19)), 0, color, PickingUserData());
+      }
+    }
+  }
+
+  int num_hits = 0;
+  for (int x = 0; x < kNumTimersPerDepth * 2; ++x) {
+    for (int y = 0; y < kNumTracks * kTrackHeight; ++y) {
+      std::optional<PickedPrimitive> picked =
+          batcher.FindPickedPrimitive(Vec2(x + 0.5f, y + 0.5f), manager);
+      if (!picked.has_value()) continue;
+      ++num_hits;
+      const int track = static_cast<int>(y / kTrackHeight);
+      const int depth = static_cast<int>((y - track * kTrackHeight) / 20);
+      EXPECT_EQ(picked->group.name, group_names[track]);
+      EXPECT_EQ(picked->id.element_id,
+                (track * kNumDepths + depth) * kNumTimersPerDepth + x / 2);
+    }
+  }
+  // Each timer covers 1 x 19 pixels, and the last timer of each depth is clipped.
+  EXPECT_EQ(num_hits, kNumTracks * kNumDepths * (kNumTimersPerDepth - 1) * 19);
+}
+
+// Not a real benchmark either, but it logs how long finding the hovered timer takes in a capture
+// with many visible timers, each track being in a clipped render group of its own. Start the test
+// binary with `--gtest_filter=OpenGlBatcher.DISABLED_HoverLatency --gtest_also_run_disabled_tests`
+// to run it.
+TEST(OpenGlBatcher, DISABLED_HoverLatency) {
+  constexpr int kNumTracks = 50;
+  constexpr int kNumDepths = 10;
+  constexpr int kNumTimersPerDepth = 2000;
+  constexpr float kTrackHeight = kNumDepths * 20.f;
+  constexpr int kNumHovers = 10'000;
+  FakeOpenGlBatcher batcher(BatcherId::kTimeGraph);
+  BatchRenderGroupStateManager manager;
+  const Color color(255, 0, 0, 255);
+  for (int track = 0; track < kNumTracks; ++track) {
+    const std::string group_name = absl::StrFormat("track %d", track);
+    BatchRenderGroupState state;
+    state.stencil.enabled = true;
+    state.stencil.pos = Vec2(0, track * kTrackHeight);
+    state.stencil.size = Vec2(kNumTimersPerDepth * 2, kTrackHeight);
+    manager.SetGroupState(group_name, state);
+    batcher.SetCurrentRenderGroupName(group_name);
+    for (int depth = 0; depth < kNumDepths; ++depth) {
+      const float y = track * kTrackHeight + depth * 20;
+      for (int timer = 0; timer < kNumTimersPerDepth; ++timer) {
+        batcher.AddBoxHelper(MakeBox(Vec2(timer * 2, y), Vec2(1, 19)), 0, color, PickingUserData());
+      }
+    }
+  }
+
+  std::mt19937 random_engine(42);
+  std::uniform_real_distribution<float> x_distribution(0, kNumTimersPerDepth * 2);
+  std::uniform_real_distribution<float> y_distribution(0, kNumTracks * kTrackHeight);
+  // The picking index of a track is filled by the first hover over it, so that the tracks are
+  // first hovered once each.
+  const absl::Time fill_start = absl::Now();
+  for (int track = 0; track < kNumTracks; ++track) {
+    std::ignore = batcher.FindPickedPrimitive(Vec2(0, track * kTrackHeight), manager);
+  }
+  const absl::Duration fill_duration = absl::Now() - fill_start;
+
+  int num_hits = 0;
+  const absl::Time start = absl::Now();
+  for (int i = 0; i < kNumHovers; ++i) {
+    const Vec2 pos(x_distribution(random_engine), y_distribution(random_engine));
+    if (batcher.FindPickedPrimitive(pos, manager).has_value()) ++num_hits;
+  }
+  const absl::Duration duration = absl::Now() - start;
+  EXPECT_GT(num_hits, 0);
+  EXPECT_LT(num_hits, kNumHovers);
+  ORBIT_LOG("%.2f us per hover among %d timers, after %.2f us to fill the index of each track",
+            absl::ToDoubleMicroseconds(duration) / kNumHovers,
+            kNumTracks * kNumDepths * kNumTimersPerDepth,
+            absl::ToDoubleMicroseconds(fill_duration) / kNumTracks);
+}
+
 }  // namespace orbit_gl
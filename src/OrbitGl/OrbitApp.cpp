@@ -49,6 +49,7 @@
 #include "CaptureFile/CaptureFileHelpers.h"
 #include "ClientData/CallstackData.h"
 #include "ClientData/CallstackType.h"
+#include "ClientData/CompactTimerChain.h"
 #include "ClientData/ModuleData.h"
 #include "ClientData/ModuleIdentifier.h"
 #include "ClientData/ModuleInMemory.h"
@@ -142,8 +143,7 @@ using orbit_client_data::ScopeStats;
 using orbit_client_data::ThreadID;
 using orbit_client_data::ThreadStateSliceInfo;
 using orbit_client_data::TimeRange;
-using orbit_client_data::TimerBlock;
-using orbit_client_data::TimerChain;
+using orbit_client_data::TimerView;
 using orbit_client_data::TracepointInfoSet;
 using orbit_client_data::UserDefinedCaptureData;
 
@@ -1385,6 +1385,9 @@ void OrbitApp::StartCapture() {
       std::move(absolute_address_to_size_of_functions_to_stop_unwinding_at);
   options.process_id = process->pid();
   options.record_return_values = absl::GetFlag(FLAGS_show_return_values);
+  options.capture_stream_compression = absl::GetFlag(FLAGS_compress_capture_stream)
+                                           ? CaptureOptions::kCaptureStreamZlib
+                                           : CaptureOptions::kCaptureStreamNoCompression;
   options.record_arguments = false;
   options.enable_auto_frame_track = data_manager_->enable_auto_frame_track();
   options.thread_state_change_callstack_collection =
@@ -2242,7 +2245,8 @@ std::optional<ThreadStateSliceInfo> OrbitApp::hovered_thread_state_slice() const
 
 void OrbitApp::set_hovered_thread_state_slice(
     std::optional<ThreadStateSliceInfo> thread_state_slice) {
-  RequestUpdatePrimitives();
+  // Only the hovered ThreadStateBar draws the slice differently, and it requests its own update.
+  // This keeps the primitives that the other tracks cached.
   data_manager_->set_hovered_thread_state_slice(thread_state_slice);
 }
 
@@ -2630,20 +2634,14 @@ void OrbitApp::AddFrameTrackTimers(uint64_t instrumented_function_id) {
     return;
   }
 
-  std::vector<const TimerChain*> chains = GetMutableTimeGraph()->GetAllThreadTrackTimerChains();
-
   std::vector<uint64_t> all_start_times;
-
-  for (const TimerChain* chain : chains) {
-    for (const TimerBlock& block : *chain) {
-      for (uint64_t i = 0; i < block.size(); ++i) {
-        const TimerInfo& timer_info = block[i];
-        if (timer_info.function_id() == instrumented_function_id) {
-          all_start_times.push_back(timer_info.start());
+  GetTimeGraph()->ForEachThreadTrackTimer(
+      std::numeric_limits<uint64_t>::min(), std::numeric_limits<uint64_t>::max(),
+      [&all_start_times, instrumented_function_id](const TimerView& timer) {
+        if (timer.function_id() == instrumented_function_id) {
+          all_start_times.push_back(timer.start());
         }
-      }
-    }
-  }
+      });
   std::sort(all_start_times.begin(), all_start_times.end());
 
   for (size_t k = 0; k < all_start_times.size() - 1; ++k) {
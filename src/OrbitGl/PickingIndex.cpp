@@ -0,0 +1,109 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitGl/PickingIndex.h"
+
+#include <GteVector.h>
+
+#include <algorithm>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_gl {
+
+void PickingIndex::Clear() {
+  for (Row& row : rows_) {
+    row.entries.clear();
+    unused_entries_.push_back(std::move(row.entries));
+  }
+  rows_.clear();
+  row_by_extent_.clear();
+  last_row_ = kNoRow;
+  is_finalized_ = true;
+}
+
+void PickingIndex::Add(uint64_t order, Vec2 min, Vec2 max, PickingId id) {
+  // Such a primitive doesn't cover any pixel.
+  if (min[0] >= max[0] || min[1] >= max[1]) return;
+  is_finalized_ = false;
+
+  if (last_row_ == kNoRow || rows_[last_row_].min_y != min[1] ||
+      rows_[last_row_].max_y != max[1]) {
+    auto [it, inserted] = row_by_extent_.try_emplace(std::make_pair(min[1], max[1]), rows_.size());
+    if (inserted) {
+      Row& row = rows_.emplace_back(Row{min[1], max[1], max[1], {}});
+      if (!unused_entries_.empty()) {
+        row.entries = std::move(unused_entries_.back());
+        unused_entries_.pop_back();
+      }
+    }
+    last_row_ = it->second;
+  }
+
+  rows_[last_row_].entries.push_back(Entry{min[0], max[0], max[0], order, id});
+}
+
+void PickingIndex::Finalize() {
+  if (is_finalized_) return;
+
+  // Rows are mostly created from top to bottom, and entries from left to right, so the sorts are
+  // skipped in the common case.
+  const auto row_is_before = [](const Row& lhs, const Row& rhs) { return lhs.min_y < rhs.min_y; };
+  if (!std::is_sorted(rows_.begin(), rows_.end(), row_is_before)) {
+    std::sort(rows_.begin(), rows_.end(), row_is_before);
+  }
+  float max_y_so_far = std::numeric_limits<float>::lowest();
+  for (Row& row : rows_) {
+    max_y_so_far = std::max(max_y_so_far, row.max_y);
+    row.max_y_so_far = max_y_so_far;
+
+    const auto entry_is_before = [](const Entry& lhs, const Entry& rhs) {
+      return lhs.min_x < rhs.min_x;
+    };
+    if (!std::is_sorted(row.entries.begin(), row.entries.end(), entry_is_before)) {
+      std::sort(row.entries.begin(), row.entries.end(), entry_is_before);
+    }
+    float max_x_so_far = std::numeric_limits<float>::lowest();
+    for (Entry& entry : row.entries) {
+      max_x_so_far = std::max(max_x_so_far, entry.max_x);
+      entry.max_x_so_far = max_x_so_far;
+    }
+  }
+  // The rows have been reordered.
+  row_by_extent_.clear();
+  last_row_ = kNoRow;
+  is_finalized_ = true;
+}
+
+std::optional<PickingIndex::Hit> PickingIndex::Find(Vec2 pos) const {
+  ORBIT_CHECK(is_finalized_);
+  std::optional<Hit> result;
+  // Only the rows that start at or above `pos`, and of those only the ones after the last row that
+  // ends above it, can contain it. The same holds for the entries of a row.
+  auto row_it = std::upper_bound(rows_.begin(), rows_.end(), pos[1],
+                                 [](float y, const Row& row) { return y < row.min_y; });
+  while (row_it != rows_.begin()) {
+    const Row& row = *--row_it;
+    if (row.max_y_so_far <= pos[1]) break;
+    if (pos[1] >= row.max_y) continue;
+
+    auto entry_it = std::upper_bound(row.entries.begin(), row.entries.end(), pos[0],
+                                     [](float x, const Entry& entry) { return x < entry.min_x; });
+    while (entry_it != row.entries.begin()) {
+      const Entry& entry = *--entry_it;
+      if (entry.max_x_so_far <= pos[0]) break;
+      if (pos[0] >= entry.max_x) continue;
+      if (!result.has_value() || result->order < entry.order) result = Hit{entry.id, entry.order};
+    }
+  }
+  return result;
+}
+
+bool IsDrawnBefore(const PickedPrimitive& lhs, const PickedPrimitive& rhs) {
+  if (lhs.group != rhs.group) return lhs.group < rhs.group;
+  if (lhs.id.batcher_id != rhs.id.batcher_id) return lhs.id.batcher_id < rhs.id.batcher_id;
+  return lhs.order < rhs.order;
+}
+
+}  // namespace orbit_gl
@@ -0,0 +1,142 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <GteVector.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <optional>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/PickingIndex.h"
+#include "OrbitGl/PickingManager.h"
+
+namespace orbit_gl {
+
+namespace {
+
+PickingId BoxId(uint32_t element_id, BatcherId batcher_id = BatcherId::kTimeGraph) {
+  return PickingId::Create(PickingType::kBox, element_id, batcher_id);
+}
+
+std::optional<uint32_t> FindElementId(const PickingIndex& index, Vec2 pos) {
+  std::optional<PickingIndex::Hit> hit = index.Find(pos);
+  if (!hit.has_value()) return std::nullopt;
+  return hit->id.element_id;
+}
+
+}  // namespace
+
+TEST(PickingIndex, FindsTheBoxAtAPoint) {
+  PickingIndex index;
+  index.Add(0, Vec2(0, 0), Vec2(10, 10), BoxId(0));
+  index.Add(1, Vec2(10, 0), Vec2(15, 10), BoxId(1));
+  index.Add(2, Vec2(20, 0), Vec2(30, 10), BoxId(2));
+  index.Add(3, Vec2(0, 10), Vec2(30, 20), BoxId(3));
+  index.Finalize();
+
+  EXPECT_EQ(FindElementId(index, Vec2(0, 0)), 0);
+  EXPECT_EQ(FindElementId(index, Vec2(9.5f, 9.5f)), 0);
+  EXPECT_EQ(FindElementId(index, Vec2(10, 5)), 1);
+  EXPECT_EQ(FindElementId(index, Vec2(15, 5)), std::nullopt);
+  EXPECT_EQ(FindElementId(index, Vec2(29, 5)), 2);
+  EXPECT_EQ(FindElementId(index, Vec2(30, 5)), std::nullopt);
+  EXPECT_EQ(FindElementId(index, Vec2(15, 10)), 3);
+  EXPECT_EQ(FindElementId(index, Vec2(15, 20)), std::nullopt);
+  EXPECT_EQ(FindElementId(index, Vec2(-1, 5)), std::nullopt);
+}
+
+TEST(PickingIndex, ReturnsThePrimitiveDrawnLast) {
+  PickingIndex index;
+  index.Add(0, Vec2(0, 0), Vec2(10, 10), BoxId(0));
+  index.Add(1, Vec2(5, 0), Vec2(15, 10), BoxId(1));
+  index.Add(3, Vec2(20, 0), Vec2(30, 10), BoxId(2));
+  // Added last, but drawn before the previous box, e.g. because it is a line.
+  index.Add(2, Vec2(20, 0), Vec2(25, 10), BoxId(3));
+  index.Finalize();
+
+  EXPECT_EQ(FindElementId(index, Vec2(2, 2)), 0);
+  EXPECT_EQ(FindElementId(index, Vec2(7, 2)), 1);
+  EXPECT_EQ(FindElementId(index, Vec2(12, 2)), 1);
+  EXPECT_EQ(FindElementId(index, Vec2(22, 2)), 2);
+}
+
+TEST(PickingIndex, FindsOverlappingPrimitivesOfTheSameRow) {
+  // Like the samples of a thread bar: boxes 9 pixels wide, each starting 1 pixel after the previous
+  // one, and a wide box added to the left of them.
+  constexpr uint32_t kNumSamples = 1000;
+  PickingIndex index;
+  for (uint32_t i = 0; i < kNumSamples; ++i) {
+    index.Add(i, Vec2(100 + i, 0), Vec2(109 + i, 10), BoxId(i));
+  }
+  index.Add(kNumSamples, Vec2(0, 0), Vec2(50, 10), BoxId(kNumSamples));
+  index.Finalize();
+
+  EXPECT_EQ(FindElementId(index, Vec2(99, 5)), std::nullopt);
+  EXPECT_EQ(FindElementId(index, Vec2(20, 5)), kNumSamples);
+  EXPECT_EQ(FindElementId(index, Vec2(100, 5)), 0);
+  EXPECT_EQ(FindElementId(index, Vec2(108.5f, 5)), 8);
+  EXPECT_EQ(FindElementId(index, Vec2(500, 5)), 400);
+  EXPECT_EQ(FindElementId(index, Vec2(100 + kNumSamples + 7, 5)), kNumSamples - 1);
+  EXPECT_EQ(FindElementId(index, Vec2(100 + kNumSamples + 8, 5)), std::nullopt);
+}
+
+TEST(PickingIndex, FindsPrimitivesOfOverlappingRows) {
+  PickingIndex index;
+  // A background spanning all depths, then one box per depth, added from the bottom up.
+  index.Add(0, Vec2(0, 0), Vec2(100, 40), BoxId(0));
+  for (uint32_t depth = 4; depth > 0; --depth) {
+    const float y = (depth - 1) * 10.f;
+    index.Add(depth, Vec2(10, y), Vec2(20, y + 10), BoxId(depth));
+  }
+  index.Add(5, Vec2(50, 5), Vec2(60, 35), BoxId(5));
+  index.Finalize();
+
+  EXPECT_EQ(FindElementId(index, Vec2(5, 5)), 0);
+  for (uint32_t depth = 1; depth <= 4; ++depth) {
+    EXPECT_EQ(FindElementId(index, Vec2(15, depth * 10.f - 5)), depth);
+  }
+  EXPECT_EQ(FindElementId(index, Vec2(55, 2)), 0);
+  EXPECT_EQ(FindElementId(index, Vec2(55, 20)), 5);
+  EXPECT_EQ(FindElementId(index, Vec2(15, 40)), std::nullopt);
+}
+
+TEST(PickingIndex, IgnoresPrimitivesThatCoverNoPixel) {
+  PickingIndex index;
+  index.Add(0, Vec2(0, 0), Vec2(0, 10), BoxId(0));
+  index.Add(1, Vec2(0, 0), Vec2(10, 0), BoxId(1));
+  index.Finalize();
+  EXPECT_EQ(FindElementId(index, Vec2(0, 0)), std::nullopt);
+}
+
+TEST(PickingIndex, CanBeRefilledAfterClear) {
+  PickingIndex index;
+  index.Add(0, Vec2(0, 0), Vec2(10, 10), BoxId(0));
+  index.Add(1, Vec2(10, 0), Vec2(20, 10), BoxId(1));
+  index.Finalize();
+  index.Clear();
+  EXPECT_EQ(FindElementId(index, Vec2(5, 5)), std::nullopt);
+
+  index.Add(0, Vec2(10, 0), Vec2(20, 10), BoxId(2));
+  index.Add(1, Vec2(0, 0), Vec2(10, 10), BoxId(3));
+  index.Finalize();
+  EXPECT_EQ(FindElementId(index, Vec2(5, 5)), 3);
+  EXPECT_EQ(FindElementId(index, Vec2(15, 5)), 2);
+}
+
+TEST(PickingIndex, IsDrawnBeforeOrdersByGroupThenBatcherThenOrder) {
+  const PickedPrimitive ui{BoxId(0, BatcherId::kUi), BatchRenderGroupId(0.5f), 0};
+  const PickedPrimitive time_graph{BoxId(0), BatchRenderGroupId(0.5f), 1};
+  const PickedPrimitive later_time_graph{BoxId(1), BatchRenderGroupId(0.5f), 2};
+  const PickedPrimitive top{BoxId(2), BatchRenderGroupId(1.f), 0};
+
+  EXPECT_TRUE(IsDrawnBefore(time_graph, ui));
+  EXPECT_FALSE(IsDrawnBefore(ui, time_graph));
+  EXPECT_TRUE(IsDrawnBefore(time_graph, later_time_graph));
+  EXPECT_FALSE(IsDrawnBefore(later_time_graph, time_graph));
+  EXPECT_TRUE(IsDrawnBefore(ui, top));
+}
+
+}  // namespace orbit_gl
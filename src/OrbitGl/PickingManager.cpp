@@ -17,6 +17,12 @@ PickingId PickingManager::GetOrCreatePickableId(const std::shared_ptr<Pickable>&
   uint32_t pickable_id = 0;
 
   auto it = pickable_pid_map_.find(pickable.get());
+  // A pickable might have been created at the address of an expired one.
+  if (it != pickable_pid_map_.end() && pid_pickable_map_.at(it->second).lock() != pickable) {
+    pid_pickable_map_.erase(it->second);
+    pickable_pid_map_.erase(it);
+    it = pickable_pid_map_.end();
+  }
   if (it == pickable_pid_map_.end()) {
     pickable_id = ++pickable_id_counter_;
     pid_pickable_map_[pickable_id] = pickable;
@@ -36,6 +42,19 @@ void PickingManager::Reset() {
   pickable_id_counter_ = 0;
 }
 
+void PickingManager::RemoveExpiredPickables() {
+  absl::MutexLock lock(&mutex_);
+  for (auto it = pickable_pid_map_.begin(); it != pickable_pid_map_.end();) {
+    auto pid_it = pid_pickable_map_.find(it->second);
+    if (pid_it->second.expired()) {
+      pid_pickable_map_.erase(pid_it);
+      it = pickable_pid_map_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 std::shared_ptr<Pickable> PickingManager::GetPickableFromId(PickingId id) const {
   ORBIT_CHECK(id.type == PickingType::kPickable);
 
@@ -126,6 +126,39 @@ TEST(PickingManager, RobustnessOnReset) {
   pickable.reset(new PickableMock());
 }
 
+TEST(PickingManager, RemoveExpiredPickablesKeepsTheIdsOfTheOthers) {
+  auto pickable = std::make_shared<PickableMock>();
+  auto expired_pickable = std::make_shared<PickableMock>();
+  PickingManager pm;
+
+  PickingId id = MockRenderPickingColor(pm.GetPickableColor(pickable, BatcherId::kUi));
+  PickingId expired_id =
+      MockRenderPickingColor(pm.GetPickableColor(expired_pickable, BatcherId::kUi));
+  expired_pickable.reset();
+
+  pm.RemoveExpiredPickables();
+  EXPECT_EQ(pm.GetPickableFromId(id), pickable);
+  EXPECT_FALSE(pm.GetPickableFromId(expired_id));
+  EXPECT_EQ(MockRenderPickingColor(pm.GetPickableColor(pickable, BatcherId::kUi)).element_id,
+            id.element_id);
+}
+
+TEST(PickingManager, PickableAtTheAddressOfAnExpiredOneGetsANewId) {
+  PickableMock mock;
+  // Aliasing shared pointers, so that both pickables have the same address.
+  std::shared_ptr<Pickable> expired_pickable(std::make_shared<int>(), &mock);
+  PickingManager pm;
+  PickingId expired_id =
+      MockRenderPickingColor(pm.GetPickableColor(expired_pickable, BatcherId::kUi));
+  expired_pickable.reset();
+
+  std::shared_ptr<Pickable> pickable(std::make_shared<int>(), &mock);
+  PickingId id = MockRenderPickingColor(pm.GetPickableColor(pickable, BatcherId::kUi));
+  EXPECT_NE(id.element_id, expired_id.element_id);
+  EXPECT_EQ(pm.GetPickableFromId(id), pickable);
+  EXPECT_FALSE(pm.GetPickableFromId(expired_id));
+}
+
 TEST(PickingManager, Overflow) {
   ASSERT_DEATH((void)PickingId::Create(PickingType::kLine, 1 << PickingId::kElementIDBitSize),
                "kElementIDBitSize");
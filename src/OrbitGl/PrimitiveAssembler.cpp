@@ -12,6 +12,7 @@
 
 #include <array>
 #include <cmath>
+#include <optional>
 #include <utility>
 
 #include "OrbitGl/CoreMath.h"
@@ -20,7 +21,7 @@
 namespace orbit_gl {
 
 void PrimitiveAssembler::AddLine(const Vec2& from, const Vec2& to, float z, const Color& color,
-                                 std::unique_ptr<PickingUserData> user_data) {
+                                 std::optional<PickingUserData> user_data) {
   Color picking_color =
       PickingId::ToColor(PickingType::kLine, batcher_->GetNumElements(), GetBatcherId());
 
@@ -33,11 +34,11 @@ void PrimitiveAssembler::AddLine(const Vec2& from, const Vec2& to, float z, cons
 
   Color picking_color = picking_manager_->GetPickableColor(pickable, GetBatcherId());
 
-  batcher_->AddLine(from, to, z, color, picking_color, nullptr);
+  batcher_->AddLine(from, to, z, color, picking_color, std::nullopt);
 }
 
 void PrimitiveAssembler::AddVerticalLine(const Vec2& pos, float size, float z, const Color& color,
-                                         std::unique_ptr<PickingUserData> user_data) {
+                                         std::optional<PickingUserData> user_data) {
   AddLine(pos, pos + Vec2(0, size), z, color, std::move(user_data));
 }
 
@@ -47,18 +48,18 @@ void PrimitiveAssembler::AddVerticalLine(const Vec2& pos, float size, float z, c
 
   Color picking_color = picking_manager_->GetPickableColor(pickable, GetBatcherId());
 
-  batcher_->AddLine(pos, pos + Vec2(0, size), z, color, picking_color, nullptr);
+  batcher_->AddLine(pos, pos + Vec2(0, size), z, color, picking_color, std::nullopt);
 }
 
 void PrimitiveAssembler::AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
-                                std::unique_ptr<PickingUserData> user_data) {
+                                std::optional<PickingUserData> user_data) {
   Color picking_color =
       PickingId::ToColor(PickingType::kBox, batcher_->GetNumElements(), GetBatcherId());
   batcher_->AddBox(box, z, colors, picking_color, std::move(user_data));
 }
 
 void PrimitiveAssembler::AddBox(const Quad& box, float z, const Color& color,
-                                std::unique_ptr<PickingUserData> user_data) {
+                                std::optional<PickingUserData> user_data) {
   std::array<Color, 4> colors;
   colors.fill(color);
   AddBox(box, z, colors, std::move(user_data));
@@ -72,23 +73,22 @@ void PrimitiveAssembler::AddBox(const Quad& box, float z, const Color& color,
   std::array<Color, 4> colors;
   colors.fill(color);
 
-  batcher_->AddBox(box, z, colors, picking_color, nullptr);
+  batcher_->AddBox(box, z, colors, picking_color, std::nullopt);
 }
 
 void PrimitiveAssembler::AddShadedBox(const Vec2& pos, const Vec2& size, float z,
                                       const Color& color) {
-  AddShadedBox(pos, size, z, color, std::unique_ptr<PickingUserData>(),
-               ShadingDirection::kLeftToRight);
+  AddShadedBox(pos, size, z, color, std::nullopt, ShadingDirection::kLeftToRight);
 }
 
 void PrimitiveAssembler::AddShadedBox(const Vec2& pos, const Vec2& size, float z,
                                       const Color& color, ShadingDirection shading_direction) {
-  AddShadedBox(pos, size, z, color, std::unique_ptr<PickingUserData>(), shading_direction);
+  AddShadedBox(pos, size, z, color, std::nullopt, shading_direction);
 }
 
 void PrimitiveAssembler::AddShadedBox(const Vec2& pos, const Vec2& size, float z,
                                       const Color& color,
-                                      std::unique_ptr<PickingUserData> user_data,
+                                      std::optional<PickingUserData> user_data,
                                       ShadingDirection shading_direction) {
   std::array<Color, 4> colors;
   GetBoxGradientColors(color, &colors, shading_direction);
@@ -186,11 +186,11 @@ void PrimitiveAssembler::AddShadedBox(const Vec2& pos, const Vec2& size, float z
   GetBoxGradientColors(color, &colors, shading_direction);
   Color picking_color = picking_manager_->GetPickableColor(pickable, GetBatcherId());
   Quad box = MakeBox(pos, size);
-  batcher_->AddBox(box, z, colors, picking_color, nullptr);
+  batcher_->AddBox(box, z, colors, picking_color, std::nullopt);
 }
 
 void PrimitiveAssembler::AddTriangle(const Triangle& triangle, float z, const Color& color,
-                                     std::unique_ptr<PickingUserData> user_data) {
+                                     std::optional<PickingUserData> user_data) {
   Color picking_color =
       PickingId::ToColor(PickingType::kTriangle, batcher_->GetNumElements(), GetBatcherId());
 
@@ -203,12 +203,12 @@ void PrimitiveAssembler::AddTriangle(const Triangle& triangle, float z, const Co
 
   Color picking_color = picking_manager_->GetPickableColor(pickable, GetBatcherId());
 
-  AddTriangle(triangle, z, color, picking_color, nullptr);
+  AddTriangle(triangle, z, color, picking_color, std::nullopt);
 }
 
 void PrimitiveAssembler::AddTriangle(const Triangle& triangle, float z, const Color& color,
                                      const Color& picking_color,
-                                     std::unique_ptr<PickingUserData> user_data) {
+                                     std::optional<PickingUserData> user_data) {
   std::array<Color, 3> colors;
   colors.fill(color);
   batcher_->AddTriangle(triangle, z, colors, picking_color, std::move(user_data));
@@ -216,7 +216,7 @@ void PrimitiveAssembler::AddTriangle(const Triangle& triangle, float z, const Co
 
 // Draw a shaded trapezium with two sides parallel to the x-axis or y-axis.
 void PrimitiveAssembler::AddShadedTrapezium(const Quad& trapezium, float z, const Color& color,
-                                            std::unique_ptr<PickingUserData> user_data,
+                                            std::optional<PickingUserData> user_data,
                                             ShadingDirection shading_direction) {
   std::array<Color, 4> colors;  // top_left, bottom_left, bottom_right, top_right.
   GetBoxGradientColors(color, &colors, shading_direction);
@@ -224,8 +224,7 @@ void PrimitiveAssembler::AddShadedTrapezium(const Quad& trapezium, float z, cons
       PickingId::ToColor(PickingType::kTriangle, batcher_->GetNumElements(), GetBatcherId());
   Triangle triangle_1{trapezium.vertices[0], trapezium.vertices[3], trapezium.vertices[1]};
   std::array<Color, 3> colors_1{colors[0], colors[1], colors[2]};
-  batcher_->AddTriangle(triangle_1, z, colors_1, picking_color,
-                        std::make_unique<PickingUserData>(*user_data));
+  batcher_->AddTriangle(triangle_1, z, colors_1, picking_color, user_data);
   Triangle triangle_2{trapezium.vertices[3], trapezium.vertices[2], trapezium.vertices[1]};
   std::array<Color, 3> colors_2{colors[1], colors[2], colors[3]};
   batcher_->AddTriangle(triangle_2, z, colors_2, picking_color, std::move(user_data));
@@ -285,13 +284,10 @@ void PrimitiveAssembler::AddVerticalArrow(Vec2 starting_pos, Vec2 arrow_body_siz
 }
 
 void PrimitiveAssembler::AddQuadBorder(const Quad& quad, float z, const Color& color,
-                                       std::unique_ptr<orbit_gl::PickingUserData> user_data) {
-  AddLine(quad.vertices[0], quad.vertices[1], z, color,
-          std::make_unique<PickingUserData>(*user_data));
-  AddLine(quad.vertices[1], quad.vertices[2], z, color,
-          std::make_unique<PickingUserData>(*user_data));
-  AddLine(quad.vertices[2], quad.vertices[3], z, color,
-          std::make_unique<PickingUserData>(*user_data));
+                                       std::optional<orbit_gl::PickingUserData> user_data) {
+  AddLine(quad.vertices[0], quad.vertices[1], z, color, user_data);
+  AddLine(quad.vertices[1], quad.vertices[2], z, color, user_data);
+  AddLine(quad.vertices[2], quad.vertices[3], z, color, user_data);
   AddLine(quad.vertices[3], quad.vertices[0], z, color, std::move(user_data));
 }
 
@@ -0,0 +1,108 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitGl/RecordingBatcher.h"
+
+#include <absl/base/casts.h>
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_gl {
+
+namespace {
+
+[[nodiscard]] Color ShiftElementPickingColor(const Color& picking_color, uint32_t element_offset) {
+  const PickingId id = PickingId::FromPixelValue(absl::bit_cast<uint32_t>(
+      std::array<uint8_t, 4>{picking_color[0], picking_color[1], picking_color[2],
+                             picking_color[3]}));
+  switch (id.type) {
+    case PickingType::kLine:
+    case PickingType::kBox:
+    case PickingType::kTriangle:
+      return PickingId::ToColor(id.type, id.element_id + element_offset, id.batcher_id);
+    case PickingType::kInvalid:
+    case PickingType::kPickable:
+    case PickingType::kCount:
+      return picking_color;
+  }
+  ORBIT_UNREACHABLE();
+}
+
+}  // namespace
+
+void RecordingBatcher::PushTranslation(float x, float y, float z) {
+  calls_.emplace_back(PushTranslationCall{x, y, z});
+}
+
+void RecordingBatcher::PopTranslation() { calls_.emplace_back(PopTranslationCall{}); }
+
+void RecordingBatcher::SetCurrentRenderGroupName(std::string name) {
+  calls_.emplace_back(SetRenderGroupNameCall{name});
+  Batcher::SetCurrentRenderGroupName(std::move(name));
+}
+
+void RecordingBatcher::ResetElements() {
+  calls_.clear();
+  num_elements_ = 0;
+}
+
+void RecordingBatcher::AddLine(Vec2 from, Vec2 to, float z, const Color& color,
+                               const Color& picking_color,
+                               std::optional<PickingUserData> user_data) {
+  calls_.emplace_back(AddLineCall{from, to, z, color, picking_color, std::move(user_data)});
+  ++num_elements_;
+}
+
+void RecordingBatcher::AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
+                              const Color& picking_color,
+                              std::optional<PickingUserData> user_data) {
+  calls_.emplace_back(AddBoxCall{box, z, colors, picking_color, std::move(user_data)});
+  ++num_elements_;
+}
+
+void RecordingBatcher::AddTriangle(const Triangle& triangle, float z,
+                                   const std::array<Color, 3>& colors, const Color& picking_color,
+                                   std::optional<PickingUserData> user_data) {
+  calls_.emplace_back(AddTriangleCall{triangle, z, colors, picking_color, std::move(user_data)});
+  ++num_elements_;
+}
+
+void RecordingBatcher::CopyTo(Batcher& batcher) const {
+  ORBIT_CHECK(batcher.GetBatcherId() == GetBatcherId());
+  const uint32_t element_offset = batcher.GetNumElements();
+
+  for (const Call& call : calls_) {
+    std::visit(
+        [&batcher, element_offset](const auto& recorded) {
+          using T = std::decay_t<decltype(recorded)>;
+          if constexpr (std::is_same_v<T, PushTranslationCall>) {
+            batcher.PushTranslation(recorded.x, recorded.y, recorded.z);
+          } else if constexpr (std::is_same_v<T, PopTranslationCall>) {
+            batcher.PopTranslation();
+          } else if constexpr (std::is_same_v<T, SetRenderGroupNameCall>) {
+            batcher.SetCurrentRenderGroupName(recorded.name);
+          } else if constexpr (std::is_same_v<T, AddLineCall>) {
+            batcher.AddLine(recorded.from, recorded.to, recorded.z, recorded.color,
+                            ShiftElementPickingColor(recorded.picking_color, element_offset),
+                            recorded.user_data);
+          } else if constexpr (std::is_same_v<T, AddBoxCall>) {
+            batcher.AddBox(recorded.box, recorded.z, recorded.colors,
+                           ShiftElementPickingColor(recorded.picking_color, element_offset),
+                           recorded.user_data);
+          } else {
+            static_assert(std::is_same_v<T, AddTriangleCall>);
+            batcher.AddTriangle(recorded.triangle, recorded.z, recorded.colors,
+                                ShiftElementPickingColor(recorded.picking_color, element_offset),
+                                recorded.user_data);
+          }
+        },
+        call);
+  }
+}
+
+}  // namespace orbit_gl
@@ -0,0 +1,158 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <GteVector.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/Batcher.h"
+#include "OrbitGl/BatcherInterface.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/Geometry.h"
+#include "OrbitGl/PickingManager.h"
+#include "OrbitGl/PickingManagerTest.h"
+#include "OrbitGl/PrimitiveAssembler.h"
+#include "OrbitGl/RecordingBatcher.h"
+#include "OrbitGl/TranslationStack.h"
+
+namespace orbit_gl {
+
+namespace {
+
+// Stores the first vertex, render group and picking id of each primitive it receives.
+class FakeBatcher : public Batcher {
+ public:
+  struct Primitive {
+    LayeredVec2 first_vertex;
+    std::string render_group_name;
+    PickingId picking_id;
+    std::optional<PickingUserData> user_data;
+  };
+
+  FakeBatcher() : Batcher(BatcherId::kTimeGraph) {}
+
+  void ResetElements() override { primitives_.clear(); }
+  void AddLine(Vec2 from, Vec2 /*to*/, float z, const Color& /*color*/,
+               const Color& picking_color, std::optional<PickingUserData> user_data) override {
+    Add(from, z, picking_color, std::move(user_data));
+  }
+  void AddBox(const Quad& box, float z, const std::array<Color, 4>& /*colors*/,
+              const Color& picking_color, std::optional<PickingUserData> user_data) override {
+    Add(box.vertices[0], z, picking_color, std::move(user_data));
+  }
+  void AddTriangle(const Triangle& triangle, float z, const std::array<Color, 3>& /*colors*/,
+                   const Color& picking_color, std::optional<PickingUserData> user_data) override {
+    Add(triangle.vertices[0], z, picking_color, std::move(user_data));
+  }
+  [[nodiscard]] uint32_t GetNumElements() const override { return primitives_.size(); }
+
+  [[nodiscard]] std::vector<BatchRenderGroupId> GetNonEmptyRenderGroups() const override {
+    return {};
+  }
+  void DrawRenderGroup(const BatchRenderGroupId& /*group*/, bool /*picking*/) override {}
+  [[nodiscard]] const PickingUserData* GetUserData(PickingId /*id*/) const override {
+    return nullptr;
+  }
+  [[nodiscard]] Statistics GetStatistics() const override { return {}; }
+
+  [[nodiscard]] const std::vector<Primitive>& GetPrimitives() const { return primitives_; }
+
+ private:
+  void Add(Vec2 vertex, float z, const Color& picking_color,
+           std::optional<PickingUserData> user_data) {
+    primitives_.push_back({translations_.TranslateXYZAndFloorXY({vertex, z}),
+                           GetCurrentRenderGroupName(), MockRenderPickingColor(picking_color),
+                           std::move(user_data)});
+  }
+
+  std::vector<Primitive> primitives_;
+};
+
+const Color kColor{255, 0, 0, 255};
+
+}  // namespace
+
+TEST(RecordingBatcher, CopyToAddsTheRecordedPrimitivesAfterTheExistingOnes) {
+  BatchRenderGroupStateManager manager;
+  PickingManager picking_manager;
+  FakeBatcher batcher;
+  PrimitiveAssembler primitive_assembler(&batcher, &manager, &picking_manager);
+  primitive_assembler.AddBox(MakeBox({0, 0}, {1, 1}), 0.f, kColor);
+  primitive_assembler.PushTranslation(10, 20, 1.f);
+
+  RecordingBatcher recording_batcher(BatcherId::kTimeGraph);
+  PrimitiveAssembler recording_primitive_assembler(&recording_batcher, &manager, &picking_manager);
+  recording_primitive_assembler.SetCurrentRenderGroupName("recorded");
+  recording_primitive_assembler.PushTranslation(1, 2, 0.5f);
+  const int custom_data = 42;
+  PickingUserData user_data;
+  user_data.custom_data_ = &custom_data;
+  recording_primitive_assembler.AddLine({3, 4}, {5, 4}, 0.25f, kColor, std::move(user_data));
+  recording_primitive_assembler.PopTranslation();
+  auto pickable = std::make_shared<PickableMock>();
+  recording_primitive_assembler.AddTriangle(Triangle({6, 7}, {8, 7}, {6, 9}), 0.f, kColor,
+                                            pickable);
+  EXPECT_EQ(recording_batcher.GetNumElements(), 2);
+  EXPECT_EQ(batcher.GetPrimitives().size(), 1);
+
+  recording_batcher.CopyTo(batcher);
+  primitive_assembler.PopTranslation();
+
+  const std::vector<FakeBatcher::Primitive>& primitives = batcher.GetPrimitives();
+  ASSERT_EQ(primitives.size(), 3);
+
+  // The recorded translations are applied on top of the ones of the batcher.
+  EXPECT_EQ(primitives[1].first_vertex.xy, Vec2(14, 26));
+  EXPECT_EQ(primitives[1].first_vertex.z, 1.75f);
+  EXPECT_EQ(primitives[1].render_group_name, "recorded");
+  EXPECT_EQ(primitives[1].picking_id.type, PickingType::kLine);
+  EXPECT_EQ(primitives[1].picking_id.element_id, 1);
+  ASSERT_TRUE(primitives[1].user_data.has_value());
+  EXPECT_EQ(primitives[1].user_data->custom_data_, &custom_data);
+
+  EXPECT_EQ(primitives[2].first_vertex.xy, Vec2(16, 27));
+  EXPECT_EQ(primitives[2].first_vertex.z, 1.f);
+  EXPECT_EQ(primitives[2].picking_id.type, PickingType::kPickable);
+  EXPECT_EQ(picking_manager.GetPickableFromId(primitives[2].picking_id), pickable);
+
+  EXPECT_EQ(batcher.GetCurrentRenderGroupName(), "recorded");
+}
+
+TEST(RecordingBatcher, CopyToKeepsTheRecording) {
+  BatchRenderGroupStateManager manager;
+  PickingManager picking_manager;
+  RecordingBatcher recording_batcher(BatcherId::kTimeGraph);
+  PrimitiveAssembler recording_primitive_assembler(&recording_batcher, &manager, &picking_manager);
+  recording_primitive_assembler.AddBox(MakeBox({1, 2}, {3, 4}), 0.f, kColor, PickingUserData());
+
+  FakeBatcher batcher;
+  recording_batcher.CopyTo(batcher);
+  recording_batcher.CopyTo(batcher);
+  EXPECT_EQ(recording_batcher.GetNumElements(), 1);
+
+  const std::vector<FakeBatcher::Primitive>& primitives = batcher.GetPrimitives();
+  ASSERT_EQ(primitives.size(), 2);
+  for (uint32_t i = 0; i < primitives.size(); ++i) {
+    EXPECT_EQ(primitives[i].first_vertex.xy, Vec2(1, 2));
+    EXPECT_EQ(primitives[i].picking_id.type, PickingType::kBox);
+    EXPECT_EQ(primitives[i].picking_id.element_id, i);
+    EXPECT_TRUE(primitives[i].user_data.has_value());
+  }
+}
+
+TEST(RecordingBatcher, CopyToABatcherWithADifferentIdFails) {
+  FakeBatcher batcher;
+  RecordingBatcher recording_batcher(BatcherId::kUi);
+  EXPECT_DEATH(recording_batcher.CopyTo(batcher), "GetBatcherId");
+}
+
+}  // namespace orbit_gl
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitGl/RecordingTextRenderer.h"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_gl {
+
+void RecordingTextRenderer::PushTranslation(float x, float y, float z) {
+  calls_.emplace_back(PushTranslationCall{x, y, z});
+}
+
+void RecordingTextRenderer::PopTranslation() { calls_.emplace_back(PopTranslationCall{}); }
+
+void RecordingTextRenderer::SetCurrentRenderGroupName(std::string name) {
+  calls_.emplace_back(SetRenderGroupNameCall{name});
+  TextRenderer::SetCurrentRenderGroupName(std::move(name));
+}
+
+void RecordingTextRenderer::Clear() { calls_.clear(); }
+
+void RecordingTextRenderer::AddText(const char* text, float x, float y, float z,
+                                    TextFormatting formatting) {
+  calls_.emplace_back(AddTextCall{text, x, y, z, formatting});
+}
+
+void RecordingTextRenderer::AddText(const char* text, float x, float y, float z,
+                                    TextFormatting formatting, Vec2* out_text_pos,
+                                    Vec2* out_text_size) {
+  ORBIT_CHECK(out_text_pos == nullptr && out_text_size == nullptr);
+  AddText(text, x, y, z, formatting);
+}
+
+float RecordingTextRenderer::AddTextTrailingCharsPrioritized(const char* text, float x, float y,
+                                                             float z, TextFormatting formatting,
+                                                             size_t trailing_chars_length) {
+  calls_.emplace_back(
+      AddTextTrailingCharsPrioritizedCall{text, x, y, z, formatting, trailing_chars_length});
+  return 0.f;
+}
+
+float RecordingTextRenderer::GetStringWidth(const char* text, uint32_t font_size) {
+  return measuring_renderer_->GetStringWidth(text, font_size);
+}
+
+float RecordingTextRenderer::GetStringHeight(const char* text, uint32_t font_size) {
+  return measuring_renderer_->GetStringHeight(text, font_size);
+}
+
+float RecordingTextRenderer::GetMinimumTextWidth(uint32_t font_size) {
+  return measuring_renderer_->GetMinimumTextWidth(font_size);
+}
+
+void RecordingTextRenderer::CopyTo(TextRenderer& text_renderer) const {
+  for (const Call& call : calls_) {
+    std::visit(
+        [&text_renderer](const auto& recorded) {
+          using T = std::decay_t<decltype(recorded)>;
+          if constexpr (std::is_same_v<T, PushTranslationCall>) {
+            text_renderer.PushTranslation(recorded.x, recorded.y, recorded.z);
+          } else if constexpr (std::is_same_v<T, PopTranslationCall>) {
+            text_renderer.PopTranslation();
+          } else if constexpr (std::is_same_v<T, SetRenderGroupNameCall>) {
+            text_renderer.SetCurrentRenderGroupName(recorded.name);
+          } else if constexpr (std::is_same_v<T, AddTextCall>) {
+            text_renderer.AddText(recorded.text.c_str(), recorded.x, recorded.y, recorded.z,
+                                  recorded.formatting);
+          } else {
+            static_assert(std::is_same_v<T, AddTextTrailingCharsPrioritizedCall>);
+            std::ignore = text_renderer.AddTextTrailingCharsPrioritized(
+                recorded.text.c_str(), recorded.x, recorded.y, recorded.z, recorded.formatting,
+                recorded.trailing_chars_length);
+          }
+        },
+        call);
+  }
+}
+
+}  // namespace orbit_gl
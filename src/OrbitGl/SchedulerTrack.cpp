@@ -88,8 +88,7 @@ void SchedulerTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
       const bool is_selected = timer_info == draw_data.selected_timer;
 
       Color color = GetTimerColor(*timer_info, is_selected, /*is_highlighted=*/false, draw_data);
-      std::unique_ptr<PickingUserData> user_data =
-          CreatePickingUserData(primitive_assembler, *timer_info);
+      PickingUserData user_data = CreatePickingUserData(*timer_info);
 
       auto [box_start_x, box_width] =
           timeline_info_->GetBoxPosXAndWidthFromTicks(timer_info->start(), timer_info->end());
@@ -157,9 +156,8 @@ std::string SchedulerTrack::GetTooltip() const {
   return "Shows scheduling information for CPU cores";
 }
 
-std::string SchedulerTrack::GetBoxTooltip(const PrimitiveAssembler& primitive_assembler,
-                                          PickingId id) const {
-  const orbit_client_protos::TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
+std::string SchedulerTrack::GetBoxTooltip(const PickingUserData& user_data) const {
+  const orbit_client_protos::TimerInfo* timer_info = user_data.timer_info_;
   if (timer_info == nullptr) {
     return "";
   }
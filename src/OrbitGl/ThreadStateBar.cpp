@@ -175,15 +175,12 @@ static std::string GetThreadStateDescription(ThreadStateSlice::ThreadState state
   }
 }
 
-std::string ThreadStateBar::GetThreadStateSliceTooltip(PrimitiveAssembler& primitive_assembler,
-                                                       PickingId id) const {
-  const PickingUserData* user_data = primitive_assembler.GetUserData(id);
-  if (user_data == nullptr || user_data->custom_data_ == nullptr) {
+std::string ThreadStateBar::GetThreadStateSliceTooltip(const PickingUserData& user_data) const {
+  if (user_data.custom_data_ == nullptr) {
     return "";
   }
 
-  const auto* thread_state_slice =
-      static_cast<const ThreadStateSliceInfo*>(user_data->custom_data_);
+  const auto* thread_state_slice = static_cast<const ThreadStateSliceInfo*>(user_data.custom_data_);
 
   std::string tooltip = absl::StrFormat(
       "<b>%s</b><br/>"
@@ -304,10 +301,8 @@ void ThreadStateBar::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
 
         const Color color = GetThreadStateColor(slice.thread_state());
 
-        auto user_data = std::make_unique<PickingUserData>(nullptr, [&](PickingId id) {
-          return GetThreadStateSliceTooltip(primitive_assembler, id);
-        });
-        user_data->custom_data_ = &slice;
+        PickingUserData user_data(nullptr, &slice_tooltip_callback_);
+        user_data.custom_data_ = &slice;
         Quad box = MakeBox(pos, size);
         primitive_assembler.AddBox(box, GlCanvas::kZValueEvent, color, std::move(user_data));
       });
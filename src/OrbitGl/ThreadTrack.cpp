@@ -123,9 +123,8 @@ const TimerInfo* ThreadTrack::GetDown(const TimerInfo& timer_info) const {
   return thread_track_data_provider_->GetDown(timer_info);
 }
 
-std::string ThreadTrack::GetBoxTooltip(const PrimitiveAssembler& primitive_assembler,
-                                       PickingId id) const {
-  const TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
+std::string ThreadTrack::GetBoxTooltip(const PickingUserData& user_data) const {
+  const TimerInfo* timer_info = user_data.timer_info_;
   if (timer_info == nullptr || timer_info->type() == TimerInfo::kCoreActivity) {
     return "";
   }
@@ -404,8 +403,7 @@ void ThreadTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
       ++visible_timer_count_;
 
       Color color = GetTimerColor(*timer_info, draw_data);
-      std::unique_ptr<PickingUserData> user_data =
-          CreatePickingUserData(primitive_assembler, *timer_info);
+      PickingUserData user_data = CreatePickingUserData(*timer_info);
 
       auto box_height = GetDefaultBoxHeight();
       const auto [pos_x, size_x] =
@@ -420,7 +418,7 @@ void ThreadTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
       if (ShouldHaveBorder(timer_info, draw_data.histogram_selection_range, size[0])) {
         primitive_assembler.AddQuadBorder(MakeBox(pos, size), GlCanvas::kZValueBoxBorder,
                                           TimerTrack::kBoxBorderColor,
-                                          CreatePickingUserData(primitive_assembler, *timer_info));
+                                          CreatePickingUserData(*timer_info));
       }
     }
   }
@@ -11,11 +11,13 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <optional>
 #include <string>
 
 #include "ApiInterface/Orbit.h"
 #include "CaptureClient/CaptureEventProcessor.h"
 #include "ClientData/CallstackData.h"
+#include "ClientData/CompactTimerChain.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/ScopeInfo.h"
 #include "ClientFlags/ClientFlags.h"
@@ -42,6 +44,7 @@ using orbit_capture_client::CaptureEventProcessor;
 
 using orbit_client_data::CaptureData;
 using orbit_client_data::TimerChain;
+using orbit_client_data::TimerView;
 using orbit_client_protos::TimerInfo;
 
 using orbit_gl::Button;
@@ -573,43 +576,32 @@ const TimerInfo* TimeGraph::FindNextScopeTimer(ScopeId scope_id, uint64_t curren
 
 const TimerInfo* TimeGraph::FindNextThreadTrackTimer(ScopeId scope_id, uint64_t current_time,
                                                      std::optional<uint32_t> thread_id) const {
-  const TimerInfo* next_timer = nullptr;
+  std::optional<TimerView> next_timer;
   uint64_t goal_time = std::numeric_limits<uint64_t>::max();
-  std::vector<const TimerChain*> chains = GetAllThreadTrackTimerChains();
-  for (const TimerChain* chain : chains) {
-    ORBIT_CHECK(chain != nullptr);
-    for (const auto& block : *chain) {
-      if (!block.Intersects(current_time, goal_time)) continue;
-      for (uint64_t i = 0; i < block.size(); i++) {
-        const TimerInfo& timer_info = block[i];
-        if (ThreadMatches(thread_id, &timer_info) &&
-            capture_data_->ProvideScopeId(timer_info) == scope_id) {
-          UpdateNextTimerAndGoalTime(&next_timer, goal_time, &timer_info, current_time);
-        }
-      }
-    }
-  }
-  return next_timer;
+  ForEachThreadTrackTimer(current_time, goal_time, [&](const TimerView& timer) {
+    if (timer.end() <= current_time || timer.end() >= goal_time) return;
+    if (thread_id.has_value() && *thread_id != timer.thread_id()) return;
+    if (capture_data_->ProvideScopeId(timer) != scope_id) return;
+    next_timer = timer;
+    goal_time = timer.end();
+  });
+  if (!next_timer.has_value()) return nullptr;
+  return &next_timer->GetTimerInfo();
 }
 
 const TimerInfo* TimeGraph::FindPreviousThreadTrackTimer(ScopeId scope_id, uint64_t current_time,
                                                          std::optional<uint32_t> thread_id) const {
-  const TimerInfo* previous_timer = nullptr;
+  std::optional<TimerView> previous_timer;
   uint64_t goal_time = std::numeric_limits<uint64_t>::lowest();
-  std::vector<const TimerChain*> chains = GetAllThreadTrackTimerChains();
-  for (const TimerChain* chain : chains) {
-    for (const auto& block : *chain) {
-      if (!block.Intersects(goal_time, current_time)) continue;
-      for (uint64_t i = 0; i < block.size(); i++) {
-        const TimerInfo& timer_info = block[i];
-        if (ThreadMatches(thread_id, &timer_info) &&
-            capture_data_->ProvideScopeId(timer_info) == scope_id) {
-          UpdatePreviousTimerAndGoalTime(&previous_timer, &goal_time, &timer_info, current_time);
-        }
-      }
-    }
-  }
-  return previous_timer;
+  ForEachThreadTrackTimer(goal_time, current_time, [&](const TimerView& timer) {
+    if (timer.end() >= current_time || timer.end() <= goal_time) return;
+    if (thread_id.has_value() && *thread_id != timer.thread_id()) return;
+    if (capture_data_->ProvideScopeId(timer) != scope_id) return;
+    previous_timer = timer;
+    goal_time = timer.end();
+  });
+  if (!previous_timer.has_value()) return nullptr;
+  return &previous_timer->GetTimerInfo();
 }
 
 std::vector<const TimerChain*> TimeGraph::GetAllThreadTrackTimerChains() const {
@@ -617,6 +609,12 @@ std::vector<const TimerChain*> TimeGraph::GetAllThreadTrackTimerChains() const {
   return thread_track_data_provider_->GetAllThreadTimerChains();
 }
 
+void TimeGraph::ForEachThreadTrackTimer(uint64_t min_tick, uint64_t max_tick,
+                                        absl::FunctionRef<void(const TimerView&)> visitor) const {
+  ORBIT_CHECK(thread_track_data_provider_ != nullptr);
+  thread_track_data_provider_->ForEachTimer(min_tick, max_tick, visitor);
+}
+
 static void UpdateMinMaxTimers(const TimerInfo** min_timer, const TimerInfo** max_timer,
                                const TimerInfo* next_observed_timer) {
   uint64_t elapsed_nanos = next_observed_timer->end() - next_observed_timer->start();
@@ -630,19 +628,22 @@ static void UpdateMinMaxTimers(const TimerInfo** min_timer, const TimerInfo** ma
 
 std::pair<const TimerInfo*, const TimerInfo*> TimeGraph::GetMinMaxTimerForThreadTrackScope(
     ScopeId scope_id) const {
-  const TimerInfo* min_timer = nullptr;
-  const TimerInfo* max_timer = nullptr;
-  std::vector<const TimerChain*> chains = GetAllThreadTrackTimerChains();
-  for (const TimerChain* chain : chains) {
-    for (const auto& block : *chain) {
-      for (size_t i = 0; i < block.size(); i++) {
-        const TimerInfo& timer_info = block[i];
-        if (capture_data_->ProvideScopeId(timer_info) != scope_id) continue;
-        UpdateMinMaxTimers(&min_timer, &max_timer, &timer_info);
-      }
-    }
-  }
-  return std::make_pair(min_timer, max_timer);
+  std::optional<TimerView> min_timer;
+  std::optional<TimerView> max_timer;
+  ForEachThreadTrackTimer(
+      std::numeric_limits<uint64_t>::min(), std::numeric_limits<uint64_t>::max(),
+      [&](const TimerView& timer) {
+        if (capture_data_->ProvideScopeId(timer) != scope_id) return;
+        uint64_t elapsed_nanos = timer.end() - timer.start();
+        if (!min_timer.has_value() || elapsed_nanos < min_timer->end() - min_timer->start()) {
+          min_timer = timer;
+        }
+        if (!max_timer.has_value() || elapsed_nanos > max_timer->end() - max_timer->start()) {
+          max_timer = timer;
+        }
+      });
+  if (!min_timer.has_value()) return {nullptr, nullptr};
+  return std::make_pair(&min_timer->GetTimerInfo(), &max_timer->GetTimerInfo());
 }
 
 std::pair<const TimerInfo*, const TimerInfo*> TimeGraph::GetMinMaxTimerForScope(
@@ -665,10 +666,21 @@ std::pair<const TimerInfo*, const TimerInfo*> TimeGraph::GetMinMaxTimerForScope(
   return std::make_pair(min_timer, max_timer);
 }
 
+void TimeGraph::RequestUpdateOfAllPrimitives() {
+  ++external_state_generation_;
+  RequestUpdate();
+}
+
 void TimeGraph::PrepareBatcherAndUpdatePrimitives(PickingMode picking_mode) {
   ORBIT_SCOPE_FUNCTION;
   ORBIT_CHECK(app_->GetStringManager() != nullptr);
 
+  // Tracks receive new data while capturing or loading a capture, so they can't reuse the
+  // primitives they cached.
+  if (app_->IsCapturing() || app_->IsLoadingCapture()) {
+    ++external_state_generation_;
+  }
+
   primitive_assembler_.StartNewFrame();
 
   text_renderer_static_.Init();
@@ -12,6 +12,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -21,6 +22,7 @@
 #include "ApiInterface/Orbit.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/TimerChain.h"
+#include "ClientData/TimerPyramid.h"
 #include "ClientFlags/ClientFlags.h"
 #include "ClientProtos/capture_data.pb.h"
 #include "DisplayFormats/DisplayFormats.h"
@@ -37,6 +39,7 @@
 using orbit_client_data::ScopeId;
 using orbit_client_data::TimerChain;
 using orbit_client_data::TimerData;
+using orbit_client_data::TimerPyramid;
 using orbit_client_protos::TimerInfo;
 
 using orbit_gl::PickingUserData;
@@ -229,23 +232,18 @@ bool TimerTrack::DrawTimer(TextRenderer& text_renderer, const TimerInfo* prev_ti
         world_timer_y + box_height);
     PrimitiveAssembler* primitive_assembler = draw_data.primitive_assembler;
     Quad trapezium({top_left, bottom_left, bottom_right, top_right});
-    draw_data.primitive_assembler->AddShadedTrapezium(
-        trapezium, draw_data.z, color,
-        CreatePickingUserData(*primitive_assembler, *current_timer_info));
+    draw_data.primitive_assembler->AddShadedTrapezium(trapezium, draw_data.z, color,
+                                                      CreatePickingUserData(*current_timer_info));
     float width =
         world_x_info_right_overlap.world_x_start - world_x_info_left_overlap.world_x_start;
 
     if (ShouldHaveBorder(current_timer_info, draw_data.histogram_selection_range, width)) {
-      primitive_assembler->AddQuadBorder(
-          trapezium, GlCanvas::kZValueBoxBorder, TimerTrack::kBoxBorderColor,
-          CreatePickingUserData(*primitive_assembler, *current_timer_info));
+      primitive_assembler->AddQuadBorder(trapezium, GlCanvas::kZValueBoxBorder,
+                                         TimerTrack::kBoxBorderColor,
+                                         CreatePickingUserData(*current_timer_info));
     }
   } else {
-    PrimitiveAssembler* primitive_assembler = draw_data.primitive_assembler;
-    auto user_data = std::make_unique<PickingUserData>(
-        current_timer_info, [&, primitive_assembler](PickingId id) {
-          return this->GetBoxTooltip(*primitive_assembler, id);
-        });
+    PickingUserData user_data = CreatePickingUserData(*current_timer_info);
 
     WorldXInfo world_x_info = ToWorldX(start_us, end_us, draw_data.inv_time_window,
                                        draw_data.track_start_x, draw_data.track_width);
@@ -289,7 +287,6 @@ void TimerTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
 
   draw_data.z = GlCanvas::kZValueBox;
 
-  std::vector<const orbit_client_data::TimerChain*> chains = timer_data_->GetChains();
   draw_data.selected_timer = app_->selected_timer();
   draw_data.highlighted_scope_id = app_->GetScopeIdToHighlight();
   draw_data.highlighted_group_id = app_->GetGroupIdToHighlight();
@@ -304,6 +301,18 @@ void TimerTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
   draw_data.min_timegraph_tick = timeline_info_->GetTickFromUs(timeline_info_->GetMinTimeUs());
   draw_data.histogram_selection_range = app_->GetHistogramSelectionRange();
 
+  // When a pixel spans many timers, only visit one timer per bucket of the timer pyramid.
+  std::optional<uint32_t> pyramid_level;
+  if (CanDrawTimersFromPyramid() && std::isfinite(draw_data.ns_per_pixel)) {
+    pyramid_level = TimerPyramid::GetCoarsestLevelWithBucketWidthAtMost(
+        static_cast<uint64_t>(draw_data.ns_per_pixel));
+  }
+  if (pyramid_level.has_value()) {
+    DrawTimersFromPyramid(text_renderer, draw_data, pyramid_level.value());
+    return;
+  }
+
+  std::vector<const orbit_client_data::TimerChain*> chains = timer_data_->GetChains();
   for (const TimerChain* chain : chains) {
     ORBIT_CHECK(chain != nullptr);
     // In order to draw overlaps correctly, we need for every text box to be drawn (current),
@@ -347,6 +356,23 @@ void TimerTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
   }
 }
 
+void TimerTrack::DrawTimersFromPyramid(TextRenderer& text_renderer,
+                                       const internal::DrawData& draw_data, uint32_t level) {
+  for (uint32_t depth = 0; depth < timer_data_->GetDepth(); ++depth) {
+    // The buckets are at most a pixel wide, so the longest timer of a bucket is drawn as a box if
+    // it spans several pixels, or else as a line that hides the other timers of the bucket.
+    uint64_t min_ignore = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ignore = std::numeric_limits<uint64_t>::min();
+    for (const TimerPyramid::Bucket& bucket : timer_data_->GetTimerPyramidBuckets(
+             depth, level, draw_data.min_tick, draw_data.max_tick)) {
+      if (DrawTimer(text_renderer, /*prev_timer_info=*/nullptr, /*next_timer_info=*/nullptr,
+                    draw_data, bucket.longest_timer, &min_ignore, &max_ignore)) {
+        ++visible_timer_count_;
+      }
+    }
+  }
+}
+
 void TimerTrack::OnTimer(const TimerInfo& timer_info) {
   timer_data_->AddTimer(timer_info, timer_info.depth());
 }
@@ -374,8 +400,7 @@ const TimerInfo* TimerTrack::GetDown(const TimerInfo& timer_info) const {
 
 bool TimerTrack::IsEmpty() const { return timer_data_->IsEmpty(); }
 
-std::string TimerTrack::GetBoxTooltip(const PrimitiveAssembler& /*primitive_assembler*/,
-                                      PickingId /*id*/) const {
+std::string TimerTrack::GetBoxTooltip(const PickingUserData& /*user_data*/) const {
   return "";
 }
 
@@ -89,35 +89,32 @@ void TracepointThreadBar::DoUpdatePrimitives(PrimitiveAssembler& primitive_assem
                                           white_transparent);
           }
         });
-
-  } else {
-    constexpr float kPickingBoxWidth = 9.0f;
-    constexpr float kPickingBoxOffset = kPickingBoxWidth / 2.0f;
-
-    capture_data_->ForEachTracepointEventOfThreadInTimeRange(
-        GetThreadId(), min_tick, max_tick,
-        [&](const orbit_client_data::TracepointEventInfo& tracepoint) {
-          uint64_t time = tracepoint.timestamp_ns();
-          Vec2 pos(timeline_info_->GetWorldFromTick(time) - kPickingBoxOffset,
-                   GetPos()[1] - track_height + 1);
-          Vec2 size(kPickingBoxWidth, track_height);
-          auto user_data =
-              std::make_unique<PickingUserData>(nullptr, [&](PickingId id) -> std::string {
-                return GetTracepointTooltip(primitive_assembler, id);
-              });
-          user_data->custom_data_ = &tracepoint;
-          primitive_assembler.AddShadedBox(pos, size, z, white, std::move(user_data));
-        });
   }
+
+  // The boxes used for picking are transparent, as they are also used to find the hovered
+  // tracepoint when not picking.
+  constexpr float kPickingBoxWidth = 9.0f;
+  constexpr float kPickingBoxOffset = kPickingBoxWidth / 2.0f;
+  static const Color kTransparent{0, 0, 0, 0};
+
+  capture_data_->ForEachTracepointEventOfThreadInTimeRange(
+      GetThreadId(), min_tick, max_tick,
+      [&](const orbit_client_data::TracepointEventInfo& tracepoint) {
+        uint64_t time = tracepoint.timestamp_ns();
+        Vec2 pos(timeline_info_->GetWorldFromTick(time) - kPickingBoxOffset,
+                 GetPos()[1] - track_height + 1);
+        Vec2 size(kPickingBoxWidth, track_height);
+        PickingUserData user_data(nullptr, &tracepoint_tooltip_callback_);
+        user_data.custom_data_ = &tracepoint;
+        primitive_assembler.AddShadedBox(pos, size, z, kTransparent, std::move(user_data));
+      });
 }
 
-std::string TracepointThreadBar::GetTracepointTooltip(PrimitiveAssembler& primitive_assembler,
-                                                      PickingId id) const {
-  const auto* user_data = primitive_assembler.GetUserData(id);
-  ORBIT_CHECK(user_data && user_data->custom_data_);
+std::string TracepointThreadBar::GetTracepointTooltip(const PickingUserData& user_data) const {
+  ORBIT_CHECK(user_data.custom_data_ != nullptr);
 
   const auto* tracepoint_event_info =
-      static_cast<const orbit_client_data::TracepointEventInfo*>(user_data->custom_data_);
+      static_cast<const orbit_client_data::TracepointEventInfo*>(user_data.custom_data_);
 
   uint64_t tracepoint_id = tracepoint_event_info->tracepoint_id();
 
@@ -325,23 +325,23 @@ void TrackContainer::DrawIncompleteDataIntervals(PrimitiveAssembler& primitive_a
     start_x = std::max(layout_->GetTrackHeaderWidth(), start_x);
     const Vec2 pos{start_x, world_start_y};
     const Vec2 size{end_x - start_x, world_height};
-    float z_value = GlCanvas::kZValueIncompleteDataOverlay;
-
-    std::unique_ptr<PickingUserData> user_data = nullptr;
-    // Show a tooltip when hovering.
-    if (picking_mode == PickingMode::kHover) {
-      // This overlay is placed in front of the tracks (with transparency), but when it comes to
-      // tooltips give it a much lower Z value, so that it's possible to "hover through" it.
-      z_value = GlCanvas::kZValueIncompleteDataOverlayPicking;
-      user_data = std::make_unique<PickingUserData>(nullptr, [](PickingId /*id*/) {
-        return std::string{
-            "Capture data is incomplete in this time range. Some information might be inaccurate."};
-      });
-    }
-
     static const Color kIncompleteDataIntervalOrange{255, 128, 0, 32};
-    primitive_assembler.AddBox(MakeBox(pos, size), z_value, kIncompleteDataIntervalOrange,
-                               std::move(user_data));
+    primitive_assembler.AddBox(MakeBox(pos, size), GlCanvas::kZValueIncompleteDataOverlay,
+                               kIncompleteDataIntervalOrange);
+
+    // Show a tooltip when hovering. This overlay is placed in front of the tracks (with
+    // transparency), but when it comes to tooltips, a transparent copy with a much lower Z value is
+    // used, so that it's possible to "hover through" it.
+    static const PickingUserData::TooltipCallback kIncompleteDataTooltipCallback =
+        [](const PickingUserData& /*user_data*/) {
+          return std::string{
+              "Capture data is incomplete in this time range. Some information might be "
+              "inaccurate."};
+        };
+    static const Color kTransparent{0, 0, 0, 0};
+    primitive_assembler.AddBox(MakeBox(pos, size), GlCanvas::kZValueIncompleteDataOverlayPicking,
+                               kTransparent,
+                               PickingUserData(nullptr, &kIncompleteDataTooltipCallback));
   }
 }
 
@@ -472,7 +472,8 @@ Track* TrackManager::GetOrCreateTrackFromTimerInfo(const TimerInfo& timer_info)
 SchedulerTrack* TrackManager::GetOrCreateSchedulerTrack() {
   absl::WriterMutexLock lock(&mutex_);
   if (scheduler_track_ == nullptr) {
-    auto [unused, timer_data] = capture_data_->CreateTimerData();
+    // SchedulerTrack never draws timers from TimerPyramids, so its TimerData doesn't build them.
+    auto [unused, timer_data] = capture_data_->CreateTimerData(/*build_timer_pyramids=*/false);
     scheduler_track_ =
         std::make_shared<SchedulerTrack>(track_container_, timeline_info_, viewport_, layout_, app_,
                                          module_manager_, capture_data_, timer_data);
@@ -515,7 +516,9 @@ GpuTrack* TrackManager::GetOrCreateGpuTrack(uint64_t timeline_hash) {
       app_->GetStringManager()->Get(timeline_hash).value_or(std::to_string(timeline_hash));
   std::shared_ptr<GpuTrack> track = gpu_tracks_[timeline];
   if (track == nullptr) {
-    auto [unused1, submission_timer_data] = capture_data_->CreateTimerData();
+    // GpuSubmissionTrack::CanDrawTimersFromPyramid is false, unlike for GpuDebugMarkerTrack.
+    auto [unused1, submission_timer_data] =
+        capture_data_->CreateTimerData(/*build_timer_pyramids=*/false);
     auto [unused2, marker_timer_data] = capture_data_->CreateTimerData();
     track = std::make_shared<GpuTrack>(
         track_container_, timeline_info_, viewport_, layout_, timeline_hash, app_, module_manager_,
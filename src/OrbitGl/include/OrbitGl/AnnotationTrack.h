@@ -11,6 +11,7 @@
 #include <string>
 #include <utility>
 
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/TextRenderer.h"
@@ -52,6 +53,10 @@ class AnnotationTrack {
   std::optional<std::pair<std::string, double>> warning_threshold_ = std::nullopt;
   std::optional<std::pair<std::string, double>> value_upper_bound_ = std::nullopt;
   std::optional<std::pair<std::string, double>> value_lower_bound_ = std::nullopt;
+  const orbit_gl::PickingUserData::TooltipCallback value_upper_bound_tooltip_callback_ =
+      [this](const orbit_gl::PickingUserData& /*user_data*/) {
+        return GetValueUpperBoundTooltip();
+      };
 };
 
 #endif  // ORBIT_GL_ANNOTATION_TRACK_H_
\ No newline at end of file
@@ -42,8 +42,8 @@ class AsyncTrack final : public TimerTrack {
 
   [[nodiscard]] std::string GetName() const override { return name_; };
   [[nodiscard]] Type GetType() const override { return Type::kAsyncTrack; };
-  [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
-                                          PickingId id) const override;
+  [[nodiscard]] std::string GetBoxTooltip(
+      const orbit_gl::PickingUserData& user_data) const override;
   void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
   [[nodiscard]] float GetHeight() const override;
 
@@ -109,6 +109,15 @@ class BatchRenderGroupStateManager {
     group_name_to_state_[group_name] = state;
   }
 
+  // Sets the states of all groups that have a state in `other`.
+  void SetGroupStates(const BatchRenderGroupStateManager& other) {
+    for (const auto& [group_name, state] : other.group_name_to_state_) {
+      group_name_to_state_[group_name] = state;
+    }
+  }
+
+  void RemoveGroupState(std::string_view group_name) { group_name_to_state_.erase(group_name); }
+
  private:
   absl::flat_hash_map<std::string, BatchRenderGroupState> group_name_to_state_;
 };
@@ -28,8 +28,11 @@ class Batcher : public BatcherInterface {
 
   [[nodiscard]] BatcherId GetBatcherId() const { return batcher_id_; }
 
-  void PushTranslation(float x, float y, float z = 0.f) { translations_.PushTranslation(x, y, z); }
-  void PopTranslation() { translations_.PopTranslation(); }
+  // Virtual so that a RecordingBatcher can record the translations.
+  virtual void PushTranslation(float x, float y, float z = 0.f) {
+    translations_.PushTranslation(x, y, z);
+  }
+  virtual void PopTranslation() { translations_.PopTranslation(); }
 
   struct Statistics {
     size_t reserved_memory = 0;
@@ -5,6 +5,10 @@
 #ifndef ORBIT_GL_BATCHER_INTERFACE_H_
 #define ORBIT_GL_BATCHER_INTERFACE_H_
 
+#include <functional>
+#include <optional>
+#include <string>
+
 #include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/BatchRenderGroup.h"
 #include "OrbitGl/Geometry.h"
@@ -12,15 +16,19 @@
 
 namespace orbit_gl {
 
+// Data associated with a pickable primitive, usually the timer it represents. User data is stored
+// for every primitive, so it only holds pointers: The tooltip of a primitive is only generated when
+// it is hovered, by calling `generate_tooltip_` with its user data. The callback is shared by all
+// primitives of an element and owned by the element, usually as a member.
 struct PickingUserData {
-  using TooltipCallback = std::function<std::string(PickingId)>;
+  using TooltipCallback = std::function<std::string(const PickingUserData&)>;
   const orbit_client_protos::TimerInfo* timer_info_;
-  TooltipCallback generate_tooltip_;
+  const TooltipCallback* generate_tooltip_;
   const void* custom_data_ = nullptr;
 
   explicit PickingUserData(const orbit_client_protos::TimerInfo* timer_info = nullptr,
-                           TooltipCallback generate_tooltip = nullptr)
-      : timer_info_(timer_info), generate_tooltip_(std::move(generate_tooltip)) {}
+                           const TooltipCallback* generate_tooltip = nullptr)
+      : timer_info_(timer_info), generate_tooltip_(generate_tooltip) {}
 };
 
 // Collects primitives to be rendered at a later point in time.
@@ -35,12 +43,12 @@ class BatcherInterface {
 
   virtual void ResetElements() = 0;
   virtual void AddLine(Vec2 from, Vec2 to, float z, const Color& color, const Color& picking_color,
-                       std::unique_ptr<PickingUserData> user_data) = 0;
+                       std::optional<PickingUserData> user_data) = 0;
   virtual void AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
-                      const Color& picking_color, std::unique_ptr<PickingUserData> user_data) = 0;
+                      const Color& picking_color, std::optional<PickingUserData> user_data) = 0;
   virtual void AddTriangle(const Triangle& triangle, float z, const std::array<Color, 3>& colors,
                            const Color& picking_color,
-                           std::unique_ptr<PickingUserData> user_data) = 0;
+                           std::optional<PickingUserData> user_data) = 0;
   [[nodiscard]] virtual uint32_t GetNumElements() const = 0;
 
   [[nodiscard]] virtual std::vector<BatchRenderGroupId> GetNonEmptyRenderGroups() const = 0;
@@ -15,6 +15,7 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientProtos/capture_data.pb.h"
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
@@ -56,8 +57,10 @@ class CallstackThreadBar : public ThreadBar {
 
  private:
   void SelectCallstacks();
-  [[nodiscard]] std::string GetSampleTooltip(const PrimitiveAssembler& primitive_assembler,
-                                             PickingId id) const;
+  [[nodiscard]] std::string GetSampleTooltip(const PickingUserData& user_data) const;
+
+  const PickingUserData::TooltipCallback sample_tooltip_callback_ =
+      [this](const PickingUserData& user_data) { return GetSampleTooltip(user_data); };
 };
 
 }  // namespace orbit_gl
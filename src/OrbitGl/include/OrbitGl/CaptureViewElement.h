@@ -7,8 +7,10 @@
 
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "OrbitGl/CoreMath.h"
@@ -31,6 +33,7 @@ class CaptureViewElement : public Pickable {
  public:
   explicit CaptureViewElement(CaptureViewElement* parent, const Viewport* viewport,
                               const TimeGraphLayout* layout);
+  ~CaptureViewElement() override;
 
   void UpdateLayout();
 
@@ -123,6 +126,14 @@ class CaptureViewElement : public Pickable {
 
   [[nodiscard]] bool HasLayoutChanged() const { return has_layout_changed_; }
 
+  struct PrimitivesCacheStatistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+  };
+  // Counts how often this element and all its descendants replayed their cached primitives, or had
+  // to generate them instead. See `CachesPrimitives`.
+  [[nodiscard]] PrimitivesCacheStatistics GetPrimitivesCacheStatistics() const;
+
  protected:
   struct DrawContext {
     std::optional<uint64_t> current_mouse_tick;
@@ -173,6 +184,16 @@ class CaptureViewElement : public Pickable {
   // reserve at least one block of memory. It also increases the number of draw calls.
   [[nodiscard]] virtual bool RequestSeparateRenderGroup() const { return false; }
 
+  // If TRUE, the primitives and texts of this element and its children are recorded, and replayed
+  // by `UpdatePrimitives` instead of generating them again as long as this element didn't request
+  // an update, and neither the visible time range, the size of the viewport nor the external state
+  // generation (see below) changed. The cache is not used while picking.
+  [[nodiscard]] virtual bool CachesPrimitives() const { return false; }
+
+  // Changes whenever state that is not owned by the elements, but affects their primitives, changes
+  // (e.g. the selected timer). By default, this is the generation of the parent.
+  [[nodiscard]] virtual uint64_t GetExternalStateGeneration() const;
+
   [[nodiscard]] uint32_t GetUid() const { return uid_; }
 
  private:
@@ -193,6 +214,38 @@ class CaptureViewElement : public Pickable {
   void PostRender(RenderGroups&& previous_groups, PrimitiveAssembler& primitive_assembler,
                   TextRenderer& text_renderer);
 
+  // Calls DoUpdatePrimitives and updates the primitives of the children.
+  void UpdatePrimitivesOfContent(PrimitiveAssembler& primitive_assembler,
+                                 TextRenderer& text_renderer, uint64_t min_tick, uint64_t max_tick,
+                                 PickingMode picking_mode);
+
+  struct PrimitivesCacheKey {
+    uint64_t min_tick;
+    uint64_t max_tick;
+    int screen_width;
+    int screen_height;
+    float world_width;
+    float world_height;
+    uint64_t external_state_generation;
+
+    friend bool operator==(const PrimitivesCacheKey& lhs, const PrimitivesCacheKey& rhs) {
+      return std::tie(lhs.min_tick, lhs.max_tick, lhs.screen_width, lhs.screen_height,
+                      lhs.world_width, lhs.world_height, lhs.external_state_generation) ==
+             std::tie(rhs.min_tick, rhs.max_tick, rhs.screen_width, rhs.screen_height,
+                      rhs.world_width, rhs.world_height, rhs.external_state_generation);
+    }
+  };
+  struct PrimitivesCache;
+
+  [[nodiscard]] PrimitivesCacheKey MakePrimitivesCacheKey(uint64_t min_tick,
+                                                          uint64_t max_tick) const;
+  void UpdatePrimitivesUsingCache(PrimitiveAssembler& primitive_assembler,
+                                  TextRenderer& text_renderer, uint64_t min_tick,
+                                  uint64_t max_tick);
+
+  std::unique_ptr<PrimitivesCache> primitives_cache_;
+  PrimitivesCacheStatistics primitives_cache_statistics_;
+
   friend class CaptureViewElementTester;
 };
 }  // namespace orbit_gl
@@ -11,6 +11,7 @@
 #include <QPainter>
 #include <QtGlobal>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -22,7 +23,9 @@
 #include "OrbitGl/Batcher.h"
 #include "OrbitGl/CaptureStats.h"
 #include "OrbitGl/CaptureWindowDebugInterface.h"
+#include "OrbitGl/CoreMath.h"
 #include "OrbitGl/GlCanvas.h"
+#include "OrbitGl/PickingIndex.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/SimpleTimings.h"
 #include "OrbitGl/TimeGraph.h"
@@ -85,6 +88,8 @@ class CaptureWindow : public GlCanvas, public orbit_gl::CaptureWindowDebugInterf
 
   [[nodiscard]] virtual std::string GetHelpText() const;
   [[nodiscard]] virtual bool ShouldAutoZoom() const;
+  [[nodiscard]] std::optional<orbit_gl::PickedPrimitive> FindPickedPrimitive(
+      Vec2 pos) const override;
   void HandlePickedElement(PickingMode picking_mode, PickingId picking_id, int x, int y) override;
   orbit_gl::Batcher& GetBatcherById(BatcherId batcher_id);
 
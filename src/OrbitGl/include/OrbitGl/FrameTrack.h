@@ -62,8 +62,8 @@ class FrameTrack : public TimerTrack {
   [[nodiscard]] std::string GetTimesliceText(
       const orbit_client_protos::TimerInfo& timer) const override;
   [[nodiscard]] std::string GetTooltip() const override;
-  [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
-                                          PickingId id) const override;
+  [[nodiscard]] std::string GetBoxTooltip(
+      const orbit_gl::PickingUserData& user_data) const override;
 
  protected:
   void DoUpdatePrimitives(orbit_gl::PrimitiveAssembler& primitive_assembler,
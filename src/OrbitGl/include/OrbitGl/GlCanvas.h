@@ -10,6 +10,7 @@
 #include <QOpenGLFunctions>
 #include <QPainter>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "OrbitGl/BatchRenderGroup.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/OpenGlBatcher.h"
+#include "OrbitGl/PickingIndex.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/QtTextRenderer.h"
@@ -105,6 +107,11 @@ class GlCanvas : protected QOpenGLFunctions {
 
   void SetPickingMode(PickingMode mode);
 
+  // Returns the pickable primitive that was drawn last at `pos` in world coordinates, i.e. the one
+  // on top, without drawing a picking pass.
+  [[nodiscard]] virtual std::optional<orbit_gl::PickedPrimitive> FindPickedPrimitive(
+      Vec2 pos) const;
+
   Vec2 mouse_click_pos_world_;
   Vec2i mouse_move_pos_screen_ = Vec2i(0, 0);
   Vec2 select_start_pos_world_ = Vec2(0, 0);
@@ -137,6 +144,7 @@ class GlCanvas : protected QOpenGLFunctions {
 
  private:
   void Pick(PickingMode picking_mode, int x, int y);
+  void PickFromIndex(PickingMode picking_mode, int x, int y);
   virtual void HandlePickedElement(PickingMode /*picking_mode*/, PickingId /*picking_id*/,
                                    int /*x*/, int /*y*/) = 0;
 };
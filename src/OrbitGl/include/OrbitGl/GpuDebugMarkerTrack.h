@@ -62,8 +62,8 @@ class GpuDebugMarkerTrack final : public TimerTrack {
   [[nodiscard]] std::string GetTimesliceText(
       const orbit_client_protos::TimerInfo& timer) const override;
 
-  [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
-                                          PickingId id) const override;
+  [[nodiscard]] std::string GetBoxTooltip(
+      const orbit_gl::PickingUserData& user_data) const override;
 
  private:
   orbit_string_manager::StringManager* string_manager_;
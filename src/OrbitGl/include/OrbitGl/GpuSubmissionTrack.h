@@ -77,11 +77,14 @@ class GpuSubmissionTrack : public TimerTrack {
                                     bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
   [[nodiscard]] bool TimerFilter(const orbit_client_protos::TimerInfo& timer) const override;
+  // Timers of different GPU stages share a depth, but are drawn at different heights and filtered
+  // separately.
+  [[nodiscard]] bool CanDrawTimersFromPyramid() const override { return false; }
 
   [[nodiscard]] std::string GetTimesliceText(
       const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
-                                          PickingId id) const override;
+  [[nodiscard]] std::string GetBoxTooltip(
+      const orbit_gl::PickingUserData& user_data) const override;
 
  private:
   uint64_t timeline_hash_;
@@ -22,6 +22,7 @@
 #include "ClientData/ModuleManager.h"
 #include "ClientData/TimerTrackDataIdManager.h"
 #include "ClientProtos/capture_data.pb.h"
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/MultivariateTimeSeries.h"
@@ -131,6 +132,7 @@ class GraphTrack : public Track {
   [[nodiscard]] bool HasLegend() const;
 
   std::vector<Color> series_colors_;
+  std::vector<orbit_gl::PickingUserData::TooltipCallback> legend_tooltip_callbacks_;
 };
 
 #endif  // ORBIT_GL_GRAPH_TRACK_H_
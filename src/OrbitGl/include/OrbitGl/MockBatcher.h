@@ -14,6 +14,7 @@
 #include <array>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <set>
 #include <unordered_set>
 #include <vector>
@@ -32,13 +33,13 @@ class MockBatcher : public Batcher {
  public:
   explicit MockBatcher(BatcherId batcher_id = BatcherId::kTimeGraph);
   void AddLine(Vec2 from, Vec2 to, float z, const Color& color, const Color& /*picking_color*/,
-               std::unique_ptr<PickingUserData> /*user_data*/) override;
+               std::optional<PickingUserData> /*user_data*/) override;
   void AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
               const Color& /*picking_color*/,
-              std::unique_ptr<PickingUserData> /*user_data*/) override;
+              std::optional<PickingUserData> /*user_data*/) override;
   void AddTriangle(const Triangle& triangle, float z, const std::array<Color, 3>& colors,
                    const Color& /*picking_color*/,
-                   std::unique_ptr<PickingUserData> /*user_data*/) override;
+                   std::optional<PickingUserData> /*user_data*/) override;
 
   void ResetElements() override;
   [[nodiscard]] uint32_t GetNumElements() const override;
@@ -14,7 +14,9 @@
 #include <algorithm>
 #include <array>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -24,6 +26,7 @@
 #include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/Geometry.h"
+#include "OrbitGl/PickingIndex.h"
 #include "OrbitGl/PickingManager.h"
 
 namespace orbit_gl {
@@ -74,11 +77,21 @@ struct PrimitiveBuffers {
     line_buffer.Reset();
     box_buffer.Reset();
     triangle_buffer.Reset();
+    picking_index.Clear();
+    num_primitives_in_picking_index = 0;
+  }
+
+  [[nodiscard]] size_t GetNumPrimitives() const {
+    return line_buffer.lines_.size() + box_buffer.boxes_.size() + triangle_buffer.triangles_.size();
   }
 
   LineBuffer line_buffer;
   BoxBuffer box_buffer;
   TriangleBuffer triangle_buffer;
+  // Filled from the buffers by the first OpenGlBatcher::FindPickedPrimitive after they changed, so
+  // that adding primitives doesn't pay for it, and only render groups that get hovered do.
+  mutable PickingIndex picking_index;
+  mutable size_t num_primitives_in_picking_index = 0;
   BatchRenderGroupState metadata;
 };
 
@@ -95,15 +108,15 @@ class OpenGlBatcher : public Batcher, protected QOpenGLFunctions {
 
   void ResetElements() override;
   void AddLine(Vec2 from, Vec2 to, float z, const Color& color, const Color& picking_color,
-               std::unique_ptr<PickingUserData> user_data = nullptr) override;
+               std::optional<PickingUserData> user_data = std::nullopt) override;
   void AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
               const Color& picking_color,
-              std::unique_ptr<PickingUserData> user_data = nullptr) override;
+              std::optional<PickingUserData> user_data = std::nullopt) override;
   void AddTriangle(const Triangle& triangle, float z, const std::array<Color, 3>& colors,
                    const Color& picking_color,
-                   std::unique_ptr<PickingUserData> user_data = nullptr) override;
+                   std::optional<PickingUserData> user_data = std::nullopt) override;
 
-  [[nodiscard]] uint32_t GetNumElements() const override { return user_data_.size(); }
+  [[nodiscard]] uint32_t GetNumElements() const override { return user_data_indices_.size(); }
   [[nodiscard]] std::vector<BatchRenderGroupId> GetNonEmptyRenderGroups() const override;
   void DrawRenderGroup(const BatchRenderGroupId& group, bool picking) override;
 
@@ -111,12 +124,28 @@ class OpenGlBatcher : public Batcher, protected QOpenGLFunctions {
 
   [[nodiscard]] Statistics GetStatistics() const override;
 
+  // Returns the primitive at `pos` that a picking pass would read back, without drawing one. Only
+  // primitives that have user data or belong to a pickable are considered.
+  [[nodiscard]] std::optional<PickedPrimitive> FindPickedPrimitive(
+      Vec2 pos, const BatchRenderGroupStateManager& manager) const;
+
  protected:
   absl::flat_hash_map<BatchRenderGroupId, orbit_gl_internal::PrimitiveBuffers>
       primitive_buffers_by_group_;
-  std::vector<std::unique_ptr<PickingUserData>> user_data_;
+  // Elements without user data have the index kNoUserData. The user data of the other elements is
+  // stored contiguously in `user_data_`, which keeps its capacity when the elements are reset.
+  static constexpr uint32_t kNoUserData = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> user_data_indices_;
+  std::vector<PickingUserData> user_data_;
 
  private:
+  // The primitive types in the order in which DrawRenderGroup draws them.
+  enum class PrimitiveOrder : uint64_t { kBox, kLine, kTriangle };
+
+  void UpdatePickingIndex(const orbit_gl_internal::PrimitiveBuffers& buffers) const;
+  [[nodiscard]] bool IsPickable(PickingId id) const;
+  void AddUserData(std::optional<PickingUserData> user_data);
+
   void DrawLineBuffer(const BatchRenderGroupId& group, bool picking);
   void DrawBoxBuffer(const BatchRenderGroupId& group, bool picking);
   void DrawTriangleBuffer(const BatchRenderGroupId& group, bool picking);
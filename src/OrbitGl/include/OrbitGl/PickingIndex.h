@@ -0,0 +1,94 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_GL_PICKING_INDEX_H_
+#define ORBIT_GL_PICKING_INDEX_H_
+
+#include <absl/container/flat_hash_map.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/PickingManager.h"
+
+namespace orbit_gl {
+
+// Spatial index of the pickable primitives of a render group. It finds the primitive under a point
+// on the CPU, which otherwise requires rendering a picking pass and reading back a pixel.
+//
+// Primitives are approximated by their bounding rectangles and stored in one row per vertical
+// extent, e.g. one row per depth of a track. Rectangles may overlap, like the samples of a thread
+// bar. Finalize sorts the rows by min_y and the entries of each row by min_x, and records for each
+// of them the largest max_y or max_x up to it. A point is then found with a binary search, and only
+// the rows or entries that still reach it, i.e. the ones overlapping it, are scanned backwards.
+class PickingIndex {
+ public:
+  struct Hit {
+    PickingId id;
+    // Position of the primitive in the drawing order of the render group within its batcher.
+    uint64_t order;
+  };
+
+  // Keeps the allocated memory, as the index is refilled with similar primitives on every update.
+  void Clear();
+  // Coordinates are in pixels, i.e. a rectangle from `min` to `max` covers the pixels with
+  // min <= x < max and min <= y < max.
+  void Add(uint64_t order, Vec2 min, Vec2 max, PickingId id);
+  // Must be called after the last Add and before Find.
+  void Finalize();
+
+  // Returns the primitive at `pos` that is drawn last, i.e. the one a picking pass would read back.
+  [[nodiscard]] std::optional<Hit> Find(Vec2 pos) const;
+
+ private:
+  struct Entry {
+    float min_x;
+    float max_x;
+    // The largest max_x of the entries of the row up to this one, once the index is finalized.
+    float max_x_so_far;
+    uint64_t order;
+    PickingId id;
+  };
+  struct Row {
+    float min_y;
+    float max_y;
+    // The largest max_y of the rows up to this one, once the index is finalized.
+    float max_y_so_far;
+    std::vector<Entry> entries;
+  };
+
+  static constexpr size_t kNoRow = std::numeric_limits<size_t>::max();
+
+  std::vector<Row> rows_;
+  // Index of the row of each vertical extent while the index is filled.
+  absl::flat_hash_map<std::pair<float, float>, size_t> row_by_extent_;
+  // The row that the last primitive was added to. Consecutive primitives, e.g. the timers of a
+  // depth, mostly go to the same row, which avoids looking it up.
+  size_t last_row_ = kNoRow;
+  bool is_finalized_ = true;
+  // Emptied entries of the rows before the last Clear, to be reused by new rows.
+  std::vector<std::vector<Entry>> unused_entries_;
+};
+
+// A primitive found by the PickingIndex of a render group of a batcher.
+struct PickedPrimitive {
+  PickingId id;
+  BatchRenderGroupId group;
+  uint64_t order;
+};
+
+// Returns whether `lhs` is drawn before `rhs`. Primitives of different batchers are ordered by
+// render group first, and then by batcher, as the batchers are drawn in the order of their
+// BatcherId for each render group.
+[[nodiscard]] bool IsDrawnBefore(const PickedPrimitive& lhs, const PickedPrimitive& rhs);
+
+}  // namespace orbit_gl
+
+#endif  // ORBIT_GL_PICKING_INDEX_H_
@@ -109,6 +109,11 @@ struct PickingId {
     return Color(color_values[0], color_values[1], color_values[2], color_values[3]);
   }
 
+  [[nodiscard]] static PickingId FromColor(const Color& color) {
+    std::array<uint8_t, 4> color_values{color[0], color[1], color[2], color[3]};
+    return FromPixelValue(absl::bit_cast<uint32_t>(color_values));
+  }
+
   uint32_t element_id;
   PickingType type;
   BatcherId batcher_id;
@@ -120,6 +125,9 @@ class PickingManager {
   PickingManager(PickingManager& rhs) = delete;
 
   void Reset();
+  // Forgets the pickables that don't exist anymore. Unlike Reset, this keeps the ids of the others,
+  // so that primitives that were generated in earlier frames can still be picked.
+  void RemoveExpiredPickables();
 
   void Pick(PickingId id, int x, int y);
   void Release();
@@ -13,6 +13,7 @@
 #include <cmath>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -65,18 +66,18 @@ class PrimitiveAssembler {
   void PopTranslation() { batcher_->PopTranslation(); }
 
   void AddLine(const Vec2& from, const Vec2& to, float z, const Color& color,
-               std::unique_ptr<PickingUserData> user_data = nullptr);
+               std::optional<PickingUserData> user_data = std::nullopt);
   void AddVerticalLine(const Vec2& pos, float size, float z, const Color& color,
-                       std::unique_ptr<PickingUserData> user_data = nullptr);
+                       std::optional<PickingUserData> user_data = std::nullopt);
   void AddLine(const Vec2& from, const Vec2& to, float z, const Color& color,
                const std::shared_ptr<Pickable>& pickable);
   void AddVerticalLine(const Vec2& pos, float size, float z, const Color& color,
                        const std::shared_ptr<Pickable>& pickable);
 
   void AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
-              std::unique_ptr<PickingUserData> user_data = nullptr);
+              std::optional<PickingUserData> user_data = std::nullopt);
   void AddBox(const Quad& box, float z, const Color& color,
-              std::unique_ptr<PickingUserData> user_data = nullptr);
+              std::optional<PickingUserData> user_data = std::nullopt);
   void AddBox(const Quad& box, float z, const Color& color,
               const std::shared_ptr<Pickable>& pickable);
 
@@ -84,7 +85,7 @@ class PrimitiveAssembler {
   void AddShadedBox(const Vec2& pos, const Vec2& size, float z, const Color& color,
                     ShadingDirection shading_direction);
   void AddShadedBox(const Vec2& pos, const Vec2& size, float z, const Color& color,
-                    std::unique_ptr<PickingUserData> user_data,
+                    std::optional<PickingUserData> user_data,
                     ShadingDirection shading_direction = ShadingDirection::kLeftToRight);
   void AddShadedBox(const Vec2& pos, const Vec2& size, float z, const Color& color,
                     const std::shared_ptr<Pickable>& pickable,
@@ -94,15 +95,15 @@ class PrimitiveAssembler {
 
   // TODO(b/227744958) This should probably be removed and AddBox should be used instead
   void AddShadedTrapezium(const Quad& trapezium, float z, const Color& color,
-                          std::unique_ptr<PickingUserData> user_data,
+                          std::optional<PickingUserData> user_data,
                           ShadingDirection shading_direction = ShadingDirection::kLeftToRight);
   void AddTriangle(const Triangle& triangle, float z, const Color& color,
                    const std::shared_ptr<Pickable>& pickable);
   void AddTriangle(const Triangle& triangle, float z, const Color& color,
-                   std::unique_ptr<PickingUserData> user_data = nullptr);
+                   std::optional<PickingUserData> user_data = std::nullopt);
 
   void AddQuadBorder(const Quad& quad, float z, const Color& color,
-                     std::unique_ptr<orbit_gl::PickingUserData> user_data);
+                     std::optional<orbit_gl::PickingUserData> user_data);
   void AddQuadBorder(const Quad& quad, float z, const Color& color);
   void AddAabbOutline(Vec2 pos, Vec2 size, float outline_width, float z, const Color& color);
   void AddCircle(const Vec2& position, float radius, float z, const Color& color);
@@ -135,6 +136,7 @@ class PrimitiveAssembler {
   }
 
   [[nodiscard]] BatchRenderGroupStateManager* GetRenderGroupManager() { return state_manager_; }
+  [[nodiscard]] Batcher* GetBatcher() const { return batcher_; }
 
   [[nodiscard]] PickingManager* GetPickingManager() const { return picking_manager_; }
   [[nodiscard]] const PickingUserData* GetUserData(PickingId id) const {
@@ -153,7 +155,7 @@ class PrimitiveAssembler {
   void AddBottomRightRoundedCorner(const Vec2& pos, float radius, float z, const Color& color);
   void AddTriangle(const Triangle& triangle, float z, const Color& color,
                    const Color& picking_color,
-                   std::unique_ptr<PickingUserData> user_data = nullptr);
+                   std::optional<PickingUserData> user_data = std::nullopt);
 
   static void GetBoxGradientColors(
       const Color& color, std::array<Color, 4>* colors,
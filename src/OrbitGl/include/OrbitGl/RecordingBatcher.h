@@ -0,0 +1,104 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_GL_RECORDING_BATCHER_H_
+#define ORBIT_GL_RECORDING_BATCHER_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/Batcher.h"
+#include "OrbitGl/BatcherInterface.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/Geometry.h"
+#include "OrbitGl/PickingManager.h"
+
+namespace orbit_gl {
+
+// Batcher that only records the calls it receives, so that primitives can be generated once and
+// then be added to the batcher that draws them with `CopyTo`, as often as needed and in the same
+// order as if they had been added to that batcher directly.
+//
+// Picking colors of lines, boxes and triangles encode the index of the element in its batcher, so
+// they are shifted by the number of elements the target batcher already has when copying.
+// Picking colors of Pickables are left unchanged.
+class RecordingBatcher : public Batcher {
+ public:
+  explicit RecordingBatcher(BatcherId batcher_id) : Batcher(batcher_id) {}
+
+  void PushTranslation(float x, float y, float z = 0.f) override;
+  void PopTranslation() override;
+  void SetCurrentRenderGroupName(std::string name) override;
+
+  void ResetElements() override;
+  void AddLine(Vec2 from, Vec2 to, float z, const Color& color, const Color& picking_color,
+               std::optional<PickingUserData> user_data) override;
+  void AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
+              const Color& picking_color, std::optional<PickingUserData> user_data) override;
+  void AddTriangle(const Triangle& triangle, float z, const std::array<Color, 3>& colors,
+                   const Color& picking_color, std::optional<PickingUserData> user_data) override;
+  [[nodiscard]] uint32_t GetNumElements() const override { return num_elements_; }
+
+  // Recorded primitives can't be drawn or picked before they are copied.
+  [[nodiscard]] std::vector<BatchRenderGroupId> GetNonEmptyRenderGroups() const override {
+    return {};
+  }
+  void DrawRenderGroup(const BatchRenderGroupId& /*group*/, bool /*picking*/) override {}
+  [[nodiscard]] const PickingUserData* GetUserData(PickingId /*id*/) const override {
+    return nullptr;
+  }
+  [[nodiscard]] Statistics GetStatistics() const override { return {}; }
+
+  // Adds the recorded calls to `batcher`, copying the user data of the primitives. `batcher` needs
+  // to have the same id as this batcher.
+  void CopyTo(Batcher& batcher) const;
+
+ private:
+  struct PushTranslationCall {
+    float x;
+    float y;
+    float z;
+  };
+  struct PopTranslationCall {};
+  struct SetRenderGroupNameCall {
+    std::string name;
+  };
+  struct AddLineCall {
+    Vec2 from;
+    Vec2 to;
+    float z;
+    Color color;
+    Color picking_color;
+    std::optional<PickingUserData> user_data;
+  };
+  struct AddBoxCall {
+    Quad box;
+    float z;
+    std::array<Color, 4> colors;
+    Color picking_color;
+    std::optional<PickingUserData> user_data;
+  };
+  struct AddTriangleCall {
+    Triangle triangle;
+    float z;
+    std::array<Color, 3> colors;
+    Color picking_color;
+    std::optional<PickingUserData> user_data;
+  };
+  using Call = std::variant<PushTranslationCall, PopTranslationCall, SetRenderGroupNameCall,
+                            AddLineCall, AddBoxCall, AddTriangleCall>;
+
+  std::vector<Call> calls_;
+  uint32_t num_elements_ = 0;
+};
+
+}  // namespace orbit_gl
+
+#endif  // ORBIT_GL_RECORDING_BATCHER_H_
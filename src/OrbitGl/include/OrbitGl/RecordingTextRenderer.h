@@ -0,0 +1,94 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_GL_RECORDING_TEXT_RENDERER_H_
+#define ORBIT_GL_RECORDING_TEXT_RENDERER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/TextRenderer.h"
+
+namespace orbit_gl {
+
+// TextRenderer that only records the texts it receives, so that they can be generated once and then
+// be added to the renderer that draws them with `CopyTo`. This is the TextRenderer counterpart of
+// RecordingBatcher.
+//
+// Measuring text is forwarded to `measuring_renderer`, which is usually the renderer the texts are
+// copied to. The layout of a text is only known once it is copied, so AddText doesn't support its out
+// parameters and AddTextTrailingCharsPrioritized always returns 0. Elements that lay out other
+// primitives around their texts can't be recorded.
+class RecordingTextRenderer : public TextRenderer {
+ public:
+  explicit RecordingTextRenderer(TextRendererInterface* measuring_renderer)
+      : measuring_renderer_(measuring_renderer) {}
+
+  void PushTranslation(float x, float y, float z = 0.f) override;
+  void PopTranslation() override;
+  void SetCurrentRenderGroupName(std::string name) override;
+
+  void Init() override {}
+  void Clear() override;
+
+  // Recorded texts can't be drawn before they are copied.
+  [[nodiscard]] std::vector<BatchRenderGroupId> GetRenderGroups() const override { return {}; }
+  void DrawRenderGroup(QPainter* /*painter*/, BatchRenderGroupStateManager& /*manager*/,
+                       const BatchRenderGroupId& /*group*/) override {}
+
+  void AddText(const char* text, float x, float y, float z, TextFormatting formatting) override;
+  void AddText(const char* text, float x, float y, float z, TextFormatting formatting,
+               Vec2* out_text_pos, Vec2* out_text_size) override;
+  float AddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
+                                        TextFormatting formatting,
+                                        size_t trailing_chars_length) override;
+
+  [[nodiscard]] float GetStringWidth(const char* text, uint32_t font_size) override;
+  [[nodiscard]] float GetStringHeight(const char* text, uint32_t font_size) override;
+  [[nodiscard]] float GetMinimumTextWidth(uint32_t font_size) override;
+
+  // Adds the recorded calls to `text_renderer`.
+  void CopyTo(TextRenderer& text_renderer) const;
+
+ private:
+  struct PushTranslationCall {
+    float x;
+    float y;
+    float z;
+  };
+  struct PopTranslationCall {};
+  struct SetRenderGroupNameCall {
+    std::string name;
+  };
+  struct AddTextCall {
+    std::string text;
+    float x;
+    float y;
+    float z;
+    TextFormatting formatting;
+  };
+  struct AddTextTrailingCharsPrioritizedCall {
+    std::string text;
+    float x;
+    float y;
+    float z;
+    TextFormatting formatting;
+    size_t trailing_chars_length;
+  };
+  using Call = std::variant<PushTranslationCall, PopTranslationCall, SetRenderGroupNameCall,
+                            AddTextCall, AddTextTrailingCharsPrioritizedCall>;
+
+  std::vector<Call> calls_;
+  TextRendererInterface* measuring_renderer_;
+};
+
+}  // namespace orbit_gl
+
+#endif  // ORBIT_GL_RECORDING_TEXT_RENDERER_H_
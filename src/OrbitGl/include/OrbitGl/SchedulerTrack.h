@@ -63,8 +63,10 @@ class SchedulerTrack final : public TimerTrack {
   [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer_info,
                                     bool is_selected, bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
-  [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
-                                          PickingId id) const override;
+  [[nodiscard]] std::string GetBoxTooltip(
+      const orbit_gl::PickingUserData& user_data) const override;
+  // DoUpdatePrimitives draws the timers from TimerData::GetTimersAtDepthDiscretized instead.
+  [[nodiscard]] bool CanDrawTimersFromPyramid() const override { return false; }
 
  private:
   uint32_t num_cores_;
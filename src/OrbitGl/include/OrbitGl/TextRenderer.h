@@ -15,8 +15,11 @@ class TextRenderer : public TextRendererInterface {
  public:
   void SetViewport(Viewport* viewport) { viewport_ = viewport; }
 
-  void PushTranslation(float x, float y, float z = 0.f) { translations_.PushTranslation(x, y, z); }
-  void PopTranslation() { translations_.PopTranslation(); }
+  // Virtual so that a RecordingTextRenderer can record the translations.
+  virtual void PushTranslation(float x, float y, float z = 0.f) {
+    translations_.PushTranslation(x, y, z);
+  }
+  virtual void PopTranslation() { translations_.PopTranslation(); }
 
   void SetCurrentRenderGroupName(std::string name) override {
     current_render_group_.name = std::move(name);
@@ -16,6 +16,7 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
@@ -64,8 +65,10 @@ class ThreadStateBar final : public ThreadBar {
       const Vec2& pos) const;
 
  private:
-  std::string GetThreadStateSliceTooltip(PrimitiveAssembler& primitive_assembler,
-                                         PickingId id) const;
+  std::string GetThreadStateSliceTooltip(const PickingUserData& user_data) const;
+
+  const PickingUserData::TooltipCallback slice_tooltip_callback_ =
+      [this](const PickingUserData& user_data) { return GetThreadStateSliceTooltip(user_data); };
 };
 
 }  // namespace orbit_gl
@@ -114,8 +114,12 @@ class ThreadTrack final : public TimerTrack {
                                     const internal::DrawData& draw_data);
   [[nodiscard]] std::string GetTimesliceText(
       const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
-                                          PickingId id) const override;
+  [[nodiscard]] std::string GetBoxTooltip(
+      const orbit_gl::PickingUserData& user_data) const override;
+  // DoUpdatePrimitives draws the timers from the ScopeTree, with
+  // ThreadTrackDataProvider::GetTimersAtDepthDiscretized, which already visits at most a timer per
+  // pixel.
+  [[nodiscard]] bool CanDrawTimersFromPyramid() const override { return false; }
 
   [[nodiscard]] float GetHeight() const override;
   [[nodiscard]] float GetHeightAboveTimers() const override;
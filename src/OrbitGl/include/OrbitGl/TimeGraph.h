@@ -5,6 +5,8 @@
 #ifndef ORBIT_GL_TIME_GRAPH_H_
 #define ORBIT_GL_TIME_GRAPH_H_
 
+#include <absl/functional/function_ref.h>
+
 #include <QPainter>
 #include <cstdint>
 #include <limits>
@@ -19,6 +21,7 @@
 #include "ClientData/ApiTrackValue.h"
 #include "ClientData/CaptureData.h"
 #include "ClientData/CgroupAndProcessMemoryInfo.h"
+#include "ClientData/CompactTimerChain.h"
 #include "ClientData/PageFaultsInfo.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/SystemMemoryInfo.h"
@@ -34,6 +37,7 @@
 #include "OrbitGl/GlSlider.h"
 #include "OrbitGl/ManualInstrumentationManager.h"
 #include "OrbitGl/OpenGlBatcher.h"
+#include "OrbitGl/PickingIndex.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/QtTextRenderer.h"
@@ -138,8 +142,12 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
   [[nodiscard]] const orbit_client_protos::TimerInfo* FindNextScopeTimer(
       ScopeId scope_id, uint64_t current_time,
       std::optional<uint32_t> thread_id = std::nullopt) const;
+  // Doesn't include the timers of loaded captures, see ThreadTrackDataProvider.
   [[nodiscard]] std::vector<const orbit_client_data::TimerChain*> GetAllThreadTrackTimerChains()
       const;
+  void ForEachThreadTrackTimer(
+      uint64_t min_tick, uint64_t max_tick,
+      absl::FunctionRef<void(const orbit_client_data::TimerView&)> visitor) const;
   [[nodiscard]] std::pair<const orbit_client_protos::TimerInfo*,
                           const orbit_client_protos::TimerInfo*>
   GetMinMaxTimerForScope(ScopeId scope_id) const;
@@ -149,6 +157,11 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
 
   enum class RedrawType { kNone, kDraw, kUpdatePrimitives };
 
+  // Makes all tracks generate their primitives again in the next frame, instead of replaying the
+  // primitives they cached. Call this when state outside of the tracks that affects how they are
+  // drawn has changed, e.g. the selected or highlighted timer.
+  void RequestUpdateOfAllPrimitives();
+
   [[nodiscard]] RedrawType GetRedrawTypeRequired() const {
     if (update_primitives_requested_) return RedrawType::kUpdatePrimitives;
     if (draw_requested_) return RedrawType::kDraw;
@@ -157,6 +170,10 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
 
   [[nodiscard]] orbit_gl::TextRenderer* GetTextRenderer() { return &text_renderer_static_; }
   [[nodiscard]] orbit_gl::Batcher& GetBatcher() { return batcher_; }
+  [[nodiscard]] std::optional<orbit_gl::PickedPrimitive> FindPickedPrimitive(
+      Vec2 pos, const orbit_gl::BatchRenderGroupStateManager& manager) const {
+    return batcher_.FindPickedPrimitive(pos, manager);
+  }
 
   [[nodiscard]] const TimeGraphLayout& GetLayout() const { return *layout_; }
 
@@ -189,6 +206,9 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
               orbit_gl::TextRenderer& text_renderer, const DrawContext& draw_context) override;
   void PrepareBatcherAndUpdatePrimitives(PickingMode picking_mode);
   void DoUpdateLayout() override;
+  [[nodiscard]] uint64_t GetExternalStateGeneration() const override {
+    return external_state_generation_;
+  }
   void UpdateChildrenPosAndContainerSize();
   void UpdateVerticalSliderFromWorld();
   void UpdateHorizontalSliderFromWorld();
@@ -230,6 +250,7 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
   double max_time_us_ = 0;
   uint64_t capture_min_timestamp_ = std::numeric_limits<uint64_t>::max();
   uint64_t capture_max_timestamp_ = 0;
+  uint64_t external_state_generation_ = 0;
 
   TimeGraphLayout* layout_ = nullptr;
 
@@ -130,6 +130,10 @@ class TimerTrack : public Track {
     return true;
   }
 
+  // Whether the timers can be drawn from the TimerPyramid of their depth when zoomed out, that is,
+  // whether the longest timer of a bucket can stand for the other timers of the bucket.
+  [[nodiscard]] virtual bool CanDrawTimersFromPyramid() const { return true; }
+
   [[nodiscard]] bool DrawTimer(orbit_gl::TextRenderer& text_renderer,
                                const orbit_client_protos::TimerInfo* prev_timer_info,
                                const orbit_client_protos::TimerInfo* next_timer_info,
@@ -137,6 +141,9 @@ class TimerTrack : public Track {
                                const orbit_client_protos::TimerInfo* current_timer_info,
                                uint64_t* min_ignore, uint64_t* max_ignore);
 
+  void DrawTimersFromPyramid(orbit_gl::TextRenderer& text_renderer,
+                             const internal::DrawData& draw_data, uint32_t level);
+
   [[nodiscard]] virtual std::string GetTimesliceText(
       const orbit_client_protos::TimerInfo& /*timer*/) const {
     return "";
@@ -155,15 +162,10 @@ class TimerTrack : public Track {
       std::optional<ScopeId> highlighted_scope_id, uint64_t highlighted_group_id,
       std::optional<orbit_statistics::HistogramSelectionRange> histogram_selection_range);
 
-  [[nodiscard]] virtual std::string GetBoxTooltip(
-      const orbit_gl::PrimitiveAssembler& primitive_assembler, PickingId id) const;
-  [[nodiscard]] std::unique_ptr<orbit_gl::PickingUserData> CreatePickingUserData(
-      const orbit_gl::PrimitiveAssembler& primitive_assembler,
-      const orbit_client_protos::TimerInfo& timer_info) {
-    return std::make_unique<orbit_gl::PickingUserData>(
-        &timer_info, [this, &primitive_assembler](PickingId id) {
-          return this->GetBoxTooltip(primitive_assembler, id);
-        });
+  [[nodiscard]] virtual std::string GetBoxTooltip(const orbit_gl::PickingUserData& user_data) const;
+  [[nodiscard]] orbit_gl::PickingUserData CreatePickingUserData(
+      const orbit_client_protos::TimerInfo& timer_info) const {
+    return orbit_gl::PickingUserData(&timer_info, &box_tooltip_callback_);
   }
 
   [[nodiscard]] inline bool BoxHasRoomForText(orbit_gl::TextRenderer& text_renderer,
@@ -185,6 +187,8 @@ class TimerTrack : public Track {
 
   orbit_client_data::TimerData* timer_data_;
   absl::flat_hash_map<uint32_t, float> width_of_single_char_cache_;
+  const orbit_gl::PickingUserData::TooltipCallback box_tooltip_callback_ =
+      [this](const orbit_gl::PickingUserData& user_data) { return GetBoxTooltip(user_data); };
 };
 
 #endif  // ORBIT_GL_TIMER_TRACK_H_
@@ -11,6 +11,7 @@
 
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
+#include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
@@ -44,7 +45,10 @@ class TracepointThreadBar : public ThreadBar {
                           uint64_t min_tick, uint64_t max_tick, PickingMode picking_mode) override;
 
  private:
-  std::string GetTracepointTooltip(PrimitiveAssembler& primitive_assembler, PickingId id) const;
+  std::string GetTracepointTooltip(const PickingUserData& user_data) const;
+
+  const PickingUserData::TooltipCallback tracepoint_tooltip_callback_ =
+      [this](const PickingUserData& user_data) { return GetTracepointTooltip(user_data); };
 };
 
 }  // namespace orbit_gl
@@ -133,6 +133,10 @@ class Track : public orbit_gl::CaptureViewElement,
               orbit_gl::TextRenderer& text_renderer, const DrawContext& draw_context) override;
   void DoUpdateLayout() override;
 
+  // The primitives of a track only change with its data and layout, the visible time range and the
+  // state of the time graph, e.g. the selected timer.
+  [[nodiscard]] bool CachesPrimitives() const override { return true; }
+
   virtual void UpdatePositionOfSubtracks() {}
 
   [[nodiscard]] EventResult OnMouseEnter() override;
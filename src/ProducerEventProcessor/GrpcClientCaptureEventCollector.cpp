@@ -9,14 +9,19 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include "ApiInterface/Orbit.h"
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/MakeUniqueForOverwrite.h"
+#include "OrbitBase/Result.h"
 #include "OrbitBase/ThreadUtils.h"
+#include "OrbitBase/Zlib.h"
 
+using orbit_grpc_protos::CaptureOptions;
 using orbit_grpc_protos::CaptureResponse;
 using orbit_grpc_protos::ClientCaptureEvent;
 
@@ -66,11 +71,33 @@ void GrpcClientCaptureEventCollector::AddEvent(ClientCaptureEvent&& event) {
           kMaxEventsPerCaptureResponse) {
     auto* capture_response = google::protobuf::Arena::CreateMessage<CaptureResponse>(
         arena_of_capture_responses_being_built_.get());
+    if (capture_responses_being_built_.empty()) {
+      first_event_being_built_time_ = absl::Now();
+    }
     capture_responses_being_built_.push_back(capture_response);
   }
   capture_responses_being_built_.back()->mutable_capture_events()->Add(std::move(event));
 }
 
+void GrpcClientCaptureEventCollector::SetCaptureStreamCompression(
+    CaptureOptions::CaptureStreamCompression capture_stream_compression) {
+  absl::MutexLock lock{&mutex_};
+  capture_stream_compression_ = capture_stream_compression;
+}
+
+ClientCaptureEventCollector::Backlog GrpcClientCaptureEventCollector::GetBacklog() {
+  absl::MutexLock lock{&mutex_};
+  Backlog backlog;
+  backlog.size_bytes = arena_of_capture_responses_being_built_->SpaceUsed() + bytes_being_sent_;
+  const std::optional<absl::Time> oldest_event_time = first_event_being_sent_time_.has_value()
+                                                          ? first_event_being_sent_time_
+                                                          : first_event_being_built_time_;
+  if (oldest_event_time.has_value()) {
+    backlog.oldest_event_age = absl::Now() - oldest_event_time.value();
+  }
+  return backlog;
+}
+
 void GrpcClientCaptureEventCollector::StopAndWait() {
   ORBIT_CHECK(sender_thread_.joinable());
   {
@@ -93,6 +120,49 @@ GrpcClientCaptureEventCollector::~GrpcClientCaptureEventCollector() {
                           static_cast<float>(total_number_of_events_sent_);
     ORBIT_LOG("Average number of bytes per event: %.2f", average_bytes);
   }
+
+  if (total_number_of_bytes_compressed_ > 0) {
+    ORBIT_LOG("Total number of compressed bytes sent: %u (%.1f%% of %u bytes compressed)",
+              total_number_of_compressed_bytes_sent_,
+              100.0 * static_cast<double>(total_number_of_compressed_bytes_sent_) /
+                  static_cast<double>(total_number_of_bytes_compressed_),
+              total_number_of_bytes_compressed_);
+    ORBIT_LOG("Time spent compressing: %.3f ms",
+              absl::ToDoubleMilliseconds(total_compression_duration_));
+  }
+}
+
+void GrpcClientCaptureEventCollector::WriteCaptureResponse(
+    const CaptureResponse& capture_response,
+    CaptureOptions::CaptureStreamCompression capture_stream_compression) {
+  if (capture_stream_compression == CaptureOptions::kCaptureStreamZlib) {
+    const std::string serialized_capture_response = capture_response.SerializeAsString();
+    const absl::Time compression_start = absl::Now();
+    ErrorMessageOr<std::string> compressed_or_error =
+        orbit_base::ZlibCompress(serialized_capture_response);
+    total_compression_duration_ += absl::Now() - compression_start;
+
+    if (compressed_or_error.has_value()) {
+      CaptureResponse compressed_capture_response;
+      compressed_capture_response.set_compression(CaptureOptions::kCaptureStreamZlib);
+      compressed_capture_response.set_uncompressed_size(serialized_capture_response.size());
+      *compressed_capture_response.mutable_compressed_capture_events() =
+          std::move(compressed_or_error.value());
+
+      total_number_of_bytes_compressed_ += serialized_capture_response.size();
+      total_number_of_compressed_bytes_sent_ += compressed_capture_response.ByteSizeLong();
+      ORBIT_INT("Compressed byte size of CaptureResponse",
+                compressed_capture_response.ByteSizeLong());
+
+      ORBIT_SCOPE("reader_writer_->Write");
+      reader_writer_->Write(compressed_capture_response);
+      return;
+    }
+    ORBIT_ERROR("Sending CaptureResponse uncompressed: %s", compressed_or_error.error().message());
+  }
+
+  ORBIT_SCOPE("reader_writer_->Write");
+  reader_writer_->Write(capture_response);
 }
 
 void GrpcClientCaptureEventCollector::SenderThread() {
@@ -130,6 +200,11 @@ void GrpcClientCaptureEventCollector::SenderThread() {
     // `arena_of_capture_response_to_send_` are effectively the two buffers.
     arena_of_capture_responses_being_built_.swap(arena_of_capture_responses_to_send_);
     capture_responses_being_built_.swap(capture_responses_to_send_);
+    first_event_being_sent_time_ = first_event_being_built_time_;
+    first_event_being_built_time_.reset();
+    bytes_being_sent_ = arena_of_capture_responses_to_send_->SpaceUsed();
+    const CaptureOptions::CaptureStreamCompression capture_stream_compression =
+        capture_stream_compression_;
     mutex_.Unlock();
 
     uint64_t number_of_events_sent = 0;
@@ -152,10 +227,7 @@ void GrpcClientCaptureEventCollector::SenderThread() {
       number_of_bytes_sent += capture_response_bytes;
 
       // Now send the CaptureResponse.
-      {
-        ORBIT_SCOPE("reader_writer_->Write");
-        reader_writer_->Write(*capture_response);
-      }
+      WriteCaptureResponse(*capture_response, capture_stream_compression);
     }
 
     // Record statistics on event count and byte size for this entire iteration.
@@ -173,6 +245,10 @@ void GrpcClientCaptureEventCollector::SenderThread() {
 
     capture_responses_to_send_.clear();
     arena_of_capture_responses_to_send_->Reset();
+
+    absl::MutexLock lock{&mutex_};
+    first_event_being_sent_time_.reset();
+    bytes_being_sent_ = 0;
   }
 }
 
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <absl/synchronization/notification.h>
+#include <absl/time/time.h>
 #include <gmock/gmock.h>
 #include <grpcpp/grpcpp.h>
 #include <gtest/gtest.h>
@@ -10,13 +12,17 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <string>
 #include <thread>
 
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/services.pb.h"
 #include "OrbitBase/Logging.h"
+#include "OrbitBase/Result.h"
+#include "OrbitBase/Zlib.h"
 #include "ProducerEventProcessor/GrpcClientCaptureEventCollector.h"
 
+using orbit_grpc_protos::CaptureOptions;
 using orbit_grpc_protos::CaptureRequest;
 using orbit_grpc_protos::CaptureResponse;
 using orbit_grpc_protos::ClientCaptureEvent;
@@ -63,12 +69,23 @@ class GrpcClientCaptureEventCollectorTest : public testing::Test {
     }
   }
 
+  void AddEvent(ClientCaptureEvent event) { collector_.AddEvent(std::move(event)); }
+
   void AddFakeEvents(uint64_t event_count) {
     for (uint64_t i = 0; i < event_count; ++i) {
       collector_.AddEvent(ClientCaptureEvent{});
     }
   }
 
+  void SetCaptureStreamCompression(
+      CaptureOptions::CaptureStreamCompression capture_stream_compression) {
+    collector_.SetCaptureStreamCompression(capture_stream_compression);
+  }
+
+  [[nodiscard]] ClientCaptureEventCollector::Backlog GetBacklog() {
+    return collector_.GetBacklog();
+  }
+
   void CallStopAndWaitEarly() {
     ORBIT_CHECK(!stop_and_wait_called_);
     collector_.StopAndWait();
@@ -157,4 +174,68 @@ TEST_F(GrpcClientCaptureEventCollectorTest, AllCaptureResponsesSentShortlyAfterS
   EXPECT_EQ(actual_event_count, kEventCount);
 }
 
+TEST_F(GrpcClientCaptureEventCollectorTest, EventsAreSentCompressedWhenRequested) {
+  SetCaptureStreamCompression(CaptureOptions::kCaptureStreamZlib);
+
+  std::atomic<uint64_t> actual_event_count = 0;
+  EXPECT_CALL(mock_reader_writer_, OnCaptureResponse)
+      .Times(testing::Between(1, 2))
+      .WillRepeatedly([&actual_event_count](const CaptureResponse& capture_response) {
+        EXPECT_EQ(capture_response.compression(), CaptureOptions::kCaptureStreamZlib);
+        EXPECT_EQ(capture_response.capture_events_size(), 0);
+        ErrorMessageOr<std::string> serialized_or_error = orbit_base::ZlibDecompress(
+            capture_response.compressed_capture_events(), capture_response.uncompressed_size());
+        ASSERT_TRUE(serialized_or_error.has_value());
+        CaptureResponse decompressed_capture_response;
+        ASSERT_TRUE(decompressed_capture_response.ParseFromString(serialized_or_error.value()));
+        for (const ClientCaptureEvent& event : decompressed_capture_response.capture_events()) {
+          EXPECT_EQ(event.event_case(), ClientCaptureEvent::kCaptureStarted);
+          ++actual_event_count;
+        }
+      });
+
+  static constexpr uint64_t kEventCount = 100;
+  for (uint64_t i = 0; i < kEventCount; ++i) {
+    ClientCaptureEvent event;
+    event.mutable_capture_started()->set_process_id(42);
+    AddEvent(std::move(event));
+  }
+
+  std::this_thread::sleep_for(kWaitAllCaptureResponsesSentDuration);
+  EXPECT_EQ(actual_event_count, kEventCount);
+}
+
+TEST_F(GrpcClientCaptureEventCollectorTest, BacklogContainsEventsUntilTheyAreSent) {
+  EXPECT_EQ(GetBacklog().size_bytes, 0);
+  EXPECT_EQ(GetBacklog().oldest_event_age, absl::ZeroDuration());
+
+  absl::Notification capture_response_written;
+  absl::Notification unblock_write;
+  EXPECT_CALL(mock_reader_writer_, OnCaptureResponse)
+      .Times(testing::Between(1, 2))
+      .WillRepeatedly([&](const CaptureResponse& /*capture_response*/) {
+        if (!capture_response_written.HasBeenNotified()) {
+          capture_response_written.Notify();
+        }
+        unblock_write.WaitForNotification();
+      });
+
+  AddFakeEvents(10);
+  const ClientCaptureEventCollector::Backlog backlog_before_sending = GetBacklog();
+  EXPECT_GT(backlog_before_sending.size_bytes, 0);
+
+  // The events being written still count as backlog, and get older.
+  capture_response_written.WaitForNotification();
+  std::this_thread::sleep_for(kWaitAllCaptureResponsesSentDuration);
+  const ClientCaptureEventCollector::Backlog backlog_while_sending = GetBacklog();
+  EXPECT_GT(backlog_while_sending.size_bytes, 0);
+  EXPECT_GE(backlog_while_sending.oldest_event_age,
+            absl::FromChrono(kWaitAllCaptureResponsesSentDuration));
+
+  unblock_write.Notify();
+  std::this_thread::sleep_for(kWaitAllCaptureResponsesSentDuration);
+  EXPECT_EQ(GetBacklog().size_bytes, 0);
+  EXPECT_EQ(GetBacklog().oldest_event_age, absl::ZeroDuration());
+}
+
 }  // namespace orbit_producer_event_processor
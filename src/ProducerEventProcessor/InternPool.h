@@ -0,0 +1,141 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PRODUCER_EVENT_PROCESSOR_INTERN_POOL_H_
+#define PRODUCER_EVENT_PROCESSOR_INTERN_POOL_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/hash/hash.h>
+#include <absl/synchronization/mutex.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace orbit_producer_event_processor {
+
+// Assigns unique ids to entries (strings, callstacks, ...) received from many producers
+// concurrently. Ids start at 1, 0 is reserved for invalid_id.
+// Entries are spread over kShardCount shards by hash. Each shard is an open-addressing hash table
+// of pointers to immutable nodes, so that the entries that are already interned, which is the vast
+// majority, are found without taking any lock. Only assigning a new id takes the mutex of the
+// shard. When a shard grows, the old table is kept alive until the pool is destroyed, as lookups
+// might still be probing it: this at most doubles the memory used by the tables, while the nodes
+// themselves are shared.
+template <typename T>
+class InternPool final {
+ public:
+  InternPool() = default;
+
+  InternPool(const InternPool&) = delete;
+  InternPool& operator=(const InternPool&) = delete;
+  InternPool(InternPool&&) = delete;
+  InternPool& operator=(InternPool&&) = delete;
+
+  // Return pair of <id, assigned>, where assigned is true if the entry was assigned a new id
+  // and false if returning id for already existing entry.
+  std::pair<uint64_t, bool> GetOrAssignId(const T& entry) {
+    const size_t hash = absl::Hash<T>{}(entry);
+    Shard& shard = shards_[hash % kShardCount];
+    // The low bits select the shard, so use the other ones to probe.
+    const size_t probe_hash = hash / kShardCount;
+
+    const Node* node = Find(*shard.table.load(std::memory_order_acquire), hash, probe_hash, entry);
+    if (node != nullptr) {
+      return std::make_pair(node->id, false);
+    }
+
+    absl::MutexLock lock(&shard.mutex);
+    // Another producer could have assigned an id to the same entry in the meantime.
+    Table* table = shard.table.load(std::memory_order_acquire);
+    node = Find(*table, hash, probe_hash, entry);
+    if (node != nullptr) {
+      return std::make_pair(node->id, false);
+    }
+
+    if ((shard.nodes.size() + 1) * kMaxLoadFactorInverse > table->slots.size()) {
+      table = Grow(&shard);
+    }
+    uint64_t new_id = id_counter_.fetch_add(1, std::memory_order_relaxed);
+    shard.nodes.emplace_back(std::make_unique<Node>(Node{entry, hash, new_id}));
+    Insert(table, probe_hash, shard.nodes.back().get());
+    return std::make_pair(new_id, true);
+  }
+
+  static constexpr size_t kShardCount = 16;
+
+ private:
+  struct Node {
+    T entry;
+    size_t hash;
+    uint64_t id;
+  };
+
+  struct Table {
+    explicit Table(size_t size) : slots(size) {}
+    std::vector<std::atomic<const Node*>> slots;
+  };
+
+  struct Shard {
+    Shard() {
+      tables.emplace_back(std::make_unique<Table>(kInitialTableSize));
+      table.store(tables.back().get(), std::memory_order_relaxed);
+    }
+
+    absl::Mutex mutex;
+    std::atomic<Table*> table;
+    // The current table and the ones it replaced, which lookups might still be using.
+    std::vector<std::unique_ptr<Table>> tables ABSL_GUARDED_BY(mutex);
+    std::vector<std::unique_ptr<Node>> nodes ABSL_GUARDED_BY(mutex);
+  };
+
+  [[nodiscard]] static const Node* Find(const Table& table, size_t hash, size_t probe_hash,
+                                        const T& entry) {
+    const size_t mask = table.slots.size() - 1;
+    for (size_t index = probe_hash & mask;; index = (index + 1) & mask) {
+      const Node* node = table.slots[index].load(std::memory_order_acquire);
+      if (node == nullptr) return nullptr;
+      if (node->hash == hash && node->entry == entry) return node;
+    }
+  }
+
+  // Only called with the mutex of the shard held. The table always has an empty slot left.
+  static void Insert(Table* table, size_t probe_hash, const Node* node) {
+    const size_t mask = table->slots.size() - 1;
+    size_t index = probe_hash & mask;
+    while (table->slots[index].load(std::memory_order_relaxed) != nullptr) {
+      index = (index + 1) & mask;
+    }
+    // Publishes the node, whose fields were written before, to the lookups.
+    table->slots[index].store(node, std::memory_order_release);
+  }
+
+  static Table* Grow(Shard* shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard->mutex) {
+    const size_t old_size = shard->table.load(std::memory_order_relaxed)->slots.size();
+    auto new_table = std::make_unique<Table>(2 * old_size);
+    for (const std::unique_ptr<Node>& node : shard->nodes) {
+      Insert(new_table.get(), node->hash / kShardCount, node.get());
+    }
+    Table* new_table_ptr = new_table.get();
+    shard->tables.emplace_back(std::move(new_table));
+    shard->table.store(new_table_ptr, std::memory_order_release);
+    return new_table_ptr;
+  }
+
+  static constexpr size_t kInitialTableSize = 64;
+  // Tables are at most half full, which keeps probe sequences short.
+  static constexpr size_t kMaxLoadFactorInverse = 2;
+  static_assert((kInitialTableSize & (kInitialTableSize - 1)) == 0);
+
+  std::atomic<uint64_t> id_counter_ = 1;  // 0 is reserved for invalid_id
+  std::array<Shard, kShardCount> shards_;
+};
+
+}  // namespace orbit_producer_event_processor
+
+#endif  // PRODUCER_EVENT_PROCESSOR_INTERN_POOL_H_
@@ -0,0 +1,68 @@
+// Copyright (c) 2026 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/container/flat_hash_set.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "InternPool.h"
+
+namespace orbit_producer_event_processor {
+
+TEST(InternPool, AssignsConsecutiveIdsStartingFromOne) {
+  InternPool<std::string> pool;
+  EXPECT_EQ(pool.GetOrAssignId("a"), std::make_pair(uint64_t{1}, true));
+  EXPECT_EQ(pool.GetOrAssignId("b"), std::make_pair(uint64_t{2}, true));
+  EXPECT_EQ(pool.GetOrAssignId("a"), std::make_pair(uint64_t{1}, false));
+  EXPECT_EQ(pool.GetOrAssignId("c"), std::make_pair(uint64_t{3}, true));
+  EXPECT_EQ(pool.GetOrAssignId("b"), std::make_pair(uint64_t{2}, false));
+}
+
+TEST(InternPool, KeepsIdsWhileGrowing) {
+  InternPool<std::vector<uint64_t>> pool;
+  constexpr uint64_t kEntryCount = 100'000;
+  for (uint64_t i = 0; i < kEntryCount; ++i) {
+    EXPECT_EQ(pool.GetOrAssignId({i, i + 1}), std::make_pair(i + 1, true));
+  }
+  for (uint64_t i = 0; i < kEntryCount; ++i) {
+    EXPECT_EQ(pool.GetOrAssignId({i, i + 1}), std::make_pair(i + 1, false));
+  }
+}
+
+TEST(InternPool, ConcurrentProducersGetTheSameIdForTheSameEntry) {
+  InternPool<std::string> pool;
+  constexpr size_t kThreadCount = 8;
+  constexpr uint64_t kEntryCount = 10'000;
+  std::vector<std::vector<std::pair<uint64_t, bool>>> results_per_thread(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+    threads.emplace_back([&pool, &results = results_per_thread[thread_index]] {
+      for (uint64_t i = 0; i < kEntryCount; ++i) {
+        results.push_back(pool.GetOrAssignId(std::to_string(i)));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  absl::flat_hash_set<uint64_t> all_ids;
+  for (uint64_t i = 0; i < kEntryCount; ++i) {
+    size_t assigned_count = 0;
+    for (const std::vector<std::pair<uint64_t, bool>>& results : results_per_thread) {
+      EXPECT_EQ(results[i].first, results_per_thread[0][i].first);
+      if (results[i].second) ++assigned_count;
+    }
+    EXPECT_EQ(assigned_count, 1);
+    all_ids.insert(results_per_thread[0][i].first);
+  }
+  EXPECT_EQ(all_ids.size(), kEntryCount);
+}
+
+}  // namespace orbit_producer_event_processor
@@ -4,6 +4,7 @@
 
 #include "ProducerEventProcessor/ProducerEventProcessor.h"
 
+#include <absl/base/thread_annotations.h>
 #include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
 #include <absl/meta/type_traits.h>
@@ -16,6 +17,7 @@
 
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
+#include "InternPool.h"
 #include "OrbitBase/Logging.h"
 #include "ProducerEventProcessor/ClientCaptureEventCollector.h"
 
@@ -72,32 +74,6 @@ namespace orbit_producer_event_processor {
 
 namespace {
 
-template <typename T>
-class InternPool final {
- public:
-  InternPool() = default;
-
-  // Return pair of <id, assigned>, where assigned is true if the entry was assigned a new id
-  // and false if returning id for already existing entry.
-  std::pair<uint64_t, bool> GetOrAssignId(const T& entry) {
-    absl::MutexLock lock(&entry_to_id_mutex_);
-    auto it = entry_to_id_.find(entry);
-    if (it != entry_to_id_.end()) {
-      return std::make_pair(it->second, false);
-    }
-
-    uint64_t new_id = id_counter_++;
-    auto [unused_it, inserted] = entry_to_id_.insert_or_assign(entry, new_id);
-    ORBIT_CHECK(inserted);
-    return std::make_pair(new_id, true);
-  }
-
- private:
-  uint64_t id_counter_ = 1;  // 0 is reserved for invalid_id
-  absl::flat_hash_map<T, uint64_t> entry_to_id_;
-  absl::Mutex entry_to_id_mutex_;
-};
-
 class ProducerEventProcessorImpl : public ProducerEventProcessor {
  public:
   ProducerEventProcessorImpl() = delete;
@@ -175,8 +151,11 @@ class ProducerEventProcessorImpl : public ProducerEventProcessor {
   // These are mapping InternStrings and InternedCallstacks from producer ids
   // to client ids:
   // <producer_id, producer_callstack_id> -> client_callstack_id
+  // Guarded as LinuxTracing sends interned callstacks from more than one thread.
+  absl::Mutex producer_interned_callstack_id_mutex_;
   absl::flat_hash_map<std::pair<uint64_t, uint64_t>, uint64_t>
-      producer_interned_callstack_id_to_client_callstack_id_;
+      producer_interned_callstack_id_to_client_callstack_id_
+          ABSL_GUARDED_BY(producer_interned_callstack_id_mutex_);
   // <producer_id, producer_string_id> -> client_string_id
   absl::flat_hash_map<std::pair<uint64_t, uint64_t>, uint64_t>
       producer_interned_string_id_to_client_string_id_;
@@ -311,11 +290,14 @@ void ProducerEventProcessorImpl::ProcessApiTrackUint64AndTransferOwnership(
 void ProducerEventProcessorImpl::ProcessCallstackSampleAndTransferOwnership(
     uint64_t producer_id, CallstackSample* callstack_sample) {
   // translate producer id to client id
-  auto it = producer_interned_callstack_id_to_client_callstack_id_.find(
-      {producer_id, callstack_sample->callstack_id()});
-  // TODO(b/180235290): replace with error message
-  ORBIT_CHECK(it != producer_interned_callstack_id_to_client_callstack_id_.end());
-  callstack_sample->set_callstack_id(it->second);
+  {
+    absl::ReaderMutexLock lock{&producer_interned_callstack_id_mutex_};
+    auto it = producer_interned_callstack_id_to_client_callstack_id_.find(
+        {producer_id, callstack_sample->callstack_id()});
+    // TODO(b/180235290): replace with error message
+    ORBIT_CHECK(it != producer_interned_callstack_id_to_client_callstack_id_.end());
+    callstack_sample->set_callstack_id(it->second);
+  }
 
   ClientCaptureEvent event;
   event.set_allocated_callstack_sample(callstack_sample);
@@ -489,17 +471,18 @@ void ProducerEventProcessorImpl::ProcessGpuQueueSubmissionAndTransferOwnership(
 
 void ProducerEventProcessorImpl::ProcessInternedCallstack(uint64_t producer_id,
                                                           InternedCallstack* interned_callstack) {
-  // TODO(b/180235290): replace with error message
-  ORBIT_CHECK(!producer_interned_callstack_id_to_client_callstack_id_.contains(
-      {producer_id, interned_callstack->key()}));
-
   std::pair<std::vector<uint64_t>, Callstack::CallstackType> callstack_data{
       {interned_callstack->intern().pcs().begin(), interned_callstack->intern().pcs().end()},
       interned_callstack->intern().type()};
   auto [interned_callstack_id, assigned] = callstack_pool_.GetOrAssignId(callstack_data);
 
-  producer_interned_callstack_id_to_client_callstack_id_.insert_or_assign(
-      {producer_id, interned_callstack->key()}, interned_callstack_id);
+  {
+    absl::MutexLock lock{&producer_interned_callstack_id_mutex_};
+    auto [unused_it, inserted] = producer_interned_callstack_id_to_client_callstack_id_.emplace(
+        std::make_pair(producer_id, interned_callstack->key()), interned_callstack_id);
+    // TODO(b/180235290): replace with error message
+    ORBIT_CHECK(inserted);
+  }
 
   if (!assigned) {
     return;
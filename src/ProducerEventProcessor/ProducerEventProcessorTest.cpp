@@ -92,6 +92,7 @@ class MockClientCaptureEventCollector : public ClientCaptureEventCollector {
  public:
   MOCK_METHOD(void, AddEvent, (orbit_grpc_protos::ClientCaptureEvent && /*event*/), (override));
   MOCK_METHOD(void, StopAndWait, (), (override));
+  MOCK_METHOD(Backlog, GetBacklog, (), (override));
 };
 
 constexpr uint64_t kDefaultProducerId = 31;
@@ -5,6 +5,9 @@
 #ifndef CAPTURE_EVENT_PROCESSOR_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
 #define CAPTURE_EVENT_PROCESSOR_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
 
+#include <absl/time/time.h>
+#include <stdint.h>
+
 #include "GrpcProtos/capture.pb.h"
 
 namespace orbit_producer_event_processor {
@@ -16,6 +19,14 @@ class ClientCaptureEventCollector {
   virtual ~ClientCaptureEventCollector() = default;
   virtual void AddEvent(orbit_grpc_protos::ClientCaptureEvent&& event) = 0;
   virtual void StopAndWait() = 0;
+
+  // Events that were added but not delivered to the client yet.
+  struct Backlog {
+    uint64_t size_bytes = 0;
+    // Time since the oldest of these events was added.
+    absl::Duration oldest_event_age = absl::ZeroDuration();
+  };
+  [[nodiscard]] virtual Backlog GetBacklog() = 0;
 };
 
 }  // namespace orbit_producer_event_processor
@@ -7,6 +7,7 @@
 
 #include <absl/base/thread_annotations.h>
 #include <absl/synchronization/mutex.h>
+#include <absl/time/time.h>
 #include <google/protobuf/arena.h>
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/impl/codegen/sync_stream.h>
@@ -14,6 +15,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -24,7 +26,7 @@
 namespace orbit_producer_event_processor {
 
 // This class receives the ClientCaptureEvents emitted by a ProducerEventProcessor and continuously
-// sends them to the client buffered in CaptureResponses.
+// sends them to the client buffered in CaptureResponses, compressed if the client asked for it.
 class GrpcClientCaptureEventCollector final : public ClientCaptureEventCollector {
  public:
   explicit GrpcClientCaptureEventCollector(
@@ -33,18 +35,30 @@ class GrpcClientCaptureEventCollector final : public ClientCaptureEventCollector
 
   void AddEvent(orbit_grpc_protos::ClientCaptureEvent&& event) override;
 
+  // Applies to the CaptureResponses sent from now on. The default is no compression.
+  void SetCaptureStreamCompression(
+      orbit_grpc_protos::CaptureOptions::CaptureStreamCompression capture_stream_compression);
+
   void StopAndWait() override;
 
+  // The size of the backlog is the memory used by the CaptureResponses not sent yet.
+  [[nodiscard]] Backlog GetBacklog() override;
+
   ~GrpcClientCaptureEventCollector() override;
 
  private:
   void SenderThread();
+  void WriteCaptureResponse(
+      const orbit_grpc_protos::CaptureResponse& capture_response,
+      orbit_grpc_protos::CaptureOptions::CaptureStreamCompression capture_stream_compression);
 
   grpc::ServerReaderWriterInterface<orbit_grpc_protos::CaptureResponse,
                                     orbit_grpc_protos::CaptureRequest>* reader_writer_;
   absl::Mutex mutex_;
   std::thread sender_thread_;
   bool stop_requested_ ABSL_GUARDED_BY(mutex_) = false;
+  orbit_grpc_protos::CaptureOptions::CaptureStreamCompression capture_stream_compression_
+      ABSL_GUARDED_BY(mutex_) = orbit_grpc_protos::CaptureOptions::kCaptureStreamNoCompression;
 
   std::unique_ptr<char[]> initial_block_of_first_arena_;
   std::unique_ptr<char[]> initial_block_of_second_arena_;
@@ -55,8 +69,19 @@ class GrpcClientCaptureEventCollector final : public ClientCaptureEventCollector
   std::unique_ptr<google::protobuf::Arena> arena_of_capture_responses_to_send_;
   std::vector<orbit_grpc_protos::CaptureResponse*> capture_responses_to_send_;
 
+  // For GetBacklog: when the first event of capture_responses_being_built_ and of
+  // capture_responses_to_send_ were added, and the memory used by the latter while being sent.
+  std::optional<absl::Time> first_event_being_built_time_ ABSL_GUARDED_BY(mutex_);
+  std::optional<absl::Time> first_event_being_sent_time_ ABSL_GUARDED_BY(mutex_);
+  uint64_t bytes_being_sent_ ABSL_GUARDED_BY(mutex_) = 0;
+
   uint64_t total_number_of_events_sent_ = 0;
   uint64_t total_number_of_bytes_sent_ = 0;
+  // Only count the CaptureResponses that were compressed: total_number_of_bytes_compressed_ is
+  // their size before compression.
+  uint64_t total_number_of_bytes_compressed_ = 0;
+  uint64_t total_number_of_compressed_bytes_sent_ = 0;
+  absl::Duration total_compression_duration_;
 };
 
 }  // namespace orbit_producer_event_processor